@@ -18,40 +18,15 @@
 
 #ifdef ENABLE_GUROBI
 
+#include "ILPSolver.h"
 #include "MString.h"
 #include "Map.h"
 
 #include "gurobi_c++.h"
 
-class GurobiWrapper
+class GurobiWrapper : public ILPSolver
 {
 public:
-    enum VariableType {
-        CONTINUOUS = 0,
-        BINARY = 1,
-    };
-
-    /*
-      A term has the form: coefficient * variable
-    */
-    struct Term
-    {
-        Term( double coefficient, String variable )
-            : _coefficient( coefficient )
-            , _variable( variable )
-        {
-        }
-
-        Term()
-            : _coefficient( 0 )
-            , _variable( "" )
-        {
-        }
-
-        double _coefficient;
-        String _variable;
-    };
-
     GurobiWrapper();
     ~GurobiWrapper();
 
@@ -129,27 +104,17 @@ private:
 
 #else
 
+#include "ILPSolver.h"
 #include "MString.h"
 #include "Map.h"
 
-class GurobiWrapper
+class GurobiWrapper : public ILPSolver
 {
 public:
     /*
       This is a DUMMY class, for compilation purposes when Gurobi is
       disabled.
     */
-    enum VariableType {
-        CONTINUOUS = 0,
-        BINARY = 1,
-    };
-
-    struct Term
-    {
-        Term( double, String ) {}
-        Term() {}
-    };
-
     GurobiWrapper() {}
     ~GurobiWrapper() {}
 
@@ -173,7 +138,7 @@ public:
     bool haveFeasibleSolution() { return true; };
     void setTimeLimit( double ) {};
     double getObjectiveBound() { return 0; };
-    void dump() {}
+    void dumpModel( String ) {}
 };
 
 #endif // ENABLE_GUROBI
@@ -30,6 +30,16 @@ void matrixMultiplication( const double *matA, const double *matB, double *matC,
     cblas_dgemm( CblasRowMajor, CblasNoTrans, CblasNoTrans, rowsA, columnsB,
                  columnsA, alpha, matA, columnsA, matB, columnsB, beta, matC, columnsB);
 }
+
+void matrixMultiplication( const float *matA, const float *matB, float *matC,
+                           unsigned rowsA, unsigned columnsA,
+                           unsigned columnsB )
+{
+    float alpha = 1;
+    float beta = 1;
+    cblas_sgemm( CblasRowMajor, CblasNoTrans, CblasNoTrans, rowsA, columnsB,
+                 columnsA, alpha, matA, columnsA, matB, columnsB, beta, matC, columnsB);
+}
 #else
 void matrixMultiplication( const double *matA, const double *matB, double *matC,
                            unsigned rowsA, unsigned columnsA,
@@ -47,4 +57,21 @@ void matrixMultiplication( const double *matA, const double *matB, double *matC,
         }
     }
 }
+
+void matrixMultiplication( const float *matA, const float *matB, float *matC,
+                           unsigned rowsA, unsigned columnsA,
+                           unsigned columnsB )
+{
+    for ( unsigned i = 0; i < rowsA; ++i )
+    {
+        for ( unsigned j = 0; j < columnsB; ++j )
+        {
+            for ( unsigned k = 0; k < columnsA; ++k )
+            {
+                matC[i * columnsB + j] += matA[i * columnsA + k]
+                    * matB[k * columnsB + j];
+            }
+        }
+    }
+}
 #endif
@@ -11,4 +11,11 @@ void matrixMultiplication( const double *matA, const double *matB, double *matC,
                            unsigned rowsA, unsigned columnsA,
                            unsigned columnsB );
 
+/*
+  The same, in single precision
+*/
+void matrixMultiplication( const float *matA, const float *matB, float *matC,
+                           unsigned rowsA, unsigned columnsA,
+                           unsigned columnsB );
+
 #endif // __MatrixMultiplication_h__
@@ -36,6 +36,13 @@ Statistics::Statistics()
     , _numSplits( 0 )
     , _numPops( 0 )
     , _numVisitedTreeStates( 1 )
+    , _numLearnedPhaseClauses( 0 )
+    , _numBackjumps( 0 )
+    , _numPrunedTreeStates( 0 )
+    , _numRestarts( 0 )
+    , _numLookaheadProbes( 0 )
+    , _numLookaheadValidSplits( 0 )
+    , _timeLookaheadMicro( 0 )
     , _numTableauPivots( 0 )
     , _numTableauDegeneratePivots( 0 )
     , _numTableauDegeneratePivotsByRequest( 0 )
@@ -64,6 +71,9 @@ Statistics::Statistics()
     , _ppNumTighteningIterations( 0 )
     , _ppNumConstraintsRemoved( 0 )
     , _ppNumEquationsRemoved( 0 )
+    , _numFalsifierAttempts( 0 )
+    , _totalTimeFalsifierMicro( 0 )
+    , _numFalsifierCounterexamples( 0 )
     , _totalTimePerformingValidCaseSplitsMicro( 0 )
     , _totalTimePerformingSymbolicBoundTightening( 0 )
     , _totalTimeHandlingStatisticsMicro( 0 )
@@ -192,6 +202,13 @@ void Statistics::print()
     printf( "\tNumber of equations removed due to variable elimination: %u\n",
             _ppNumEquationsRemoved );
 
+    printf( "\t--- Falsifier Statistics ---\n" );
+    printf( "\tNumber of gradient descent attempts: %llu. Total time: %llu milli. "
+            "Counterexamples found: %u\n"
+            , _numFalsifierAttempts
+            , _totalTimeFalsifierMicro / 1000
+            , _numFalsifierCounterexamples );
+
     printf( "\t--- Engine Statistics ---\n" );
     printf( "\tNumber of main loop iterations: %llu\n"
             "\t\t%llu iterations were simplex steps. Total time: %llu milli. Average: %.2lf milli.\n"
@@ -254,6 +271,15 @@ void Statistics::print()
             , _numPops );
     printf( "\tMax stack depth: %u\n"
             , _maxStackDepth );
+    printf( "\tLearned phase clauses: %u. Backjumps: %u. Pruned tree states: %u. Restarts: %u\n"
+            , _numLearnedPhaseClauses
+            , _numBackjumps
+            , _numPrunedTreeStates
+            , _numRestarts );
+    printf( "\tLookahead probes: %u. Valid splits found by probing: %u. Time: %llu milli\n"
+            , _numLookaheadProbes
+            , _numLookaheadValidSplits
+            , _timeLookaheadMicro / 1000 );
 
     printf( "\t--- Bound Tightening Statistics ---\n" );
     printf( "\tNumber of tightened bounds: %llu.\n", _numTightenedBounds );
@@ -393,6 +419,71 @@ unsigned Statistics::getNumPops() const
     return _numPops;
 }
 
+void Statistics::incNumLearnedPhaseClauses()
+{
+    ++_numLearnedPhaseClauses;
+}
+
+void Statistics::incNumBackjumps()
+{
+    ++_numBackjumps;
+}
+
+void Statistics::incNumPrunedTreeStates( unsigned increment )
+{
+    _numPrunedTreeStates += increment;
+}
+
+void Statistics::incNumRestarts()
+{
+    ++_numRestarts;
+}
+
+unsigned Statistics::getNumLearnedPhaseClauses() const
+{
+    return _numLearnedPhaseClauses;
+}
+
+unsigned Statistics::getNumBackjumps() const
+{
+    return _numBackjumps;
+}
+
+unsigned Statistics::getNumPrunedTreeStates() const
+{
+    return _numPrunedTreeStates;
+}
+
+unsigned Statistics::getNumRestarts() const
+{
+    return _numRestarts;
+}
+
+void Statistics::incNumLookaheadProbes()
+{
+    ++_numLookaheadProbes;
+}
+
+void Statistics::incNumLookaheadValidSplits()
+{
+    ++_numLookaheadValidSplits;
+}
+
+void Statistics::addTimeLookahead( unsigned long long time )
+{
+    _timeLookaheadMicro += time;
+}
+
+unsigned Statistics::getNumLookaheadProbes() const
+{
+    return _numLookaheadProbes;
+}
+
+unsigned Statistics::getNumLookaheadValidSplits() const
+{
+    return _numLookaheadValidSplits;
+}
+
 void Statistics::incNumTableauPivots()
 {
     ++_numTableauPivots;
@@ -549,6 +640,21 @@ void Statistics::ppIncNumEquationsRemoved()
     ++_ppNumEquationsRemoved;
 }
 
+void Statistics::incNumFalsifierAttempts( unsigned increment )
+{
+    _numFalsifierAttempts += increment;
+}
+
+void Statistics::addTimeFalsifier( unsigned long long time )
+{
+    _totalTimeFalsifierMicro += time;
+}
+
+void Statistics::incNumFalsifierCounterexamples()
+{
+    ++_numFalsifierCounterexamples;
+}
+
 void Statistics::addTimeForValidCaseSplit( unsigned long long time )
 {
     _totalTimePerformingValidCaseSplitsMicro += time;
@@ -100,6 +100,27 @@ public:
     unsigned getNumSplits() const;
     unsigned long long getTotalTime() const;
 
+    /*
+      Conflict analysis related statistics.
+    */
+    void incNumLearnedPhaseClauses();
+    void incNumBackjumps();
+    void incNumPrunedTreeStates( unsigned increment = 1 );
+    void incNumRestarts();
+    unsigned getNumLearnedPhaseClauses() const;
+    unsigned getNumBackjumps() const;
+    unsigned getNumPrunedTreeStates() const;
+    unsigned getNumRestarts() const;
+
+    /*
+      Strong branching related statistics.
+    */
+    void incNumLookaheadProbes();
+    void incNumLookaheadValidSplits();
+    void addTimeLookahead( unsigned long long time );
+    unsigned getNumLookaheadProbes() const;
+    unsigned getNumLookaheadValidSplits() const;
+
     /*
       Report a timeout, or check whether a timeout has occurred
     */
@@ -144,6 +165,13 @@ public:
     void ppIncNumConstraintsRemoved();
     void ppIncNumEquationsRemoved();
 
+    /*
+      Gradient-based falsification statistics.
+    */
+    void incNumFalsifierAttempts( unsigned increment );
+    void addTimeFalsifier( unsigned long long time );
+    void incNumFalsifierCounterexamples();
+
     /*
       For debugging purposes
     */
@@ -200,6 +228,23 @@ private:
     // Total number of states in the search tree visited so far
     unsigned _numVisitedTreeStates;
 
+    // Number of clauses learned from conflicts, number of pops that
+    // skipped levels, and number of tree states that were pruned by
+    // them or by the learned clauses
+    unsigned _numLearnedPhaseClauses;
+    unsigned _numBackjumps;
+    unsigned _numPrunedTreeStates;
+
+    // Number of times the search restarted from the root
+    unsigned _numRestarts;
+
+    // Number of case splits probed by strong branching, number of
+    // valid splits found by finding a probed case infeasible, and the
+    // time spent probing, in microseconds
+    unsigned _numLookaheadProbes;
+    unsigned _numLookaheadValidSplits;
+    unsigned long long _timeLookaheadMicro;
+
     // Total number of tableau pivot operations performed, both
     // degenerate and non-degenerate
     unsigned long long _numTableauPivots;
@@ -277,6 +322,11 @@ private:
     unsigned _ppNumConstraintsRemoved;
     unsigned _ppNumEquationsRemoved;
 
+    // Falsifier counters: starting points tried, time spent and counterexamples found
+    unsigned long long _numFalsifierAttempts;
+    unsigned long long _totalTimeFalsifierMicro;
+    unsigned _numFalsifierCounterexamples;
+
     // Total amount of time spent performing valid case splits
     unsigned long long _totalTimePerformingValidCaseSplitsMicro;
 
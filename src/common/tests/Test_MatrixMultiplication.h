@@ -55,6 +55,25 @@ public:
         TS_ASSERT(matC[4] == 23);
         TS_ASSERT(matC[5] == 34);
     }
+
+    void test_matrix_matrix_single_precision()
+    {
+        float matA[] = {1,2,3,4,5,6}; // [1,2], [3,4], [5,6]
+        float matB[] = {1,2,3,4}; // [1,2], [3,4]
+        float matC[6] = {1,1,1,1,1,1};
+        unsigned rowsA = 3;
+        unsigned columnsA = 2;
+        unsigned columnsB = 2;
+        matrixMultiplication(matA, matB, matC, rowsA, columnsA, columnsB);
+
+        // The product is added to matC
+        TS_ASSERT(matC[0] == 8);
+        TS_ASSERT(matC[1] == 11);
+        TS_ASSERT(matC[2] == 16);
+        TS_ASSERT(matC[3] == 23);
+        TS_ASSERT(matC[4] == 24);
+        TS_ASSERT(matC[5] == 35);
+    }
 };
 
 //
@@ -45,6 +45,10 @@ const double GlobalConfiguration::GAUSSIAN_ELIMINATION_PIVOT_SCALE_THRESHOLD = 0
 const unsigned GlobalConfiguration::MAX_SIMPLEX_PIVOT_SEARCH_ITERATIONS = 5;
 const unsigned GlobalConfiguration::CONSTRAINT_VIOLATION_THRESHOLD = 20;
 const DivideStrategy GlobalConfiguration::SPLITTING_HEURISTICS = DivideStrategy::ReLUViolation;
+const bool GlobalConfiguration::USE_CONFLICT_DRIVEN_CLAUSE_LEARNING = true;
+const RestartPolicy GlobalConfiguration::RESTART_POLICY = RestartPolicy::NoRestarts;
+const unsigned GlobalConfiguration::RESTART_BASE_INTERVAL = 500;
+const double GlobalConfiguration::RESTART_GEOMETRIC_FACTOR = 1.5;
 const unsigned GlobalConfiguration::BOUND_TIGHTING_ON_CONSTRAINT_MATRIX_FREQUENCY = 100;
 const unsigned GlobalConfiguration::ROW_BOUND_TIGHTENER_SATURATION_ITERATIONS = 20;
 const double GlobalConfiguration::COST_FUNCTION_ERROR_THRESHOLD = 0.0000000001;
@@ -53,10 +57,15 @@ const bool GlobalConfiguration::USE_HARRIS_RATIO_TEST = true;
 
 const bool GlobalConfiguration::USE_SYMBOLIC_BOUND_TIGHTENING = true;
 const double GlobalConfiguration::SYMBOLIC_TIGHTENING_ROUNDING_CONSTANT = 0.00000005;
+const bool GlobalConfiguration::USE_INCREMENTAL_SYMBOLIC_BOUND_TIGHTENING = true;
+const unsigned GlobalConfiguration::CONVOLUTION_DETECTION_MAX_KERNEL_SIZE = 11;
+const unsigned GlobalConfiguration::CONVOLUTION_DETECTION_MAX_STRIDE = 4;
 
 const bool GlobalConfiguration::PREPROCESS_INPUT_QUERY = true;
 const bool GlobalConfiguration::PREPROCESSOR_ELIMINATE_VARIABLES = true;
 const bool GlobalConfiguration::PREPROCESSOR_PL_CONSTRAINTS_ADD_AUX_EQUATIONS = true;
+const bool GlobalConfiguration::PREPROCESSOR_SIMPLIFY_NETWORK = true;
+const unsigned GlobalConfiguration::PREPROCESSOR_SIMPLIFY_NETWORK_MAX_FAN_IN = 16;
 const double GlobalConfiguration::PREPROCESSOR_ALMOST_FIXED_THRESHOLD = 0.00001;
 
 const bool GlobalConfiguration::WARM_START = false;
@@ -68,6 +77,8 @@ const double GlobalConfiguration::PSE_GAMMA_ERROR_THRESHOLD = 0.001;
 const double GlobalConfiguration::PSE_GAMMA_UPDATE_TOLERANCE = 0.000000001;
 
 const double GlobalConfiguration::RELU_CONSTRAINT_COMPARISON_TOLERANCE = 0.00001;
+const bool GlobalConfiguration::USE_RELU_LAYER_CONSTRAINTS = true;
+const bool GlobalConfiguration::DEFER_VARIABLE_VALUE_NOTIFICATIONS = true;
 const double GlobalConfiguration::ABS_CONSTRAINT_COMPARISON_TOLERANCE = 0.00001;
 
 const bool GlobalConfiguration::ONLY_AUX_INITIAL_BASIS = false;
@@ -80,6 +91,7 @@ const GlobalConfiguration::MILPSolverBoundTighteningType GlobalConfiguration::MI
     GlobalConfiguration::LP_RELAXATION;
 
 const unsigned GlobalConfiguration::MILPSolverTimeoutValueInSeconds = 1;
+const double GlobalConfiguration::LP_TIGHTENING_TIME_BUDGET_PER_NEURON_IN_SECONDS = 2;
 
 const unsigned GlobalConfiguration::REFACTORIZATION_THRESHOLD = 100;
 const GlobalConfiguration::BasisFactorizationType GlobalConfiguration::BASIS_FACTORIZATION_TYPE =
@@ -87,6 +99,19 @@ const GlobalConfiguration::BasisFactorizationType GlobalConfiguration::BASIS_FAC
 
 const unsigned GlobalConfiguration::RUNTIME_ESTIMATE_THRESHOLD = 5;
 
+const unsigned GlobalConfiguration::STRONG_BRANCHING_CANDIDATES = 4;
+const unsigned GlobalConfiguration::STRONG_BRANCHING_BUDGET_IN_MICROSECONDS = 100000;
+
+const unsigned GlobalConfiguration::DNC_SHARED_KNOWLEDGE_MAX_ENTRIES = 4096;
+const unsigned GlobalConfiguration::DNC_SHARED_CLAUSE_MAX_LENGTH = 10;
+const unsigned GlobalConfiguration::DNC_RUNTIME_MODEL_MIN_SAMPLES = 8;
+const double GlobalConfiguration::DNC_MAX_BUDGET_SCALE = 2;
+const double GlobalConfiguration::DNC_EAGER_SPLIT_RATIO = 4;
+
+const unsigned GlobalConfiguration::GRADIENT_FALSIFIER_STEPS_PER_ATTEMPT = 100;
+const double GlobalConfiguration::GRADIENT_FALSIFIER_INITIAL_STEP_SIZE = 0.1;
+const unsigned GlobalConfiguration::GRADIENT_FALSIFIER_RANDOM_SEED = 1;
+
 #ifdef ENABLE_GUROBI
 const unsigned GlobalConfiguration::GUROBI_NUMBER_OF_THREADS = 1;
 #endif // ENABLE_GUROBI
@@ -132,6 +157,11 @@ void GlobalConfiguration::print()
     printf( "  GAUSSIAN_ELIMINATION_PIVOT_SCALE_THRESHOLD: %.15lf\n", GAUSSIAN_ELIMINATION_PIVOT_SCALE_THRESHOLD );
     printf( "  MAX_SIMPLEX_PIVOT_SEARCH_ITERATIONS: %u\n", MAX_SIMPLEX_PIVOT_SEARCH_ITERATIONS );
     printf( "  CONSTRAINT_VIOLATION_THRESHOLD: %u\n", CONSTRAINT_VIOLATION_THRESHOLD );
+    printf( "  USE_CONFLICT_DRIVEN_CLAUSE_LEARNING: %s\n",
+            USE_CONFLICT_DRIVEN_CLAUSE_LEARNING ? "Yes" : "No" );
+    printf( "  RESTART_POLICY: %u\n", RESTART_POLICY );
+    printf( "  RESTART_BASE_INTERVAL: %u\n", RESTART_BASE_INTERVAL );
+    printf( "  RESTART_GEOMETRIC_FACTOR: %.2lf\n", RESTART_GEOMETRIC_FACTOR );
     printf( "  BOUND_TIGHTING_ON_CONSTRAINT_MATRIX_FREQUENCY: %u\n",
             BOUND_TIGHTING_ON_CONSTRAINT_MATRIX_FREQUENCY );
     printf( "  COST_FUNCTION_ERROR_THRESHOLD: %.15lf\n", COST_FUNCTION_ERROR_THRESHOLD );
@@ -141,9 +171,13 @@ void GlobalConfiguration::print()
     printf( "  PREPROCESSOR_ELIMINATE_VARIABLES: %s\n", PREPROCESSOR_ELIMINATE_VARIABLES ? "Yes" : "No" );
     printf( "  PREPROCESSOR_PL_CONSTRAINTS_ADD_AUX_EQUATIONS: %s\n",
             PREPROCESSOR_PL_CONSTRAINTS_ADD_AUX_EQUATIONS ? "Yes" : "No" );
+    printf( "  PREPROCESSOR_SIMPLIFY_NETWORK: %s\n", PREPROCESSOR_SIMPLIFY_NETWORK ? "Yes" : "No" );
+    printf( "  PREPROCESSOR_SIMPLIFY_NETWORK_MAX_FAN_IN: %u\n", PREPROCESSOR_SIMPLIFY_NETWORK_MAX_FAN_IN );
     printf( "  PSE_ITERATIONS_BEFORE_RESET: %u\n", PSE_ITERATIONS_BEFORE_RESET );
     printf( "  PSE_GAMMA_ERROR_THRESHOLD: %.15lf\n", PSE_GAMMA_ERROR_THRESHOLD );
     printf( "  RELU_CONSTRAINT_COMPARISON_TOLERANCE: %.15lf\n", RELU_CONSTRAINT_COMPARISON_TOLERANCE );
+    printf( "  USE_RELU_LAYER_CONSTRAINTS: %s\n", USE_RELU_LAYER_CONSTRAINTS ? "Yes" : "No" );
+    printf( "  DEFER_VARIABLE_VALUE_NOTIFICATIONS: %s\n", DEFER_VARIABLE_VALUE_NOTIFICATIONS ? "Yes" : "No" );
 
     String basisBoundTighteningType;
     switch ( EXPLICIT_BASIS_BOUND_TIGHTENING_TYPE )
@@ -179,6 +213,11 @@ void GlobalConfiguration::print()
         basisFactorizationType = "Unknown";
 
     printf( "  BASIS_FACTORIZATION_TYPE: %s\n", basisFactorizationType.ascii() );
+    printf( "  STRONG_BRANCHING_CANDIDATES: %u\n", STRONG_BRANCHING_CANDIDATES );
+    printf( "  STRONG_BRANCHING_BUDGET_IN_MICROSECONDS: %u\n", STRONG_BRANCHING_BUDGET_IN_MICROSECONDS );
+    printf( "  DNC_RUNTIME_MODEL_MIN_SAMPLES: %u\n", DNC_RUNTIME_MODEL_MIN_SAMPLES );
+    printf( "  DNC_MAX_BUDGET_SCALE: %.2lf\n", DNC_MAX_BUDGET_SCALE );
+    printf( "  DNC_EAGER_SPLIT_RATIO: %.2lf\n", DNC_EAGER_SPLIT_RATIO );
     printf( "****************************\n" );
 }
 
@@ -17,6 +17,7 @@
 #define __GlobalConfiguration_h__
 
 #include "DivideStrategy.h"
+#include "RestartPolicy.h"
 
 class GlobalConfiguration
 {
@@ -76,6 +77,16 @@ public:
     // to add auxiliary variables and equations.
     static const bool PREPROCESSOR_PL_CONSTRAINTS_ADD_AUX_EQUATIONS;
 
+    // Assuming the preprocessor is on and a network was detected, toggle whether or not
+    // symbolic bound tightening is used to fix ReLU phases before the tableau is built, with
+    // fixed ReLUs and the weighted sums feeding them folded into the following layer.
+    static const bool PREPROCESSOR_SIMPLIFY_NETWORK;
+
+    // When folding a weighted sum into the equations that use it, the maximal number of
+    // variables that the weighted sum may have. Larger sums would make the equations they
+    // are folded into too dense.
+    static const unsigned PREPROCESSOR_SIMPLIFY_NETWORK_MAX_FAN_IN;
+
     // If the difference between a variable's lower and upper bounds is smaller than this
     // threshold, the preprocessor will treat it as fixed.
     static const double PREPROCESSOR_ALMOST_FIXED_THRESHOLD;
@@ -114,6 +125,17 @@ public:
 
     static const DivideStrategy SPLITTING_HEURISTICS;
 
+    // Should the SMT core analyze conflicts, backjump over splits that did not
+    // contribute to them, and learn clauses over ReLU phases to prune the search?
+    static const bool USE_CONFLICT_DRIVEN_CLAUSE_LEARNING;
+
+    // When should the SMT core abandon the current search tree and restart from the root, keeping
+    // the learned clauses and the last phase of each ReLU? The interval is measured in visited tree
+    // states, and grows with the number of restarts according to the policy.
+    static const RestartPolicy RESTART_POLICY;
+    static const unsigned RESTART_BASE_INTERVAL;
+    static const double RESTART_GEOMETRIC_FACTOR;
+
     // How often should we perform full bound tightening, on the entire contraints matrix A.
     static const unsigned BOUND_TIGHTING_ON_CONSTRAINT_MATRIX_FREQUENCY;
 
@@ -136,6 +158,14 @@ public:
     // The tolerance for checking whether f = Relu( b )
     static const double RELU_CONSTRAINT_COMPARISON_TOLERANCE;
 
+    // Should the engine group the ReLUs of each network layer into a single
+    // ReluLayerConstraint, which keeps their state in contiguous arrays?
+    static const bool USE_RELU_LAYER_CONSTRAINTS;
+
+    // Should the tableau defer variable value notifications, and deliver
+    // them once per variable only when the engine needs the current values?
+    static const bool DEFER_VARIABLE_VALUE_NOTIFICATIONS;
+
     // The tolerance for checking whether f = Abs( b )
     static const double ABS_CONSTRAINT_COMPARISON_TOLERANCE;
 
@@ -181,6 +211,10 @@ public:
     // The timeout value for an individual query of the MILP solver
     static const unsigned MILPSolverTimeoutValueInSeconds;
 
+    // The total time spent on tightening the bounds of a single neuron
+    // using the LP relaxation, over both its lower and upper bounds
+    static const double LP_TIGHTENING_TIME_BUDGET_PER_NEURON_IN_SECONDS;
+
     /*
       Symbolic bound tightening options
     */
@@ -191,6 +225,15 @@ public:
     // Symbolic tightening rounding constant
     static const double SYMBOLIC_TIGHTENING_ROUNDING_CONSTANT;
 
+    // Whether symbolic bound tightening should only recompute the layers affected by
+    // bound changes since the previous invocation
+    static const bool USE_INCREMENTAL_SYMBOLIC_BOUND_TIGHTENING;
+
+    // The largest kernel size and stride considered when looking for convolutions
+    // in the weighted sum layers of the network level reasoner
+    static const unsigned CONVOLUTION_DETECTION_MAX_KERNEL_SIZE;
+    static const unsigned CONVOLUTION_DETECTION_MAX_STRIDE;
+
     /*
       Constraint fixing heuristics
     */
@@ -224,6 +267,53 @@ public:
     */
     static const unsigned RUNTIME_ESTIMATE_THRESHOLD;
 
+    /*
+      In the strong branching heuristic, the number of most violated ReLUs whose phases are
+      probed before each split, and the time that the probing may take at each split.
+    */
+    static const unsigned STRONG_BRANCHING_CANDIDATES;
+    static const unsigned STRONG_BRANCHING_BUDGET_IN_MICROSECONDS;
+
+    /*
+      The maximal number of subquery boxes whose learned bounds and
+      clauses are kept in the store shared by the DnC workers, and the
+      maximal length of the clauses that are shared. 0 entries disables
+      sharing.
+    */
+    static const unsigned DNC_SHARED_KNOWLEDGE_MAX_ENTRIES;
+    static const unsigned DNC_SHARED_CLAUSE_MAX_LENGTH;
+
+    /*
+      The number of DnC subqueries whose solving times are recorded
+      before the runtime model is used to predict the times of new
+      ones.
+    */
+    static const unsigned DNC_RUNTIME_MODEL_MIN_SAMPLES;
+
+    /*
+      A DnC subquery predicted to be hard gets a larger time budget,
+      of up to this many times its regular budget.
+    */
+    static const double DNC_MAX_BUDGET_SCALE;
+
+    /*
+      A DnC subquery predicted to take more than this many times its
+      time budget is divided before being solved.
+    */
+    static const double DNC_EAGER_SPLIT_RATIO;
+
+    /*
+      Gradient-based falsification options
+    */
+
+    // The number of gradient steps taken from each starting point
+    static const unsigned GRADIENT_FALSIFIER_STEPS_PER_ATTEMPT;
+
+    // The initial step size, as a fraction of the range of each input variable
+    static const double GRADIENT_FALSIFIER_INITIAL_STEP_SIZE;
+
+    // The seed used to draw the random starting points
+    static const unsigned GRADIENT_FALSIFIER_RANDOM_SEED;
 
 #ifdef ENABLE_GUROBI
     /*
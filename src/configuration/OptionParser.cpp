@@ -48,6 +48,18 @@ void OptionParser::initialize()
         ( "restore-tree-states",
           boost::program_options::bool_switch( &((*_boolOptions)[Options::RESTORE_TREE_STATES]) ),
           "Restore tree states in dnc mode" )
+        ( "native-lp-tightening",
+          boost::program_options::bool_switch( &((*_boolOptions)[Options::NATIVE_LP_TIGHTENING]) ),
+          "Perform LP-based bound tightening with the built-in simplex instead of Gurobi" )
+        ( "sbt-single-precision",
+          boost::program_options::bool_switch( &((*_boolOptions)[Options::SBT_SINGLE_PRECISION]) ),
+          "Perform symbolic bound tightening in single precision, with sound error bounds" )
+        ( "resume",
+          boost::program_options::bool_switch( &((*_boolOptions)[Options::RESUME]) ),
+          "(DNC) Resume the run saved in the checkpoint file, if there is one" )
+        ( "dnc-processes",
+          boost::program_options::bool_switch( &((*_boolOptions)[Options::DNC_PROCESSES]) ),
+          "(DNC) Run the workers in separate processes rather than threads. Tree states are not restored" )
         ( "input",
           boost::program_options::value<std::string>( &((*_stringOptions)[Options::INPUT_FILE_PATH]) ),
           "Neural netowrk file" )
@@ -63,6 +75,21 @@ void OptionParser::initialize()
         ( "query-dump-file",
           boost::program_options::value<std::string>( &((*_stringOptions)[Options::QUERY_DUMP_FILE]) ),
           "Query dump file" )
+        ( "split-strategy",
+          boost::program_options::value<std::string>( &((*_stringOptions)[Options::SPLITTING_STRATEGY]) ),
+          "The branching heuristic for ReLU splitting: relu-violation/polarity/earliest-relu/babsr/strong-branching" )
+        ( "divide-strategy",
+          boost::program_options::value<std::string>( &((*_stringOptions)[Options::DIVIDE_STRATEGY]) ),
+          "(DNC) How to divide a query: by input region, largest-interval/babsr, or by ReLU phases, polarity/earliest-relu/relu-violation" )
+        ( "restarts",
+          boost::program_options::value<std::string>( &((*_stringOptions)[Options::RESTART_POLICY]) ),
+          "When to restart the search, keeping learned clauses and saved phases: none/luby/geometric" )
+        ( "runtime-log-file",
+          boost::program_options::value<std::string>( &((*_stringOptions)[Options::RUNTIME_LOG_FILE]) ),
+          "(DNC) File to which the predicted and actual solving times of subqueries are written" )
+        ( "checkpoint-file",
+          boost::program_options::value<std::string>( &((*_stringOptions)[Options::CHECKPOINT_FILE]) ),
+          "(DNC) File to which the remaining subqueries and the solved regions are saved" )
         ( "num-workers",
           boost::program_options::value<int>( &((*_intOptions)[Options::NUM_WORKERS]) ),
           "(DNC) Number of workers" )
@@ -85,9 +112,21 @@ void OptionParser::initialize()
         ( "split-threshold",
           boost::program_options::value<int>( &((*_intOptions)[Options::SPLIT_THRESHOLD]) ),
           "Max number of tries to repair a relu before splitting" )
+        ( "lp-tightening-threads",
+          boost::program_options::value<int>( &((*_intOptions)[Options::NUM_LP_TIGHTENING_THREADS]) ),
+          "Number of threads used for LP-based bound tightening" )
+        ( "falsifier-attempts",
+          boost::program_options::value<int>( &((*_intOptions)[Options::FALSIFIER_ATTEMPTS]) ),
+          "Number of starting points for gradient-based falsification before search (0 disables it)" )
+        ( "checkpoint-interval",
+          boost::program_options::value<int>( &((*_intOptions)[Options::CHECKPOINT_INTERVAL]) ),
+          "(DNC) Seconds between saves of the checkpoint file" )
         ( "timeout-factor",
           boost::program_options::value<float>( &((*_floatOptions)[Options::TIMEOUT_FACTOR]) ),
           "(DNC) The timeout factor" )
+        ( "falsifier-timeout",
+          boost::program_options::value<float>( &((*_floatOptions)[Options::FALSIFIER_TIMEOUT]) ),
+          "Time limit, in seconds, for gradient-based falsification before search" )
         ( "help",
           boost::program_options::bool_switch( &((*_boolOptions)[Options::HELP]) ),
           "Prints the help message")
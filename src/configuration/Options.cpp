@@ -15,6 +15,7 @@
 
 #include "ConfigurationError.h"
 #include "Debug.h"
+#include "GlobalConfiguration.h"
 #include "Options.h"
 
 Options *Options::get()
@@ -44,6 +45,10 @@ void Options::initializeDefaultValues()
     _boolOptions[DNC_MODE] = false;
     _boolOptions[PREPROCESSOR_PL_CONSTRAINTS_ADD_AUX_EQUATIONS] = false;
     _boolOptions[RESTORE_TREE_STATES] = false;
+    _boolOptions[NATIVE_LP_TIGHTENING] = false;
+    _boolOptions[SBT_SINGLE_PRECISION] = false;
+    _boolOptions[RESUME] = false;
+    _boolOptions[DNC_PROCESSES] = false;
 
     /*
       Int options
@@ -55,11 +60,15 @@ void Options::initializeDefaultValues()
     _intOptions[VERBOSITY] = 2;
     _intOptions[TIMEOUT] = 0;
     _intOptions[SPLIT_THRESHOLD] = 20;
+    _intOptions[NUM_LP_TIGHTENING_THREADS] = 1;
+    _intOptions[FALSIFIER_ATTEMPTS] = 10;
+    _intOptions[CHECKPOINT_INTERVAL] = 300;
 
     /*
       Float options
     */
     _floatOptions[TIMEOUT_FACTOR] = 1.5;
+    _floatOptions[FALSIFIER_TIMEOUT] = 1;
 
     /*
       String options
@@ -69,6 +78,11 @@ void Options::initializeDefaultValues()
     _stringOptions[INPUT_QUERY_FILE_PATH] = "";
     _stringOptions[SUMMARY_FILE] = "";
     _stringOptions[QUERY_DUMP_FILE] = "";
+    _stringOptions[SPLITTING_STRATEGY] = "";
+    _stringOptions[DIVIDE_STRATEGY] = "";
+    _stringOptions[RESTART_POLICY] = "";
+    _stringOptions[RUNTIME_LOG_FILE] = "";
+    _stringOptions[CHECKPOINT_FILE] = "";
 }
 
 void Options::parseOptions( int argc, char **argv )
@@ -96,6 +110,51 @@ String Options::getString( unsigned option ) const
     return String( _stringOptions.get( option ) );
 }
 
+DivideStrategy Options::getSplittingStrategy() const
+{
+    String strategy = getString( SPLITTING_STRATEGY );
+    if ( strategy == "relu-violation" )
+        return DivideStrategy::ReLUViolation;
+    else if ( strategy == "polarity" )
+        return DivideStrategy::Polarity;
+    else if ( strategy == "earliest-relu" )
+        return DivideStrategy::EarliestReLU;
+    else if ( strategy == "babsr" )
+        return DivideStrategy::BaBSR;
+    else if ( strategy == "strong-branching" )
+        return DivideStrategy::StrongBranching;
+    else
+        return GlobalConfiguration::SPLITTING_HEURISTICS;
+}
+
+DivideStrategy Options::getDivideStrategy() const
+{
+    String strategy = getString( DIVIDE_STRATEGY );
+    if ( strategy == "babsr" )
+        return DivideStrategy::BaBSR;
+    else if ( strategy == "polarity" )
+        return DivideStrategy::Polarity;
+    else if ( strategy == "earliest-relu" )
+        return DivideStrategy::EarliestReLU;
+    else if ( strategy == "relu-violation" )
+        return DivideStrategy::ReLUViolation;
+    else
+        return DivideStrategy::LargestInterval;
+}
+
+RestartPolicy Options::getRestartPolicy() const
+{
+    String policy = getString( RESTART_POLICY );
+    if ( policy == "none" )
+        return RestartPolicy::NoRestarts;
+    else if ( policy == "luby" )
+        return RestartPolicy::LubyRestarts;
+    else if ( policy == "geometric" )
+        return RestartPolicy::GeometricRestarts;
+    else
+        return GlobalConfiguration::RESTART_POLICY;
+}
+
 //
 // Local Variables:
 // compile-command: "make -C ../.. "
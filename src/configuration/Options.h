@@ -16,9 +16,11 @@
 #ifndef __Options_h__
 #define __Options_h__
 
+#include "DivideStrategy.h"
 #include "MString.h"
 #include "Map.h"
 #include "OptionParser.h"
+#include "RestartPolicy.h"
 #include "boost/program_options.hpp"
 
 /*
@@ -37,6 +39,20 @@ public:
         // Restore tree states of the parent when handling children in DnC.
         RESTORE_TREE_STATES,
 
+        // Use the built-in simplex, rather than Gurobi, for LP-based
+        // bound tightening
+        NATIVE_LP_TIGHTENING,
+
+        // Perform the matrix products of symbolic bound tightening in
+        // single precision
+        SBT_SINGLE_PRECISION,
+
+        // (DNC) Resume from the checkpoint file, if it exists
+        RESUME,
+
+        // (DNC) Run the workers in processes rather than threads
+        DNC_PROCESSES,
+
         // Help flag
         HELP,
 
@@ -58,11 +74,24 @@ public:
         TIMEOUT,
 
         SPLIT_THRESHOLD,
+
+        // Number of threads used for LP-based bound tightening
+        NUM_LP_TIGHTENING_THREADS,
+
+        // Number of starting points for gradient-based falsification
+        // before search. 0 disables falsification.
+        FALSIFIER_ATTEMPTS,
+
+        // (DNC) Seconds between saves of the checkpoint file
+        CHECKPOINT_INTERVAL,
     };
 
     enum FloatOptions{
         // DNC options
         TIMEOUT_FACTOR,
+
+        // Time limit, in seconds, for gradient-based falsification
+        FALSIFIER_TIMEOUT,
     };
 
     enum StringOptions {
@@ -71,6 +100,26 @@ public:
         INPUT_QUERY_FILE_PATH,
         SUMMARY_FILE,
         QUERY_DUMP_FILE,
+
+        // The branching heuristic for ReLU splitting: relu-violation,
+        // polarity, earliest-relu, babsr or strong-branching. Empty for
+        // the default.
+        SPLITTING_STRATEGY,
+
+        // How DnC divides a query: largest-interval or babsr
+        DIVIDE_STRATEGY,
+
+        // When the search restarts: none, luby or geometric. Empty for
+        // the default.
+        RESTART_POLICY,
+
+        // (DNC) The file to which the predicted and actual solving
+        // times of subqueries are written. Empty for none.
+        RUNTIME_LOG_FILE,
+
+        // (DNC) The file to which the progress of the run is saved, so
+        // that it can be resumed. Empty for none.
+        CHECKPOINT_FILE,
     };
 
     /*
@@ -91,6 +140,19 @@ public:
     float getFloat( unsigned option ) const;
     String getString( unsigned option ) const;
 
+    /*
+      The strategies named by the SPLITTING_STRATEGY and
+      DIVIDE_STRATEGY options, or the defaults if none were given
+    */
+    DivideStrategy getSplittingStrategy() const;
+    DivideStrategy getDivideStrategy() const;
+
+    /*
+      The restart policy named by the RESTART_POLICY option, or the
+      default if none was given
+    */
+    RestartPolicy getRestartPolicy() const;
+
     /*
       Options that are determined at compile time
     */
@@ -103,6 +165,20 @@ public:
 #endif
     }
 
+    /*
+      LP-based bound tightening is available either through Gurobi or
+      through the built-in simplex, if requested
+    */
+    bool lpTighteningEnabled() const
+    {
+        return gurobiEnabled() || getBool( NATIVE_LP_TIGHTENING );
+    }
+
+    bool nativeLpSolverInUse() const
+    {
+        return !gurobiEnabled() || getBool( NATIVE_LP_TIGHTENING );
+    }
+
 private:
     /*
       Disable default constructor and copy constructor
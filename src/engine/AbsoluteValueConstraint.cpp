@@ -94,6 +94,8 @@ void AbsoluteValueConstraint::notifyLowerBound( unsigned variable, double bound
          !FloatUtils::gt( bound, _lowerBounds[variable] ) )
         return;
 
+    saveStateIfNeeded();
+
     _lowerBounds[variable] = bound;
 
     // Check whether the phase has become fixed
@@ -134,6 +136,8 @@ void AbsoluteValueConstraint::notifyUpperBound( unsigned variable, double bound
     if ( _upperBounds.exists( variable ) && !FloatUtils::lt( bound, _upperBounds[variable] ) )
         return;
 
+    saveStateIfNeeded();
+
     _upperBounds[variable] = bound;
 
     // Check whether the phase has become fixed
@@ -494,6 +498,16 @@ bool AbsoluteValueConstraint::supportsSymbolicBoundTightening() const
     return false;
 }
 
+unsigned AbsoluteValueConstraint::getB() const
+{
+    return _b;
+}
+
+unsigned AbsoluteValueConstraint::getF() const
+{
+    return _f;
+}
+
 //
 // Local Variables:
 // compile-command: "make -C ../.. "
@@ -151,6 +151,12 @@ public:
     */
     bool supportsSymbolicBoundTightening() const;
 
+    /*
+      Get the index of the B and F variables.
+    */
+    unsigned getB() const;
+    unsigned getF() const;
+
 private:
     /*
       The variables that make up this constraint; _f = | _b |.
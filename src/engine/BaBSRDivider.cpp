@@ -0,0 +1,78 @@
+/*********************                                                        */
+/*! \file BaBSRDivider.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include "BaBSRDivider.h"
+#include "Debug.h"
+#include "FloatUtils.h"
+
+BaBSRDivider::BaBSRDivider( const List<unsigned> &inputVariables,
+                            IEngine *engine )
+    : LargestIntervalDivider( inputVariables )
+    , _engine( engine )
+{
+}
+
+void BaBSRDivider::createSubQueries( unsigned numNewSubqueries,
+                                     const String queryIdPrefix,
+                                     const PiecewiseLinearCaseSplit
+                                     &previousSplit,
+                                     const unsigned timeoutInSeconds,
+                                     SubQueries &subQueries )
+{
+    _sensitivity.clear();
+    _engine->getInputSensitivity( _sensitivity );
+
+    LargestIntervalDivider::createSubQueries( numNewSubqueries, queryIdPrefix,
+                                              previousSplit, timeoutInSeconds,
+                                              subQueries );
+}
+
+unsigned BaBSRDivider::getDimensionToSplit( const InputRegion &inputRegion )
+{
+    unsigned dimensionToSplit = 0;
+    double bestScore = 0;
+    bool haveCandidate = false;
+
+    for ( const auto &variable : _inputVariables )
+    {
+        double interval = inputRegion._upperBounds[variable] -
+            inputRegion._lowerBounds[variable];
+
+        if ( FloatUtils::isZero( interval ) || !_sensitivity.exists( variable ) )
+            continue;
+
+        double score = _sensitivity[variable] * interval;
+        if ( FloatUtils::isPositive( score ) &&
+             ( !haveCandidate || score > bestScore ) )
+        {
+            dimensionToSplit = variable;
+            bestScore = score;
+            haveCandidate = true;
+        }
+    }
+
+    if ( !haveCandidate )
+        return getLargestInterval( inputRegion );
+
+    return dimensionToSplit;
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
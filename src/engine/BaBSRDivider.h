@@ -0,0 +1,61 @@
+/*********************                                                        */
+/*! \file BaBSRDivider.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#ifndef __BaBSRDivider_h__
+#define __BaBSRDivider_h__
+
+#include "IEngine.h"
+#include "LargestIntervalDivider.h"
+#include "Map.h"
+
+/*
+  Bisects the input whose interval, weighted by the sensitivity of
+  the output bounds to that input, is the largest. The sensitivity is
+  obtained from the engine, and reflects the region it last solved.
+  If the engine has no sensitivity information, this falls back to
+  bisecting the largest interval.
+*/
+class BaBSRDivider : public LargestIntervalDivider
+{
+public:
+    BaBSRDivider( const List<unsigned> &inputVariables, IEngine *engine );
+
+    void createSubQueries( unsigned numNewSubQueries,
+                           const String queryIdPrefix,
+                           const PiecewiseLinearCaseSplit
+                           &previousSplit,
+                           const unsigned timeoutInSeconds,
+                           SubQueries &subQueries );
+
+    unsigned getDimensionToSplit( const InputRegion &inputRegion );
+
+private:
+    IEngine *_engine;
+
+    /*
+      The sensitivity used for the current call to createSubQueries
+    */
+    Map<unsigned, double> _sensitivity;
+};
+
+#endif // __BaBSRDivider_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,62 @@
+/*********************                                                        */
+/*! \file CompiledQuery.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#ifndef __CompiledQuery_h__
+#define __CompiledQuery_h__
+
+#include "InputQuery.h"
+#include "List.h"
+
+/*
+  A query as processed by an engine, ready to be loaded into other
+  engines without being processed again: in DnC mode, the base engine
+  compiles the query once, and the workers' engines are all
+  initialized from it. The compiled query is not changed once stored;
+  the weights of its network level reasoner are shared with the
+  workers' copies of the reasoner, so it must outlive the engines
+  initialized from it.
+*/
+class CompiledQuery
+{
+public:
+    CompiledQuery();
+    ~CompiledQuery();
+
+    /*
+      The preprocessed query, including the auxiliary variables, with
+      the bounds derived while processing it
+    */
+    InputQuery _query;
+
+    /*
+      The dense m-by-n constraint matrix of the query's equations
+    */
+    double *_constraintMatrix;
+
+    /*
+      The variables of the initial basis
+    */
+    List<unsigned> _initialBasis;
+};
+
+#endif // __CompiledQuery_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,229 @@
+/*********************                                                        */
+/*! \file ConflictAnalyzer.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#include "ConflictAnalyzer.h"
+#include "FloatUtils.h"
+#include "ICostFunctionManager.h"
+#include "MarabouError.h"
+#include "SmtCore.h"
+
+ConflictAnalyzer::ConflictAnalyzer()
+    : _smtCore( NULL )
+    , _n( 0 )
+    , _lowerBoundLevels( NULL )
+    , _upperBoundLevels( NULL )
+    , _haveConflictLevel( false )
+    , _conflictLevel( 0 )
+{
+}
+
+ConflictAnalyzer::~ConflictAnalyzer()
+{
+    freeMemoryIfNeeded();
+}
+
+void ConflictAnalyzer::freeMemoryIfNeeded()
+{
+    if ( _lowerBoundLevels )
+    {
+        delete[] _lowerBoundLevels;
+        _lowerBoundLevels = NULL;
+    }
+
+    if ( _upperBoundLevels )
+    {
+        delete[] _upperBoundLevels;
+        _upperBoundLevels = NULL;
+    }
+}
+
+void ConflictAnalyzer::setSmtCore( const SmtCore *smtCore )
+{
+    _smtCore = smtCore;
+}
+
+void ConflictAnalyzer::registerWithTableau( ITableau *tableau )
+{
+    freeMemoryIfNeeded();
+    _n = 0;
+    resize( tableau->getN() );
+
+    tableau->registerToWatchAllVariables( this );
+    tableau->registerResizeWatcher( this );
+}
+
+void ConflictAnalyzer::resize( unsigned n )
+{
+    unsigned *lowerBoundLevels = new unsigned[n];
+    if ( !lowerBoundLevels )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "ConflictAnalyzer::lowerBoundLevels" );
+
+    unsigned *upperBoundLevels = new unsigned[n];
+    if ( !upperBoundLevels )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "ConflictAnalyzer::upperBoundLevels" );
+
+    // New variables get the current level; their bounds are set from
+    // here on
+    unsigned level = getCurrentLevel();
+    for ( unsigned i = 0; i < n; ++i )
+    {
+        lowerBoundLevels[i] = ( i < _n ) ? _lowerBoundLevels[i] : level;
+        upperBoundLevels[i] = ( i < _n ) ? _upperBoundLevels[i] : level;
+    }
+
+    freeMemoryIfNeeded();
+    _lowerBoundLevels = lowerBoundLevels;
+    _upperBoundLevels = upperBoundLevels;
+    _n = n;
+}
+
+void ConflictAnalyzer::notifyLowerBound( unsigned variable, double /* bound */ )
+{
+    if ( variable < _n )
+        _lowerBoundLevels[variable] = getCurrentLevel();
+}
+
+void ConflictAnalyzer::notifyUpperBound( unsigned variable, double /* bound */ )
+{
+    if ( variable < _n )
+        _upperBoundLevels[variable] = getCurrentLevel();
+}
+
+void ConflictAnalyzer::notifyDimensionChange( unsigned /* m */, unsigned n )
+{
+    if ( n > _n )
+        resize( n );
+}
+
+unsigned ConflictAnalyzer::getCurrentLevel() const
+{
+    return _smtCore ? _smtCore->getStackDepth() : 0;
+}
+
+unsigned ConflictAnalyzer::getLowerBoundLevel( unsigned variable ) const
+{
+    // A recorded level above the current one is stale: the bound was
+    // restored from a state stored at or below the current level
+    unsigned level = getCurrentLevel();
+    if ( variable < _n && _lowerBoundLevels[variable] < level )
+        return _lowerBoundLevels[variable];
+    return level;
+}
+
+unsigned ConflictAnalyzer::getUpperBoundLevel( unsigned variable ) const
+{
+    unsigned level = getCurrentLevel();
+    if ( variable < _n && _upperBoundLevels[variable] < level )
+        return _upperBoundLevels[variable];
+    return level;
+}
+
+void ConflictAnalyzer::includeVariable( unsigned variable )
+{
+    unsigned lowerBoundLevel = getLowerBoundLevel( variable );
+    unsigned upperBoundLevel = getUpperBoundLevel( variable );
+
+    if ( lowerBoundLevel > _conflictLevel )
+        _conflictLevel = lowerBoundLevel;
+    if ( upperBoundLevel > _conflictLevel )
+        _conflictLevel = upperBoundLevel;
+}
+
+void ConflictAnalyzer::analyzeInvalidBounds( const ITableau &tableau )
+{
+    const double *lowerBounds = tableau.getLowerBounds();
+    const double *upperBounds = tableau.getUpperBounds();
+
+    // Each variable with invalid bounds proves the conflict on its
+    // own, so take the one with the lowest level
+    bool found = false;
+    unsigned bestLevel = 0;
+    for ( unsigned i = 0; i < tableau.getN(); ++i )
+    {
+        if ( FloatUtils::lte( lowerBounds[i], upperBounds[i] ) )
+            continue;
+
+        _conflictLevel = 0;
+        includeVariable( i );
+        if ( !found || _conflictLevel < bestLevel )
+            bestLevel = _conflictLevel;
+        found = true;
+    }
+
+    if ( found )
+    {
+        _conflictLevel = bestLevel;
+        _haveConflictLevel = true;
+    }
+}
+
+void ConflictAnalyzer::analyzeSimplexFailure( const ITableau &tableau,
+                                              const ICostFunctionManager &costFunctionManager )
+{
+    /*
+      The phase one cost function is the sum of the rows of the
+      out-of-bounds basic variables, with signs according to the
+      violated bounds, written in terms of the non-basic variables. If
+      no non-basic variable can move to decrease it, every non-basic
+      variable with a non-zero reduced cost is at the bound that blocks
+      it, and the cost cannot be decreased within these bounds: the
+      violated bounds of the basic variables cannot all be met. The
+      bounds of the variables with non-zero costs are therefore
+      sufficient for the conflict.
+    */
+    _conflictLevel = 0;
+
+    unsigned m = tableau.getM();
+    unsigned n = tableau.getN();
+
+    for ( unsigned i = 0; i < m; ++i )
+    {
+        if ( tableau.basicOutOfBounds( i ) || costFunctionManager.getBasicCost( i ) != 0 )
+            includeVariable( tableau.basicIndexToVariable( i ) );
+    }
+
+    const double *costFunction = costFunctionManager.getCostFunction();
+    for ( unsigned i = 0; i < n - m; ++i )
+    {
+        if ( costFunction[i] != 0 )
+            includeVariable( tableau.nonBasicIndexToVariable( i ) );
+    }
+
+    _haveConflictLevel = true;
+}
+
+void ConflictAnalyzer::setConflictLevel( unsigned level )
+{
+    _conflictLevel = level;
+    _haveConflictLevel = true;
+}
+
+unsigned ConflictAnalyzer::extractConflictLevel()
+{
+    unsigned level = getCurrentLevel();
+    if ( _haveConflictLevel && _conflictLevel < level )
+        level = _conflictLevel;
+
+    _haveConflictLevel = false;
+    return level;
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
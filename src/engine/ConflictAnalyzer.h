@@ -0,0 +1,124 @@
+/*********************                                                        */
+/*! \file ConflictAnalyzer.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#ifndef __ConflictAnalyzer_h__
+#define __ConflictAnalyzer_h__
+
+#include "ITableau.h"
+
+class ICostFunctionManager;
+class SmtCore;
+
+/*
+  Finds the lowest decision level at which a conflict already holds.
+
+  The analyzer watches the bounds of all the variables, and records
+  the decision level of the SMT core when each bound was last changed.
+  A bound is implied by the decisions up to its recorded level: the
+  recorded level can only be higher than the level at which the bound
+  was actually derived, because restoring an older state does not
+  lower it.
+
+  When the query becomes infeasible, the analyzer collects the
+  variables whose bounds prove it -- for an invalid bound, the
+  variable itself, and for a failed simplex step, the variables that
+  take part in the Farkas certificate given by the phase one cost
+  function -- and takes the highest level of their bounds. The
+  decisions above that level did not contribute to the conflict.
+*/
+class ConflictAnalyzer
+    : public ITableau::VariableWatcher
+    , public ITableau::ResizeWatcher
+{
+public:
+    ConflictAnalyzer();
+    ~ConflictAnalyzer();
+
+    /*
+      The SMT core whose stack depth is the current decision level.
+    */
+    void setSmtCore( const SmtCore *smtCore );
+
+    /*
+      Register with the tableau as a watcher of all variables. All
+      current bounds are taken to hold at the current decision level.
+    */
+    void registerWithTableau( ITableau *tableau );
+
+    void notifyLowerBound( unsigned variable, double bound );
+    void notifyUpperBound( unsigned variable, double bound );
+    void notifyDimensionChange( unsigned m, unsigned n );
+
+    /*
+      Analyze a conflict due to a variable whose lower bound exceeds
+      its upper bound.
+    */
+    void analyzeInvalidBounds( const ITableau &tableau );
+
+    /*
+      Analyze a conflict due to a simplex step that found no entering
+      variable for a freshly computed phase one cost function.
+    */
+    void analyzeSimplexFailure( const ITableau &tableau,
+                                const ICostFunctionManager &costFunctionManager );
+
+    /*
+      Set the conflict level directly, for conflicts detected
+      elsewhere.
+    */
+    void setConflictLevel( unsigned level );
+
+    /*
+      Return the level of the last analyzed conflict, and forget it. If
+      the last conflict was not analyzed, this is the current decision
+      level.
+    */
+    unsigned extractConflictLevel();
+
+    /*
+      The recorded levels of a variable's bounds.
+    */
+    unsigned getLowerBoundLevel( unsigned variable ) const;
+    unsigned getUpperBoundLevel( unsigned variable ) const;
+
+private:
+    const SmtCore *_smtCore;
+
+    unsigned _n;
+    unsigned *_lowerBoundLevels;
+    unsigned *_upperBoundLevels;
+
+    bool _haveConflictLevel;
+    unsigned _conflictLevel;
+
+    unsigned getCurrentLevel() const;
+    void resize( unsigned n );
+    void freeMemoryIfNeeded();
+
+    /*
+      Raise the conflict level to cover both bounds of a variable.
+    */
+    void includeVariable( unsigned variable );
+};
+
+#endif // __ConflictAnalyzer_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
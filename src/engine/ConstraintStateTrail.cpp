@@ -0,0 +1,59 @@
+/*********************                                                        */
+/*! \file ConstraintStateTrail.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#include "ConstraintStateTrail.h"
+
+ConstraintStateTrail::ConstraintStateTrail()
+    : _checkpoint( 0 )
+{
+}
+
+void ConstraintStateTrail::checkpoint()
+{
+    ++_checkpoint;
+}
+
+unsigned ConstraintStateTrail::getCheckpoint() const
+{
+    return _checkpoint;
+}
+
+void ConstraintStateTrail::record( Trailable *trailable )
+{
+    _trail.append( trailable );
+}
+
+unsigned ConstraintStateTrail::size() const
+{
+    return _trail.size();
+}
+
+void ConstraintStateTrail::undoTo( unsigned size )
+{
+    while ( _trail.size() > size )
+        _trail.pop()->undoLastChange();
+
+    // The objects are now in their state from before the undone
+    // changes, and have to save it again before they next change
+    checkpoint();
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,81 @@
+/*********************                                                        */
+/*! \file ConstraintStateTrail.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#ifndef __ConstraintStateTrail_h__
+#define __ConstraintStateTrail_h__
+
+#include "Vector.h"
+
+/*
+  An undo trail for the state of the piecewise linear constraints.
+
+  When the engine stores its state, it marks a checkpoint on the
+  trail. The first time an object's state changes after a checkpoint,
+  the object saves its current state and records itself on the
+  trail. Restoring the engine state then undoes only the changes
+  recorded since the checkpoint, in reverse order, instead of copying
+  the state of every constraint.
+*/
+class ConstraintStateTrail
+{
+public:
+    /*
+      An object whose state changes are recorded on the trail. Each
+      object keeps the states that it saved, and restores the last one
+      when asked to undo its last change.
+    */
+    class Trailable
+    {
+    public:
+        virtual ~Trailable() {}
+        virtual void undoLastChange() = 0;
+    };
+
+    ConstraintStateTrail();
+
+    /*
+      Mark a checkpoint: objects changed from now on need to save their
+      state again. An object compares the checkpoint at which it last
+      saved its state with the current one.
+    */
+    void checkpoint();
+    unsigned getCheckpoint() const;
+
+    /*
+      Record that an object has saved its state.
+    */
+    void record( Trailable *trailable );
+
+    /*
+      The number of recorded changes, and undoing all the changes
+      recorded after the trail had the given size.
+    */
+    unsigned size() const;
+    void undoTo( unsigned size );
+
+private:
+    Vector<Trailable *> _trail;
+    unsigned _checkpoint;
+};
+
+#endif // __ConstraintStateTrail_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -154,6 +154,39 @@ void CostFunctionManager::computeCoreCostFunction()
     _costFunctionStatus = ICostFunctionManager::COST_FUNCTION_JUST_COMPUTED;
 }
 
+void CostFunctionManager::computeGivenCostFunction( const Map<unsigned, double> &cost )
+{
+    /*
+      Split the given cost between the basic and non-basic variables,
+      and then compute the reduced costs as for the core cost function:
+      the multipliers p solve pB = c', and the reduced costs are given
+      by c_N - p * AN.
+    */
+    std::fill( _costFunction, _costFunction + _n - _m, 0.0 );
+    std::fill( _basicCosts, _basicCosts + _m, 0.0 );
+
+    for ( const auto &variableCost : cost )
+    {
+        unsigned variable = variableCost.first;
+        unsigned variableIndex = _tableau->variableToIndex( variable );
+        if ( _tableau->isBasic( variable ) )
+            _basicCosts[variableIndex] += variableCost.second;
+        else
+            _costFunction[variableIndex] += variableCost.second;
+    }
+
+    computeMultipliers();
+    computeReducedCosts();
+
+    /*
+      The basic costs are only used for the ratio test from here on,
+      where a non-zero cost marks a variable as out-of-bounds.
+    */
+    std::fill( _basicCosts, _basicCosts + _m, 0.0 );
+
+    _costFunctionStatus = ICostFunctionManager::COST_FUNCTION_JUST_COMPUTED;
+}
+
 void CostFunctionManager::adjustBasicCostAccuracy()
 {
     unsigned variable;
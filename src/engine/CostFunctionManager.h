@@ -41,6 +41,14 @@ public:
     void computeCostFunction( const Map<unsigned, double> &heuristicCost );
     void computeCoreCostFunction();
 
+    /*
+      Compute the reduced costs of a given linear cost function, e.g.
+      the objective of an LP, from scratch. This assumes that all basic
+      variables are within bounds: their basic costs are reset to zero
+      afterwards, so that the ratio test respects their bounds.
+    */
+    void computeGivenCostFunction( const Map<unsigned, double> &cost );
+
     /*
       Get the current cost function.
     */
@@ -74,6 +74,8 @@ void DisjunctionConstraint::notifyLowerBound( unsigned variable, double bound )
     if ( _lowerBounds.exists( variable ) && !FloatUtils::gt( bound, _lowerBounds[variable] ) )
         return;
 
+    saveStateIfNeeded();
+
     _lowerBounds[variable] = bound;
 
     updateFeasibleDisjuncts();
@@ -87,6 +89,8 @@ void DisjunctionConstraint::notifyUpperBound( unsigned variable, double bound )
     if ( _upperBounds.exists( variable ) && !FloatUtils::lt( bound, _upperBounds[variable] ) )
         return;
 
+    saveStateIfNeeded();
+
     _upperBounds[variable] = bound;
 
     updateFeasibleDisjuncts();
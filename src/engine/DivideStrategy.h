@@ -25,6 +25,8 @@ enum DivideStrategy
     Polarity,      // Pick the ReLU with the polarity closest to 0 among the first K nodes
     EarliestReLU,  // Pick a ReLU that appears in the earliest layer
     ReLUViolation, // Pick the ReLU that has been violated for the most times
+    BaBSR,         // Pick the ReLU (in DnC: the input) whose split most tightens the output bounds
+    StrongBranching, // Probe both phases of the most violated ReLUs, and pick the one whose phases fix the most bounds
 };
 
 #endif // __DivideStrategy_h__
@@ -0,0 +1,117 @@
+/*********************                                                        */
+/*! \file DnCChannel.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#include "DnCChannel.h"
+#include "MarabouError.h"
+
+#include <cerrno>
+#include <sys/socket.h>
+#include <unistd.h>
+
+DnCChannel::DnCChannel( int descriptor )
+    : _descriptor( descriptor )
+{
+}
+
+DnCChannel::~DnCChannel()
+{
+    close();
+}
+
+void DnCChannel::createLocalPair( int &first, int &second )
+{
+    int descriptors[2];
+    if ( socketpair( AF_UNIX, SOCK_STREAM, 0, descriptors ) != 0 )
+        throw MarabouError( MarabouError::DNC_PROCESS_FAILED, "socketpair" );
+
+    first = descriptors[0];
+    second = descriptors[1];
+}
+
+bool DnCChannel::send( MessageType type, const std::string &payload )
+{
+    unsigned header[2] = { (unsigned)type, (unsigned)payload.size() };
+    return sendAll( (const char *)header, sizeof( header ) ) &&
+        sendAll( payload.data(), payload.size() );
+}
+
+bool DnCChannel::receive( MessageType &type, std::string &payload )
+{
+    unsigned header[2];
+    if ( !receiveAll( (char *)header, sizeof( header ) ) || header[0] > QUIT )
+        return false;
+
+    type = (MessageType)header[0];
+    payload.resize( header[1] );
+    return receiveAll( &payload[0], header[1] );
+}
+
+int DnCChannel::getDescriptor() const
+{
+    return _descriptor;
+}
+
+void DnCChannel::close()
+{
+    if ( _descriptor >= 0 )
+    {
+        ::close( _descriptor );
+        _descriptor = -1;
+    }
+}
+
+bool DnCChannel::sendAll( const char *data, size_t size )
+{
+    while ( size > 0 )
+    {
+        // A worker that died must not take the coordinator with it
+        // through SIGPIPE
+        ssize_t sent = ::send( _descriptor, data, size, MSG_NOSIGNAL );
+        if ( sent < 0 && errno == EINTR )
+            continue;
+        if ( sent <= 0 )
+            return false;
+
+        data += sent;
+        size -= sent;
+    }
+
+    return true;
+}
+
+bool DnCChannel::receiveAll( char *data, size_t size )
+{
+    while ( size > 0 )
+    {
+        ssize_t received = ::recv( _descriptor, data, size, 0 );
+        if ( received < 0 && errno == EINTR )
+            continue;
+        if ( received <= 0 )
+            return false;
+
+        data += received;
+        size -= received;
+    }
+
+    return true;
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
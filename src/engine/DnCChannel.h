@@ -0,0 +1,77 @@
+/*********************                                                        */
+/*! \file DnCChannel.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#ifndef __DnCChannel_h__
+#define __DnCChannel_h__
+
+#include <string>
+
+/*
+  A connection between the DnC coordinator and a worker process,
+  over which whole messages are sent. Each message is a type and a
+  payload, framed by their sizes, so any stream socket can carry it:
+  local workers are connected through Unix domain socket pairs, and
+  workers on other nodes could be connected through TCP sockets.
+*/
+class DnCChannel
+{
+public:
+    enum MessageType {
+        // Coordinator to worker: a subquery to solve
+        SOLVE = 0,
+        // Worker to coordinator: the outcome of a subquery
+        RESULT = 1,
+        // Coordinator to worker: there is no more work
+        QUIT = 2,
+    };
+
+    /*
+      Take ownership of a connected stream socket
+    */
+    DnCChannel( int descriptor );
+    ~DnCChannel();
+
+    /*
+      Create a pair of connected sockets, for a local worker
+    */
+    static void createLocalPair( int &first, int &second );
+
+    /*
+      Send or receive one message, blocking until it is done. Both
+      return false if the other side has closed the connection or an
+      error occurred.
+    */
+    bool send( MessageType type, const std::string &payload );
+    bool receive( MessageType &type, std::string &payload );
+
+    int getDescriptor() const;
+    void close();
+
+private:
+    int _descriptor;
+
+    bool sendAll( const char *data, size_t size );
+    bool receiveAll( char *data, size_t size );
+};
+
+#endif // __DnCChannel_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,268 @@
+/*********************                                                        */
+/*! \file DnCCheckpoint.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#include "DnCCheckpoint.h"
+#include "MarabouError.h"
+#include "SubQuerySerializer.h"
+
+#include <cstdio>
+#include <cstring>
+
+/*
+  The file starts with a magic string and a format version, followed
+  by the fingerprint and the number of open and solved subqueries. An
+  open subquery is stored as its id, its timeout and its split; a
+  solved one as the bound tightenings of its split.
+*/
+static const char CHECKPOINT_MAGIC[8] = { 'M', 'R', 'B', 'D', 'N', 'C', 'C', 'P' };
+static const unsigned CHECKPOINT_VERSION = 1;
+
+DnCCheckpoint::DnCCheckpoint( unsigned long long fingerprint )
+    : _fingerprint( fingerprint )
+{
+}
+
+unsigned long long DnCCheckpoint::fingerprint( const InputQuery &inputQuery )
+{
+    // FNV-1a over the dimensions of the query and its input bounds
+    unsigned long long hash = 14695981039346656037ULL;
+    auto add = [&]( const void *value, unsigned size )
+    {
+        const unsigned char *bytes = (const unsigned char *)value;
+        for ( unsigned i = 0; i < size; ++i )
+        {
+            hash ^= bytes[i];
+            hash *= 1099511628211ULL;
+        }
+    };
+
+    unsigned dimensions[4] = {
+        inputQuery.getNumberOfVariables(),
+        inputQuery.getEquations().size(),
+        inputQuery.getPiecewiseLinearConstraints().size(),
+        inputQuery.getNumOutputVariables(),
+    };
+    add( dimensions, sizeof( dimensions ) );
+
+    for ( const auto &variable : inputQuery.getInputVariables() )
+    {
+        double bounds[2] = {
+            inputQuery.getLowerBound( variable ),
+            inputQuery.getUpperBound( variable ),
+        };
+        add( &variable, sizeof( variable ) );
+        add( bounds, sizeof( bounds ) );
+    }
+
+    return hash;
+}
+
+unsigned long long DnCCheckpoint::getFingerprint() const
+{
+    return _fingerprint;
+}
+
+void DnCCheckpoint::addSubQuery( const SubQuery &subQuery )
+{
+    std::lock_guard<std::mutex> lock( _mutex );
+    OpenSubQuery &open = _openSubQueries[subQuery._queryId];
+    open._split = *subQuery._split;
+    open._timeoutInSeconds = subQuery._timeoutInSeconds;
+}
+
+void DnCCheckpoint::markSolved( const String &queryId )
+{
+    std::lock_guard<std::mutex> lock( _mutex );
+    if ( !_openSubQueries.exists( queryId ) )
+        return;
+
+    _solvedRegions.append( _openSubQueries[queryId]._split.getBoundTightenings() );
+    _openSubQueries.erase( queryId );
+}
+
+void DnCCheckpoint::markDivided( const String &queryId, const SubQueries &subQueries )
+{
+    // The parent and its children are replaced at once, so that a
+    // checkpoint saved meanwhile covers the parent's box exactly once
+    std::lock_guard<std::mutex> lock( _mutex );
+    if ( _openSubQueries.exists( queryId ) )
+        _openSubQueries.erase( queryId );
+    for ( const auto &subQuery : subQueries )
+    {
+        OpenSubQuery &open = _openSubQueries[subQuery->_queryId];
+        open._split = *subQuery->_split;
+        open._timeoutInSeconds = subQuery->_timeoutInSeconds;
+    }
+}
+
+unsigned DnCCheckpoint::getNumOpenSubQueries() const
+{
+    std::lock_guard<std::mutex> lock( _mutex );
+    return _openSubQueries.size();
+}
+
+unsigned DnCCheckpoint::getNumSolvedSubQueries() const
+{
+    std::lock_guard<std::mutex> lock( _mutex );
+    return _solvedRegions.size();
+}
+
+void DnCCheckpoint::getOpenSubQueries( SubQueries &subQueries ) const
+{
+    std::lock_guard<std::mutex> lock( _mutex );
+    for ( const auto &open : _openSubQueries )
+    {
+        auto split = std::unique_ptr<PiecewiseLinearCaseSplit>
+            ( new PiecewiseLinearCaseSplit( open.second._split ) );
+        SubQuery *subQuery = new SubQuery( open.first, split,
+                                           open.second._timeoutInSeconds );
+        if ( !subQuery )
+            throw MarabouError( MarabouError::ALLOCATION_FAILED, "DnCCheckpoint::subQuery" );
+        subQueries.append( subQuery );
+    }
+}
+
+void DnCCheckpoint::getSolvedRegions( List<List<Tightening>> &regions ) const
+{
+    std::lock_guard<std::mutex> lock( _mutex );
+    regions = _solvedRegions;
+}
+
+void DnCCheckpoint::serialize( std::string &data ) const
+{
+    std::lock_guard<std::mutex> lock( _mutex );
+
+    data.clear();
+    data.append( CHECKPOINT_MAGIC, sizeof( CHECKPOINT_MAGIC ) );
+
+    SubQueryWriter writer( data );
+    writer.write<unsigned>( CHECKPOINT_VERSION );
+    writer.write<unsigned long long>( _fingerprint );
+    writer.write<unsigned>( _openSubQueries.size() );
+    writer.write<unsigned>( _solvedRegions.size() );
+
+    for ( const auto &open : _openSubQueries )
+    {
+        writer.writeString( open.first );
+        writer.write<unsigned>( open.second._timeoutInSeconds );
+        writer.writeSplit( open.second._split );
+    }
+
+    for ( const auto &region : _solvedRegions )
+        writer.writeBounds( region );
+}
+
+bool DnCCheckpoint::deserialize( const std::string &data )
+{
+    SubQueryReader reader( data );
+
+    char magic[sizeof( CHECKPOINT_MAGIC )];
+    for ( unsigned i = 0; i < sizeof( magic ); ++i )
+    {
+        if ( !reader.read( magic[i] ) )
+            return false;
+    }
+
+    unsigned version;
+    unsigned long long fingerprint;
+    unsigned numOpen;
+    unsigned numSolved;
+    if ( memcmp( magic, CHECKPOINT_MAGIC, sizeof( magic ) ) != 0 ||
+         !reader.read( version ) || version != CHECKPOINT_VERSION ||
+         !reader.read( fingerprint ) || fingerprint != _fingerprint ||
+         !reader.read( numOpen ) || !reader.read( numSolved ) )
+        return false;
+
+    Map<String, OpenSubQuery> openSubQueries;
+    for ( unsigned i = 0; i < numOpen; ++i )
+    {
+        String queryId;
+        unsigned timeoutInSeconds;
+        if ( !reader.readString( queryId ) || !reader.read( timeoutInSeconds ) )
+            return false;
+
+        OpenSubQuery &open = openSubQueries[queryId];
+        open._timeoutInSeconds = timeoutInSeconds;
+        if ( !reader.readSplit( open._split ) )
+            return false;
+    }
+
+    List<List<Tightening>> solvedRegions;
+    for ( unsigned i = 0; i < numSolved; ++i )
+    {
+        List<Tightening> bounds;
+        if ( !reader.readBounds( bounds ) )
+            return false;
+        solvedRegions.append( bounds );
+    }
+
+    if ( !reader.done() )
+        return false;
+
+    std::lock_guard<std::mutex> lock( _mutex );
+    _openSubQueries = openSubQueries;
+    _solvedRegions = solvedRegions;
+    return true;
+}
+
+bool DnCCheckpoint::save( const String &path ) const
+{
+    std::string data;
+    serialize( data );
+
+    // Write to a temporary file and rename it over the checkpoint, so
+    // that a run killed while saving leaves the previous one intact
+    String temporaryPath = path + ".tmp";
+    FILE *file = fopen( temporaryPath.ascii(), "wb" );
+    if ( !file )
+        return false;
+
+    bool written = ( fwrite( data.data(), 1, data.size(), file ) == data.size() );
+    written = ( fclose( file ) == 0 ) && written;
+
+    if ( !written || rename( temporaryPath.ascii(), path.ascii() ) != 0 )
+    {
+        remove( temporaryPath.ascii() );
+        return false;
+    }
+
+    return true;
+}
+
+bool DnCCheckpoint::load( const String &path )
+{
+    FILE *file = fopen( path.ascii(), "rb" );
+    if ( !file )
+        return false;
+
+    std::string data;
+    char buffer[4096];
+    size_t bytesRead;
+    while ( ( bytesRead = fread( buffer, 1, sizeof( buffer ), file ) ) > 0 )
+        data.append( buffer, bytesRead );
+
+    bool failed = ferror( file );
+    fclose( file );
+
+    return !failed && deserialize( data );
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,128 @@
+/*********************                                                        */
+/*! \file DnCCheckpoint.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#ifndef __DnCCheckpoint_h__
+#define __DnCCheckpoint_h__
+
+#include "InputQuery.h"
+#include "List.h"
+#include "MString.h"
+#include "Map.h"
+#include "PiecewiseLinearCaseSplit.h"
+#include "SubQuery.h"
+
+#include <mutex>
+#include <string>
+
+/*
+  The progress of a DnC run, from which it can be resumed: the
+  subqueries that are still open, i.e. that were created but were
+  neither solved nor divided yet, and the boxes of the subqueries
+  proven UNSAT. The open subqueries always cover whatever is left of
+  the input region.
+
+  The workers update the checkpoint as they go, and the manager saves
+  it to a binary file from time to time. A checkpoint is tied to the
+  query it was created for by a fingerprint of that query, and cannot
+  be loaded for another.
+
+  The SmtStates of the open subqueries are not kept: a resumed
+  subquery is solved from the root of its box.
+*/
+class DnCCheckpoint
+{
+public:
+    DnCCheckpoint( unsigned long long fingerprint );
+
+    /*
+      A fingerprint of the query: its dimensions and input bounds
+    */
+    static unsigned long long fingerprint( const InputQuery &inputQuery );
+
+    unsigned long long getFingerprint() const;
+
+    /*
+      Record a new subquery as open
+    */
+    void addSubQuery( const SubQuery &subQuery );
+
+    /*
+      Record an open subquery as solved (UNSAT)
+    */
+    void markSolved( const String &queryId );
+
+    /*
+      Replace an open subquery by the subqueries it was divided into
+    */
+    void markDivided( const String &queryId, const SubQueries &subQueries );
+
+    unsigned getNumOpenSubQueries() const;
+    unsigned getNumSolvedSubQueries() const;
+
+    /*
+      Create a subquery for each of the open subqueries. The caller
+      owns the new subqueries.
+    */
+    void getOpenSubQueries( SubQueries &subQueries ) const;
+
+    /*
+      The boxes of the solved subqueries
+    */
+    void getSolvedRegions( List<List<Tightening>> &regions ) const;
+
+    /*
+      Convert the checkpoint to and from its binary format. Restoring
+      fails, leaving the checkpoint unchanged, if the data is malformed
+      or was stored for a query with another fingerprint.
+    */
+    void serialize( std::string &data ) const;
+    bool deserialize( const std::string &data );
+
+    /*
+      Save the checkpoint to a file, replacing the previous one only
+      once the new one is complete, or load it from a file. Both return
+      false on failure.
+    */
+    bool save( const String &path ) const;
+    bool load( const String &path );
+
+private:
+    struct OpenSubQuery
+    {
+        PiecewiseLinearCaseSplit _split;
+        unsigned _timeoutInSeconds;
+    };
+
+    unsigned long long _fingerprint;
+
+    Map<String, OpenSubQuery> _openSubQueries;
+
+    /*
+      The bound tightenings of the split of each solved subquery
+    */
+    List<List<Tightening>> _solvedRegions;
+
+    mutable std::mutex _mutex;
+};
+
+#endif // __DnCCheckpoint_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
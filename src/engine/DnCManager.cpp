@@ -14,9 +14,13 @@
  **/
 
 #include "Debug.h"
+#include "BaBSRDivider.h"
 #include "DivideStrategy.h"
 #include "DnCManager.h"
+#include "DnCChannel.h"
+#include "DnCProcessWorker.h"
 #include "DnCWorker.h"
+#include "File.h"
 #include "GetCPUData.h"
 #include "GlobalConfiguration.h"
 #include "LargestIntervalDivider.h"
@@ -24,20 +28,32 @@
 #include "MarabouError.h"
 #include "PiecewiseLinearCaseSplit.h"
 #include "QueryDivider.h"
+#include "ReluDivider.h"
+#include "SubQuerySerializer.h"
 #include "TimeUtils.h"
 #include "Vector.h"
+#include <algorithm>
 #include <atomic>
+#include <cerrno>
 #include <chrono>
 #include <cmath>
+#include <poll.h>
+#include <signal.h>
+#include <sys/wait.h>
 #include <thread>
+#include <unistd.h>
+#include <vector>
 
 void DnCManager::dncSolve( WorkerQueue *workload, std::shared_ptr<Engine> engine,
-                           std::unique_ptr<InputQuery> inputQuery,
+                           const CompiledQuery *compiledQuery,
                            std::atomic_uint &numUnsolvedSubQueries,
                            std::atomic_bool &shouldQuitSolving,
                            unsigned threadId, unsigned onlineDivides,
                            float timeoutFactor, DivideStrategy divideStrategy,
-                           bool restoreTreeStates, unsigned verbosity )
+                           bool restoreTreeStates, unsigned verbosity,
+                           SharedKnowledgeStore *sharedKnowledge,
+                           RuntimeEstimator *runtimeEstimator,
+                           DnCCheckpoint *checkpoint )
 {
     unsigned cpuId = 0;
     (void) threadId;
@@ -46,11 +62,12 @@ void DnCManager::dncSolve( WorkerQueue *workload, std::shared_ptr<Engine> engine
     getCPUId( cpuId );
     DNC_MANAGER_LOG( Stringf( "Thread #%u on CPU %u", threadId, cpuId ).ascii() );
 
-    engine->processInputQuery( *inputQuery, false );
+    engine->processCompiledQuery( *compiledQuery );
 
     DnCWorker worker( workload, engine, std::ref( numUnsolvedSubQueries ),
                       std::ref( shouldQuitSolving ), threadId, onlineDivides,
-                      timeoutFactor, divideStrategy, verbosity );
+                      timeoutFactor, divideStrategy, verbosity,
+                      sharedKnowledge, runtimeEstimator, checkpoint );
     while ( !shouldQuitSolving.load() )
     {
         worker.popOneSubQueryAndSolve( restoreTreeStates );
@@ -61,7 +78,8 @@ DnCManager::DnCManager( unsigned numWorkers, unsigned initialDivides,
                         unsigned initialTimeout, unsigned onlineDivides,
                         float timeoutFactor, DivideStrategy divideStrategy,
                         InputQuery *inputQuery, unsigned verbosity )
-    : _numWorkers( numWorkers )
+    : _compiledQuery( NULL )
+    , _numWorkers( numWorkers )
     , _initialDivides( initialDivides )
     , _initialTimeout( initialTimeout )
     , _onlineDivides( onlineDivides )
@@ -74,6 +92,9 @@ DnCManager::DnCManager( unsigned numWorkers, unsigned initialDivides,
     , _numUnsolvedSubQueries( 0 )
     , _verbosity( verbosity )
     , _constraintViolationThreshold( GlobalConfiguration::CONSTRAINT_VIOLATION_THRESHOLD )
+    , _checkpointIntervalInSeconds( 0 )
+    , _resumeFromCheckpoint( false )
+    , _useProcesses( false )
 {
 }
 
@@ -96,6 +117,12 @@ void DnCManager::freeMemoryIfNeeded()
         delete _workload;
         _workload = NULL;
     }
+
+    if ( _compiledQuery )
+    {
+        delete _compiledQuery;
+        _compiledQuery = NULL;
+    }
 }
 
 void DnCManager::solve( unsigned timeoutInSeconds, bool restoreTreeStates )
@@ -107,6 +134,9 @@ void DnCManager::solve( unsigned timeoutInSeconds, bool restoreTreeStates )
     unsigned long long timeoutInMicroSeconds = timeoutInSeconds * MICROSECONDS_IN_SECOND;
     struct timespec startTime = TimeUtils::sampleMicro();
 
+    // The progress is tied to the query as given, before preprocessing
+    DnCCheckpoint checkpoint( DnCCheckpoint::fingerprint( *_baseInputQuery ) );
+
     // Preprocess the input query and create an engine for each of the threads
     if ( !createEngines() )
     {
@@ -120,52 +150,96 @@ void DnCManager::solve( unsigned timeoutInSeconds, bool restoreTreeStates )
         quitThreads.append( _engines[i]->getQuitRequested() );
 
     // Partition the input query into initial subqueries, and place these
-    // queries in the queue
-    _workload = new WorkerQueue( 0 );
+    // queries in the queue, spread evenly over the workers' deques
+    _workload = new WorkerQueue( _numWorkers );
     if ( !_workload )
         throw MarabouError( MarabouError::ALLOCATION_FAILED, "DnCManager::workload" );
 
+    // When resuming, only the subqueries left open by the earlier run
+    // are solved
     SubQueries subQueries;
-    initialDivide( subQueries );
+    if ( !( _resumeFromCheckpoint && resumeFromCheckpoint( checkpoint, subQueries ) ) )
+    {
+        initialDivide( subQueries );
+        for ( const auto &subQuery : subQueries )
+            checkpoint.addSubQuery( *subQuery );
+    }
+    rankInitialSubQueries( subQueries );
+
+    if ( subQueries.empty() )
+    {
+        // The earlier run solved all of its subqueries
+        _exitCode = DnCManager::UNSAT;
+        return;
+    }
 
     // Create objects shared across workers
     _numUnsolvedSubQueries = subQueries.size();
     std::atomic_bool shouldQuitSolving( false );
-    WorkerQueue *workload = new WorkerQueue( 0 );
+    SharedKnowledgeStore sharedKnowledge( GlobalConfiguration::DNC_SHARED_KNOWLEDGE_MAX_ENTRIES );
+    RuntimeEstimator runtimeEstimator( GlobalConfiguration::DNC_RUNTIME_MODEL_MIN_SAMPLES );
+
+    // The subqueries are ordered from the easiest to the hardest, and
+    // each worker starts from the back of its deque, with the hardest
+    unsigned worker = 0;
     for ( auto &subQuery : subQueries )
     {
-        if ( !workload->push( subQuery ) )
-        {
-            // This should never happen
-            ASSERT( false );
-        }
+        _workload->push( subQuery, worker );
+        worker = ( worker + 1 ) % _numWorkers;
+    }
+
+    if ( _useProcesses )
+    {
+        solveInProcesses( checkpoint, startTime, timeoutInMicroSeconds );
+        saveCheckpoint( checkpoint );
+        updateDnCExitCode();
+        return;
     }
 
     // Spawn threads and start solving
     std::list<std::thread> threads;
     for ( unsigned threadId = 0; threadId < _numWorkers; ++threadId )
     {
-        // Get the processed input query from the base engine
-        auto inputQuery = std::unique_ptr<InputQuery>
-            ( new InputQuery( *( _baseEngine->getInputQuery() ) ) );
-        threads.push_back( std::thread( dncSolve, workload, _engines[ threadId ],
-                                        std::move( inputQuery ),
+        threads.push_back( std::thread( dncSolve, _workload, _engines[ threadId ],
+                                        _compiledQuery,
                                         std::ref( _numUnsolvedSubQueries ),
                                         std::ref( shouldQuitSolving ),
                                         threadId, _onlineDivides,
                                         _timeoutFactor, _divideStrategy,
-                                        restoreTreeStates, _verbosity ) );
+                                        restoreTreeStates, _verbosity,
+                                        &sharedKnowledge, &runtimeEstimator,
+                                        &checkpoint ) );
     }
 
     // Wait until either all subQueries are solved or a satisfying assignment is
-    // found by some worker
+    // found by some worker. The workers wake us up when that happens, so
+    // we only need to wake up by ourselves to check the timeout, and to
+    // save the checkpoint
+    struct timespec lastCheckpointTime = startTime;
     while ( !shouldQuitSolving.load() )
     {
         updateTimeoutReached( startTime, timeoutInMicroSeconds );
         if ( _timeoutReached )
+        {
             shouldQuitSolving = true;
+            _workload->notifyQuit();
+        }
         else
-            std::this_thread::sleep_for( std::chrono::milliseconds( 100 ) );
+        {
+            saveCheckpointIfDue( checkpoint, lastCheckpointTime );
+
+            unsigned long long waitTime = MICROSECONDS_IN_SECOND;
+            if ( timeoutInMicroSeconds > 0 )
+            {
+                unsigned long long timePassed =
+                    TimeUtils::timePassed( startTime, TimeUtils::sampleMicro() );
+                if ( timePassed >= timeoutInMicroSeconds )
+                    waitTime = 0;
+                else if ( timeoutInMicroSeconds - timePassed < waitTime )
+                    waitTime = timeoutInMicroSeconds - timePassed;
+            }
+            _workload->waitForQuit( shouldQuitSolving, waitTime );
+        }
     }
 
 
@@ -176,6 +250,17 @@ void DnCManager::solve( unsigned timeoutInSeconds, bool restoreTreeStates )
     for ( auto &thread : threads )
         thread.join();
 
+    // Subqueries that were interrupted are still open, and are solved
+    // again if the run is resumed
+    saveCheckpoint( checkpoint );
+
+    if ( _verbosity > 0 )
+        printf( "Runtime estimates: %u subqueries recorded, mean |log error| %.3f\n",
+                runtimeEstimator.getNumSamples(), runtimeEstimator.getMeanLogError() );
+
+    if ( _runtimeLogFile.length() > 0 )
+        runtimeEstimator.dumpRecords( _runtimeLogFile );
+
     updateDnCExitCode();
     return;
 }
@@ -190,12 +275,14 @@ void DnCManager::updateDnCExitCode()
     bool hasSat = false;
     bool hasError = false;
     bool hasQuitRequested = false;
-    for ( auto &engine : _engines )
+    for ( unsigned i = 0; i < _numWorkers; ++i )
     {
-        Engine::ExitCode result = engine->getExitCode();
+        IEngine::ExitCode result = _useProcesses ?
+            _processExitCodes[i] : _engines[i]->getExitCode();
         if ( result == Engine::SAT )
         {
-            _engineWithSATAssignment = engine;
+            if ( !_useProcesses )
+                _engineWithSATAssignment = _engines[i];
             hasSat = true;
             break;
         }
@@ -246,11 +333,16 @@ String DnCManager::getResultString()
 void DnCManager::getSolution( std::map<int, double> &ret,
                               InputQuery &inputQuery )
 {
-    ASSERT( _engineWithSATAssignment != nullptr );
-    TableauState tableauStateWithSolution;
-    _engineWithSATAssignment->storeTableauState( tableauStateWithSolution );
-    _baseEngine->restoreTableauState( tableauStateWithSolution );
-    _baseEngine->extractSolution( inputQuery );
+    if ( _useProcesses )
+        _baseEngine->extractSolution( inputQuery, _processSolution );
+    else
+    {
+        ASSERT( _engineWithSATAssignment != nullptr );
+        TableauState tableauStateWithSolution;
+        _engineWithSATAssignment->storeTableauState( tableauStateWithSolution );
+        _baseEngine->restoreTableauState( tableauStateWithSolution );
+        _baseEngine->extractSolution( inputQuery );
+    }
 
     for ( unsigned i = 0; i < inputQuery.getNumberOfVariables(); ++i )
         ret[i] = inputQuery.getSolutionValue( i );
@@ -267,10 +359,22 @@ void DnCManager::printResult()
     {
         std::cout << "sat\n" << std::endl;
 
-        ASSERT( _engineWithSATAssignment != nullptr );
+        // A worker process reports the assignment of the processed
+        // query, which it shares with the base engine
+        InputQuery *inputQuery = NULL;
+        if ( _useProcesses )
+        {
+            inputQuery = _baseEngine->getInputQuery();
+            for ( unsigned i = 0; i < _processSolution.size(); ++i )
+                inputQuery->setSolutionValue( i, _processSolution[i] );
+        }
+        else
+        {
+            ASSERT( _engineWithSATAssignment != nullptr );
 
-        InputQuery *inputQuery = _engineWithSATAssignment->getInputQuery();
-        _engineWithSATAssignment->extractSolution( *( inputQuery ) );
+            inputQuery = _engineWithSATAssignment->getInputQuery();
+            _engineWithSATAssignment->extractSolution( *( inputQuery ) );
+        }
 
         Vector<double> inputVector( inputQuery->getNumInputVariables() );
         Vector<double> outputVector( inputQuery->getNumOutputVariables() );
@@ -327,6 +431,13 @@ bool DnCManager::createEngines()
     if ( !_baseEngine->processInputQuery( *_baseInputQuery ) )
         // Solved by preprocessing, we are done!
         return false;
+
+    // Compile the processed query once, for all workers
+    _compiledQuery = new CompiledQuery;
+    if ( !_compiledQuery )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "DnCManager::compiledQuery" );
+    _baseEngine->storeCompiledQuery( *_compiledQuery );
+
     // Create engines for each thread
     for ( unsigned i = 0; i < _numWorkers; ++i )
     {
@@ -347,6 +458,18 @@ void DnCManager::initialDivide( SubQueries &subQueries )
         queryDivider = std::unique_ptr<QueryDivider>
             ( new LargestIntervalDivider( inputVariables ) );
     }
+    else if ( _divideStrategy == DivideStrategy::BaBSR )
+    {
+        queryDivider = std::unique_ptr<QueryDivider>
+            ( new BaBSRDivider( inputVariables, _baseEngine.get() ) );
+    }
+    else if ( _divideStrategy == DivideStrategy::Polarity ||
+              _divideStrategy == DivideStrategy::EarliestReLU ||
+              _divideStrategy == DivideStrategy::ReLUViolation )
+    {
+        queryDivider = std::unique_ptr<QueryDivider>
+            ( new ReluDivider( _baseEngine.get(), _divideStrategy ) );
+    }
     else
     {
         // Default
@@ -384,6 +507,295 @@ void DnCManager::initialDivide( SubQueries &subQueries )
                                     *split, _initialTimeout, subQueries );
 }
 
+void DnCManager::rankInitialSubQueries( SubQueries &subQueries )
+{
+    std::vector<SubQuery *> ranked;
+    for ( const auto &subQuery : subQueries )
+    {
+        _baseEngine->estimateSubQueryDifficulty( *subQuery->_split,
+                                                 subQuery->_numUnfixedConstraints,
+                                                 subQuery->_outputBoundGap );
+        ranked.push_back( subQuery );
+    }
+
+    std::stable_sort( ranked.begin(), ranked.end(), RuntimeEstimator::easierThan );
+
+    subQueries.clear();
+    for ( const auto &subQuery : ranked )
+        subQueries.append( subQuery );
+}
+
+bool DnCManager::resumeFromCheckpoint( DnCCheckpoint &checkpoint, SubQueries &subQueries )
+{
+    if ( _checkpointFile.length() == 0 || !File::exists( _checkpointFile ) )
+        return false;
+
+    if ( !checkpoint.load( _checkpointFile ) )
+    {
+        printf( "Error: the checkpoint file (%s) is corrupt, or was saved for another query!\n",
+                _checkpointFile.ascii() );
+        throw MarabouError( MarabouError::INVALID_CHECKPOINT, _checkpointFile.ascii() );
+    }
+
+    checkpoint.getOpenSubQueries( subQueries );
+
+    if ( _verbosity > 0 )
+        printf( "Resuming from %s: %u subqueries left, %u solved\n", _checkpointFile.ascii(),
+                checkpoint.getNumOpenSubQueries(), checkpoint.getNumSolvedSubQueries() );
+
+    return true;
+}
+
+void DnCManager::saveCheckpoint( const DnCCheckpoint &checkpoint )
+{
+    if ( _checkpointFile.length() == 0 )
+        return;
+
+    if ( !checkpoint.save( _checkpointFile ) )
+        printf( "Warning: failed to save the checkpoint file (%s)\n", _checkpointFile.ascii() );
+    else
+        DNC_MANAGER_LOG( Stringf( "Checkpoint saved: %u subqueries left, %u solved",
+                                  checkpoint.getNumOpenSubQueries(),
+                                  checkpoint.getNumSolvedSubQueries() ).ascii() );
+}
+
+void DnCManager::saveCheckpointIfDue( const DnCCheckpoint &checkpoint,
+                                      timespec &lastCheckpointTime )
+{
+    if ( _checkpointFile.length() == 0 || _checkpointIntervalInSeconds == 0 )
+        return;
+
+    struct timespec now = TimeUtils::sampleMicro();
+    if ( TimeUtils::timePassed( lastCheckpointTime, now ) >=
+         _checkpointIntervalInSeconds * 1000000ULL )
+    {
+        saveCheckpoint( checkpoint );
+        lastCheckpointTime = now;
+    }
+}
+
+void DnCManager::solveInProcesses( DnCCheckpoint &checkpoint, timespec startTime,
+                                   unsigned long long timeoutInMicroSeconds )
+{
+    struct WorkerProcess
+    {
+        pid_t _pid;
+        DnCChannel *_channel;
+
+        // The subquery being solved, or NULL if the worker is idle
+        SubQuery *_subQuery;
+    };
+
+    // Output buffered so far would otherwise be printed again by each
+    // of the workers
+    fflush( stdout );
+
+    // The workers are forked once the query is compiled, and share its
+    // memory with the coordinator until they write to it
+    Vector<WorkerProcess> workers;
+    for ( unsigned i = 0; i < _numWorkers; ++i )
+    {
+        int coordinatorEnd;
+        int workerEnd;
+        DnCChannel::createLocalPair( coordinatorEnd, workerEnd );
+
+        pid_t pid = fork();
+        if ( pid < 0 )
+            throw MarabouError( MarabouError::DNC_PROCESS_FAILED, "fork" );
+
+        if ( pid == 0 )
+        {
+            // The worker keeps only its own end of its own channel
+            close( coordinatorEnd );
+            for ( auto &worker : workers )
+                worker._channel->close();
+            runWorkerProcess( i, workerEnd );
+        }
+
+        close( workerEnd );
+
+        WorkerProcess worker;
+        worker._pid = pid;
+        worker._channel = new DnCChannel( coordinatorEnd );
+        if ( !worker._channel )
+            throw MarabouError( MarabouError::ALLOCATION_FAILED, "DnCManager::channel" );
+        worker._subQuery = NULL;
+        workers.append( worker );
+        _processExitCodes.append( IEngine::NOT_DONE );
+    }
+
+    struct timespec lastCheckpointTime = startTime;
+    std::string payload;
+    bool done = false;
+    while ( !done )
+    {
+        // Hand out subqueries to the idle workers, each taking those it
+        // created itself first
+        for ( unsigned i = 0; i < workers.size() && !done; ++i )
+        {
+            WorkerProcess &worker = workers[i];
+            if ( worker._subQuery || !_workload->pop( i, worker._subQuery ) )
+                continue;
+
+            payload.clear();
+            SubQueryWriter( payload ).writeSubQuery( *worker._subQuery );
+            if ( !worker._channel->send( DnCChannel::SOLVE, payload ) )
+            {
+                printf( "Worker process %u failed\n", i );
+                _processExitCodes[i] = IEngine::ERROR;
+                done = true;
+            }
+        }
+
+        // Wait for results, but wake up every second to check the
+        // timeout and to save the checkpoint
+        std::vector<struct pollfd> descriptors;
+        std::vector<unsigned> busyWorkers;
+        for ( unsigned i = 0; i < workers.size() && !done; ++i )
+        {
+            if ( !workers[i]._subQuery )
+                continue;
+
+            struct pollfd descriptor;
+            descriptor.fd = workers[i]._channel->getDescriptor();
+            descriptor.events = POLLIN;
+            descriptor.revents = 0;
+            descriptors.push_back( descriptor );
+            busyWorkers.push_back( i );
+        }
+
+        if ( !done && descriptors.empty() )
+            break;
+
+        int waitTime = 1000;
+        if ( timeoutInMicroSeconds > 0 )
+        {
+            unsigned long long timePassed =
+                TimeUtils::timePassed( startTime, TimeUtils::sampleMicro() );
+            if ( timePassed >= timeoutInMicroSeconds )
+                waitTime = 0;
+            else if ( ( timeoutInMicroSeconds - timePassed ) / 1000 < (unsigned)waitTime )
+                waitTime = ( timeoutInMicroSeconds - timePassed ) / 1000 + 1;
+        }
+
+        if ( !done && poll( descriptors.data(), descriptors.size(), waitTime ) < 0 &&
+             errno != EINTR )
+            throw MarabouError( MarabouError::DNC_PROCESS_FAILED, "poll" );
+
+        for ( unsigned j = 0; j < descriptors.size() && !done; ++j )
+        {
+            if ( descriptors[j].revents == 0 )
+                continue;
+
+            unsigned i = busyWorkers[j];
+            WorkerProcess &worker = workers[i];
+
+            // A worker that crashed closes its end of the channel
+            DnCChannel::MessageType type;
+            DnCProcessWorker::Result result;
+            if ( !worker._channel->receive( type, payload ) ||
+                 type != DnCChannel::RESULT ||
+                 !DnCProcessWorker::decodeResult( payload, result ) )
+            {
+                for ( auto &newSubQuery : result._subQueries )
+                    delete newSubQuery;
+
+                printf( "Worker process %u failed\n", i );
+                _processExitCodes[i] = IEngine::ERROR;
+                done = true;
+                break;
+            }
+
+            _processExitCodes[i] = result._exitCode;
+            if ( result._exitCode == IEngine::UNSAT )
+            {
+                checkpoint.markSolved( result._queryId );
+                _numUnsolvedSubQueries -= 1;
+                if ( _numUnsolvedSubQueries.load() == 0 )
+                    done = true;
+            }
+            else if ( result._exitCode == IEngine::TIMEOUT )
+            {
+                checkpoint.markDivided( result._queryId, result._subQueries );
+                for ( auto &newSubQuery : result._subQueries )
+                {
+                    _numUnsolvedSubQueries += 1;
+                    _workload->push( newSubQuery, i );
+                }
+                _numUnsolvedSubQueries -= 1;
+            }
+            else if ( result._exitCode == IEngine::SAT )
+            {
+                _processSolution = result._solution;
+                _numUnsolvedSubQueries -= 1;
+                done = true;
+            }
+            else
+            {
+                for ( auto &newSubQuery : result._subQueries )
+                    delete newSubQuery;
+                done = true;
+            }
+
+            if ( _verbosity > 0 )
+                printf( "Worker %u: Query %s %s, %u tasks remaining\n", i,
+                        result._queryId.ascii(),
+                        DnCWorker::exitCodeToString( result._exitCode ).ascii(),
+                        _numUnsolvedSubQueries.load() );
+
+            delete worker._subQuery;
+            worker._subQuery = NULL;
+        }
+
+        updateTimeoutReached( startTime, timeoutInMicroSeconds );
+        if ( _timeoutReached )
+            done = true;
+        else
+            saveCheckpointIfDue( checkpoint, lastCheckpointTime );
+    }
+
+    // Stop the workers. Those still solving a subquery are killed; the
+    // subquery is still open in the checkpoint
+    for ( auto &worker : workers )
+    {
+        if ( worker._subQuery )
+        {
+            kill( worker._pid, SIGKILL );
+            delete worker._subQuery;
+        }
+        else
+            worker._channel->send( DnCChannel::QUIT, "" );
+
+        delete worker._channel;
+        waitpid( worker._pid, NULL, 0 );
+    }
+}
+
+void DnCManager::runWorkerProcess( unsigned workerId, int descriptor )
+{
+    int status = 0;
+    try
+    {
+        _engines[workerId]->processCompiledQuery( *_compiledQuery );
+
+        DnCChannel channel( descriptor );
+        DnCProcessWorker worker( &channel, _engines[workerId],
+                                 _engines[workerId]->getInputQuery(),
+                                 workerId, _onlineDivides, _timeoutFactor,
+                                 _divideStrategy );
+        worker.run();
+    }
+    catch ( ... )
+    {
+        status = 1;
+    }
+
+    // Leave without running the destructors of the coordinator's
+    // objects, which this process has copies of
+    fflush( stdout );
+    _exit( status );
+}
+
 void DnCManager::updateTimeoutReached( timespec startTime, unsigned long long
                                        timeoutInMicroSeconds )
 {
@@ -399,6 +811,24 @@ void DnCManager::setConstraintViolationThreshold( unsigned threshold )
     _constraintViolationThreshold = threshold;
 }
 
+void DnCManager::setRuntimeLogFile( const String &filePath )
+{
+    _runtimeLogFile = filePath;
+}
+
+void DnCManager::setCheckpointFile( const String &filePath, unsigned intervalInSeconds,
+                                    bool resume )
+{
+    _checkpointFile = filePath;
+    _checkpointIntervalInSeconds = intervalInSeconds;
+    _resumeFromCheckpoint = resume;
+}
+
+void DnCManager::setUseProcesses( bool useProcesses )
+{
+    _useProcesses = useProcesses;
+}
+
 //
 // Local Variables:
 // compile-command: "make -C ../.. "
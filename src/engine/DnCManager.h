@@ -16,11 +16,16 @@
 #ifndef __DnCManager_h__
 #define __DnCManager_h__
 
+#include "CompiledQuery.h"
+#include "DnCCheckpoint.h"
 #include "DivideStrategy.h"
 #include "Engine.h"
 #include "InputQuery.h"
+#include "RuntimeEstimator.h"
+#include "SharedKnowledgeStore.h"
 #include "SubQuery.h"
 #include "Vector.h"
+#include "WorkerQueue.h"
 
 #include <atomic>
 
@@ -77,21 +82,60 @@ public:
 
     void setConstraintViolationThreshold( unsigned threshold );
 
+    /*
+      Write the predicted and actual times of the solved subqueries to
+      the given file once solving is done
+    */
+    void setRuntimeLogFile( const String &filePath );
+
+    /*
+      Save the remaining subqueries and the solved regions to the given
+      file every so many seconds, and once solving is done. If resume
+      is set, and the file exists, solving picks up from the saved
+      subqueries instead of dividing the input region anew.
+    */
+    void setCheckpointFile( const String &filePath, unsigned intervalInSeconds,
+                            bool resume );
+
+    /*
+      Run the workers in processes of their own, rather than in
+      threads, so that a worker that crashes does not bring down the
+      others
+    */
+    void setUseProcesses( bool useProcesses );
+
 private:
     /*
       Create and run a DnCWorker
     */
     static void dncSolve( WorkerQueue *workload, std::shared_ptr<Engine> engine,
-                          std::unique_ptr<InputQuery> inputQuery,
+                          const CompiledQuery *compiledQuery,
                           std::atomic_uint &numUnsolvedSubQueries,
                           std::atomic_bool &shouldQuitSolving,
                           unsigned threadId, unsigned onlineDivides,
                           float timeoutFactor, DivideStrategy divideStrategy,
-                          bool restoreTreeStates, unsigned verbosity );
+                          bool restoreTreeStates, unsigned verbosity,
+                          SharedKnowledgeStore *sharedKnowledge,
+                          RuntimeEstimator *runtimeEstimator,
+                          DnCCheckpoint *checkpoint );
+
+    /*
+      Hand out the subqueries in the workload to worker processes, and
+      collect their results, until the search is over
+    */
+    void solveInProcesses( DnCCheckpoint &checkpoint, timespec startTime,
+                           unsigned long long timeoutInMicroSeconds );
+
+    /*
+      The body of a worker process, which solves the subqueries sent
+      over the given socket. Does not return.
+    */
+    void runWorkerProcess( unsigned workerId, int descriptor );
 
     /*
       Create the base engine from the network and property files,
-      and if necessary, create engines for workers
+      compile the processed query, and if necessary, create engines
+      for workers
     */
     bool createEngines();
 
@@ -100,6 +144,30 @@ private:
     */
     void initialDivide( SubQueries &subQueries );
 
+    /*
+      Estimate the difficulty of the initial subqueries, and order them
+      from the easiest to the hardest
+    */
+    void rankInitialSubQueries( SubQueries &subQueries );
+
+    /*
+      Load the subqueries left by an earlier run from the checkpoint
+      file. Returns false if there is no such file.
+    */
+    bool resumeFromCheckpoint( DnCCheckpoint &checkpoint, SubQueries &subQueries );
+
+    /*
+      Save the checkpoint to the checkpoint file, if there is one
+    */
+    void saveCheckpoint( const DnCCheckpoint &checkpoint );
+
+    /*
+      Save the checkpoint if the checkpoint interval has passed since
+      the last time
+    */
+    void saveCheckpointIfDue( const DnCCheckpoint &checkpoint,
+                              timespec &lastCheckpointTime );
+
     /*
       Read the exitCode of the engine of each thread, and update the manager's
       exitCode.
@@ -117,6 +185,13 @@ private:
     */
     std::shared_ptr<Engine> _baseEngine;
 
+    /*
+      The query as processed by the base engine, from which the
+      workers' engines are initialized. It is shared by all of them,
+      and must outlive them.
+    */
+    CompiledQuery *_compiledQuery;
+
     /*
       The engines that are run in different threads
     */
@@ -198,6 +273,29 @@ private:
     */
     unsigned _constraintViolationThreshold;
 
+    /*
+      The file to which the predicted and actual subquery times are
+      written, or empty
+    */
+    String _runtimeLogFile;
+
+    /*
+      The file to which the progress is saved, or empty; the time
+      between saves; and whether to resume from it
+    */
+    String _checkpointFile;
+    unsigned _checkpointIntervalInSeconds;
+    bool _resumeFromCheckpoint;
+
+    /*
+      Whether the workers run in processes of their own; the last
+      result reported by each worker process; and the satisfying
+      assignment of the input query, if one was found by a worker
+      process
+    */
+    bool _useProcesses;
+    Vector<IEngine::ExitCode> _processExitCodes;
+    Vector<double> _processSolution;
 };
 
 #endif // __DnCManager_h__
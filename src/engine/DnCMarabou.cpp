@@ -112,9 +112,21 @@ void DnCMarabou::run()
     _dncManager = std::unique_ptr<DnCManager>
       ( new DnCManager( numWorkers, initialDivides, initialTimeout,
                         onlineDivides, timeoutFactor,
-                        DivideStrategy::LargestInterval, &_inputQuery,
+                        Options::get()->getDivideStrategy(), &_inputQuery,
                         verbosity ) );
     _dncManager->setConstraintViolationThreshold( splitThreshold );
+    _dncManager->setRuntimeLogFile( Options::get()->getString( Options::RUNTIME_LOG_FILE ) );
+
+    String checkpointFilePath = Options::get()->getString( Options::CHECKPOINT_FILE );
+    bool resume = Options::get()->getBool( Options::RESUME );
+    if ( resume && checkpointFilePath.length() == 0 )
+        printf( "Warning: --resume has no effect without --checkpoint-file\n\n" );
+
+    int checkpointInterval = Options::get()->getInt( Options::CHECKPOINT_INTERVAL );
+    if ( checkpointInterval < 0 )
+        checkpointInterval = 0;
+    _dncManager->setCheckpointFile( checkpointFilePath, checkpointInterval, resume );
+    _dncManager->setUseProcesses( Options::get()->getBool( Options::DNC_PROCESSES ) );
 
     struct timespec start = TimeUtils::sampleMicro();
 
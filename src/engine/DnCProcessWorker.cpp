@@ -0,0 +1,158 @@
+/*********************                                                        */
+/*! \file DnCProcessWorker.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#include "DnCProcessWorker.h"
+#include "DnCWorker.h"
+#include "GlobalConfiguration.h"
+#include "RuntimeEstimator.h"
+#include "SharedKnowledgeStore.h"
+#include "SubQuerySerializer.h"
+#include "WorkerQueue.h"
+
+#include <atomic>
+#include <vector>
+
+DnCProcessWorker::DnCProcessWorker( DnCChannel *channel, std::shared_ptr<IEngine> engine,
+                                    InputQuery *inputQuery, unsigned workerId,
+                                    unsigned onlineDivides, float timeoutFactor,
+                                    DivideStrategy divideStrategy )
+    : _channel( channel )
+    , _engine( engine )
+    , _inputQuery( inputQuery )
+    , _workerId( workerId )
+    , _onlineDivides( onlineDivides )
+    , _timeoutFactor( timeoutFactor )
+    , _divideStrategy( divideStrategy )
+{
+}
+
+void DnCProcessWorker::run()
+{
+    // The DnCWorker takes its subqueries from a queue of its own, to
+    // which it also pushes the subqueries it creates
+    WorkerQueue workload( 1 );
+    std::atomic_uint numUnsolvedSubQueries( 0 );
+    std::atomic_bool shouldQuitSolving( false );
+    SharedKnowledgeStore sharedKnowledge( GlobalConfiguration::DNC_SHARED_KNOWLEDGE_MAX_ENTRIES );
+    RuntimeEstimator runtimeEstimator( GlobalConfiguration::DNC_RUNTIME_MODEL_MIN_SAMPLES );
+
+    // Progress is reported by the coordinator
+    DnCWorker worker( &workload, _engine, numUnsolvedSubQueries, shouldQuitSolving,
+                      _workerId, _onlineDivides, _timeoutFactor, _divideStrategy, 0,
+                      &sharedKnowledge, &runtimeEstimator );
+
+    DnCChannel::MessageType type;
+    std::string payload;
+    while ( _channel->receive( type, payload ) && type == DnCChannel::SOLVE )
+    {
+        SubQuery *subQuery = NULL;
+        SubQueryReader reader( payload );
+        if ( !reader.readSubQuery( subQuery ) )
+            return;
+
+        Result result;
+        result._queryId = subQuery->_queryId;
+
+        numUnsolvedSubQueries = 1;
+        shouldQuitSolving = false;
+        workload.push( subQuery, 0 );
+        result._exitCode = worker.popOneSubQueryAndSolve();
+
+        if ( result._exitCode == IEngine::TIMEOUT )
+        {
+            // The new subqueries were pushed from the easiest to the
+            // hardest, and are popped in reverse
+            std::vector<SubQuery *> newSubQueries;
+            SubQuery *newSubQuery = NULL;
+            while ( workload.pop( 0, newSubQuery ) )
+                newSubQueries.push_back( newSubQuery );
+
+            for ( auto it = newSubQueries.rbegin(); it != newSubQueries.rend(); ++it )
+                result._subQueries.append( *it );
+        }
+        else if ( result._exitCode == IEngine::SAT )
+        {
+            _engine->extractSolution( *_inputQuery );
+            for ( unsigned i = 0; i < _inputQuery->getNumberOfVariables(); ++i )
+                result._solution.append( _inputQuery->getSolutionValue( i ) );
+        }
+
+        encodeResult( result, payload );
+        for ( auto &newSubQuery : result._subQueries )
+            delete newSubQuery;
+
+        if ( !_channel->send( DnCChannel::RESULT, payload ) )
+            return;
+    }
+}
+
+void DnCProcessWorker::encodeResult( const Result &result, std::string &payload )
+{
+    payload.clear();
+    SubQueryWriter writer( payload );
+    writer.writeString( result._queryId );
+    writer.write<unsigned>( result._exitCode );
+
+    writer.write<unsigned>( result._subQueries.size() );
+    for ( const auto &subQuery : result._subQueries )
+        writer.writeSubQuery( *subQuery );
+
+    writer.write<unsigned>( result._solution.size() );
+    for ( unsigned i = 0; i < result._solution.size(); ++i )
+        writer.write<double>( result._solution[i] );
+}
+
+bool DnCProcessWorker::decodeResult( const std::string &payload, Result &result )
+{
+    SubQueryReader reader( payload );
+    unsigned exitCode;
+    unsigned numSubQueries;
+    if ( !reader.readString( result._queryId ) || !reader.read( exitCode ) ||
+         ( exitCode > IEngine::QUIT_REQUESTED && exitCode != IEngine::NOT_DONE ) ||
+         !reader.read( numSubQueries ) )
+        return false;
+
+    result._exitCode = (IEngine::ExitCode)exitCode;
+
+    for ( unsigned i = 0; i < numSubQueries; ++i )
+    {
+        SubQuery *subQuery = NULL;
+        if ( !reader.readSubQuery( subQuery ) )
+            return false;
+        result._subQueries.append( subQuery );
+    }
+
+    unsigned numValues;
+    if ( !reader.read( numValues ) )
+        return false;
+
+    for ( unsigned i = 0; i < numValues; ++i )
+    {
+        double value;
+        if ( !reader.read( value ) )
+            return false;
+        result._solution.append( value );
+    }
+
+    return reader.done();
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
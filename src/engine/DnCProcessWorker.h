@@ -0,0 +1,105 @@
+/*********************                                                        */
+/*! \file DnCProcessWorker.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#ifndef __DnCProcessWorker_h__
+#define __DnCProcessWorker_h__
+
+#include "DivideStrategy.h"
+#include "DnCChannel.h"
+#include "IEngine.h"
+#include "InputQuery.h"
+#include "SubQuery.h"
+#include "Vector.h"
+
+#include <memory>
+
+/*
+  The DnC worker of a worker process. It receives subqueries from the
+  coordinator over a channel, solves each with a DnCWorker of its own,
+  and sends back the result: for a subquery that timed out, the
+  subqueries it was divided into, and for a satisfiable one, the
+  satisfying assignment of the engine's processed query.
+
+  Bounds, clauses and runtime samples are shared only among the
+  subqueries solved by the same process.
+*/
+class DnCProcessWorker
+{
+public:
+    struct Result
+    {
+        Result()
+            : _exitCode( IEngine::NOT_DONE )
+        {
+        }
+
+        String _queryId;
+        IEngine::ExitCode _exitCode;
+
+        /*
+          The new subqueries, if the subquery timed out, owned by
+          whoever decoded the result
+        */
+        SubQueries _subQueries;
+
+        /*
+          The value of each variable of the processed query, if the
+          subquery is satisfiable
+        */
+        Vector<double> _solution;
+    };
+
+    DnCProcessWorker( DnCChannel *channel, std::shared_ptr<IEngine> engine,
+                      InputQuery *inputQuery, unsigned workerId,
+                      unsigned onlineDivides, float timeoutFactor,
+                      DivideStrategy divideStrategy );
+
+    /*
+      Solve subqueries until told to quit, or until the channel is
+      closed
+    */
+    void run();
+
+    /*
+      Convert a result to and from the payload of a RESULT message
+    */
+    static void encodeResult( const Result &result, std::string &payload );
+    static bool decodeResult( const std::string &payload, Result &result );
+
+private:
+    DnCChannel *_channel;
+    std::shared_ptr<IEngine> _engine;
+
+    /*
+      The engine's processed query, into which its solution is
+      extracted
+    */
+    InputQuery *_inputQuery;
+
+    unsigned _workerId;
+    unsigned _onlineDivides;
+    float _timeoutFactor;
+    DivideStrategy _divideStrategy;
+};
+
+#endif // __DnCProcessWorker_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
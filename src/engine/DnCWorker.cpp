@@ -14,27 +14,34 @@
  **/
 
 #include "Debug.h"
+#include "BaBSRDivider.h"
 #include "DivideStrategy.h"
 #include "DnCWorker.h"
 #include "IEngine.h"
 #include "EngineState.h"
+#include "FloatUtils.h"
+#include "GlobalConfiguration.h"
 #include "LargestIntervalDivider.h"
 #include "MarabouError.h"
 #include "MStringf.h"
 #include "PiecewiseLinearCaseSplit.h"
+#include "ReluDivider.h"
 #include "SubQuery.h"
+#include "TimeUtils.h"
 
+#include <algorithm>
 #include <atomic>
-#include <chrono>
 #include <cmath>
-#include <thread>
+#include <vector>
 
 DnCWorker::DnCWorker( WorkerQueue *workload, std::shared_ptr<IEngine> engine,
                       std::atomic_uint &numUnsolvedSubQueries,
                       std::atomic_bool &shouldQuitSolving,
                       unsigned threadId, unsigned onlineDivides,
                       float timeoutFactor, DivideStrategy divideStrategy,
-                      unsigned verbosity )
+                      unsigned verbosity, SharedKnowledgeStore *sharedKnowledge,
+                      RuntimeEstimator *runtimeEstimator,
+                      DnCCheckpoint *checkpoint )
     : _workload( workload )
     , _engine( engine )
     , _numUnsolvedSubQueries( &numUnsolvedSubQueries )
@@ -43,6 +50,9 @@ DnCWorker::DnCWorker( WorkerQueue *workload, std::shared_ptr<IEngine> engine,
     , _onlineDivides( onlineDivides )
     , _timeoutFactor( timeoutFactor )
     , _verbosity( verbosity )
+    , _sharedKnowledge( sharedKnowledge )
+    , _runtimeEstimator( runtimeEstimator )
+    , _checkpoint( checkpoint )
 {
     setQueryDivider( divideStrategy );
 
@@ -53,23 +63,34 @@ DnCWorker::DnCWorker( WorkerQueue *workload, std::shared_ptr<IEngine> engine,
 
 void DnCWorker::setQueryDivider( DivideStrategy divideStrategy )
 {
-    // For now, there is only one strategy
-    ASSERT( divideStrategy == DivideStrategy::LargestInterval );
-    if ( divideStrategy == DivideStrategy::LargestInterval )
+    const List<unsigned> &inputVariables = _engine->getInputVariables();
+    if ( divideStrategy == DivideStrategy::BaBSR )
     {
-        const List<unsigned> &inputVariables = _engine->getInputVariables();
+        _queryDivider = std::unique_ptr<BaBSRDivider>
+            ( new BaBSRDivider( inputVariables, _engine.get() ) );
+    }
+    else if ( divideStrategy == DivideStrategy::Polarity ||
+              divideStrategy == DivideStrategy::EarliestReLU ||
+              divideStrategy == DivideStrategy::ReLUViolation )
+    {
+        _queryDivider = std::unique_ptr<ReluDivider>
+            ( new ReluDivider( _engine.get(), divideStrategy ) );
+    }
+    else
+    {
+        ASSERT( divideStrategy == DivideStrategy::LargestInterval );
         _queryDivider = std::unique_ptr<LargestIntervalDivider>
             ( new LargestIntervalDivider( inputVariables ) );
     }
 }
 
-void DnCWorker::popOneSubQueryAndSolve( bool restoreTreeStates )
+IEngine::ExitCode DnCWorker::popOneSubQueryAndSolve( bool restoreTreeStates )
 {
     SubQuery *subQuery = NULL;
-    // Boost queue stores the next element into the passed-in pointer
-    // and returns true if the pop is successful (aka, the queue is not empty
-    // in most cases)
-    if ( _workload->pop( subQuery ) )
+    // Take a subquery from this worker's deque, or steal one from
+    // another worker. If there is none, the worker is parked until one
+    // is pushed or the search is over
+    if ( _workload->waitAndPop( _threadId, subQuery, *_shouldQuitSolving ) )
     {
         String queryId = subQuery->_queryId;
         auto split = std::move( subQuery->_split );
@@ -79,7 +100,7 @@ void DnCWorker::popOneSubQueryAndSolve( bool restoreTreeStates )
         unsigned timeoutInSeconds = subQuery->_timeoutInSeconds;
 
         // Reset the engine state
-        _engine->restoreState( *_initialState );
+        _engine->restoreState( *_initialState, true );
         _engine->reset();
 
         // TODO: each worker is going to keep a map from *CaseSplit to an
@@ -89,14 +110,47 @@ void DnCWorker::popOneSubQueryAndSolve( bool restoreTreeStates )
         // Apply the split and solve
         _engine->applySplit( *split );
 
+        // Start from the bounds and clauses learned, by any worker, for
+        // the earlier boxes that contain this one
+        if ( _sharedKnowledge )
+        {
+            List<Tightening> sharedBounds;
+            List<Vector<unsigned>> sharedClauses;
+            if ( _sharedKnowledge->import( *split, sharedBounds, sharedClauses ) )
+            {
+                PiecewiseLinearCaseSplit sharedSplit;
+                for ( const auto &bound : sharedBounds )
+                    sharedSplit.storeBoundTightening( bound );
+                _engine->applySplit( sharedSplit );
+                _engine->addLearnedClauses( sharedClauses );
+            }
+        }
+
+        // A subquery predicted to take much longer than its budget is
+        // divided right away, rather than solved until it times out
+        bool divideUnsolved = !restoreTreeStates && shouldDivideUnsolved( *subQuery );
+
         bool fullSolveNeeded = true; // denotes whether we need to solve the subquery
         if ( restoreTreeStates && smtState )
             fullSolveNeeded = _engine->restoreSmtState( *smtState );
         IEngine::ExitCode result = IEngine::NOT_DONE;
-        if ( fullSolveNeeded )
+        double timeInSeconds = 0;
+        if ( divideUnsolved )
+        {
+            result = IEngine::TIMEOUT;
+        }
+        else if ( fullSolveNeeded )
         {
+            struct timespec start = TimeUtils::sampleMicro();
             _engine->solve( timeoutInSeconds );
             result = _engine->getExitCode();
+            struct timespec end = TimeUtils::sampleMicro();
+            timeInSeconds = TimeUtils::timePassed( start, end ) / 1000000.0;
+
+            if ( _runtimeEstimator &&
+                 ( result == IEngine::UNSAT || result == IEngine::TIMEOUT ) )
+                _runtimeEstimator->record( *subQuery, timeInSeconds,
+                                           result == IEngine::TIMEOUT );
         }
         else
         {
@@ -110,9 +164,14 @@ void DnCWorker::popOneSubQueryAndSolve( bool restoreTreeStates )
         if ( result == IEngine::UNSAT )
         {
             // If UNSAT, continue to solve
+            if ( _checkpoint )
+                _checkpoint->markSolved( queryId );
             *_numUnsolvedSubQueries -= 1;
             if ( _numUnsolvedSubQueries->load() == 0 )
+            {
                 *_shouldQuitSolving = true;
+                _workload->notifyQuit();
+            }
             delete subQuery;
         }
         else if ( result == IEngine::TIMEOUT )
@@ -121,6 +180,11 @@ void DnCWorker::popOneSubQueryAndSolve( bool restoreTreeStates )
             // new subQueries to the current queue
             SubQueries subQueries;
 
+            // The bounds and clauses learned for this box also hold for
+            // its sub-boxes
+            if ( _sharedKnowledge && !divideUnsolved )
+                publishKnowledge( *split );
+
             unsigned numNewSubQueries = pow( 2, _onlineDivides );
             std::vector<std::unique_ptr<SmtState>> newSmtStates;
             if ( restoreTreeStates )
@@ -134,9 +198,23 @@ void DnCWorker::popOneSubQueryAndSolve( bool restoreTreeStates )
                 }
             }
 
+            // Divide from the state in which the subquery was started,
+            // rather than from wherever the search stopped
+            _engine->restoreState( *_initialState, true );
+            // A subquery divided without being solved passes its budget
+            // on unchanged
+            unsigned newTimeoutInSeconds = divideUnsolved ? timeoutInSeconds :
+                (unsigned)timeoutInSeconds * _timeoutFactor;
             _queryDivider->createSubQueries( numNewSubQueries, queryId, *split,
-                                             (unsigned)timeoutInSeconds *
-                                             _timeoutFactor, subQueries );
+                                             newTimeoutInSeconds, subQueries );
+
+            for ( auto &newSubQuery : subQueries )
+                newSubQuery->_fromEagerSplit = divideUnsolved;
+            rankSubQueries( subQueries, divideUnsolved ?
+                            subQuery->_parentTimeInSeconds : timeInSeconds );
+
+            if ( _checkpoint )
+                _checkpoint->markDivided( queryId, subQueries );
 
             unsigned i = 0;
             for ( auto &newSubQuery : subQueries )
@@ -147,12 +225,10 @@ void DnCWorker::popOneSubQueryAndSolve( bool restoreTreeStates )
                     newSubQuery->_smtState = std::move( newSmtStates[i++] );
                 }
 
-                if ( !_workload->push( std::move( newSubQuery ) ) )
-                {
-                    throw MarabouError( MarabouError::UNSUCCESSFUL_QUEUE_PUSH );
-                }
-
+                // Count the new subquery before it can be taken and
+                // solved by another worker
                 *_numUnsolvedSubQueries += 1;
+                _workload->push( newSubQuery, _threadId );
             }
             *_numUnsolvedSubQueries -= 1;
             delete subQuery;
@@ -170,6 +246,7 @@ void DnCWorker::popOneSubQueryAndSolve( bool restoreTreeStates )
             // TIMEOUT. This way, the DnCManager will kill all the DnCWorkers.
 
             *_shouldQuitSolving = true;
+            _workload->notifyQuit();
             if ( result == IEngine::SAT )
             {
                 // case SAT
@@ -190,12 +267,81 @@ void DnCWorker::popOneSubQueryAndSolve( bool restoreTreeStates )
                 delete subQuery;
             }
         }
+
+        return result;
     }
-    else
+
+    return IEngine::NOT_DONE;
+}
+
+void DnCWorker::publishKnowledge( const PiecewiseLinearCaseSplit &split )
+{
+    List<Tightening> rootBounds;
+    _engine->getRootBounds( rootBounds );
+
+    // Long clauses rarely prune anything, and are not worth the memory
+    List<Vector<unsigned>> learnedClauses;
+    _engine->getLearnedClauses( learnedClauses );
+    List<Vector<unsigned>> clauses;
+    for ( const auto &clause : learnedClauses )
+    {
+        if ( clause.size() <= GlobalConfiguration::DNC_SHARED_CLAUSE_MAX_LENGTH )
+            clauses.append( clause );
+    }
+
+    _sharedKnowledge->publish( split, rootBounds, clauses );
+}
+
+void DnCWorker::rankSubQueries( SubQueries &subQueries, double parentTimeInSeconds )
+{
+    if ( !_runtimeEstimator )
+        return;
+
+    std::vector<SubQuery *> ranked;
+    for ( const auto &subQuery : subQueries )
     {
-        // If the queue is empty but the pop fails, wait and retry
-        std::this_thread::sleep_for( std::chrono::milliseconds( 100 ) );
+        subQuery->_parentTimeInSeconds = parentTimeInSeconds;
+        if ( _engine->estimateSubQueryDifficulty( *subQuery->_split,
+                                                  subQuery->_numUnfixedConstraints,
+                                                  subQuery->_outputBoundGap ) )
+            subQuery->_predictedTimeInSeconds = _runtimeEstimator->predict( *subQuery );
+        else
+            // Bound propagation alone shows the subquery to be infeasible
+            subQuery->_predictedTimeInSeconds = 0;
+
+        // Subqueries predicted to be hard get a larger budget, up to a
+        // limit, so that they are less likely to time out and have
+        // their work thrown away
+        unsigned timeout = subQuery->_timeoutInSeconds;
+        if ( timeout > 0 && subQuery->_predictedTimeInSeconds > timeout )
+        {
+            double scaled = FloatUtils::min( subQuery->_predictedTimeInSeconds,
+                                             timeout * GlobalConfiguration::DNC_MAX_BUDGET_SCALE );
+            subQuery->_timeoutInSeconds = (unsigned)std::ceil( scaled );
+        }
+
+        ranked.push_back( subQuery );
     }
+
+    // The worker pops its subqueries from the back, so that it goes on
+    // with the hardest, while other workers steal from the front
+    std::stable_sort( ranked.begin(), ranked.end(), RuntimeEstimator::easierThan );
+
+    subQueries.clear();
+    for ( const auto &subQuery : ranked )
+        subQueries.append( subQuery );
+}
+
+bool DnCWorker::shouldDivideUnsolved( const SubQuery &subQuery ) const
+{
+    // Dividing without solving is done at most once in a row, so that
+    // a poor prediction cannot keep dividing a subquery
+    if ( !_runtimeEstimator || subQuery._fromEagerSplit ||
+         subQuery._timeoutInSeconds == 0 || subQuery._predictedTimeInSeconds < 0 )
+        return false;
+
+    return subQuery._predictedTimeInSeconds >
+        subQuery._timeoutInSeconds * GlobalConfiguration::DNC_EAGER_SPLIT_RATIO;
 }
 
 void DnCWorker::printProgress( String queryId, IEngine::ExitCode result ) const
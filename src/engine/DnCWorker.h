@@ -17,9 +17,13 @@
 #define __DnCWorker_h__
 
 #include "DivideStrategy.h"
+#include "DnCCheckpoint.h"
 #include "Engine.h"
 #include "PiecewiseLinearCaseSplit.h"
 #include "QueryDivider.h"
+#include "RuntimeEstimator.h"
+#include "SharedKnowledgeStore.h"
+#include "WorkerQueue.h"
 
 #include <atomic>
 
@@ -30,13 +34,21 @@ public:
                std::atomic_uint &numUnsolvedSubqueries,
                std::atomic_bool &shouldQuitSolving, unsigned threadId,
                unsigned onlineDivides, float timeoutFactor,
-               DivideStrategy divideStrategy, unsigned verbosity );
+               DivideStrategy divideStrategy, unsigned verbosity,
+               SharedKnowledgeStore *sharedKnowledge = NULL,
+               RuntimeEstimator *runtimeEstimator = NULL,
+               DnCCheckpoint *checkpoint = NULL );
 
     /*
-      Pop one subQuery, solve it and handle the result
-      Return true if the DnCWorker should continue running
+      Pop one subQuery, solve it and handle the result. Returns the
+      result, or NOT_DONE if no subquery was popped.
     */
-    void popOneSubQueryAndSolve( bool restoreTreeStates = false );
+    IEngine::ExitCode popOneSubQueryAndSolve( bool restoreTreeStates = false );
+
+    /*
+      Convert the exitCode to string
+    */
+    static String exitCodeToString( IEngine::ExitCode result );
 
 private:
     /*
@@ -45,9 +57,23 @@ private:
     void setQueryDivider( DivideStrategy divideStrategy );
 
     /*
-      Convert the exitCode to string
+      Publish the bounds and clauses learned while solving the subquery
+      given by the split, which timed out
     */
-    static String exitCodeToString( IEngine::ExitCode result );
+    void publishKnowledge( const PiecewiseLinearCaseSplit &split );
+
+    /*
+      Estimate the difficulty of newly created subqueries, set their
+      time budgets accordingly, and order them from the easiest to the
+      hardest
+    */
+    void rankSubQueries( SubQueries &subQueries, double parentTimeInSeconds );
+
+    /*
+      Whether a subquery is predicted to take so much longer than its
+      time budget that it should be divided before being solved
+    */
+    bool shouldDivideUnsolved( const SubQuery &subQuery ) const;
 
     /*
       Print the current progress
@@ -81,6 +107,24 @@ private:
     unsigned _onlineDivides;
     float _timeoutFactor;
     unsigned _verbosity;
+
+    /*
+      Bounds and clauses learned for the boxes of earlier subqueries
+      (shared across threads), or NULL if not in use
+    */
+    SharedKnowledgeStore *_sharedKnowledge;
+
+    /*
+      The model of subquery solving times (shared across threads), or
+      NULL if not in use
+    */
+    RuntimeEstimator *_runtimeEstimator;
+
+    /*
+      The record of open and solved subqueries (shared across threads),
+      or NULL if not in use
+    */
+    DnCCheckpoint *_checkpoint;
 };
 
 #endif // __DnCWorker_h__
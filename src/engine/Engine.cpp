@@ -15,9 +15,12 @@
  **/
 
 #include "AutoConstraintMatrixAnalyzer.h"
+#include "CompiledQuery.h"
 #include "Debug.h"
 #include "Engine.h"
 #include "EngineState.h"
+#include "FloatUtils.h"
+#include "GradientFalsifier.h"
 #include "InfeasibleQueryException.h"
 #include "InputQuery.h"
 #include "MStringf.h"
@@ -26,6 +29,8 @@
 #include "Options.h"
 #include "PiecewiseLinearConstraint.h"
 #include "Preprocessor.h"
+#include "ReluConstraint.h"
+#include "ReluLayerConstraint.h"
 #include "TableauRow.h"
 #include "TimeUtils.h"
 
@@ -47,12 +52,14 @@ Engine::Engine( unsigned verbosity )
     , _verbosity( verbosity )
     , _lastNumVisitedStates( 0 )
     , _lastIterationWithProgress( 0 )
+    , _splittingStrategy( Options::get()->getSplittingStrategy() )
 {
     _smtCore.setStatistics( &_statistics );
     _tableau->setStatistics( &_statistics );
     _rowBoundTightener->setStatistics( &_statistics );
     _constraintBoundTightener->setStatistics( &_statistics );
     _preprocessor.setStatistics( &_statistics );
+    _conflictAnalyzer.setSmtCore( &_smtCore );
 
     _activeEntryStrategy = _projectedSteepestEdgeRule;
     _activeEntryStrategy->setStatistics( &_statistics );
@@ -67,6 +74,10 @@ Engine::~Engine()
         delete[] _work;
         _work = NULL;
     }
+
+    for ( const auto &layer : _reluLayerConstraints )
+        delete layer;
+    _reluLayerConstraints.clear();
 }
 
 void Engine::setVerbosity( unsigned verbosity )
@@ -95,6 +106,17 @@ bool Engine::solve( unsigned timeoutInSeconds )
     updateDirections();
     storeInitialEngineState();
 
+    if ( falsifyWithGradients() )
+    {
+        if ( _verbosity > 0 )
+        {
+            printf( "\nEngine::solve: sat assignment found by the falsifier\n" );
+            _statistics.print();
+        }
+        _exitCode = Engine::SAT;
+        return true;
+    }
+
     mainLoopStatistics();
     if ( _verbosity > 0 )
     {
@@ -192,15 +214,28 @@ bool Engine::solve( unsigned timeoutInSeconds )
             {
                 do
                 {
+                    propagateLearnedClauses();
                     performSymbolicBoundTightening();
                 }
                 while ( applyAllValidConstraintCaseSplits() );
                 splitJustPerformed = false;
+
+                if ( _smtCore.getStackDepth() == 0 )
+                    storeRootBounds();
             }
 
             // Perform any SmtCore-initiated case splits
             if ( _smtCore.needToSplit() )
             {
+                _tableau->notifyPendingVariableValues();
+                if ( _splittingStrategy == DivideStrategy::StrongBranching &&
+                     !performLookahead() )
+                {
+                    // A valid split was found instead
+                    splitJustPerformed = true;
+                    continue;
+                }
+
                 _smtCore.performSplit();
                 splitJustPerformed = true;
                 continue;
@@ -209,6 +244,7 @@ bool Engine::solve( unsigned timeoutInSeconds )
             if ( !_tableau->allBoundsValid() )
             {
                 // Some variable bounds are invalid, so the query is unsat
+                _conflictAnalyzer.analyzeInvalidBounds( *_tableau );
                 throw InfeasibleQueryException();
             }
 
@@ -291,8 +327,9 @@ bool Engine::solve( unsigned timeoutInSeconds )
         catch ( const InfeasibleQueryException & )
         {
             // The current query is unsat, and we need to pop.
-            // If we're at level 0, the whole query is unsat.
-            if ( !_smtCore.popSplit() )
+            // If we're at level 0, or the conflict does not depend
+            // on any split, the whole query is unsat.
+            if ( !_smtCore.backjump( _conflictAnalyzer.extractConflictLevel() ) )
             {
                 if ( _verbosity > 0 )
                 {
@@ -499,6 +536,7 @@ void Engine::performSimplexStep()
             // Cost function is fresh --- failure is real.
             struct timespec end = TimeUtils::sampleMicro();
             _statistics.addTimeSimplexSteps( TimeUtils::timePassed( start, end ) );
+            _conflictAnalyzer.analyzeSimplexFailure( *_tableau, *_costFunctionManager );
             throw InfeasibleQueryException();
         }
     }
@@ -1028,19 +1066,39 @@ void Engine::initializeTableau( const double *constraintMatrix, const List<unsig
     _rowBoundTightener->setDimensions();
     _constraintBoundTightener->setDimensions();
 
+    if ( GlobalConfiguration::USE_CONFLICT_DRIVEN_CLAUSE_LEARNING )
+        _conflictAnalyzer.registerWithTableau( _tableau );
+
     // Register the constraint bound tightener to all the PL constraints
     for ( auto &plConstraint : _preprocessedQuery.getPiecewiseLinearConstraints() )
         plConstraint->registerConstraintBoundTightener( _constraintBoundTightener );
 
     _plConstraints = _preprocessedQuery.getPiecewiseLinearConstraints();
+    if ( GlobalConfiguration::USE_RELU_LAYER_CONSTRAINTS )
+        initializeReluLayerConstraints();
+
     for ( const auto &constraint : _plConstraints )
     {
         constraint->registerAsWatcher( _tableau );
         constraint->setStatistics( &_statistics );
+        constraint->registerConstraintStateTrail( &_constraintStateTrail );
+    }
+
+    for ( const auto &layer : _reluLayerConstraints )
+    {
+        layer->registerAsWatcher( _tableau );
+        layer->registerConstraintBoundTightener( _constraintBoundTightener );
+        layer->setStatistics( &_statistics );
+        layer->registerConstraintStateTrail( &_constraintStateTrail );
     }
 
     _tableau->initializeTableau( initialBasis );
 
+    // From here on, the watchers are informed of new values only when
+    // the engine needs them
+    if ( GlobalConfiguration::DEFER_VARIABLE_VALUE_NOTIFICATIONS )
+        _tableau->setDeferValueNotifications( true );
+
     _costFunctionManager->initialize();
     _tableau->registerCostFunctionManager( _costFunctionManager );
     _activeEntryStrategy->initialize( _tableau );
@@ -1048,12 +1106,75 @@ void Engine::initializeTableau( const double *constraintMatrix, const List<unsig
     _statistics.setNumPlConstraints( _plConstraints.size() );
 }
 
+void Engine::initializeReluLayerConstraints()
+{
+    // The layers are taken from the network level reasoner
+    if ( !_networkLevelReasoner )
+        return;
+
+    Map<unsigned, ReluConstraint *> fToRelu;
+    for ( const auto &constraint : _plConstraints )
+    {
+        if ( constraint->getType() == RELU )
+        {
+            ReluConstraint *relu = (ReluConstraint *)constraint;
+            fToRelu[relu->getF()] = relu;
+        }
+    }
+
+    for ( unsigned i = 0; i < _networkLevelReasoner->getNumberOfLayers(); ++i )
+    {
+        const NLR::Layer *layer = _networkLevelReasoner->getLayer( i );
+        if ( layer->getLayerType() != NLR::Layer::RELU )
+            continue;
+
+        // ReLUs that share a variable are left to watch for themselves
+        List<ReluConstraint *> relus;
+        Set<unsigned> variables;
+        for ( unsigned neuron = 0; neuron < layer->getSize(); ++neuron )
+        {
+            if ( !layer->neuronHasVariable( neuron ) )
+                continue;
+
+            unsigned f = layer->neuronToVariable( neuron );
+            if ( !fToRelu.exists( f ) )
+                continue;
+
+            ReluConstraint *relu = fToRelu[f];
+            bool shared = false;
+            for ( const auto &variable : relu->getParticipatingVariables() )
+                if ( variables.exists( variable ) )
+                    shared = true;
+
+            if ( shared )
+                continue;
+
+            for ( const auto &variable : relu->getParticipatingVariables() )
+                variables.insert( variable );
+            relus.append( relu );
+        }
+
+        if ( relus.size() > 1 )
+            _reluLayerConstraints.append( new ReluLayerConstraint( relus ) );
+    }
+}
+
+void Engine::processPendingReluLayerNotifications()
+{
+    for ( const auto &layer : _reluLayerConstraints )
+        layer->processPendingNotifications();
+}
+
 void Engine::initializeNetworkLevelReasoning()
 {
     _networkLevelReasoner = _preprocessedQuery.getNetworkLevelReasoner();
 
     if ( _networkLevelReasoner )
+    {
         _networkLevelReasoner->setTableau( _tableau );
+        _networkLevelReasoner->useSinglePrecisionSymbolicBounds
+            ( Options::get()->getBool( Options::SBT_SINGLE_PRECISION ) );
+    }
 }
 
 bool Engine::processInputQuery( InputQuery &inputQuery, bool preprocess )
@@ -1090,6 +1211,7 @@ bool Engine::processInputQuery( InputQuery &inputQuery, bool preprocess )
 
         initializeNetworkLevelReasoning();
         initializeTableau( constraintMatrix, initialBasis );
+        _initialBasis = initialBasis;
 
         if ( GlobalConfiguration::WARM_START )
             warmStart();
@@ -1126,9 +1248,74 @@ bool Engine::processInputQuery( InputQuery &inputQuery, bool preprocess )
     return true;
 }
 
+void Engine::storeCompiledQuery( CompiledQuery &compiledQuery )
+{
+    compiledQuery._query = _preprocessedQuery;
+
+    // The bounds derived while processing the query hold for all of
+    // it, and need not be derived again
+    for ( unsigned i = 0; i < _preprocessedQuery.getNumberOfVariables(); ++i )
+    {
+        compiledQuery._query.setLowerBound( i, _tableau->getLowerBound( i ) );
+        compiledQuery._query.setUpperBound( i, _tableau->getUpperBound( i ) );
+    }
+
+    if ( compiledQuery._query.getNetworkLevelReasoner() )
+        compiledQuery._query.getNetworkLevelReasoner()->shareWeightsWithCopies();
+
+    if ( compiledQuery._constraintMatrix )
+        delete[] compiledQuery._constraintMatrix;
+    compiledQuery._constraintMatrix = createConstraintMatrix();
+
+    compiledQuery._initialBasis = _initialBasis;
+}
+
+bool Engine::processCompiledQuery( const CompiledQuery &compiledQuery )
+{
+    ENGINE_LOG( "processCompiledQuery starting\n" );
+
+    struct timespec start = TimeUtils::sampleMicro();
+
+    try
+    {
+        // The query has already been preprocessed, its redundant
+        // equations removed and its auxiliary variables added
+        _preprocessingEnabled = false;
+        _preprocessedQuery = compiledQuery._query;
+        informConstraintsOfInitialBounds( _preprocessedQuery );
+
+        storeEquationsInDegradationChecker();
+
+        initializeNetworkLevelReasoning();
+        initializeTableau( compiledQuery._constraintMatrix, compiledQuery._initialBasis );
+        _initialBasis = compiledQuery._initialBasis;
+
+        if ( GlobalConfiguration::WARM_START )
+            warmStart();
+
+        struct timespec end = TimeUtils::sampleMicro();
+        _statistics.setPreprocessingTime( TimeUtils::timePassed( start, end ) );
+    }
+    catch ( const InfeasibleQueryException & )
+    {
+        ENGINE_LOG( "processCompiledQuery done\n" );
+
+        struct timespec end = TimeUtils::sampleMicro();
+        _statistics.setPreprocessingTime( TimeUtils::timePassed( start, end ) );
+
+        _exitCode = Engine::UNSAT;
+        return false;
+    }
+
+    ENGINE_LOG( "processCompiledQuery done\n" );
+
+    _smtCore.storeDebuggingSolution( _preprocessedQuery._debuggingSolution );
+    return true;
+}
+
 void Engine::performMILPSolverBoundedTightening()
 {
-    if ( _networkLevelReasoner && Options::get()->gurobiEnabled() )
+    if ( _networkLevelReasoner && Options::get()->lpTighteningEnabled() )
     {
         _networkLevelReasoner->obtainCurrentBounds();
 
@@ -1141,7 +1328,11 @@ void Engine::performMILPSolverBoundedTightening()
 
         case GlobalConfiguration::MILP_ENCODING:
         case GlobalConfiguration::MILP_ENCODING_INCREMENTAL:
-            _networkLevelReasoner->MILPPropagation();
+            // The built-in LP solver cannot handle integer variables
+            if ( Options::get()->nativeLpSolverInUse() )
+                _networkLevelReasoner->lpRelaxationPropagation();
+            else
+                _networkLevelReasoner->MILPPropagation();
             break;
         case GlobalConfiguration::NONE:
             return;
@@ -1161,30 +1352,42 @@ void Engine::performMILPSolverBoundedTightening()
     }
 }
 
+bool Engine::getProcessedVariable( unsigned variable, unsigned &processedVariable,
+                                   double &fixedValue ) const
+{
+    // Has the variable been merged into another?
+    while ( _preprocessor.variableIsMerged( variable ) )
+        variable = _preprocessor.getMergedIndex( variable );
+
+    // Fixed variables are easy: return the value they've been fixed to.
+    if ( _preprocessor.variableIsFixed( variable ) )
+    {
+        fixedValue = _preprocessor.getFixedValue( variable );
+        return false;
+    }
+
+    // We know which variable to look for, but it may have been assigned
+    // a new index, due to variable elimination
+    processedVariable = _preprocessor.getNewIndex( variable );
+    return true;
+}
+
 void Engine::extractSolution( InputQuery &inputQuery )
 {
     for ( unsigned i = 0; i < inputQuery.getNumberOfVariables(); ++i )
     {
         if ( _preprocessingEnabled )
         {
-            // Has the variable been merged into another?
-            unsigned variable = i;
-            while ( _preprocessor.variableIsMerged( variable ) )
-                variable = _preprocessor.getMergedIndex( variable );
-
-            // Fixed variables are easy: return the value they've been fixed to.
-            if ( _preprocessor.variableIsFixed( variable ) )
+            unsigned variable;
+            double fixedValue;
+            if ( !getProcessedVariable( i, variable, fixedValue ) )
             {
-                inputQuery.setSolutionValue( i, _preprocessor.getFixedValue( variable ) );
-                inputQuery.setLowerBound( i, _preprocessor.getFixedValue( variable ) );
-                inputQuery.setUpperBound( i, _preprocessor.getFixedValue( variable ) );
+                inputQuery.setSolutionValue( i, fixedValue );
+                inputQuery.setLowerBound( i, fixedValue );
+                inputQuery.setUpperBound( i, fixedValue );
                 continue;
             }
 
-            // We know which variable to look for, but it may have been assigned
-            // a new index, due to variable elimination
-            variable = _preprocessor.getNewIndex( variable );
-
             // Finally, set the assigned value
             inputQuery.setSolutionValue( i, _tableau->getValue( variable ) );
             inputQuery.setLowerBound( i, _tableau->getLowerBound( variable ) );
@@ -1199,6 +1402,19 @@ void Engine::extractSolution( InputQuery &inputQuery )
     }
 }
 
+void Engine::extractSolution( InputQuery &inputQuery, const Vector<double> &processedSolution )
+{
+    for ( unsigned i = 0; i < inputQuery.getNumberOfVariables(); ++i )
+    {
+        unsigned variable = i;
+        double fixedValue;
+        if ( _preprocessingEnabled && !getProcessedVariable( i, variable, fixedValue ) )
+            inputQuery.setSolutionValue( i, fixedValue );
+        else
+            inputQuery.setSolutionValue( i, processedSolution[variable] );
+    }
+}
+
 bool Engine::allVarsWithinBounds() const
 {
     return !_tableau->existsBasicOutOfBounds();
@@ -1206,6 +1422,8 @@ bool Engine::allVarsWithinBounds() const
 
 void Engine::collectViolatedPlConstraints()
 {
+    _tableau->notifyPendingVariableValues();
+
     _violatedPlConstraints.clear();
     for ( const auto &constraint : _plConstraints )
     {
@@ -1244,43 +1462,61 @@ void Engine::restoreTableauState( const TableauState &state )
     _tableau->restoreState( state );
 }
 
-void Engine::storeState( EngineState &state, bool storeAlsoTableauState ) const
+void Engine::storeState( EngineState &state, bool storeAlsoTableauState )
 {
     if ( storeAlsoTableauState )
     {
         _tableau->storeState( state._tableauState );
         state._tableauStateIsStored = true;
+
+        if ( _networkLevelReasoner )
+            _networkLevelReasoner->storeState( state._networkLevelReasonerState );
+
+        // The PL constraints record their changes on the trail from
+        // here on. The layers save their slots without pending bounds,
+        // so these are processed first
+        for ( const auto &layer : _reluLayerConstraints )
+            layer->processPendingNotifications();
+
+        _constraintStateTrail.checkpoint();
+        state._constraintStateTrailSize = _constraintStateTrail.size();
     }
     else
+    {
         state._tableauStateIsStored = false;
 
-    for ( const auto &constraint : _plConstraints )
-        state._plConstraintToState[constraint] = constraint->duplicateConstraint();
+        for ( const auto &constraint : _plConstraints )
+            state._plConstraintToState[constraint] = constraint->duplicateConstraint();
+    }
 
     state._numPlConstraintsDisabledByValidSplits = _numPlConstraintsDisabledByValidSplits;
 }
 
-void Engine::restoreState( const EngineState &state )
+void Engine::restoreState( const EngineState &state, bool restoreAlsoPlConstraintStates )
 {
     ENGINE_LOG( "Restore state starting" );
 
     if ( !state._tableauStateIsStored )
         throw MarabouError( MarabouError::RESTORING_ENGINE_FROM_INVALID_STATE );
 
+    // The constraints are restored first: the tableau then informs them
+    // of the restored assignment
+    if ( restoreAlsoPlConstraintStates )
+    {
+        ENGINE_LOG( "\tRestoring constraint states" );
+        _constraintStateTrail.undoTo( state._constraintStateTrailSize );
+        _numPlConstraintsDisabledByValidSplits = state._numPlConstraintsDisabledByValidSplits;
+    }
+
     ENGINE_LOG( "\tRestoring tableau state" );
     _tableau->restoreState( state._tableauState );
 
-    ENGINE_LOG( "\tRestoring constraint states" );
-    for ( auto &constraint : _plConstraints )
+    if ( _networkLevelReasoner )
     {
-        if ( !state._plConstraintToState.exists( constraint ) )
-            throw MarabouError( MarabouError::MISSING_PL_CONSTRAINT_STATE );
-
-        constraint->restoreState( state._plConstraintToState[constraint] );
+        ENGINE_LOG( "\tRestoring network level reasoner state" );
+        _networkLevelReasoner->restoreState( state._networkLevelReasonerState );
     }
 
-    _numPlConstraintsDisabledByValidSplits = state._numPlConstraintsDisabledByValidSplits;
-
     // Make sure the data structures are initialized to the correct size
     _rowBoundTightener->setDimensions();
     _constraintBoundTightener->setDimensions();
@@ -1531,6 +1767,7 @@ void Engine::applyAllConstraintTightenings()
 {
     List<Tightening> entailedTightenings;
 
+    processPendingReluLayerNotifications();
     _constraintBoundTightener->getConstraintTightenings( entailedTightenings );
 
     for ( const auto &tightening : entailedTightenings )
@@ -1581,7 +1818,7 @@ bool Engine::applyValidConstraintCaseSplit( PiecewiseLinearConstraint *constrain
 
         constraint->setActiveConstraint( false );
         PiecewiseLinearCaseSplit validSplit = constraint->getValidCaseSplit();
-        _smtCore.recordImpliedValidSplit( validSplit );
+        _smtCore.recordImpliedValidSplit( validSplit, constraint );
         applySplit( validSplit );
         ++_numPlConstraintsDisabledByValidSplits;
 
@@ -1591,6 +1828,16 @@ bool Engine::applyValidConstraintCaseSplit( PiecewiseLinearConstraint *constrain
     return false;
 }
 
+void Engine::propagateLearnedClauses()
+{
+    unsigned conflictLevel;
+    if ( !_smtCore.propagateLearnedClauses( conflictLevel ) )
+    {
+        _conflictAnalyzer.setConflictLevel( conflictLevel );
+        throw InfeasibleQueryException();
+    }
+}
+
 bool Engine::shouldCheckDegradation()
 {
     return _statistics.getNumMainLoopIterations() %
@@ -1705,10 +1952,58 @@ void Engine::performPrecisionRestoration( PrecisionRestorer::RestoreBasics resto
     }
 }
 
+bool Engine::falsifyWithGradients()
+{
+    int attempts = Options::get()->getInt( Options::FALSIFIER_ATTEMPTS );
+    if ( !_networkLevelReasoner || attempts <= 0 )
+        return false;
+
+    struct timespec start = TimeUtils::sampleMicro();
+
+    GradientFalsifier falsifier( _networkLevelReasoner,
+                                 _preprocessedQuery.getEquations(),
+                                 _tableau );
+    bool found = falsifier.run( attempts, Options::get()->getFloat( Options::FALSIFIER_TIMEOUT ) );
+
+    _statistics.incNumFalsifierAttempts( falsifier.getNumberOfAttempts() );
+    _statistics.addTimeFalsifier( TimeUtils::timePassed( start, TimeUtils::sampleMicro() ) );
+
+    if ( !found )
+        return false;
+
+    // Load the assignment into the tableau, and let it confirm the result
+    unsigned n = _tableau->getN();
+    for ( unsigned i = 0; i < n; ++i )
+    {
+        if ( _tableau->isBasic( i ) )
+            continue;
+
+        double value = falsifier.getValue( i );
+        value = FloatUtils::max( value, _tableau->getLowerBound( i ) );
+        value = FloatUtils::min( value, _tableau->getUpperBound( i ) );
+        _tableau->setNonBasicAssignment( i, value, false );
+    }
+    _tableau->computeAssignment();
+
+    if ( allVarsWithinBounds() )
+    {
+        collectViolatedPlConstraints();
+        if ( allPlConstraintsHold() )
+        {
+            _statistics.incNumFalsifierCounterexamples();
+            return true;
+        }
+    }
+
+    _costFunctionManager->invalidateCostFunction();
+    return false;
+}
+
 void Engine::storeInitialEngineState()
 {
     if ( !_initialStateStored )
     {
+        _tableau->notifyPendingVariableValues();
         _precisionRestorer.storeInitialEngineState( *this );
         _initialStateStored = true;
     }
@@ -1785,6 +2080,58 @@ List<unsigned> Engine::getInputVariables() const
     return _preprocessedQuery.getInputVariables();
 }
 
+void Engine::getRootBounds( List<Tightening> &bounds ) const
+{
+    bounds = _rootBounds;
+}
+
+void Engine::getLearnedClauses( List<Vector<unsigned>> &clauses ) const
+{
+    _smtCore.getLearnedClauses( clauses );
+}
+
+void Engine::addLearnedClauses( const List<Vector<unsigned>> &clauses )
+{
+    _smtCore.addClauses( clauses );
+}
+
+void Engine::storeRootBounds()
+{
+    _rootBounds.clear();
+
+    unsigned n = _tableau->getN();
+    for ( unsigned i = 0; i < n; ++i )
+    {
+        double lb = _tableau->getLowerBound( i );
+        double ub = _tableau->getUpperBound( i );
+
+        if ( FloatUtils::isFinite( lb ) )
+            _rootBounds.append( Tightening( i, lb, Tightening::LB ) );
+        if ( FloatUtils::isFinite( ub ) )
+            _rootBounds.append( Tightening( i, ub, Tightening::UB ) );
+    }
+
+    _rootInputSensitivity.clear();
+    if ( _networkLevelReasoner &&
+         Options::get()->getDivideStrategy() == DivideStrategy::BaBSR )
+    {
+        _networkLevelReasoner->obtainCurrentBounds();
+        _networkLevelReasoner->getInputSensitivity( _rootInputSensitivity );
+    }
+}
+
+void Engine::getInputSensitivity( Map<unsigned, double> &sensitivity ) const
+{
+    sensitivity = _rootInputSensitivity;
+
+    // Before search has started, use the current bounds
+    if ( sensitivity.empty() && _networkLevelReasoner )
+    {
+        _networkLevelReasoner->obtainCurrentBounds();
+        _networkLevelReasoner->getInputSensitivity( sensitivity );
+    }
+}
+
 void Engine::performSymbolicBoundTightening()
 {
     if ( ( !GlobalConfiguration::USE_SYMBOLIC_BOUND_TIGHTENING ) ||
@@ -1848,6 +2195,8 @@ void Engine::reset()
     resetSmtCore();
     resetBoundTighteners();
     resetExitCode();
+    _rootBounds.clear();
+    _rootInputSensitivity.clear();
 }
 
 void Engine::resetStatistics()
@@ -2041,7 +2390,7 @@ void Engine::storeSmtState( SmtState & smtState )
 void Engine::updateScores()
 {
     if ( _networkLevelReasoner &&
-         GlobalConfiguration::SPLITTING_HEURISTICS == DivideStrategy::Polarity )
+         _splittingStrategy == DivideStrategy::Polarity )
     {
         // We find the earliest K ReLUs that have not been fixed, update
         // their scores, and pop them to the _candidatePlConstraints
@@ -2063,8 +2412,44 @@ void Engine::updateScores()
             }
         }
     }
-    else if ( GlobalConfiguration::SPLITTING_HEURISTICS ==
-              DivideStrategy::EarliestReLU )
+    else if ( _networkLevelReasoner &&
+              _splittingStrategy == DivideStrategy::BaBSR )
+    {
+        // Pick the unfixed ReLU whose split is estimated to most
+        // tighten the output bounds
+        ENGINE_LOG( Stringf( "Using BaBSR heuristics..." ).ascii() );
+
+        _networkLevelReasoner->obtainCurrentBounds();
+
+        Map<unsigned, double> scores;
+        _networkLevelReasoner->getReluSplitScores( scores );
+
+        PiecewiseLinearConstraint *best = NULL;
+        double bestScore = 0;
+        for ( const auto &plConstraint : _plConstraints )
+        {
+            if ( !plConstraint->isActive() || plConstraint->phaseFixed() ||
+                 plConstraint->getType() != RELU )
+                continue;
+
+            unsigned f = ( (ReluConstraint *)plConstraint )->getF();
+            if ( !scores.exists( f ) )
+                continue;
+
+            if ( !best || scores[f] > bestScore )
+            {
+                best = plConstraint;
+                bestScore = scores[f];
+            }
+        }
+
+        if ( best )
+        {
+            best->setScore( bestScore );
+            _candidatePlConstraints.insert( best );
+        }
+    }
+    else if ( _splittingStrategy == DivideStrategy::EarliestReLU )
     {
         for ( const auto plConstraint : _plConstraints )
         {
@@ -2101,6 +2486,304 @@ PiecewiseLinearConstraint *Engine::pickSplitPLConstraint()
     }
 }
 
+PiecewiseLinearConstraint *Engine::pickSplitPLConstraintSnC( const PiecewiseLinearCaseSplit &split,
+                                                             DivideStrategy strategy )
+{
+    EngineState stateBeforeSplit;
+    storeState( stateBeforeSplit, true );
+
+    PiecewiseLinearConstraint *candidate = NULL;
+    try
+    {
+        // Fix the phases that the split implies, so that these are not
+        // picked
+        applySplit( split );
+        performSymbolicBoundTightening();
+
+        List<PiecewiseLinearConstraint *> constraints;
+        if ( _networkLevelReasoner )
+            constraints = _networkLevelReasoner->getConstraintsInTopologicalOrder();
+        else
+        {
+            for ( const auto &constraint : _plConstraints )
+                constraints.append( constraint );
+        }
+
+        List<PiecewiseLinearConstraint *> unfixed;
+        for ( const auto &constraint : constraints )
+        {
+            if ( constraint->isActive() && !constraint->phaseFixed() )
+                unfixed.append( constraint );
+        }
+
+        if ( strategy == DivideStrategy::Polarity )
+        {
+            // The ReLU with the most balanced bounds among the earliest
+            // K unfixed ones
+            double bestPolarity = 0;
+            unsigned numConsidered = 0;
+            for ( const auto &constraint : unfixed )
+            {
+                if ( numConsidered >= GlobalConfiguration::RUNTIME_ESTIMATE_THRESHOLD )
+                    break;
+                if ( constraint->getType() != RELU )
+                    continue;
+
+                ++numConsidered;
+                double polarity =
+                    FloatUtils::abs( ( (ReluConstraint *)constraint )->computePolarity() );
+                if ( !candidate || polarity < bestPolarity )
+                {
+                    candidate = constraint;
+                    bestPolarity = polarity;
+                }
+            }
+        }
+        else if ( strategy == DivideStrategy::ReLUViolation )
+        {
+            // The ReLU violated the most times during the last solve
+            unsigned bestCount = 0;
+            for ( const auto &constraint : unfixed )
+            {
+                unsigned count = _smtCore.getTotalViolationCounts( constraint );
+                if ( count > bestCount )
+                {
+                    candidate = constraint;
+                    bestCount = count;
+                }
+            }
+        }
+
+        // Otherwise, or if nothing was found, take the earliest
+        if ( !candidate && !unfixed.empty() )
+            candidate = unfixed.front();
+    }
+    catch ( const InfeasibleQueryException & )
+    {
+        // The subquery is infeasible, and is left for the worker that
+        // solves it to find out
+        candidate = NULL;
+    }
+
+    restoreState( stateBeforeSplit, true );
+
+    return candidate;
+}
+
+bool Engine::estimateSubQueryDifficulty( const PiecewiseLinearCaseSplit &split,
+                                         unsigned &numUnfixedConstraints,
+                                         double &outputBoundGap )
+{
+    EngineState stateBeforeSplit;
+    storeState( stateBeforeSplit, true );
+
+    bool feasible = true;
+    numUnfixedConstraints = 0;
+    outputBoundGap = 0;
+    try
+    {
+        applySplit( split );
+        performSymbolicBoundTightening();
+
+        for ( const auto &constraint : _plConstraints )
+        {
+            if ( constraint->isActive() && !constraint->phaseFixed() )
+                ++numUnfixedConstraints;
+        }
+
+        for ( const auto &variable : _preprocessedQuery.getOutputVariables() )
+        {
+            if ( variable < _tableau->getN() )
+                outputBoundGap += _tableau->getUpperBound( variable ) -
+                    _tableau->getLowerBound( variable );
+        }
+    }
+    catch ( const InfeasibleQueryException & )
+    {
+        feasible = false;
+    }
+
+    restoreState( stateBeforeSplit, true );
+
+    return feasible;
+}
+
+bool Engine::performLookahead()
+{
+    // The candidates are the most violated unfixed ReLUs
+    List<PiecewiseLinearConstraint *> candidates;
+    Set<PiecewiseLinearConstraint *> picked;
+    while ( candidates.size() < GlobalConfiguration::STRONG_BRANCHING_CANDIDATES )
+    {
+        PiecewiseLinearConstraint *best = NULL;
+        unsigned bestCount = 0;
+        for ( const auto &constraint : _plConstraints )
+        {
+            if ( constraint->getType() != RELU || !constraint->isActive() ||
+                 constraint->phaseFixed() || picked.exists( constraint ) )
+                continue;
+
+            unsigned count = _smtCore.getViolationCounts( constraint );
+            if ( count > bestCount )
+            {
+                best = constraint;
+                bestCount = count;
+            }
+        }
+
+        if ( !best )
+            break;
+
+        candidates.append( best );
+        picked.insert( best );
+    }
+
+    if ( candidates.empty() )
+        return true;
+
+    struct timespec start = TimeUtils::sampleMicro();
+
+    EngineState state;
+    storeState( state, true );
+
+    unsigned n = _tableau->getN();
+    double *lowerBounds = new double[n];
+    if ( !lowerBounds )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Engine::lookaheadLowerBounds" );
+    double *upperBounds = new double[n];
+    if ( !upperBounds )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Engine::lookaheadUpperBounds" );
+    memcpy( lowerBounds, _tableau->getLowerBounds(), sizeof(double) * n );
+    memcpy( upperBounds, _tableau->getUpperBounds(), sizeof(double) * n );
+
+    PiecewiseLinearConstraint *best = NULL;
+    PiecewiseLinearConstraint *fixedConstraint = NULL;
+    PiecewiseLinearCaseSplit validSplit;
+    bool bothInfeasible = false;
+    double bestScore = 0;
+
+    for ( const auto &candidate : candidates )
+    {
+        // Always probe at least one candidate
+        if ( best && TimeUtils::timePassed( start, TimeUtils::sampleMicro() ) >
+             GlobalConfiguration::STRONG_BRANCHING_BUDGET_IN_MICROSECONDS )
+            break;
+
+        List<PiecewiseLinearCaseSplit> splits = candidate->getCaseSplits();
+        ASSERT( splits.size() == 2 );
+
+        bool infeasible[2];
+        unsigned numFixed[2];
+        unsigned i = 0;
+        for ( const auto &split : splits )
+        {
+            numFixed[i] = probeSplit( split, state, lowerBounds, upperBounds, infeasible[i] );
+            ++i;
+        }
+
+        if ( infeasible[0] && infeasible[1] )
+        {
+            bothInfeasible = true;
+            break;
+        }
+
+        if ( infeasible[0] || infeasible[1] )
+        {
+            fixedConstraint = candidate;
+            validSplit = infeasible[0] ? splits.back() : splits.front();
+            break;
+        }
+
+        // Prefer ReLUs both of whose phases fix many bounds
+        double score = ( numFixed[0] + 1.0 ) * ( numFixed[1] + 1.0 );
+        if ( !best || score > bestScore )
+        {
+            best = candidate;
+            bestScore = score;
+        }
+    }
+
+    delete[] lowerBounds;
+    delete[] upperBounds;
+
+    struct timespec end = TimeUtils::sampleMicro();
+    _statistics.addTimeLookahead( TimeUtils::timePassed( start, end ) );
+
+    if ( bothInfeasible )
+        throw InfeasibleQueryException();
+
+    if ( fixedConstraint )
+    {
+        ENGINE_LOG( "Lookahead found an infeasible phase, applying the other one" );
+        _statistics.incNumLookaheadValidSplits();
+
+        fixedConstraint->setActiveConstraint( false );
+        _smtCore.recordImpliedValidSplit( validSplit, fixedConstraint );
+        applySplit( validSplit );
+        ++_numPlConstraintsDisabledByValidSplits;
+        return false;
+    }
+
+    _smtCore.setConstraintForSplitting( best );
+    return true;
+}
+
+unsigned Engine::probeSplit( const PiecewiseLinearCaseSplit &split,
+                             const EngineState &state,
+                             const double *lowerBounds,
+                             const double *upperBounds,
+                             bool &infeasible )
+{
+    _statistics.incNumLookaheadProbes();
+
+    unsigned numFixedPhasesBefore = 0;
+    for ( const auto &constraint : _plConstraints )
+        if ( constraint->isActive() && constraint->phaseFixed() )
+            ++numFixedPhasesBefore;
+
+    unsigned numFixed = 0;
+    infeasible = false;
+
+    try
+    {
+        applySplit( split );
+        _rowBoundTightener->examineConstraintMatrix( false );
+        applyAllBoundTightenings();
+        performSymbolicBoundTightening();
+
+        if ( !_tableau->allBoundsValid() )
+            infeasible = true;
+    }
+    catch ( const InfeasibleQueryException & )
+    {
+        infeasible = true;
+    }
+
+    if ( !infeasible )
+    {
+        // Only the variables that existed before the split are compared
+        const double *probedLowerBounds = _tableau->getLowerBounds();
+        const double *probedUpperBounds = _tableau->getUpperBounds();
+        for ( unsigned i = 0; i < state._tableauState._n; ++i )
+        {
+            if ( FloatUtils::gt( probedLowerBounds[i], lowerBounds[i] ) )
+                ++numFixed;
+            if ( FloatUtils::lt( probedUpperBounds[i], upperBounds[i] ) )
+                ++numFixed;
+        }
+
+        unsigned numFixedPhases = 0;
+        for ( const auto &constraint : _plConstraints )
+            if ( constraint->isActive() && constraint->phaseFixed() )
+                ++numFixedPhases;
+        if ( numFixedPhases > numFixedPhasesBefore )
+            numFixed += numFixedPhases - numFixedPhasesBefore;
+    }
+
+    restoreState( state, true );
+    return numFixed;
+}
+
 void Engine::setConstraintViolationThreshold( unsigned threshold )
 {
     _smtCore.setConstraintViolationThreshold( threshold );
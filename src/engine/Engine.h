@@ -22,6 +22,8 @@
 #include "AutoRowBoundTightener.h"
 #include "AutoTableau.h"
 #include "BlandsRule.h"
+#include "ConflictAnalyzer.h"
+#include "ConstraintStateTrail.h"
 #include "DantzigsRule.h"
 #include "DegradationChecker.h"
 #include "DivideStrategy.h"
@@ -42,9 +44,11 @@
 
 #define ENGINE_LOG(x, ...) LOG(GlobalConfiguration::ENGINE_LOGGING, "Engine: %s\n", x)
 
+class CompiledQuery;
 class EngineState;
 class InputQuery;
 class PiecewiseLinearConstraint;
+class ReluLayerConstraint;
 class String;
 
 class Engine : public IEngine, public SignalHandler::Signalable
@@ -67,19 +71,39 @@ public:
     bool processInputQuery( InputQuery &inputQuery );
     bool processInputQuery( InputQuery &inputQuery, bool preprocess );
 
+    /*
+      Store the processed query, so that other engines can be
+      initialized from it without processing it again.
+    */
+    void storeCompiledQuery( CompiledQuery &compiledQuery );
+
+    /*
+      Initialize the engine from a query compiled by another engine.
+      Only the data that changes during the search is copied. Return
+      false if query is found to be infeasible, true otherwise.
+    */
+    bool processCompiledQuery( const CompiledQuery &compiledQuery );
+
     /*
       If the query is feasiable and has been successfully solved, this
       method can be used to extract the solution.
      */
     void extractSolution( InputQuery &inputQuery );
 
+    /*
+      As above, but from an assignment of the variables of the
+      processed query that was found elsewhere, e.g. by an engine in
+      another process initialized from this engine's compiled query.
+    */
+    void extractSolution( InputQuery &inputQuery, const Vector<double> &processedSolution );
+
     /*
       Methods for storing and restoring the state of the engine.
     */
     void storeTableauState( TableauState &state ) const;
     void restoreTableauState( const TableauState &state );
-    void storeState( EngineState &state, bool storeAlsoTableauState ) const;
-    void restoreState( const EngineState &state );
+    void storeState( EngineState &state, bool storeAlsoTableauState );
+    void restoreState( const EngineState &state, bool restoreAlsoPlConstraintStates );
     void setNumPlConstraintsDisabledByValidSplits( unsigned numConstraints );
 
     /*
@@ -106,6 +130,23 @@ public:
     */
     List<unsigned> getInputVariables() const;
 
+    /*
+      Get the bounds derived before the first case split
+    */
+    void getRootBounds( List<Tightening> &bounds ) const;
+
+    /*
+      Get the phase clauses learned by the last solve, or add clauses
+      learned elsewhere
+    */
+    void getLearnedClauses( List<Vector<unsigned>> &clauses ) const;
+    void addLearnedClauses( const List<Vector<unsigned>> &clauses );
+
+    /*
+      Get the sensitivity of the output bounds to each input variable
+    */
+    void getInputSensitivity( Map<unsigned, double> &sensitivity ) const;
+
     /*
       Add equations and tightenings from a split.
     */
@@ -148,6 +189,20 @@ public:
     */
     PiecewiseLinearConstraint *pickSplitPLConstraint();
 
+    /*
+      Pick the piecewise linear constraint on which to divide a DnC
+      subquery
+    */
+    PiecewiseLinearConstraint *pickSplitPLConstraintSnC( const PiecewiseLinearCaseSplit &split,
+                                                         DivideStrategy strategy );
+
+    /*
+      Estimate the difficulty of a DnC subquery by bound propagation
+    */
+    bool estimateSubQueryDifficulty( const PiecewiseLinearCaseSplit &split,
+                                     unsigned &numUnfixedConstraints,
+                                     double &outputBoundGap );
+
     /*
       Update the scores of each candidate splitting PL constraints
     */
@@ -201,6 +256,17 @@ private:
     */
     List<PiecewiseLinearConstraint *> _plConstraints;
 
+    /*
+      The ReLUs of each network layer, grouped so that their bound
+      notifications are processed in batches.
+    */
+    List<ReluLayerConstraint *> _reluLayerConstraints;
+
+    /*
+      The undo trail for the state of the PL constraints and layers.
+    */
+    ConstraintStateTrail _constraintStateTrail;
+
     /*
       The ordered set of candidate PL constraints for splitting
     */
@@ -221,6 +287,11 @@ private:
 	*/
 	InputQuery _preprocessedQuery;
 
+    /*
+      The initial basis of the tableau, kept for compiling the query
+    */
+    List<unsigned> _initialBasis;
+
     /*
       Pivot selection strategies.
     */
@@ -239,6 +310,18 @@ private:
     */
     SmtCore _smtCore;
 
+    /*
+      Tracks the decision levels of the bounds, to find the splits
+      that contributed to a conflict.
+    */
+    ConflictAnalyzer _conflictAnalyzer;
+
+    /*
+      The bounds of all variables, as derived when the SmtCore's stack
+      was last empty. Used to share bounds between DnC subqueries.
+    */
+    List<Tightening> _rootBounds;
+
     /*
       Number of pl constraints disabled by valid splits.
     */
@@ -333,6 +416,14 @@ private:
     unsigned _lastNumVisitedStates;
     unsigned long long _lastIterationWithProgress;
 
+    /*
+      The heuristic for picking the piecewise linear constraint to
+      split on, and the per-input sensitivity of the output bounds
+      at the root, used by the BaBSR divide strategy in DnC mode.
+    */
+    DivideStrategy _splittingStrategy;
+    Map<unsigned, double> _rootInputSensitivity;
+
     /*
       Perform a simplex step: compute the cost function, pick the
       entering and leaving variables and perform a pivot.
@@ -391,6 +482,13 @@ private:
     */
     void applyAllConstraintTightenings();
 
+    /*
+      Have the ReLU layer constraints process their pending bound
+      notifications, so that their tightenings reach the constraint
+      bound tightener.
+    */
+    void processPendingReluLayerNotifications();
+
     /*
       Apply all valid case splits proposed by the constraints.
       Return true if a valid case split has been applied.
@@ -398,6 +496,34 @@ private:
     bool applyAllValidConstraintCaseSplits();
     bool applyValidConstraintCaseSplit( PiecewiseLinearConstraint *constraint );
 
+    /*
+      Apply the ReLU phases implied by the clauses learned by the SMT
+      core. Throws an InfeasibleQueryException if a learned clause is
+      violated.
+    */
+    void propagateLearnedClauses();
+
+    /*
+      Strong branching: probe both phases of the most violated ReLUs
+      before a split. A phase that turns out infeasible makes the other
+      phase a valid split, which is applied instead of splitting;
+      otherwise, the ReLU whose phases fix the most bounds and phases
+      is split on. Returns true if a split is still needed.
+    */
+    bool performLookahead();
+
+    /*
+      Apply a case split followed by a round of row and symbolic bound
+      tightening, then restore the given state. Returns the number of
+      bounds and phases that the split fixed, as compared to the given
+      bounds.
+    */
+    unsigned probeSplit( const PiecewiseLinearCaseSplit &split,
+                         const EngineState &state,
+                         const double *lowerBounds,
+                         const double *upperBounds,
+                         bool &infeasible );
+
     /*
       Update statitstics, print them if needed.
     */
@@ -424,6 +550,18 @@ private:
       Restore the tableau from the original version.
     */
     void storeInitialEngineState();
+
+    /*
+      Record the current bounds as the root bounds
+    */
+    void storeRootBounds();
+
+    /*
+      Look for a satisfying assignment by gradient descent over the
+      network's inputs, before search starts. If one is found, it is
+      loaded into the tableau and true is returned.
+    */
+    bool falsifyWithGradients();
     void performPrecisionRestoration( PrecisionRestorer::RestoreBasics restoreBasics );
     bool basisRestorationNeeded() const;
 
@@ -470,6 +608,14 @@ private:
       Helper functions for input query preprocessing
     */
     void informConstraintsOfInitialBounds( InputQuery &inputQuery ) const;
+
+    /*
+      Find the variable of the processed query that a variable of the
+      input query became. Returns false if the variable was fixed by
+      preprocessing instead, in which case its value is stored.
+    */
+    bool getProcessedVariable( unsigned variable, unsigned &processedVariable,
+                               double &fixedValue ) const;
     void invokePreprocessor( const InputQuery &inputQuery, bool preprocess );
     void printInputBounds( const InputQuery &inputQuery ) const;
     void storeEquationsInDegradationChecker();
@@ -477,6 +623,7 @@ private:
     void selectInitialVariablesForBasis( const double *constraintMatrix, List<unsigned> &initialBasis, List<unsigned> &basicRows );
     void initializeTableau( const double *constraintMatrix, const List<unsigned> &initialBasis );
     void initializeNetworkLevelReasoning();
+    void initializeReluLayerConstraints();
     double *createConstraintMatrix();
     void addAuxiliaryVariables();
     void augmentInitialBasisIfNeeded( List<unsigned> &initialBasis, const List<unsigned> &basicRows );
@@ -16,6 +16,8 @@
 #include "EngineState.h"
 
 EngineState::EngineState()
+    : _tableauStateIsStored( false )
+    , _constraintStateTrailSize( 0 )
 {
 }
 
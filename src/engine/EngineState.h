@@ -18,6 +18,7 @@
 
 #include "List.h"
 #include "Map.h"
+#include "NetworkLevelReasonerState.h"
 #include "PiecewiseLinearConstraint.h"
 #include "TableauState.h"
 
@@ -34,11 +35,26 @@ public:
     TableauState _tableauState;
 
     /*
-      The state of each of the PL constraints
+      The size of the engine's constraint state trail when the state
+      was stored. Restoring the state undoes the changes to the PL
+      constraints recorded after this point.
+    */
+    unsigned _constraintStateTrailSize;
+
+    /*
+      Copies of the PL constraints. These are only stored for states
+      that do not include the tableau, which cannot be restored, and
+      are used to inspect the constraints' status.
     */
     Map<PiecewiseLinearConstraint *, PiecewiseLinearConstraint *> _plConstraintToState;
     unsigned _numPlConstraintsDisabledByValidSplits;
 
+    /*
+      The results of the network level reasoner's symbolic bound
+      propagation
+    */
+    NLR::NetworkLevelReasonerState _networkLevelReasonerState;
+
     /*
       A unique ID allocated to every state that is stored, for
       debugging purposes. These are assigned by the SMT core.
@@ -0,0 +1,410 @@
+/*********************                                                        */
+/*! \file GradientFalsifier.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#include "Debug.h"
+#include "FloatUtils.h"
+#include "GlobalConfiguration.h"
+#include "GradientFalsifier.h"
+#include "Set.h"
+#include "TimeUtils.h"
+
+GradientFalsifier::Derivation::Derivation( unsigned variable, double coefficient, const Equation *equation )
+    : _variable( variable )
+    , _coefficient( coefficient )
+    , _equation( equation )
+{
+}
+
+GradientFalsifier::GradientFalsifier( NLR::NetworkLevelReasoner *networkLevelReasoner,
+                                      const List<Equation> &equations,
+                                      const ITableau *tableau )
+    : _networkLevelReasoner( networkLevelReasoner )
+    , _equations( equations )
+    , _tableau( tableau )
+    , _n( tableau->getN() )
+    , _values( _n, 0 )
+    , _variableGradients( _n, 0 )
+    , _inputSize( 0 )
+    , _outputSize( 0 )
+    , _inputLb( NULL )
+    , _inputUb( NULL )
+    , _output( NULL )
+    , _generator( GlobalConfiguration::GRADIENT_FALSIFIER_RANDOM_SEED )
+    , _numberOfAttempts( 0 )
+{
+}
+
+GradientFalsifier::~GradientFalsifier()
+{
+    freeMemoryIfNeeded();
+}
+
+void GradientFalsifier::freeMemoryIfNeeded()
+{
+    for ( const auto &gradient : _layerGradients )
+        delete[] gradient.second;
+    _layerGradients.clear();
+
+    if ( _inputLb )
+    {
+        delete[] _inputLb;
+        _inputLb = NULL;
+    }
+
+    if ( _inputUb )
+    {
+        delete[] _inputUb;
+        _inputUb = NULL;
+    }
+
+    if ( _output )
+    {
+        delete[] _output;
+        _output = NULL;
+    }
+}
+
+const NLR::Layer *GradientFalsifier::getLayer( unsigned index ) const
+{
+    return _networkLevelReasoner->getLayer( index );
+}
+
+bool GradientFalsifier::prepare()
+{
+    freeMemoryIfNeeded();
+    _neurons.clear();
+    _derivations.clear();
+
+    Set<unsigned> known;
+
+    // The neurons are assigned by evaluating the network
+    unsigned numberOfLayers = _networkLevelReasoner->getNumberOfLayers();
+    for ( unsigned i = 0; i < numberOfLayers; ++i )
+    {
+        const NLR::Layer *layer = getLayer( i );
+        _layerGradients[i] = new double[layer->getSize()];
+
+        for ( unsigned j = 0; j < layer->getSize(); ++j )
+        {
+            if ( layer->neuronEliminated( j ) )
+                continue;
+
+            unsigned variable = layer->neuronToVariable( j );
+            _neurons.append( NLR::NeuronIndex( i, j ) );
+            known.insert( variable );
+        }
+    }
+
+    const NLR::Layer *inputLayer = getLayer( 0 );
+    _inputSize = inputLayer->getSize();
+    _inputLb = new double[_inputSize];
+    _inputUb = new double[_inputSize];
+    for ( unsigned i = 0; i < _inputSize; ++i )
+    {
+        if ( inputLayer->neuronEliminated( i ) )
+        {
+            _inputLb[i] = inputLayer->getEliminatedNeuronValue( i );
+            _inputUb[i] = _inputLb[i];
+        }
+        else
+        {
+            unsigned variable = inputLayer->neuronToVariable( i );
+            _inputLb[i] = _tableau->getLowerBound( variable );
+            _inputUb[i] = _tableau->getUpperBound( variable );
+        }
+
+        if ( !FloatUtils::isFinite( _inputLb[i] ) || !FloatUtils::isFinite( _inputUb[i] ) )
+            return false;
+    }
+
+    _outputSize = getLayer( numberOfLayers - 1 )->getSize();
+    _output = new double[_outputSize];
+
+    // Variables that are fixed by their bounds are constants
+    for ( unsigned i = 0; i < _n; ++i )
+    {
+        if ( !known.exists( i ) &&
+             FloatUtils::areEqual( _tableau->getLowerBound( i ), _tableau->getUpperBound( i ) ) )
+        {
+            _values[i] = _tableau->getLowerBound( i );
+            known.insert( i );
+        }
+    }
+
+    // Derive the remaining variables from the equations, where possible
+    List<const Equation *> pending;
+    for ( const auto &equation : _equations )
+    {
+        if ( equation._type == Equation::EQ )
+            pending.append( &equation );
+    }
+
+    bool progress = true;
+    while ( progress )
+    {
+        progress = false;
+
+        auto it = pending.begin();
+        while ( it != pending.end() )
+        {
+            unsigned unknowns = 0;
+            const Equation::Addend *unknown = NULL;
+            for ( const auto &addend : ( *it )->_addends )
+            {
+                if ( !known.exists( addend._variable ) && !FloatUtils::isZero( addend._coefficient ) )
+                {
+                    ++unknowns;
+                    unknown = &addend;
+                }
+            }
+
+            if ( unknowns > 1 )
+            {
+                ++it;
+                continue;
+            }
+
+            if ( unknowns == 1 )
+            {
+                _derivations.append( Derivation( unknown->_variable, unknown->_coefficient, *it ) );
+                known.insert( unknown->_variable );
+            }
+
+            it = pending.erase( it );
+            progress = true;
+        }
+    }
+
+    // The equations left have several unknown variables
+    if ( !pending.empty() )
+        return false;
+
+    // Variables that appear nowhere can take any value within their bounds
+    for ( unsigned i = 0; i < _n; ++i )
+    {
+        if ( !known.exists( i ) )
+        {
+            double lb = _tableau->getLowerBound( i );
+            double ub = _tableau->getUpperBound( i );
+            _values[i] = FloatUtils::max( lb, FloatUtils::min( 0, ub ) );
+        }
+    }
+
+    return true;
+}
+
+double GradientFalsifier::getViolation( unsigned variable ) const
+{
+    /*
+      Aim for half the tolerance that the tableau allows, so that the
+      assignment is accepted despite rounding
+    */
+    double tolerance = GlobalConfiguration::BOUND_COMPARISON_ADDITIVE_TOLERANCE / 2;
+
+    double value = _values.get( variable );
+    double lb = _tableau->getLowerBound( variable );
+    double ub = _tableau->getUpperBound( variable );
+
+    if ( value < lb - tolerance )
+        return lb - value;
+    if ( value > ub + tolerance )
+        return value - ub;
+    return 0;
+}
+
+double GradientFalsifier::evaluate( const double *input )
+{
+    _networkLevelReasoner->evaluate( const_cast<double *>( input ), _output );
+
+    for ( const auto &neuron : _neurons )
+    {
+        const NLR::Layer *layer = getLayer( neuron._layer );
+        _values[layer->neuronToVariable( neuron._neuron )] = layer->getAssignment( neuron._neuron );
+    }
+
+    for ( const auto &derivation : _derivations )
+    {
+        double value = derivation._equation->_scalar;
+        for ( const auto &addend : derivation._equation->_addends )
+        {
+            if ( addend._variable != derivation._variable )
+                value -= addend._coefficient * _values[addend._variable];
+        }
+
+        _values[derivation._variable] = value / derivation._coefficient;
+    }
+
+    double violation = 0;
+    for ( const auto &neuron : _neurons )
+        violation += getViolation( getLayer( neuron._layer )->neuronToVariable( neuron._neuron ) );
+    for ( const auto &derivation : _derivations )
+        violation += getViolation( derivation._variable );
+
+    return violation;
+}
+
+void GradientFalsifier::computeInputGradient( double *gradient )
+{
+    std::fill( _variableGradients.begin(), _variableGradients.end(), 0 );
+
+    for ( const auto &neuron : _neurons )
+    {
+        unsigned variable = getLayer( neuron._layer )->neuronToVariable( neuron._neuron );
+        if ( getViolation( variable ) > 0 )
+            _variableGradients[variable] = _values[variable] < _tableau->getLowerBound( variable ) ? -1 : 1;
+    }
+
+    for ( const auto &derivation : _derivations )
+    {
+        unsigned variable = derivation._variable;
+        if ( getViolation( variable ) > 0 )
+            _variableGradients[variable] = _values[variable] < _tableau->getLowerBound( variable ) ? -1 : 1;
+    }
+
+    // Derived variables pass their gradient on to the variables they depend on
+    for ( auto derivation = _derivations.rbegin(); derivation != _derivations.rend(); ++derivation )
+    {
+        double variableGradient = _variableGradients[derivation->_variable];
+        if ( variableGradient == 0 )
+            continue;
+
+        for ( const auto &addend : derivation->_equation->_addends )
+        {
+            if ( addend._variable != derivation->_variable )
+                _variableGradients[addend._variable] -=
+                    variableGradient * addend._coefficient / derivation->_coefficient;
+        }
+    }
+
+    for ( const auto &layerGradient : _layerGradients )
+        std::fill_n( layerGradient.second, getLayer( layerGradient.first )->getSize(), 0 );
+
+    for ( const auto &neuron : _neurons )
+    {
+        unsigned variable = getLayer( neuron._layer )->neuronToVariable( neuron._neuron );
+        _layerGradients[neuron._layer][neuron._neuron] = _variableGradients[variable];
+    }
+
+    _networkLevelReasoner->backPropagate( _layerGradients );
+
+    memcpy( gradient, _layerGradients[0], sizeof(double) * _inputSize );
+}
+
+bool GradientFalsifier::run( unsigned numberOfAttempts, double timeoutInSeconds )
+{
+    if ( !prepare() )
+        return false;
+
+    struct timespec start = TimeUtils::sampleMicro();
+    unsigned long long timeoutInMicroSeconds = timeoutInSeconds * 1000000;
+
+    Vector<double> input( _inputSize, 0 );
+    Vector<double> candidate( _inputSize, 0 );
+    Vector<double> gradient( _inputSize, 0 );
+
+    bool found = false;
+    for ( unsigned attempt = 0; attempt < numberOfAttempts && !found; ++attempt )
+    {
+        ++_numberOfAttempts;
+
+        // Start from the center of the box, and then from random points
+        for ( unsigned i = 0; i < _inputSize; ++i )
+        {
+            if ( attempt == 0 )
+                input[i] = ( _inputLb[i] + _inputUb[i] ) / 2;
+            else
+                input[i] = std::uniform_real_distribution<double>( _inputLb[i], _inputUb[i] )( _generator );
+        }
+
+        double violation = evaluate( input.data() );
+        double stepSize = GlobalConfiguration::GRADIENT_FALSIFIER_INITIAL_STEP_SIZE;
+        bool gradientValid = false;
+
+        for ( unsigned step = 0; step < GlobalConfiguration::GRADIENT_FALSIFIER_STEPS_PER_ATTEMPT; ++step )
+        {
+            if ( violation == 0 )
+            {
+                found = true;
+                break;
+            }
+
+            if ( timeoutInMicroSeconds > 0 &&
+                 TimeUtils::timePassed( start, TimeUtils::sampleMicro() ) > timeoutInMicroSeconds )
+                return false;
+
+            if ( !gradientValid )
+            {
+                computeInputGradient( gradient.data() );
+                gradientValid = true;
+            }
+
+            // Take a signed step against the gradient, and project onto the box
+            bool moved = false;
+            for ( unsigned i = 0; i < _inputSize; ++i )
+            {
+                double width = _inputUb[i] - _inputLb[i];
+                candidate[i] = input[i];
+
+                if ( gradient[i] > 0 )
+                    candidate[i] = FloatUtils::max( input[i] - stepSize * width, _inputLb[i] );
+                else if ( gradient[i] < 0 )
+                    candidate[i] = FloatUtils::min( input[i] + stepSize * width, _inputUb[i] );
+
+                if ( candidate[i] != input[i] )
+                    moved = true;
+            }
+
+            // The violation is flat around this point
+            if ( !moved )
+                break;
+
+            double candidateViolation = evaluate( candidate.data() );
+            if ( candidateViolation < violation )
+            {
+                input = candidate;
+                violation = candidateViolation;
+                gradientValid = false;
+            }
+            else
+            {
+                stepSize /= 2;
+            }
+        }
+
+        // The last evaluation was not necessarily at the current point
+        if ( found || evaluate( input.data() ) == 0 )
+            found = true;
+    }
+
+    return found;
+}
+
+double GradientFalsifier::getValue( unsigned variable ) const
+{
+    return _values.get( variable );
+}
+
+unsigned GradientFalsifier::getNumberOfAttempts() const
+{
+    return _numberOfAttempts;
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,132 @@
+/*********************                                                        */
+/*! \file GradientFalsifier.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#ifndef __GradientFalsifier_h__
+#define __GradientFalsifier_h__
+
+#include "Equation.h"
+#include "ITableau.h"
+#include "List.h"
+#include "Map.h"
+#include "NetworkLevelReasoner.h"
+#include "Vector.h"
+
+#include <random>
+
+/*
+  A cheap attempt at finding a satisfying assignment before search
+  starts, by running projected gradient descent over the input box.
+
+  Evaluating the network assigns values to all of its neurons. Any
+  other variable is either fixed by its bounds, or is determined by
+  an equation in which all other variables are already known; if
+  neither is the case, the falsifier gives up. The descent minimizes
+  the total violation of the variables' current bounds in the
+  tableau, taking signed steps within the input box, starting from
+  the center of the box and then from random points. Any assignment
+  that is found still needs to be checked against the piecewise
+  linear constraints and the tableau by the caller.
+*/
+class GradientFalsifier
+{
+public:
+    GradientFalsifier( NLR::NetworkLevelReasoner *networkLevelReasoner,
+                       const List<Equation> &equations,
+                       const ITableau *tableau );
+    ~GradientFalsifier();
+
+    /*
+      Run up to the given number of descents, or until the timeout
+      (in seconds, 0 means no timeout) expires. Returns true iff an
+      assignment within all bounds was found.
+    */
+    bool run( unsigned numberOfAttempts, double timeoutInSeconds );
+
+    /*
+      The value of a variable in the assignment found
+    */
+    double getValue( unsigned variable ) const;
+
+    unsigned getNumberOfAttempts() const;
+
+private:
+    /*
+      A variable whose value follows from an equation, once the
+      values of all other variables in the equation are known
+    */
+    struct Derivation
+    {
+        Derivation( unsigned variable, double coefficient, const Equation *equation );
+
+        unsigned _variable;
+        double _coefficient;
+        const Equation *_equation;
+    };
+
+    NLR::NetworkLevelReasoner *_networkLevelReasoner;
+    const List<Equation> &_equations;
+    const ITableau *_tableau;
+    unsigned _n;
+
+    // The variables of the neurons, ordered by layer
+    List<NLR::NeuronIndex> _neurons;
+    List<Derivation> _derivations;
+
+    Vector<double> _values;
+    Vector<double> _variableGradients;
+    Map<unsigned, double *> _layerGradients;
+
+    unsigned _inputSize;
+    unsigned _outputSize;
+    double *_inputLb;
+    double *_inputUb;
+    double *_output;
+
+    std::mt19937 _generator;
+    unsigned _numberOfAttempts;
+
+    /*
+      Determine how every variable is assigned. Returns false if some
+      variable cannot be assigned.
+    */
+    bool prepare();
+
+    /*
+      Evaluate the network at the given input, assign all variables
+      and return the total violation of their bounds
+    */
+    double evaluate( const double *input );
+
+    /*
+      Compute the gradient of the total violation with respect to the
+      input, at the point of the last evaluation
+    */
+    void computeInputGradient( double *gradient );
+
+    double getViolation( unsigned variable ) const;
+    const NLR::Layer *getLayer( unsigned index ) const;
+
+    void freeMemoryIfNeeded();
+};
+
+#endif // __GradientFalsifier_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
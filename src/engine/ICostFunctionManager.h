@@ -35,6 +35,7 @@ public:
     virtual ICostFunctionManager::CostFunctionStatus getCostFunctionStatus() const = 0;
     virtual void computeCostFunction( const Map<unsigned, double> &heuristicCost ) = 0;
     virtual void computeCoreCostFunction() = 0;
+    virtual void computeGivenCostFunction( const Map<unsigned, double> &cost ) = 0;
     virtual const double *getCostFunction() const = 0;
     virtual void dumpCostFunction() const = 0;
     virtual void setCostFunctionStatus( ICostFunctionManager::CostFunctionStatus status ) = 0;
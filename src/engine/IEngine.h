@@ -16,7 +16,10 @@
 #ifndef __IEngine_h__
 #define __IEngine_h__
 
+#include "DivideStrategy.h"
 #include "List.h"
+#include "Map.h"
+#include "Vector.h"
 
 #ifdef _WIN32
 #undef ERROR
@@ -24,8 +27,10 @@
 
 class EngineState;
 class Equation;
+class InputQuery;
 class PiecewiseLinearCaseSplit;
 class SmtState;
+class Tightening;
 class PiecewiseLinearConstraint;
 
 class IEngine
@@ -49,10 +54,12 @@ public:
     virtual void applySplit( const PiecewiseLinearCaseSplit &split ) = 0;
 
     /*
-      Methods for storing and restoring the state of the engine.
+      Methods for storing and restoring the state of the engine. The
+      states of the PL constraints may be left as they are when
+      restoring, e.g. when only the tableau needs to be rebuilt.
     */
-    virtual void storeState( EngineState &state, bool storeAlsoTableauState ) const = 0;
-    virtual void restoreState( const EngineState &state ) = 0;
+    virtual void storeState( EngineState &state, bool storeAlsoTableauState ) = 0;
+    virtual void restoreState( const EngineState &state, bool restoreAlsoPlConstraintStates ) = 0;
     virtual void setNumPlConstraintsDisabledByValidSplits( unsigned numConstraints ) = 0;
 
     /*
@@ -76,6 +83,12 @@ public:
     */
     virtual ExitCode getExitCode() const = 0;
 
+    /*
+      Store the satisfying assignment found by solve() into the
+      variables of the given query
+    */
+    virtual void extractSolution( InputQuery &inputQuery ) = 0;
+
     /*
       Methods for DnC: reset the engine state for re-use,
       get input variables.
@@ -83,6 +96,29 @@ public:
     virtual void reset() = 0;
     virtual List<unsigned> getInputVariables() const = 0;
 
+    /*
+      The bounds derived by the last call to solve() before any case
+      split was performed; these hold for the entire query. Empty if
+      no such bounds were derived.
+    */
+    virtual void getRootBounds( List<Tightening> &bounds ) const = 0;
+
+    /*
+      The ReLU phase clauses learned by the last call to solve(), and
+      clauses learned over the same query elsewhere, e.g. by other DnC
+      workers, to be used by the next call. Clauses learned under a
+      case split only hold within it.
+    */
+    virtual void getLearnedClauses( List<Vector<unsigned>> &clauses ) const = 0;
+    virtual void addLearnedClauses( const List<Vector<unsigned>> &clauses ) = 0;
+
+    /*
+      The estimated effect of each input variable on the output
+      bounds, as computed alongside the root bounds. Empty if not
+      computed.
+    */
+    virtual void getInputSensitivity( Map<unsigned, double> &sensitivity ) const = 0;
+
     virtual void updateScores() = 0;
 
     /*
@@ -90,6 +126,26 @@ public:
     */
     virtual PiecewiseLinearConstraint *pickSplitPLConstraint() = 0;
 
+    /*
+      Pick the piecewise linear constraint on which to divide the
+      DnC subquery given by the split, according to the strategy.
+      Returns NULL if the split leaves no constraint to divide on.
+      The state of the engine is left unchanged.
+    */
+    virtual PiecewiseLinearConstraint *pickSplitPLConstraintSnC( const PiecewiseLinearCaseSplit &split,
+                                                                 DivideStrategy strategy ) = 0;
+
+    /*
+      Propagate bounds over the DnC subquery given by the split, and
+      report the number of piecewise linear constraints left unfixed
+      and the total width of the output variables' bounds. Returns
+      false if propagation shows the subquery to be infeasible. The
+      state of the engine is left unchanged.
+    */
+    virtual bool estimateSubQueryDifficulty( const PiecewiseLinearCaseSplit &split,
+                                             unsigned &numUnfixedConstraints,
+                                             double &outputBoundGap ) = 0;
+
 };
 
 #endif // __IEngine_h__
@@ -89,6 +89,9 @@ public:
 
     virtual void registerResizeWatcher( ResizeWatcher *watcher ) = 0;
 
+    virtual void setDeferValueNotifications( bool defer ) = 0;
+    virtual void notifyPendingVariableValues() = 0;
+
     virtual void registerCostFunctionManager( ICostFunctionManager *costFunctionManager ) = 0;
 
     virtual ~ITableau() {};
@@ -13,12 +13,15 @@
 
  **/
 
+#include "AbsoluteValueConstraint.h"
 #include "AutoFile.h"
 #include "Debug.h"
 #include "FloatUtils.h"
 #include "InputQuery.h"
 #include "MStringf.h"
 #include "MarabouError.h"
+#include "MaxConstraint.h"
+#include "SignConstraint.h"
 
 #define INPUT_QUERY_LOG( x, ... ) LOG( GlobalConfiguration::INPUT_QUERY_LOGGING, "Preprocessor: %s\n", x )
 
@@ -221,14 +224,22 @@ InputQuery &InputQuery::operator=( const InputQuery &other )
     _outputIndexToVariable = other._outputIndexToVariable;
 
     freeConstraintsIfNeeded();
+    Map<PiecewiseLinearConstraint *, PiecewiseLinearConstraint *> constraintToDuplicate;
     for ( const auto &constraint : other._plConstraints )
-        _plConstraints.append( constraint->duplicateConstraint() );
+    {
+        PiecewiseLinearConstraint *duplicate = constraint->duplicateConstraint();
+        _plConstraints.append( duplicate );
+        constraintToDuplicate[constraint] = duplicate;
+    }
 
     if ( other._networkLevelReasoner )
     {
         if ( !_networkLevelReasoner )
             _networkLevelReasoner = new NLR::NetworkLevelReasoner;
         other._networkLevelReasoner->storeIntoOther( *_networkLevelReasoner );
+
+        // The reasoner should refer to this query's constraints
+        _networkLevelReasoner->updateConstraintsInTopologicalOrder( constraintToDuplicate );
     }
     else
     {
@@ -554,7 +565,10 @@ bool InputQuery::constructNetworkLevelReasoner()
     INPUT_QUERY_LOG( "PP: constructing an NLR... " );
 
     if ( _networkLevelReasoner )
+    {
         delete _networkLevelReasoner;
+        _networkLevelReasoner = NULL;
+    }
     NLR::NetworkLevelReasoner *nlr = new NLR::NetworkLevelReasoner;
 
     Map<unsigned, unsigned> handledVariableToLayer;
@@ -573,7 +587,10 @@ bool InputQuery::constructNetworkLevelReasoner()
     unsigned newLayerIndex = 1;
     // Now, repeatedly attempt to construct addditional layers
     while ( constructWeighedSumLayer( nlr, handledVariableToLayer, newLayerIndex ) ||
-            constructReluLayer( nlr, handledVariableToLayer, newLayerIndex ) )
+            constructReluLayer( nlr, handledVariableToLayer, newLayerIndex ) ||
+            constructAbsoluteValueLayer( nlr, handledVariableToLayer, newLayerIndex ) ||
+            constructSignLayer( nlr, handledVariableToLayer, newLayerIndex ) ||
+            constructMaxLayer( nlr, handledVariableToLayer, newLayerIndex ) )
     {
         ++newLayerIndex;
     }
@@ -582,6 +599,10 @@ bool InputQuery::constructNetworkLevelReasoner()
 
     if ( success )
     {
+        unsigned convolutions = nlr->detectConvolutionalLayers();
+        if ( convolutions > 0 )
+            INPUT_QUERY_LOG( Stringf( "detected %u convolutional layers... ", convolutions ).ascii() );
+
         unsigned count = 0;
         for ( unsigned i = 0; i < nlr->getNumberOfLayers(); ++i )
             count += nlr->getLayer( i )->getSize();
@@ -707,6 +728,28 @@ bool InputQuery::constructWeighedSumLayer( NLR::NetworkLevelReasoner *nlr,
 bool InputQuery::constructReluLayer( NLR::NetworkLevelReasoner *nlr,
                                      Map<unsigned, unsigned> &handledVariableToLayer,
                                      unsigned newLayerIndex )
+{
+    return constructUnaryActivationLayer( nlr, handledVariableToLayer, newLayerIndex, RELU );
+}
+
+bool InputQuery::constructAbsoluteValueLayer( NLR::NetworkLevelReasoner *nlr,
+                                              Map<unsigned, unsigned> &handledVariableToLayer,
+                                              unsigned newLayerIndex )
+{
+    return constructUnaryActivationLayer( nlr, handledVariableToLayer, newLayerIndex, ABSOLUTE_VALUE );
+}
+
+bool InputQuery::constructSignLayer( NLR::NetworkLevelReasoner *nlr,
+                                     Map<unsigned, unsigned> &handledVariableToLayer,
+                                     unsigned newLayerIndex )
+{
+    return constructUnaryActivationLayer( nlr, handledVariableToLayer, newLayerIndex, SIGN );
+}
+
+bool InputQuery::constructUnaryActivationLayer( NLR::NetworkLevelReasoner *nlr,
+                                                Map<unsigned, unsigned> &handledVariableToLayer,
+                                                unsigned newLayerIndex,
+                                                PiecewiseLinearFunctionType type )
 {
     struct NeuronInformation
     {
@@ -726,25 +769,43 @@ bool InputQuery::constructReluLayer( NLR::NetworkLevelReasoner *nlr,
 
     List<NeuronInformation> newNeurons;
 
-    // Look for ReLUs where all b variables have already been handled
+    // Look for constraints of this type where all b variables have already been handled
     const List<PiecewiseLinearConstraint *> &plConstraints =
         getPiecewiseLinearConstraints();
 
     for ( const auto &plc : plConstraints )
     {
-        // Only consider ReLUs
-        if ( plc->getType() != RELU )
+        if ( plc->getType() != type )
             continue;
 
-        const ReluConstraint *relu = (const ReluConstraint *)plc;
+        unsigned b = 0;
+        unsigned f = 0;
+        switch ( type )
+        {
+        case RELU:
+            b = ( (const ReluConstraint *)plc )->getB();
+            f = ( (const ReluConstraint *)plc )->getF();
+            break;
+
+        case ABSOLUTE_VALUE:
+            b = ( (const AbsoluteValueConstraint *)plc )->getB();
+            f = ( (const AbsoluteValueConstraint *)plc )->getF();
+            break;
+
+        case SIGN:
+            b = ( (const SignConstraint *)plc )->getB();
+            f = ( (const SignConstraint *)plc )->getF();
+            break;
+
+        default:
+            throw MarabouError( MarabouError::NETWORK_LEVEL_REASONER_ACTIVATION_NOT_SUPPORTED );
+        }
 
         // Has the b variable been handled?
-        unsigned b = relu->getB();
         if ( !handledVariableToLayer.exists( b ) )
             continue;
 
         // If the f variable has also been handled, ignore this constraint
-        unsigned f = relu->getF();
         if ( handledVariableToLayer.exists( f ) )
             continue;
 
@@ -756,7 +817,13 @@ bool InputQuery::constructReluLayer( NLR::NetworkLevelReasoner *nlr,
     if ( newNeurons.empty() )
         return false;
 
-    nlr->addLayer( newLayerIndex, NLR::Layer::RELU, newNeurons.size() );
+    NLR::Layer::Type layerType = NLR::Layer::RELU;
+    if ( type == ABSOLUTE_VALUE )
+        layerType = NLR::Layer::ABSOLUTE_VALUE;
+    else if ( type == SIGN )
+        layerType = NLR::Layer::SIGN;
+
+    nlr->addLayer( newLayerIndex, layerType, newNeurons.size() );
     for ( const auto &newNeuron : newNeurons )
     {
         handledVariableToLayer[newNeuron._variable] = newLayerIndex;
@@ -780,6 +847,99 @@ bool InputQuery::constructReluLayer( NLR::NetworkLevelReasoner *nlr,
     return true;
 }
 
+bool InputQuery::constructMaxLayer( NLR::NetworkLevelReasoner *nlr,
+                                    Map<unsigned, unsigned> &handledVariableToLayer,
+                                    unsigned newLayerIndex )
+{
+    struct NeuronInformation
+    {
+    public:
+
+        NeuronInformation( unsigned variable, unsigned neuron, const List<unsigned> &sourceVariables )
+            : _variable( variable )
+            , _neuron( neuron )
+            , _sourceVariables( sourceVariables )
+        {
+        }
+
+        unsigned _variable;
+        unsigned _neuron;
+        List<unsigned> _sourceVariables;
+    };
+
+    List<NeuronInformation> newNeurons;
+
+    // Look for Max constraints where all the elements have already been handled
+    const List<PiecewiseLinearConstraint *> &plConstraints =
+        getPiecewiseLinearConstraints();
+
+    for ( const auto &plc : plConstraints )
+    {
+        if ( plc->getType() != MAX )
+            continue;
+
+        const MaxConstraint *max = (const MaxConstraint *)plc;
+
+        // If the f variable has already been handled, ignore this constraint
+        unsigned f = max->getF();
+        if ( handledVariableToLayer.exists( f ) )
+            continue;
+
+        const Set<unsigned> &elements = max->getElements();
+        if ( elements.empty() )
+            continue;
+
+        bool allElementsHandled = true;
+        List<unsigned> sourceVariables;
+        for ( const auto &element : elements )
+        {
+            if ( !handledVariableToLayer.exists( element ) )
+            {
+                allElementsHandled = false;
+                break;
+            }
+
+            sourceVariables.append( element );
+        }
+
+        if ( !allElementsHandled )
+            continue;
+
+        // All elements have been handled, f hasn't. Add f
+        newNeurons.append( NeuronInformation( f, newNeurons.size(), sourceVariables ) );
+    }
+
+    // No neurons found for the new layer
+    if ( newNeurons.empty() )
+        return false;
+
+    nlr->addLayer( newLayerIndex, NLR::Layer::MAX, newNeurons.size() );
+    for ( const auto &newNeuron : newNeurons )
+    {
+        handledVariableToLayer[newNeuron._variable] = newLayerIndex;
+
+        // Add the new neuron
+        nlr->setNeuronVariable( NLR::NeuronIndex( newLayerIndex, newNeuron._neuron ), newNeuron._variable );
+
+        for ( const auto &sourceVariable : newNeuron._sourceVariables )
+        {
+            unsigned sourceLayer = handledVariableToLayer[sourceVariable];
+            unsigned sourceNeuron = nlr->getLayer( sourceLayer )->variableToNeuron( sourceVariable );
+
+            // Mark the layer dependency
+            nlr->addLayerDependency( sourceLayer, newLayerIndex );
+
+            // Mark the activation connection
+            nlr->addActivationSource( sourceLayer,
+                                      sourceNeuron,
+                                      newLayerIndex,
+                                      newNeuron._neuron );
+        }
+    }
+
+    return true;
+}
+
 //
 // Local Variables:
 // compile-command: "make -C ../.. "
@@ -157,6 +157,24 @@ private:
     bool constructReluLayer( NLR::NetworkLevelReasoner *nlr,
                              Map<unsigned, unsigned> &handledVariableToLayer,
                              unsigned newLayerIndex );
+    bool constructAbsoluteValueLayer( NLR::NetworkLevelReasoner *nlr,
+                                      Map<unsigned, unsigned> &handledVariableToLayer,
+                                      unsigned newLayerIndex );
+    bool constructSignLayer( NLR::NetworkLevelReasoner *nlr,
+                             Map<unsigned, unsigned> &handledVariableToLayer,
+                             unsigned newLayerIndex );
+    bool constructMaxLayer( NLR::NetworkLevelReasoner *nlr,
+                            Map<unsigned, unsigned> &handledVariableToLayer,
+                            unsigned newLayerIndex );
+
+    /*
+      Construct a layer of activation functions of the given type, each
+      of which has a single source neuron (f = activation( b )).
+    */
+    bool constructUnaryActivationLayer( NLR::NetworkLevelReasoner *nlr,
+                                        Map<unsigned, unsigned> &handledVariableToLayer,
+                                        unsigned newLayerIndex,
+                                        PiecewiseLinearFunctionType type );
 
 
 public:
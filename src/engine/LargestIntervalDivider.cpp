@@ -59,7 +59,7 @@ void LargestIntervalDivider::createSubQueries( unsigned numNewSubqueries,
         List<InputRegion> newInputRegions;
         for ( const auto &inputRegion : inputRegions )
         {
-            unsigned dimensionToSplit = getLargestInterval( inputRegion );
+            unsigned dimensionToSplit = getDimensionToSplit( inputRegion );
             bisectInputRegion( inputRegion, dimensionToSplit, newInputRegions );
         }
         inputRegions = newInputRegions;
@@ -130,6 +130,12 @@ unsigned LargestIntervalDivider::getLargestInterval( const InputRegion
     return dimensionToSplit;
 }
 
+unsigned LargestIntervalDivider::getDimensionToSplit( const InputRegion
+                                                      &inputRegion )
+{
+    return getLargestInterval( inputRegion );
+}
+
 //
 // Local Variables:
 // compile-command: "make -C ../.. "
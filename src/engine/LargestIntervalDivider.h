@@ -38,7 +38,12 @@ public:
     */
     unsigned getLargestInterval( const InputRegion &inputRegion );
 
-private:
+    /*
+      Returns the variable to bisect next
+    */
+    virtual unsigned getDimensionToSplit( const InputRegion &inputRegion );
+
+protected:
     /*
       All input variables of the network
     */
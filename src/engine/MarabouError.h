@@ -47,6 +47,8 @@ public:
         INVALID_WEIGHTED_SUM_INDEX = 22,
         UNSUCCESSFUL_QUEUE_PUSH = 23,
         NETWORK_LEVEL_REASONER_ACTIVATION_NOT_SUPPORTED = 24,
+        INVALID_CHECKPOINT = 25,
+        DNC_PROCESS_FAILED = 26,
 
         // Error codes for Query Loader
         FILE_DOES_NOT_EXIST = 100,
@@ -115,6 +115,8 @@ void MaxConstraint::notifyLowerBound( unsigned variable, double value )
     if ( _lowerBounds.exists( variable ) && !FloatUtils::gt( value, _lowerBounds[variable] ) )
         return;
 
+    saveStateIfNeeded();
+
     _lowerBounds[variable] = value;
 
     bool maxErased = false;
@@ -168,6 +170,8 @@ void MaxConstraint::notifyUpperBound( unsigned variable, double value )
     if ( _upperBounds.exists( variable ) && !FloatUtils::lt( value, _upperBounds[variable] ) )
         return;
 
+    saveStateIfNeeded();
+
     _upperBounds[variable] = value;
 
     if ( _elements.exists( variable ) && FloatUtils::lt( value, _maxLowerBound ) )
@@ -484,6 +488,16 @@ String MaxConstraint::serializeToString() const
     return output;
 }
 
+unsigned MaxConstraint::getF() const
+{
+    return _f;
+}
+
+const Set<unsigned> &MaxConstraint::getElements() const
+{
+    return _elements;
+}
+
 //
 // Local Variables:
 // compile-command: "make -C ../.. "
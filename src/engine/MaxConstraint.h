@@ -131,6 +131,12 @@ class MaxConstraint : public PiecewiseLinearConstraint
     */
     String serializeToString() const;
 
+    /*
+      Get the f variable and the elements over which the max is taken.
+    */
+    unsigned getF() const;
+    const Set<unsigned> &getElements() const;
+
  private:
     unsigned _f;
     Set<unsigned> _elements;
@@ -0,0 +1,581 @@
+/*********************                                                        */
+/*! \file NativeLPSolver.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#include "CostFunctionManager.h"
+#include "Debug.h"
+#include "Error.h"
+#include "File.h"
+#include "FloatUtils.h"
+#include "GlobalConfiguration.h"
+#include "MStringf.h"
+#include "MarabouError.h"
+#include "NativeLPSolver.h"
+#include "Tableau.h"
+#include "TimeUtils.h"
+
+NativeLPSolver::NativeLPSolver()
+    : _maximize( false )
+    , _timeLimit( GlobalConfiguration::MILPSolverTimeoutValueInSeconds )
+    , _status( UNSOLVED )
+    , _optimalCost( 0 )
+    , _tableau( NULL )
+    , _costFunctionManager( NULL )
+    , _work( NULL )
+{
+}
+
+NativeLPSolver::~NativeLPSolver()
+{
+    freeTableauIfNeeded();
+}
+
+void NativeLPSolver::freeTableauIfNeeded()
+{
+    if ( _costFunctionManager )
+    {
+        delete _costFunctionManager;
+        _costFunctionManager = NULL;
+    }
+
+    if ( _tableau )
+    {
+        delete _tableau;
+        _tableau = NULL;
+    }
+
+    if ( _work )
+    {
+        delete[] _work;
+        _work = NULL;
+    }
+}
+
+void NativeLPSolver::addVariable( String name, double lb, double ub, VariableType type )
+{
+    if ( type != CONTINUOUS )
+        throw MarabouError( MarabouError::FEATURE_NOT_YET_SUPPORTED,
+                            "NativeLPSolver only supports continuous variables" );
+
+    freeTableauIfNeeded();
+
+    _nameToVariable[name] = _variableToName.size();
+    _variableToName.append( name );
+    _lowerBounds.append( lb );
+    _upperBounds.append( ub );
+}
+
+void NativeLPSolver::setLowerBound( String name, double lb )
+{
+    unsigned variable = _nameToVariable.at( name );
+    double previousLb = _lowerBounds[variable];
+    _lowerBounds[variable] = lb;
+
+    if ( !_tableau )
+        return;
+
+    // Tightening keeps the current basis. Loosening might invalidate
+    // the implied bounds of the slack variables, so start over.
+    if ( FloatUtils::gte( lb, previousLb ) )
+        _tableau->tightenLowerBound( variable, lb );
+    else
+        freeTableauIfNeeded();
+}
+
+void NativeLPSolver::setUpperBound( String name, double ub )
+{
+    unsigned variable = _nameToVariable.at( name );
+    double previousUb = _upperBounds[variable];
+    _upperBounds[variable] = ub;
+
+    if ( !_tableau )
+        return;
+
+    if ( FloatUtils::lte( ub, previousUb ) )
+        _tableau->tightenUpperBound( variable, ub );
+    else
+        freeTableauIfNeeded();
+}
+
+void NativeLPSolver::addLeqConstraint( const List<Term> &terms, double scalar )
+{
+    addConstraint( terms, scalar, Equation::LE );
+}
+
+void NativeLPSolver::addGeqConstraint( const List<Term> &terms, double scalar )
+{
+    addConstraint( terms, scalar, Equation::GE );
+}
+
+void NativeLPSolver::addEqConstraint( const List<Term> &terms, double scalar )
+{
+    addConstraint( terms, scalar, Equation::EQ );
+}
+
+void NativeLPSolver::addConstraint( const List<Term> &terms, double scalar, Equation::EquationType type )
+{
+    freeTableauIfNeeded();
+
+    Equation equation( type );
+    for ( const auto &term : terms )
+        equation.addAddend( term._coefficient, _nameToVariable.at( term._variable ) );
+    equation.setScalar( scalar );
+
+    _constraints.append( equation );
+}
+
+void NativeLPSolver::setCost( const List<Term> &terms )
+{
+    setCostFunction( terms, false );
+}
+
+void NativeLPSolver::setObjective( const List<Term> &terms )
+{
+    setCostFunction( terms, true );
+}
+
+void NativeLPSolver::setCostFunction( const List<Term> &terms, bool maximize )
+{
+    _maximize = maximize;
+    _cost.clear();
+
+    for ( const auto &term : terms )
+    {
+        unsigned variable = _nameToVariable.at( term._variable );
+        double coefficient = maximize ? -term._coefficient : term._coefficient;
+
+        if ( _cost.exists( variable ) )
+            _cost[variable] += coefficient;
+        else
+            _cost[variable] = coefficient;
+    }
+}
+
+void NativeLPSolver::setCutoff( double /* cutoff */ )
+{
+}
+
+bool NativeLPSolver::optimal()
+{
+    return _status == OPTIMAL;
+}
+
+bool NativeLPSolver::cutoffOccurred()
+{
+    return false;
+}
+
+bool NativeLPSolver::infeasbile()
+{
+    return _status == INFEASIBLE;
+}
+
+bool NativeLPSolver::timeout()
+{
+    return _status == INCONCLUSIVE;
+}
+
+bool NativeLPSolver::haveFeasibleSolution()
+{
+    return _status == OPTIMAL;
+}
+
+void NativeLPSolver::setTimeLimit( double seconds )
+{
+    _timeLimit = seconds;
+}
+
+void NativeLPSolver::reset()
+{
+    _status = UNSOLVED;
+}
+
+void NativeLPSolver::resetModel()
+{
+    freeTableauIfNeeded();
+
+    _nameToVariable.clear();
+    _variableToName.clear();
+    _lowerBounds.clear();
+    _upperBounds.clear();
+    _constraints.clear();
+    _cost.clear();
+    _maximize = false;
+    _status = UNSOLVED;
+}
+
+void NativeLPSolver::solve()
+{
+    _status = UNSOLVED;
+
+    for ( unsigned i = 0; i < _variableToName.size(); ++i )
+    {
+        if ( !FloatUtils::isFinite( _lowerBounds[i] ) || !FloatUtils::isFinite( _upperBounds[i] ) )
+        {
+            _status = INCONCLUSIVE;
+            return;
+        }
+
+        if ( FloatUtils::gt( _lowerBounds[i], _upperBounds[i] ) )
+        {
+            _status = INFEASIBLE;
+            return;
+        }
+    }
+
+    if ( _constraints.empty() )
+    {
+        solveWithoutConstraints();
+        return;
+    }
+
+    try
+    {
+        if ( !_tableau )
+            buildTableau();
+
+        if ( !_tableau->allBoundsValid() )
+        {
+            _status = INFEASIBLE;
+            return;
+        }
+
+        if ( runSimplex() )
+            storeSolution();
+    }
+    catch ( const Error & )
+    {
+        // Numerical trouble; discard the tableau and give up on this query
+        freeTableauIfNeeded();
+        _status = INCONCLUSIVE;
+    }
+}
+
+void NativeLPSolver::solveWithoutConstraints()
+{
+    _solution.clear();
+    _optimalCost = 0;
+
+    for ( unsigned i = 0; i < _variableToName.size(); ++i )
+    {
+        double cost = _cost.exists( i ) ? _cost[i] : 0;
+        double value = FloatUtils::isPositive( cost ) ? _lowerBounds[i] : _upperBounds[i];
+        if ( FloatUtils::isZero( cost ) )
+            value = _lowerBounds[i];
+
+        _solution.append( value );
+        _optimalCost += cost * value;
+    }
+
+    _status = OPTIMAL;
+}
+
+void NativeLPSolver::buildTableau()
+{
+    unsigned numVariables = _variableToName.size();
+    unsigned m = _constraints.size();
+    unsigned n = numVariables + m;
+
+    _tableau = new Tableau;
+    _tableau->setDimensions( m, n );
+
+    double *constraintMatrix = new double[n * m];
+    std::fill_n( constraintMatrix, n * m, 0.0 );
+
+    // Row i encodes: sum a_j x_j - s_i = 0
+    unsigned row = 0;
+    for ( const auto &constraint : _constraints )
+    {
+        for ( const auto &addend : constraint._addends )
+            constraintMatrix[row * n + addend._variable] += addend._coefficient;
+        constraintMatrix[row * n + numVariables + row] = -1;
+
+        _tableau->setRightHandSide( row, 0 );
+        ++row;
+    }
+
+    _tableau->setConstraintMatrix( constraintMatrix );
+    delete[] constraintMatrix;
+
+    for ( unsigned i = 0; i < numVariables; ++i )
+    {
+        _tableau->setLowerBound( i, _lowerBounds[i] );
+        _tableau->setUpperBound( i, _upperBounds[i] );
+    }
+
+    /*
+      The slack of an equality is fixed to the scalar. For
+      inequalities, the slack is bounded on one side by the scalar, and
+      on the other by the bound implied by the variable bounds.
+    */
+    List<unsigned> initialBasis;
+    row = 0;
+    for ( const auto &constraint : _constraints )
+    {
+        unsigned slack = numVariables + row;
+        double scalar = constraint._scalar;
+
+        double impliedLb = 0;
+        double impliedUb = 0;
+        for ( const auto &addend : constraint._addends )
+        {
+            double coefficient = addend._coefficient;
+            if ( FloatUtils::isPositive( coefficient ) )
+            {
+                impliedLb += coefficient * _lowerBounds[addend._variable];
+                impliedUb += coefficient * _upperBounds[addend._variable];
+            }
+            else
+            {
+                impliedLb += coefficient * _upperBounds[addend._variable];
+                impliedUb += coefficient * _lowerBounds[addend._variable];
+            }
+        }
+
+        switch ( constraint._type )
+        {
+        case Equation::EQ:
+            _tableau->setLowerBound( slack, scalar );
+            _tableau->setUpperBound( slack, scalar );
+            break;
+
+        case Equation::LE:
+            _tableau->setLowerBound( slack, FloatUtils::min( impliedLb, scalar ) );
+            _tableau->setUpperBound( slack, scalar );
+            break;
+
+        case Equation::GE:
+            _tableau->setLowerBound( slack, scalar );
+            _tableau->setUpperBound( slack, FloatUtils::max( impliedUb, scalar ) );
+            break;
+        }
+
+        initialBasis.append( slack );
+        ++row;
+    }
+
+    _tableau->initializeTableau( initialBasis );
+
+    _costFunctionManager = new CostFunctionManager( _tableau );
+    _costFunctionManager->initialize();
+    _tableau->registerCostFunctionManager( _costFunctionManager );
+    _entryStrategy.initialize( *_tableau );
+
+    _work = new double[m];
+}
+
+bool NativeLPSolver::runSimplex()
+{
+    struct timespec start = TimeUtils::sampleMicro();
+    bool timeLimitInUse = FloatUtils::isFinite( _timeLimit );
+    unsigned long long timeLimitInMicro = timeLimitInUse ? _timeLimit * 1000000 : 0;
+    unsigned m = _tableau->getM();
+
+    while ( true )
+    {
+        if ( timeLimitInUse &&
+             TimeUtils::timePassed( start, TimeUtils::sampleMicro() ) > timeLimitInMicro )
+        {
+            _status = INCONCLUSIVE;
+            return false;
+        }
+
+        /*
+          Phase 1: as long as some basic variable is out of bounds,
+          reduce the sum of infeasibilities. Phase 2: minimize the
+          given cost.
+        */
+        _costFunctionManager->computeCoreCostFunction();
+
+        bool feasible = true;
+        for ( unsigned i = 0; i < m; ++i )
+        {
+            if ( _costFunctionManager->getBasicCost( i ) != 0 )
+            {
+                feasible = false;
+                break;
+            }
+        }
+
+        if ( feasible )
+            _costFunctionManager->computeGivenCostFunction( _cost );
+
+        if ( performSimplexStep() )
+            continue;
+
+        /*
+          No entering variable exists. If the basic assignment has
+          drifted, recompute it and try again. Otherwise, we are done.
+        */
+        if ( _tableau->getBasicAssignmentStatus() != ITableau::BASIC_ASSIGNMENT_JUST_COMPUTED )
+        {
+            _tableau->computeAssignment();
+            continue;
+        }
+
+        _status = feasible ? OPTIMAL : INFEASIBLE;
+        return feasible;
+    }
+}
+
+bool NativeLPSolver::performSimplexStep()
+{
+    /*
+      Pick an entering variable and its leaving variable, trying to
+      avoid tiny pivot values, as in Engine::performSimplexStep().
+    */
+    List<unsigned> enteringVariableCandidates;
+    _tableau->getEntryCandidates( enteringVariableCandidates );
+
+    unsigned bestLeaving = 0;
+    double bestChangeRatio = 0.0;
+    Set<unsigned> excludedEnteringVariables;
+    bool haveCandidate = false;
+    unsigned bestEntering = 0;
+    double bestPivotEntry = 0.0;
+    unsigned tries = GlobalConfiguration::MAX_SIMPLEX_PIVOT_SEARCH_ITERATIONS;
+    unsigned m = _tableau->getM();
+
+    while ( tries > 0 )
+    {
+        --tries;
+
+        if ( !_entryStrategy.select( *_tableau,
+                                     enteringVariableCandidates,
+                                     excludedEnteringVariables ) )
+            break;
+
+        haveCandidate = true;
+        excludedEnteringVariables.insert( _tableau->getEnteringVariableIndex() );
+
+        _tableau->computeChangeColumn();
+        _tableau->pickLeavingVariable();
+
+        if ( _tableau->performingFakePivot() )
+        {
+            bestEntering = _tableau->getEnteringVariableIndex();
+            bestLeaving = _tableau->getLeavingVariableIndex();
+            bestChangeRatio = _tableau->getChangeRatio();
+            memcpy( _work, _tableau->getChangeColumn(), sizeof(double) * m );
+            break;
+        }
+
+        unsigned leavingIndex = _tableau->getLeavingVariableIndex();
+        double pivotEntry = FloatUtils::abs( _tableau->getChangeColumn()[leavingIndex] );
+        if ( pivotEntry > bestPivotEntry )
+        {
+            bestEntering = _tableau->getEnteringVariableIndex();
+            bestPivotEntry = pivotEntry;
+            bestLeaving = leavingIndex;
+            bestChangeRatio = _tableau->getChangeRatio();
+            memcpy( _work, _tableau->getChangeColumn(), sizeof(double) * m );
+        }
+
+        if ( bestPivotEntry >= GlobalConfiguration::ACCEPTABLE_SIMPLEX_PIVOT_THRESHOLD )
+            break;
+    }
+
+    if ( !haveCandidate )
+        return false;
+
+    _tableau->setEnteringVariableIndex( bestEntering );
+    _tableau->setLeavingVariableIndex( bestLeaving );
+    _tableau->setChangeColumn( _work );
+    _tableau->setChangeRatio( bestChangeRatio );
+
+    bool fakePivot = _tableau->performingFakePivot();
+
+    if ( !fakePivot &&
+         bestPivotEntry < GlobalConfiguration::ACCEPTABLE_SIMPLEX_PIVOT_THRESHOLD &&
+         !_tableau->basisMatrixAvailable() )
+    {
+        _tableau->refreshBasisFactorization();
+        return true;
+    }
+
+    if ( !fakePivot )
+        _tableau->computePivotRow();
+
+    _tableau->performPivot();
+    return true;
+}
+
+void NativeLPSolver::storeSolution()
+{
+    _solution.clear();
+    for ( unsigned i = 0; i < _variableToName.size(); ++i )
+        _solution.append( _tableau->getValue( i ) );
+
+    _optimalCost = 0;
+    for ( const auto &cost : _cost )
+        _optimalCost += cost.second * _solution[cost.first];
+}
+
+void NativeLPSolver::extractSolution( Map<String, double> &values, double &costOrObjective )
+{
+    values.clear();
+
+    ASSERT( _status == OPTIMAL );
+
+    for ( unsigned i = 0; i < _variableToName.size(); ++i )
+        values[_variableToName[i]] = _solution[i];
+
+    costOrObjective = _maximize ? -_optimalCost : _optimalCost;
+}
+
+double NativeLPSolver::getObjectiveBound()
+{
+    if ( _status == OPTIMAL )
+        return _maximize ? -_optimalCost : _optimalCost;
+
+    return _maximize ? FloatUtils::infinity() : FloatUtils::negativeInfinity();
+}
+
+void NativeLPSolver::dumpModel( String name )
+{
+    File file( name );
+    file.open( File::MODE_WRITE_TRUNCATE );
+
+    file.write( _maximize ? "Maximize\n" : "Minimize\n" );
+    for ( const auto &cost : _cost )
+        file.write( Stringf( " %+.6lf %s", _maximize ? -cost.second : cost.second,
+                             _variableToName[cost.first].ascii() ) );
+
+    file.write( "\nSubject To\n" );
+    for ( const auto &constraint : _constraints )
+    {
+        for ( const auto &addend : constraint._addends )
+            file.write( Stringf( " %+.6lf %s", addend._coefficient,
+                                 _variableToName[addend._variable].ascii() ) );
+
+        const char *sense = constraint._type == Equation::EQ ? "=" :
+            ( constraint._type == Equation::LE ? "<=" : ">=" );
+        file.write( Stringf( " %s %.6lf\n", sense, constraint._scalar ) );
+    }
+
+    file.write( "Bounds\n" );
+    for ( unsigned i = 0; i < _variableToName.size(); ++i )
+        file.write( Stringf( " %.6lf <= %s <= %.6lf\n", _lowerBounds[i],
+                             _variableToName[i].ascii(), _upperBounds[i] ) );
+
+    file.write( "End\n" );
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,157 @@
+/*********************                                                        */
+/*! \file NativeLPSolver.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#ifndef __NativeLPSolver_h__
+#define __NativeLPSolver_h__
+
+#include "DantzigsRule.h"
+#include "Equation.h"
+#include "ILPSolver.h"
+#include "Map.h"
+#include "Vector.h"
+
+class CostFunctionManager;
+class Tableau;
+
+/*
+  An LP solver that uses Marabou's own tableau and simplex
+  implementation, for when Gurobi is not available. Only continuous
+  variables with finite bounds are supported.
+
+  Each constraint sum a_i x_i <op> b is encoded as an equation
+  sum a_i x_i - s = 0, where the bounds of the fresh variable s encode
+  the constraint. The slack variables form the initial basis. Once
+  built, the tableau is kept between calls to solve(): changing the
+  objective or tightening a variable bound warm-starts from the
+  previous basis. Adding variables or constraints, or loosening a
+  bound, discards the tableau.
+
+  Solving is done in two phases. The first phase uses the core cost
+  function to find a feasible assignment, exactly as the engine does,
+  and the second phase minimizes the given cost over the feasible
+  region. If the time limit expires or a numerical problem occurs,
+  timeout() becomes true and getObjectiveBound() returns the trivial
+  bound (-infinity when minimizing, +infinity when maximizing).
+  Cutoffs are not supported, and are ignored.
+*/
+class NativeLPSolver : public ILPSolver
+{
+public:
+    NativeLPSolver();
+    ~NativeLPSolver();
+
+    void addVariable( String name, double lb, double ub, VariableType type = CONTINUOUS );
+
+    void setLowerBound( String name, double lb );
+    void setUpperBound( String name, double ub );
+
+    void addLeqConstraint( const List<Term> &terms, double scalar );
+    void addGeqConstraint( const List<Term> &terms, double scalar );
+    void addEqConstraint( const List<Term> &terms, double scalar );
+
+    void setCost( const List<Term> &terms );
+    void setObjective( const List<Term> &terms );
+
+    void setCutoff( double cutoff );
+
+    bool optimal();
+    bool cutoffOccurred();
+    bool infeasbile();
+    bool timeout();
+    bool haveFeasibleSolution();
+
+    void setTimeLimit( double seconds );
+
+    void solve();
+    void extractSolution( Map<String, double> &values, double &costOrObjective );
+    double getObjectiveBound();
+
+    void reset();
+    void resetModel();
+
+    void dumpModel( String name );
+
+private:
+    enum Status {
+        UNSOLVED = 0,
+        OPTIMAL = 1,
+        INFEASIBLE = 2,
+        // The time limit expired, or the solver got stuck
+        INCONCLUSIVE = 3,
+    };
+
+    /*
+      The model
+    */
+    Map<String, unsigned> _nameToVariable;
+    Vector<String> _variableToName;
+    Vector<double> _lowerBounds;
+    Vector<double> _upperBounds;
+    List<Equation> _constraints;
+
+    /*
+      The cost function to minimize. When maximizing, the negated
+      objective is minimized.
+    */
+    Map<unsigned, double> _cost;
+    bool _maximize;
+
+    double _timeLimit;
+
+    Status _status;
+    double _optimalCost;
+    Vector<double> _solution;
+
+    /*
+      The tableau in which the model is encoded, and the simplex
+      machinery operating on it.
+    */
+    Tableau *_tableau;
+    CostFunctionManager *_costFunctionManager;
+    DantzigsRule _entryStrategy;
+    double *_work;
+
+    void setCostFunction( const List<Term> &terms, bool maximize );
+    void addConstraint( const List<Term> &terms, double scalar, Equation::EquationType type );
+
+    void buildTableau();
+    bool runSimplex();
+
+    /*
+      Perform a single simplex step using the current cost function.
+      Return false if no entering variable could be found.
+    */
+    bool performSimplexStep();
+
+    /*
+      Solve a model without constraints directly, by setting every
+      variable to its cheaper bound.
+    */
+    void solveWithoutConstraints();
+
+    void storeSolution();
+
+    void freeTableauIfNeeded();
+};
+
+#endif // __NativeLPSolver_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
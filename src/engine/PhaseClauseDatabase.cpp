@@ -0,0 +1,289 @@
+/*********************                                                        */
+/*! \file PhaseClauseDatabase.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#include "Debug.h"
+#include "PhaseClauseDatabase.h"
+
+const unsigned PhaseClauseDatabase::NO_LITERAL = 0xFFFFFFFF;
+
+unsigned PhaseClauseDatabase::literal( unsigned variable, bool active )
+{
+    return 2 * variable + ( active ? 0 : 1 );
+}
+
+unsigned PhaseClauseDatabase::getVariable( unsigned literal )
+{
+    return literal >> 1;
+}
+
+bool PhaseClauseDatabase::isActive( unsigned literal )
+{
+    return !( literal & 1 );
+}
+
+unsigned PhaseClauseDatabase::negate( unsigned literal )
+{
+    return literal ^ 1;
+}
+
+PhaseClauseDatabase::PhaseClauseDatabase()
+{
+}
+
+void PhaseClauseDatabase::addClause( const Vector<unsigned> &clause )
+{
+    ASSERT( !clause.empty() );
+
+    if ( clause.size() == 1 )
+    {
+        _unitClauses.append( clause.get( 0 ) );
+        return;
+    }
+
+    Vector<unsigned> stored = clause;
+
+    // Move the two literals that would be the last to become false to
+    // the front: unassigned and true literals first, then the false
+    // ones by decreasing level
+    for ( unsigned i = 0; i < 2; ++i )
+    {
+        unsigned best = i;
+        for ( unsigned j = i + 1; j < stored.size(); ++j )
+        {
+            if ( !isFalse( stored[best] ) )
+                break;
+
+            if ( !isFalse( stored[j] ) ||
+                 getLevel( getVariable( stored[j] ) ) > getLevel( getVariable( stored[best] ) ) )
+                best = j;
+        }
+
+        unsigned temp = stored[i];
+        stored[i] = stored[best];
+        stored[best] = temp;
+    }
+
+    unsigned id = _clauses.size();
+    _clauses.append( stored );
+    _watches[stored[0]].append( id );
+    _watches[stored[1]].append( id );
+    _newClauses.append( id );
+}
+
+unsigned PhaseClauseDatabase::getNumClauses() const
+{
+    return _clauses.size() + _unitClauses.size();
+}
+
+void PhaseClauseDatabase::assign( unsigned literal, unsigned level )
+{
+    unsigned variable = getVariable( literal );
+    if ( _assignment.exists( variable ) )
+        return;
+
+    Assignment assignment;
+    assignment._literal = literal;
+    assignment._level = level;
+    _assignment[variable] = assignment;
+
+    _trail.append( literal );
+    _propagationQueue.append( literal );
+}
+
+void PhaseClauseDatabase::backtrack( unsigned level )
+{
+    while ( !_trail.empty() )
+    {
+        unsigned variable = getVariable( _trail.back() );
+        if ( _assignment[variable]._level <= level )
+            break;
+
+        _assignment.erase( variable );
+        _trail.popBack();
+    }
+}
+
+bool PhaseClauseDatabase::isTrue( unsigned literal ) const
+{
+    unsigned variable = getVariable( literal );
+    return _assignment.exists( variable ) && _assignment.at( variable )._literal == literal;
+}
+
+bool PhaseClauseDatabase::isFalse( unsigned literal ) const
+{
+    unsigned variable = getVariable( literal );
+    return _assignment.exists( variable ) && _assignment.at( variable )._literal != literal;
+}
+
+unsigned PhaseClauseDatabase::getLevel( unsigned variable ) const
+{
+    return _assignment.at( variable )._level;
+}
+
+bool PhaseClauseDatabase::propagate( unsigned level, List<unsigned> &implied, unsigned &conflictLevel )
+{
+    // Unit clauses have no watches, and are checked every time
+    for ( const auto &unit : _unitClauses )
+    {
+        if ( isFalse( unit ) )
+        {
+            conflictLevel = getLevel( getVariable( unit ) );
+            return false;
+        }
+
+        if ( !isTrue( unit ) )
+        {
+            assign( unit, level );
+            implied.append( unit );
+        }
+    }
+
+    auto newClause = _newClauses.begin();
+    while ( newClause != _newClauses.end() )
+    {
+        const Vector<unsigned> &clause = _clauses[*newClause];
+
+        bool satisfied = false;
+        unsigned numUnassigned = 0;
+        unsigned unassigned = NO_LITERAL;
+        for ( unsigned i = 0; i < clause.size(); ++i )
+        {
+            if ( isTrue( clause.get( i ) ) )
+                satisfied = true;
+            else if ( !isFalse( clause.get( i ) ) )
+            {
+                ++numUnassigned;
+                unassigned = clause.get( i );
+            }
+        }
+
+        if ( !satisfied && numUnassigned == 0 )
+        {
+            // Checked again after the search backtracks
+            conflictLevel = getFalsifiedLevel( clause );
+            return false;
+        }
+
+        if ( !satisfied && numUnassigned == 1 )
+        {
+            assign( unassigned, level );
+            implied.append( unassigned );
+        }
+
+        newClause = _newClauses.erase( newClause );
+    }
+
+    while ( !_propagationQueue.empty() )
+    {
+        unsigned trueLiteral = _propagationQueue.front();
+        _propagationQueue.erase( _propagationQueue.begin() );
+
+        // The assignment may have been undone since it was queued
+        if ( !isTrue( trueLiteral ) )
+            continue;
+
+        unsigned falseLiteral = negate( trueLiteral );
+        if ( !_watches.exists( falseLiteral ) )
+            continue;
+
+        List<unsigned> &watching = _watches[falseLiteral];
+        auto it = watching.begin();
+        while ( it != watching.end() )
+        {
+            Vector<unsigned> &clause = _clauses[*it];
+
+            // Keep the false literal second
+            if ( clause[0] == falseLiteral )
+            {
+                clause[0] = clause[1];
+                clause[1] = falseLiteral;
+            }
+
+            if ( isTrue( clause[0] ) )
+            {
+                ++it;
+                continue;
+            }
+
+            // Look for another literal to watch
+            bool foundWatch = false;
+            for ( unsigned i = 2; i < clause.size(); ++i )
+            {
+                if ( !isFalse( clause[i] ) )
+                {
+                    clause[1] = clause[i];
+                    clause[i] = falseLiteral;
+                    _watches[clause[1]].append( *it );
+                    foundWatch = true;
+                    break;
+                }
+            }
+
+            if ( foundWatch )
+            {
+                it = watching.erase( it );
+                continue;
+            }
+
+            if ( isFalse( clause[0] ) )
+            {
+                // The clauses after this one still need to see the
+                // assignment
+                _propagationQueue.appendHead( trueLiteral );
+                conflictLevel = getFalsifiedLevel( clause );
+                return false;
+            }
+
+            // All other literals are false: the first one is implied
+            assign( clause[0], level );
+            implied.append( clause[0] );
+            ++it;
+        }
+    }
+
+    return true;
+}
+
+void PhaseClauseDatabase::clear()
+{
+    _clauses.clear();
+    _watches.clear();
+    _unitClauses.clear();
+    _newClauses.clear();
+    _assignment.clear();
+    _trail.clear();
+    _propagationQueue.clear();
+}
+
+unsigned PhaseClauseDatabase::getFalsifiedLevel( const Vector<unsigned> &clause ) const
+{
+    unsigned level = 0;
+    for ( unsigned i = 0; i < clause.size(); ++i )
+    {
+        unsigned literalLevel = getLevel( getVariable( clause.get( i ) ) );
+        if ( literalLevel > level )
+            level = literalLevel;
+    }
+
+    return level;
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
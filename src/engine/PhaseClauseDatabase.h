@@ -0,0 +1,134 @@
+/*********************                                                        */
+/*! \file PhaseClauseDatabase.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#ifndef __PhaseClauseDatabase_h__
+#define __PhaseClauseDatabase_h__
+
+#include "HashMap.h"
+#include "List.h"
+#include "Vector.h"
+
+/*
+  A database of clauses over the phases of ReLU constraints, learned
+  from conflicts during the search.
+
+  A phase literal states that the ReLU whose input variable is b is
+  active (b >= 0) or inactive (b <= 0). Identifying a ReLU by its
+  input variable keeps the literals meaningful across engines that
+  solve the same query. A clause states that at least one of its
+  literals holds.
+
+  The database keeps the phases that are currently fixed, together
+  with the decision level at which they were fixed, and propagates
+  them through the clauses using two watched literals per clause.
+*/
+class PhaseClauseDatabase
+{
+public:
+    /*
+      A literal is encoded as 2 * b + ( active ? 0 : 1 ), so that its
+      negation is obtained by flipping the lowest bit.
+    */
+    static const unsigned NO_LITERAL;
+
+    static unsigned literal( unsigned variable, bool active );
+    static unsigned getVariable( unsigned literal );
+    static bool isActive( unsigned literal );
+    static unsigned negate( unsigned literal );
+
+    PhaseClauseDatabase();
+
+    /*
+      Add a learned clause. All the literals of a clause learned from
+      a conflict are false when it is added, and the clause is watched
+      on the literals that were falsified last, so that it becomes unit
+      once the search backtracks past the highest of their levels.
+    */
+    void addClause( const Vector<unsigned> &clause );
+    unsigned getNumClauses() const;
+
+    /*
+      Record that a literal holds from the given decision level on. A
+      variable that is already assigned keeps its first assignment.
+    */
+    void assign( unsigned literal, unsigned level );
+
+    /*
+      Undo all the assignments made above the given level.
+    */
+    void backtrack( unsigned level );
+
+    bool isTrue( unsigned literal ) const;
+    bool isFalse( unsigned literal ) const;
+    unsigned getLevel( unsigned variable ) const;
+
+    /*
+      Propagate the assignments through the clauses. Literals that are
+      implied by a clause whose other literals are all false are
+      assigned at the given level and appended to implied. Returns
+      false if some clause has all of its literals false; the highest
+      level at which one of them was falsified is then stored in
+      conflictLevel.
+    */
+    bool propagate( unsigned level, List<unsigned> &implied, unsigned &conflictLevel );
+
+    /*
+      Drop all the clauses and assignments.
+    */
+    void clear();
+
+private:
+    struct Assignment
+    {
+        unsigned _literal;
+        unsigned _level;
+    };
+
+    /*
+      The clauses, and for every literal the clauses watching it. The
+      watched literals of a clause are its first two; clauses with a
+      single literal are kept separately.
+    */
+    Vector<Vector<unsigned> > _clauses;
+    HashMap<unsigned, List<unsigned> > _watches;
+    List<unsigned> _unitClauses;
+
+    /*
+      Clauses added since the last propagation. A learned clause only
+      becomes unit when the search backtracks, which its watches do not
+      see, so it is checked in full once.
+    */
+    List<unsigned> _newClauses;
+
+    /*
+      The current assignment, the order in which it was made, and the
+      literals that still need to be propagated.
+    */
+    HashMap<unsigned, Assignment> _assignment;
+    List<unsigned> _trail;
+    List<unsigned> _propagationQueue;
+
+    unsigned getFalsifiedLevel( const Vector<unsigned> &clause ) const;
+};
+
+#endif // __PhaseClauseDatabase_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
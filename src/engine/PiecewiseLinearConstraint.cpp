@@ -34,6 +34,58 @@ void PiecewiseLinearConstraint::registerConstraintBoundTightener( IConstraintBou
     _constraintBoundTightener = tightener;
 }
 
+void PiecewiseLinearConstraint::registerConstraintStateTrail( ConstraintStateTrail *trail )
+{
+    _trailBookkeeping._trail = trail;
+}
+
+void PiecewiseLinearConstraint::saveStateIfNeeded()
+{
+    ConstraintStateTrail *trail = _trailBookkeeping._trail;
+    if ( !trail || _trailBookkeeping._checkpoint == trail->getCheckpoint() )
+        return;
+
+    _trailBookkeeping._savedStates.push( duplicateConstraint() );
+    _trailBookkeeping._checkpoint = trail->getCheckpoint();
+    trail->record( this );
+}
+
+void PiecewiseLinearConstraint::undoLastChange()
+{
+    PiecewiseLinearConstraint *state = _trailBookkeeping._savedStates.top();
+    _trailBookkeeping._savedStates.pop();
+
+    restoreState( state );
+    delete state;
+}
+
+PiecewiseLinearConstraint::TrailBookkeeping::TrailBookkeeping()
+    : _trail( NULL )
+    , _checkpoint( 0 )
+{
+}
+
+PiecewiseLinearConstraint::TrailBookkeeping::TrailBookkeeping( const TrailBookkeeping &/* other */ )
+    : _trail( NULL )
+    , _checkpoint( 0 )
+{
+}
+
+PiecewiseLinearConstraint::TrailBookkeeping &
+PiecewiseLinearConstraint::TrailBookkeeping::operator=( const TrailBookkeeping &/* other */ )
+{
+    return *this;
+}
+
+PiecewiseLinearConstraint::TrailBookkeeping::~TrailBookkeeping()
+{
+    while ( !_savedStates.empty() )
+    {
+        delete _savedStates.top();
+        _savedStates.pop();
+    }
+}
+
 //
 // Local Variables:
 // compile-command: "make -C ../.. "
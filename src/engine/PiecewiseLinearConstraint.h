@@ -16,6 +16,7 @@
 #ifndef __PiecewiseLinearConstraint_h__
 #define __PiecewiseLinearConstraint_h__
 
+#include "ConstraintStateTrail.h"
 #include "FloatUtils.h"
 #include "ITableau.h"
 #include "List.h"
@@ -23,6 +24,7 @@
 #include "PiecewiseLinearCaseSplit.h"
 #include "PiecewiseLinearFunctionType.h"
 #include "Queue.h"
+#include "Stack.h"
 #include "Tightening.h"
 
 class Equation;
@@ -31,7 +33,9 @@ class ITableau;
 class InputQuery;
 class String;
 
-class PiecewiseLinearConstraint : public ITableau::VariableWatcher
+class PiecewiseLinearConstraint
+    : public ITableau::VariableWatcher
+    , public ConstraintStateTrail::Trailable
 {
 public:
     /*
@@ -101,6 +105,9 @@ public:
     */
     virtual void setActiveConstraint( bool active )
     {
+        if ( active != _constraintActive )
+            saveStateIfNeeded();
+
         _constraintActive = active;
     }
 
@@ -205,6 +212,15 @@ public:
     */
     void registerConstraintBoundTightener( IConstraintBoundTightener *tightener );
 
+    /*
+      Register a trail. If a trail is registered, the constraint saves
+      its state on the trail before the state changes for the first
+      time after a checkpoint, and restores the saved state when the
+      change is undone. Changes to the assignment are not recorded.
+    */
+    void registerConstraintStateTrail( ConstraintStateTrail *trail );
+    void undoLastChange();
+
     /*
       Return true if and only if this piecewise linear constraint supports
       symbolic bound tightening.
@@ -245,12 +261,12 @@ public:
     /*
       Retrieve the current lower and upper bounds
     */
-    double getLowerBound( unsigned i ) const
+    virtual double getLowerBound( unsigned i ) const
     {
         return _lowerBounds[i];
     }
 
-    double getUpperBound( unsigned i ) const
+    virtual double getUpperBound( unsigned i ) const
     {
         return _upperBounds[i];
     }
@@ -274,6 +290,35 @@ protected:
       Statistics collection
     */
     Statistics *_statistics;
+
+    /*
+      Save the state of the constraint on the registered trail, unless
+      it has already been saved since the last checkpoint. Called
+      before any change to the state other than the assignment.
+    */
+    void saveStateIfNeeded();
+
+private:
+    /*
+      The registered trail, the checkpoint at which the state was last
+      saved, and the saved states. This bookkeeping is not part of the
+      constraint's state: it is not copied into duplicates of the
+      constraint, and is left as is when a state is restored.
+    */
+    class TrailBookkeeping
+    {
+    public:
+        TrailBookkeeping();
+        TrailBookkeeping( const TrailBookkeeping &other );
+        TrailBookkeeping &operator=( const TrailBookkeeping &other );
+        ~TrailBookkeeping();
+
+        ConstraintStateTrail *_trail;
+        unsigned _checkpoint;
+        Stack<PiecewiseLinearConstraint *> _savedStates;
+    };
+
+    TrailBookkeeping _trailBookkeeping;
 };
 
 #endif // __PiecewiseLinearConstraint_h__
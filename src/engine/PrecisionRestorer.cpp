@@ -20,7 +20,7 @@
 #include "MarabouError.h"
 #include "SmtCore.h"
 
-void PrecisionRestorer::storeInitialEngineState( const IEngine &engine )
+void PrecisionRestorer::storeInitialEngineState( IEngine &engine )
 {
     engine.storeState( _initialEngineState, true );
 }
@@ -50,8 +50,10 @@ void PrecisionRestorer::restorePrecision( IEngine &engine,
         List<PiecewiseLinearCaseSplit> targetSplits;
         smtCore.allSplitsSoFar( targetSplits );
 
-        // Restore engine and tableau to their original form
-        engine.restoreState( _initialEngineState );
+        // Restore engine and tableau to their original form. The PL
+        // constraints are already in their target state, which the
+        // states stored by the SMT core build on, and are left as is
+        engine.restoreState( _initialEngineState, false );
 
         // Re-add all splits, which will restore variables and equations
         for ( const auto &split : targetSplits )
@@ -113,13 +115,6 @@ void PrecisionRestorer::restorePrecision( IEngine &engine,
             tableau.tightenUpperBound( i, upperBounds[i] );
         }
 
-        // Restore constraint status
-        for ( const auto &pair : targetEngineState._plConstraintToState )
-            pair.first->setActiveConstraint( pair.second->isActive() );
-
-        engine.setNumPlConstraintsDisabledByValidSplits
-            ( targetEngineState._numPlConstraintsDisabledByValidSplits );
-
         DEBUG({
                 // Same dimensions
                 ASSERT( GlobalConfiguration::USE_COLUMN_MERGING_EQUATIONS || tableau.getN() == targetN );
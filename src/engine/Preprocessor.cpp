@@ -20,6 +20,7 @@
 #include "MStringf.h"
 #include "Map.h"
 #include "Preprocessor.h"
+#include "ReluConstraint.h"
 #include "MarabouError.h"
 #include "Statistics.h"
 #include "Tightening.h"
@@ -56,6 +57,15 @@ InputQuery Preprocessor::preprocess( const InputQuery &query, bool attemptVariab
     for ( const auto &var : _preprocessed.getOutputVariables() )
         _inputOutputVariables.insert( var );
 
+    /*
+      If a network was detected, use it to fix and fold ReLUs before
+      the auxiliary equations are added
+    */
+    if ( attemptVariableElimination &&
+         GlobalConfiguration::PREPROCESSOR_SIMPLIFY_NETWORK &&
+         _preprocessed._networkLevelReasoner )
+        simplifyNetwork();
+
     /*
       Initial work: if needed, have the PL constraints add their additional
       equations to the pool.
@@ -419,37 +429,331 @@ bool Preprocessor::processConstraints()
         constraint->getEntailedTightenings( tightenings );
 
         for ( const auto &tightening : tightenings )
-		{
-			if ( ( tightening._type == Tightening::LB ) &&
-                 ( FloatUtils::gt( tightening._value, _preprocessed.getLowerBound( tightening._variable ) ) ) )
+            tighterBoundFound = tightenBound( tightening ) || tighterBoundFound;
+	}
+
+    return tighterBoundFound;
+}
+
+bool Preprocessor::tightenBound( const Tightening &tightening )
+{
+    bool tighterBoundFound = false;
+
+    if ( ( tightening._type == Tightening::LB ) &&
+         ( FloatUtils::gt( tightening._value, _preprocessed.getLowerBound( tightening._variable ) ) ) )
+    {
+        tighterBoundFound = true;
+        _preprocessed.setLowerBound( tightening._variable, tightening._value );
+    }
+
+    else if ( ( tightening._type == Tightening::UB ) &&
+              ( FloatUtils::lt( tightening._value, _preprocessed.getUpperBound( tightening._variable ) ) ) )
+    {
+        tighterBoundFound = true;
+        _preprocessed.setUpperBound( tightening._variable, tightening._value );
+    }
+
+    if ( FloatUtils::areEqual( _preprocessed.getLowerBound( tightening._variable ),
+                               _preprocessed.getUpperBound( tightening._variable ),
+                               GlobalConfiguration::PREPROCESSOR_ALMOST_FIXED_THRESHOLD ) )
+        _preprocessed.setUpperBound( tightening._variable,
+                                     _preprocessed.getLowerBound( tightening._variable ) );
+
+    if ( FloatUtils::gt( _preprocessed.getLowerBound( tightening._variable ),
+                         _preprocessed.getUpperBound( tightening._variable ),
+                         GlobalConfiguration::PREPROCESSOR_ALMOST_FIXED_THRESHOLD ) )
+    {
+        throw InfeasibleQueryException();
+    }
+
+    return tighterBoundFound;
+}
+
+void Preprocessor::simplifyNetwork()
+{
+    unsigned numberOfVariables = _preprocessed.getNumberOfVariables();
+    for ( unsigned i = 0; i < numberOfVariables; ++i )
+    {
+        _requiredLowerBounds[i] = _preprocessed.getLowerBound( i );
+        _requiredUpperBounds[i] = _preprocessed.getUpperBound( i );
+    }
+
+    // Symbolic bounds are only meaningful if the input is bounded
+    bool inputBounded = true;
+    for ( const auto &variable : _preprocessed.getInputVariables() )
+    {
+        if ( !FloatUtils::isFinite( _preprocessed.getLowerBound( variable ) ) ||
+             !FloatUtils::isFinite( _preprocessed.getUpperBound( variable ) ) )
+            inputBounded = false;
+    }
+
+    bool continueTightening = true;
+    while ( continueTightening )
+    {
+        continueTightening = processEquations();
+        continueTightening = processConstraints() || continueTightening;
+        if ( inputBounded )
+            continueTightening = processNetwork() || continueTightening;
+
+        if ( _statistics )
+            _statistics->ppIncNumTighteningIterations();
+    }
+
+    unsigned numberOfConstraints = _preprocessed.getPiecewiseLinearConstraints().size();
+    eliminateFixedRelus();
+
+    bool networkChanged = ( numberOfConstraints != _preprocessed.getPiecewiseLinearConstraints().size() );
+    networkChanged = processIdenticalVariables() || networkChanged;
+    networkChanged = foldWeightedSums() || networkChanged;
+
+    if ( networkChanged )
+        _preprocessed.constructNetworkLevelReasoner();
+}
+
+bool Preprocessor::processNetwork()
+{
+    NLR::NetworkLevelReasoner *nlr = _preprocessed._networkLevelReasoner;
+
+    nlr->obtainCurrentBounds( _preprocessed );
+    nlr->symbolicBoundPropagation();
+
+    List<Tightening> tightenings;
+    nlr->getConstraintTightenings( tightenings );
+
+    bool tighterBoundFound = false;
+    for ( const auto &tightening : tightenings )
+        tighterBoundFound = tightenBound( tightening ) || tighterBoundFound;
+
+    return tighterBoundFound;
+}
+
+void Preprocessor::eliminateFixedRelus()
+{
+    List<PiecewiseLinearConstraint *> &constraints( _preprocessed.getPiecewiseLinearConstraints() );
+    List<PiecewiseLinearConstraint *>::iterator constraint = constraints.begin();
+    while ( constraint != constraints.end() )
+    {
+        if ( (*constraint)->getType() != RELU )
+        {
+            ++constraint;
+            continue;
+        }
+
+        unsigned b = ( (ReluConstraint *)*constraint )->getB();
+        unsigned f = ( (ReluConstraint *)*constraint )->getF();
+
+        if ( !FloatUtils::isNegative( _preprocessed.getLowerBound( b ) ) )
+        {
+            // Active: f = b, and b must stay non-negative
+            Equation equation( Equation::EQ );
+            equation.addAddend( 1, f );
+            equation.addAddend( -1, b );
+            equation.setScalar( 0 );
+            _preprocessed.addEquation( equation );
+
+            _requiredLowerBounds[b] = FloatUtils::max( _requiredLowerBounds[b], 0 );
+        }
+        else if ( !FloatUtils::isPositive( _preprocessed.getUpperBound( b ) ) )
+        {
+            // Inactive: f = 0, and b must stay non-positive
+            _preprocessed.setLowerBound( f, 0 );
+            _preprocessed.setUpperBound( f, 0 );
+
+            _requiredLowerBounds[f] = 0;
+            _requiredUpperBounds[f] = 0;
+            _requiredUpperBounds[b] = FloatUtils::min( _requiredUpperBounds[b], 0 );
+        }
+        else
+        {
+            ++constraint;
+            continue;
+        }
+
+        if ( _statistics )
+            _statistics->ppIncNumConstraintsRemoved();
+
+        delete *constraint;
+        *constraint = NULL;
+        constraint = constraints.erase( constraint );
+    }
+}
+
+bool Preprocessor::foldWeightedSums()
+{
+    Set<unsigned> constrainedVariables;
+    for ( const auto &constraint : _preprocessed.getPiecewiseLinearConstraints() )
+    {
+        for ( const auto &variable : constraint->getParticipatingVariables() )
+            constrainedVariables.insert( variable );
+    }
+
+    // The equations in which each variable appears
+    List<Equation> &equations( _preprocessed.getEquations() );
+    Map<unsigned, List<Equation *>> occurrences;
+    for ( auto &equation : equations )
+    {
+        for ( const auto &addend : equation._addends )
+            occurrences[addend._variable].append( &equation );
+    }
+
+    Set<Equation *> removedEquations;
+    unsigned numberOfVariables = _preprocessed.getNumberOfVariables();
+    for ( unsigned variable = 0; variable < numberOfVariables; ++variable )
+    {
+        if ( _inputOutputVariables.exists( variable ) ||
+             constrainedVariables.exists( variable ) ||
+             !occurrences.exists( variable ) ||
+             occurrences[variable].empty() )
+            continue;
+
+        double requiredLb;
+        double requiredUb;
+        getRequiredBounds( variable, requiredLb, requiredUb );
+
+        /*
+          Look for an equation that defines the variable, such that the
+          bounds it implies for the variable satisfy the required
+          bounds. If the variable appears in other equations too, the
+          definition is substituted into them, which is only done if
+          it is small enough.
+        */
+        Equation *definition = NULL;
+        for ( const auto &equation : occurrences[variable] )
+        {
+            if ( occurrences[variable].size() > 1 &&
+                 equation->_addends.size() > GlobalConfiguration::PREPROCESSOR_SIMPLIFY_NETWORK_MAX_FAN_IN + 1 )
+                continue;
+
+            double lb;
+            double ub;
+            computeImpliedBounds( *equation, variable, lb, ub );
+
+            if ( FloatUtils::gte( lb, requiredLb ) && FloatUtils::lte( ub, requiredUb ) )
             {
-                tighterBoundFound = true;
-                _preprocessed.setLowerBound( tightening._variable, tightening._value );
+                definition = equation;
+                break;
             }
+        }
 
-            else if ( ( tightening._type == Tightening::UB ) &&
-                      ( FloatUtils::lt( tightening._value, _preprocessed.getUpperBound( tightening._variable ) ) ) )
+        if ( !definition )
+            continue;
+
+        double definitionCoefficient = definition->getCoefficient( variable );
+        List<Equation *> users = occurrences[variable];
+        for ( const auto &equation : users )
+        {
+            if ( equation == definition )
+                continue;
+
+            // equation += factor * definition, eliminating the variable
+            double factor = -equation->getCoefficient( variable ) / definitionCoefficient;
+
+            Map<unsigned, double> coefficients;
+            for ( const auto &addend : equation->_addends )
+                coefficients[addend._variable] += addend._coefficient;
+            for ( const auto &addend : definition->_addends )
+                coefficients[addend._variable] += factor * addend._coefficient;
+
+            for ( const auto &addend : equation->_addends )
+                occurrences[addend._variable].erase( equation );
+
+            equation->_addends.clear();
+            equation->_scalar += factor * definition->_scalar;
+            for ( const auto &coefficient : coefficients )
             {
-                tighterBoundFound = true;
-                _preprocessed.setUpperBound( tightening._variable, tightening._value );
-            }
+                if ( coefficient.first == variable || FloatUtils::isZero( coefficient.second ) )
+                    continue;
 
-            if ( FloatUtils::areEqual( _preprocessed.getLowerBound( tightening._variable ),
-                                       _preprocessed.getUpperBound( tightening._variable ),
-                                       GlobalConfiguration::PREPROCESSOR_ALMOST_FIXED_THRESHOLD ) )
-                _preprocessed.setUpperBound( tightening._variable,
-                                             _preprocessed.getLowerBound( tightening._variable ) );
+                equation->addAddend( coefficient.second, coefficient.first );
+                occurrences[coefficient.first].append( equation );
+            }
 
-            if ( FloatUtils::gt( _preprocessed.getLowerBound( tightening._variable ),
-                                 _preprocessed.getUpperBound( tightening._variable ),
-                                 GlobalConfiguration::PREPROCESSOR_ALMOST_FIXED_THRESHOLD ) )
+            if ( equation->_addends.empty() )
             {
-                throw InfeasibleQueryException();
+                if ( !FloatUtils::isZero( equation->_scalar ) )
+                    throw InfeasibleQueryException();
+
+                removedEquations.insert( equation );
             }
-		}
-	}
+        }
 
-    return tighterBoundFound;
+        // The variable now only appears in its definition, which is implied
+        for ( const auto &addend : definition->_addends )
+            occurrences[addend._variable].erase( definition );
+        removedEquations.insert( definition );
+    }
+
+    if ( removedEquations.empty() )
+        return false;
+
+    List<Equation>::iterator equation = equations.begin();
+    while ( equation != equations.end() )
+    {
+        if ( removedEquations.exists( &( *equation ) ) )
+        {
+            if ( _statistics )
+                _statistics->ppIncNumEquationsRemoved();
+
+            equation = equations.erase( equation );
+        }
+        else
+            ++equation;
+    }
+
+    return true;
+}
+
+void Preprocessor::computeImpliedBounds( const Equation &equation,
+                                         unsigned variable,
+                                         double &lb,
+                                         double &ub ) const
+{
+    // variable = ( scalar - sum of the other addends ) / coefficient
+    double coefficient = equation.getCoefficient( variable );
+    ASSERT( !FloatUtils::isZero( coefficient ) );
+
+    lb = equation._scalar / coefficient;
+    ub = lb;
+
+    for ( const auto &addend : equation._addends )
+    {
+        if ( addend._variable == variable )
+            continue;
+
+        double weight = -addend._coefficient / coefficient;
+        double addendLb = _preprocessed.getLowerBound( addend._variable );
+        double addendUb = _preprocessed.getUpperBound( addend._variable );
+
+        if ( weight > 0 )
+        {
+            lb += weight * addendLb;
+            ub += weight * addendUb;
+        }
+        else
+        {
+            lb += weight * addendUb;
+            ub += weight * addendLb;
+        }
+    }
+}
+
+void Preprocessor::getRequiredBounds( unsigned variable, double &lb, double &ub ) const
+{
+    lb = _requiredLowerBounds[variable];
+    ub = _requiredUpperBounds[variable];
+
+    for ( const auto &merged : _mergedVariables )
+    {
+        unsigned target = merged.second;
+        while ( _mergedVariables.exists( target ) )
+            target = _mergedVariables[target];
+
+        if ( target == variable )
+        {
+            lb = FloatUtils::max( lb, _requiredLowerBounds[merged.first] );
+            ub = FloatUtils::min( ub, _requiredUpperBounds[merged.first] );
+        }
+    }
 }
 
 bool Preprocessor::processIdenticalVariables()
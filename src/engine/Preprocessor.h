@@ -22,6 +22,7 @@
 #include "Map.h"
 #include "PiecewiseLinearConstraint.h"
 #include "Set.h"
+#include "Tightening.h"
 
 class Preprocessor
 {
@@ -99,6 +100,58 @@ private:
     */
     void addPlAuxiliaryEquations();
 
+    /*
+      Use the network structure to shrink the query, before any
+      auxiliary equations are added:
+
+        1. Tighten bounds using symbolic bound propagation
+        2. Replace ReLUs whose phase is fixed: active ReLUs by the
+           equation f = b, inactive ReLUs by fixing f to 0
+        3. Fold weighted sums that are no longer constrained by any
+           PL constraint into the equations that use them, thereby
+           merging consecutive weighted sum layers
+
+      The network level reasoner is then reconstructed.
+    */
+    void simplifyNetwork();
+
+    /*
+      Tighten bounds using symbolic bound propagation
+    */
+    bool processNetwork();
+
+    /*
+      Remove the ReLU constraints whose phase is fixed
+    */
+    void eliminateFixedRelus();
+
+    /*
+      Eliminate variables that are defined by an equation and are not
+      otherwise constrained, by substituting their definition into
+      the other equations. Returns true iff any were eliminated.
+    */
+    bool foldWeightedSums();
+
+    /*
+      Helpers for network simplification: apply a tightening to the
+      preprocessed query, returning true iff the bound became tighter;
+      compute the bounds that an equation implies for one of its
+      variables, using the bounds of the other variables; and get the
+      bounds that a variable must satisfy in order for it to be
+      eliminated: those given in the original query for the variable
+      and for any variable merged into it, and those required for any
+      ReLU that has been removed.
+    */
+    bool tightenBound( const Tightening &tightening );
+    void computeImpliedBounds( const Equation &equation,
+                               unsigned variable,
+                               double &lb,
+                               double &ub ) const;
+    void getRequiredBounds( unsigned variable, double &lb, double &ub ) const;
+
+    Map<unsigned, double> _requiredLowerBounds;
+    Map<unsigned, double> _requiredUpperBounds;
+
     /*
       All input/output variables
     */
@@ -22,6 +22,7 @@
 #include "MStringf.h"
 #include "PiecewiseLinearCaseSplit.h"
 #include "ReluConstraint.h"
+#include "ReluLayerConstraint.h"
 #include "MarabouError.h"
 #include "Statistics.h"
 #include "TableauRow.h"
@@ -36,12 +37,16 @@ ReluConstraint::ReluConstraint( unsigned b, unsigned f )
     , _auxVarInUse( false )
     , _direction( PhaseStatus::PHASE_NOT_FIXED )
     , _haveEliminatedVariables( false )
+    , _layer( NULL )
+    , _slot( 0 )
 {
     setPhaseStatus( PhaseStatus::PHASE_NOT_FIXED );
 }
 
 ReluConstraint::ReluConstraint( const String &serializedRelu )
     : _haveEliminatedVariables( false )
+    , _layer( NULL )
+    , _slot( 0 )
 {
     String constraintType = serializedRelu.substring( 0, 4 );
     ASSERT( constraintType == String( "relu" ) );
@@ -85,17 +90,37 @@ PiecewiseLinearConstraint *ReluConstraint::duplicateConstraint() const
 {
     ReluConstraint *clone = new ReluConstraint( _b, _f );
     *clone = *this;
+
+    // The clone is a detached snapshot of the state held by the layer
+    if ( _layer )
+    {
+        _layer->processPendingNotifications();
+        clone->detachFromLayer();
+    }
+
     return clone;
 }
 
 void ReluConstraint::restoreState( const PiecewiseLinearConstraint *state )
 {
     const ReluConstraint *relu = dynamic_cast<const ReluConstraint *>( state );
+    ASSERT( !relu->_layer );
+
+    ReluLayerConstraint *layer = _layer;
+    unsigned slot = _slot;
+
     *this = *relu;
+
+    if ( layer )
+        attachToLayer( layer, slot );
 }
 
 void ReluConstraint::registerAsWatcher( ITableau *tableau )
 {
+    // An attached ReLU is watched by its layer
+    if ( _layer )
+        return;
+
     tableau->registerToWatchVariable( this, _b );
     tableau->registerToWatchVariable( this, _f );
 
@@ -105,6 +130,9 @@ void ReluConstraint::registerAsWatcher( ITableau *tableau )
 
 void ReluConstraint::unregisterAsWatcher( ITableau *tableau )
 {
+    if ( _layer )
+        return;
+
     tableau->unregisterToWatchVariable( this, _b );
     tableau->unregisterToWatchVariable( this, _f );
 
@@ -114,6 +142,12 @@ void ReluConstraint::unregisterAsWatcher( ITableau *tableau )
 
 void ReluConstraint::notifyVariableValue( unsigned variable, double value )
 {
+    if ( _layer )
+    {
+        _layer->notifyVariableValue( variable, value );
+        return;
+    }
+
     if ( FloatUtils::isZero( value, GlobalConfiguration::RELU_CONSTRAINT_COMPARISON_TOLERANCE ) )
         value = 0.0;
 
@@ -122,12 +156,20 @@ void ReluConstraint::notifyVariableValue( unsigned variable, double value )
 
 void ReluConstraint::notifyLowerBound( unsigned variable, double bound )
 {
+    if ( _layer )
+    {
+        _layer->notifyLowerBound( variable, bound );
+        return;
+    }
+
     if ( _statistics )
         _statistics->incNumBoundNotificationsPlConstraints();
 
     if ( _lowerBounds.exists( variable ) && !FloatUtils::gt( bound, _lowerBounds[variable] ) )
         return;
 
+    saveStateIfNeeded();
+
     _lowerBounds[variable] = bound;
 
     if ( variable == _f && FloatUtils::isPositive( bound ) )
@@ -181,12 +223,20 @@ void ReluConstraint::notifyLowerBound( unsigned variable, double bound )
 
 void ReluConstraint::notifyUpperBound( unsigned variable, double bound )
 {
+    if ( _layer )
+    {
+        _layer->notifyUpperBound( variable, bound );
+        return;
+    }
+
     if ( _statistics )
         _statistics->incNumBoundNotificationsPlConstraints();
 
     if ( _upperBounds.exists( variable ) && !FloatUtils::lt( bound, _upperBounds[variable] ) )
         return;
 
+    saveStateIfNeeded();
+
     _upperBounds[variable] = bound;
 
     if ( ( variable == _f || variable == _b ) && !FloatUtils::isPositive( bound ) )
@@ -242,11 +292,11 @@ List<unsigned> ReluConstraint::getParticipatingVariables() const
 
 bool ReluConstraint::satisfied() const
 {
-    if ( !( _assignment.exists( _b ) && _assignment.exists( _f ) ) )
+    if ( !( hasValue( _b ) && hasValue( _f ) ) )
         throw MarabouError( MarabouError::PARTICIPATING_VARIABLES_ABSENT );
 
-    double bValue = _assignment.get( _b );
-    double fValue = _assignment.get( _f );
+    double bValue = getValue( _b );
+    double fValue = getValue( _f );
 
     if ( FloatUtils::isNegative( fValue ) )
         return false;
@@ -260,11 +310,11 @@ bool ReluConstraint::satisfied() const
 List<PiecewiseLinearConstraint::Fix> ReluConstraint::getPossibleFixes() const
 {
     ASSERT( !satisfied() );
-    ASSERT( _assignment.exists( _b ) );
-    ASSERT( _assignment.exists( _f ) );
+    ASSERT( hasValue( _b ) );
+    ASSERT( hasValue( _f ) );
 
-    double bValue = _assignment.get( _b );
-    double fValue = _assignment.get( _f );
+    double bValue = getValue( _b );
+    double fValue = getValue( _f );
 
     ASSERT( !FloatUtils::isNegative( fValue ) );
 
@@ -315,7 +365,7 @@ List<PiecewiseLinearConstraint::Fix> ReluConstraint::getPossibleFixes() const
 List<PiecewiseLinearConstraint::Fix> ReluConstraint::getSmartFixes( ITableau *tableau ) const
 {
     ASSERT( !satisfied() );
-    ASSERT( _assignment.exists( _f ) && _assignment.size() > 1 );
+    ASSERT( hasValue( _f ) && hasValue( _b ) );
 
     double bDeltaToFDelta;
     double fDeltaToBDelta;
@@ -369,8 +419,8 @@ List<PiecewiseLinearConstraint::Fix> ReluConstraint::getSmartFixes( ITableau *ta
       by 4, repairing the violation. Of course, there may be multiple options for repair.
     */
 
-    double bValue = _assignment.get( _b );
-    double fValue = _assignment.get( _f );
+    double bValue = getValue( _b );
+    double fValue = getValue( _f );
 
     /*
       Repair option number 1: the active fix. We want to set f = b > 0.
@@ -434,7 +484,7 @@ List<PiecewiseLinearConstraint::Fix> ReluConstraint::getSmartFixes( ITableau *ta
 
 List<PiecewiseLinearCaseSplit> ReluConstraint::getCaseSplits() const
 {
-    if ( _phaseStatus != PhaseStatus::PHASE_NOT_FIXED )
+    if ( getPhaseStatus() != PhaseStatus::PHASE_NOT_FIXED )
         throw MarabouError( MarabouError::REQUESTED_CASE_SPLITS_FROM_FIXED_CONSTRAINT );
 
     List<PiecewiseLinearCaseSplit> splits;
@@ -454,9 +504,9 @@ List<PiecewiseLinearCaseSplit> ReluConstraint::getCaseSplits() const
 
     // If we have existing knowledge about the assignment, use it to
     // influence the order of splits
-    if ( _assignment.exists( _f ) )
+    if ( hasValue( _f ) )
     {
-        if ( FloatUtils::isPositive( _assignment[_f] ) )
+        if ( FloatUtils::isPositive( getValue( _f ) ) )
         {
             splits.append( getActiveSplit() );
             splits.append( getInactiveSplit() );
@@ -513,14 +563,15 @@ PiecewiseLinearCaseSplit ReluConstraint::getActiveSplit() const
 
 bool ReluConstraint::phaseFixed() const
 {
-    return _phaseStatus != PhaseStatus::PHASE_NOT_FIXED;
+    return getPhaseStatus() != PhaseStatus::PHASE_NOT_FIXED;
 }
 
 PiecewiseLinearCaseSplit ReluConstraint::getValidCaseSplit() const
 {
-    ASSERT( _phaseStatus != PhaseStatus::PHASE_NOT_FIXED );
+    PhaseStatus phaseStatus = getPhaseStatus();
+    ASSERT( phaseStatus != PhaseStatus::PHASE_NOT_FIXED );
 
-    if ( _phaseStatus == PhaseStatus::PHASE_ACTIVE )
+    if ( phaseStatus == PhaseStatus::PHASE_ACTIVE )
         return getActiveSplit();
 
     return getInactiveSplit();
@@ -528,31 +579,33 @@ PiecewiseLinearCaseSplit ReluConstraint::getValidCaseSplit() const
 
 void ReluConstraint::dump( String &output ) const
 {
+    PhaseStatus phaseStatus = getPhaseStatus();
     output = Stringf( "ReluConstraint: x%u = ReLU( x%u ). Active? %s. PhaseStatus = %u (%s).\n",
                       _f, _b,
                       _constraintActive ? "Yes" : "No",
-                      _phaseStatus, phaseToString( _phaseStatus ).ascii()
+                      phaseStatus, phaseToString( phaseStatus ).ascii()
                       );
 
     output += Stringf( "b in [%s, %s], ",
-                       _lowerBounds.exists( _b ) ? Stringf( "%lf", _lowerBounds[_b] ).ascii() : "-inf",
-                       _upperBounds.exists( _b ) ? Stringf( "%lf", _upperBounds[_b] ).ascii() : "inf" );
+                       hasLowerBound( _b ) ? Stringf( "%lf", getLowerBound( _b ) ).ascii() : "-inf",
+                       hasUpperBound( _b ) ? Stringf( "%lf", getUpperBound( _b ) ).ascii() : "inf" );
 
     output += Stringf( "f in [%s, %s]",
-                       _lowerBounds.exists( _f ) ? Stringf( "%lf", _lowerBounds[_f] ).ascii() : "-inf",
-                       _upperBounds.exists( _f ) ? Stringf( "%lf", _upperBounds[_f] ).ascii() : "inf" );
+                       hasLowerBound( _f ) ? Stringf( "%lf", getLowerBound( _f ) ).ascii() : "-inf",
+                       hasUpperBound( _f ) ? Stringf( "%lf", getUpperBound( _f ) ).ascii() : "inf" );
 
     if ( _auxVarInUse )
     {
         output += Stringf( ". Aux var: %u. Range: [%s, %s]\n",
                            _aux,
-                           _lowerBounds.exists( _aux ) ? Stringf( "%lf", _lowerBounds[_aux] ).ascii() : "-inf",
-                           _upperBounds.exists( _aux ) ? Stringf( "%lf", _upperBounds[_aux] ).ascii() : "inf" );
+                           hasLowerBound( _aux ) ? Stringf( "%lf", getLowerBound( _aux ) ).ascii() : "-inf",
+                           hasUpperBound( _aux ) ? Stringf( "%lf", getUpperBound( _aux ) ).ascii() : "inf" );
     }
 }
 
 void ReluConstraint::updateVariableIndex( unsigned oldIndex, unsigned newIndex )
 {
+    ASSERT( !_layer );
 	ASSERT( oldIndex == _b || oldIndex == _f || ( _auxVarInUse && oldIndex == _aux ) );
     ASSERT( !_assignment.exists( newIndex ) &&
             !_lowerBounds.exists( newIndex ) &&
@@ -588,6 +641,7 @@ void ReluConstraint::updateVariableIndex( unsigned oldIndex, unsigned newIndex )
 void ReluConstraint::eliminateVariable( __attribute__((unused)) unsigned variable,
                                         __attribute__((unused)) double fixedValue )
 {
+    ASSERT( !_layer );
     ASSERT( variable == _b || variable == _f || ( _auxVarInUse && variable == _aux ) );
 
     DEBUG({
@@ -628,24 +682,24 @@ bool ReluConstraint::constraintObsolete() const
 
 void ReluConstraint::getEntailedTightenings( List<Tightening> &tightenings ) const
 {
-    ASSERT( _lowerBounds.exists( _b ) && _lowerBounds.exists( _f ) &&
-            _upperBounds.exists( _b ) && _upperBounds.exists( _f ) );
+    ASSERT( hasLowerBound( _b ) && hasLowerBound( _f ) &&
+            hasUpperBound( _b ) && hasUpperBound( _f ) );
 
-    ASSERT( !_auxVarInUse || ( _lowerBounds.exists( _aux ) && _upperBounds.exists( _aux ) ) );
+    ASSERT( !_auxVarInUse || ( hasLowerBound( _aux ) && hasUpperBound( _aux ) ) );
 
-    double bLowerBound = _lowerBounds[_b];
-    double fLowerBound = _lowerBounds[_f];
+    double bLowerBound = getLowerBound( _b );
+    double fLowerBound = getLowerBound( _f );
 
-    double bUpperBound = _upperBounds[_b];
-    double fUpperBound = _upperBounds[_f];
+    double bUpperBound = getUpperBound( _b );
+    double fUpperBound = getUpperBound( _f );
 
     double auxLowerBound = 0;
     double auxUpperBound = 0;
 
     if ( _auxVarInUse )
     {
-        auxLowerBound = _lowerBounds[_aux];
-        auxUpperBound = _upperBounds[_aux];
+        auxLowerBound = getLowerBound( _aux );
+        auxUpperBound = getUpperBound( _aux );
     }
 
     // Determine if we are in the active phase, inactive phase or unknown phase
@@ -739,7 +793,10 @@ String ReluConstraint::phaseToString( PhaseStatus phase )
 
 void ReluConstraint::setPhaseStatus( PhaseStatus phaseStatus )
 {
-    _phaseStatus = phaseStatus;
+    if ( _layer )
+        _layer->setPhaseStatus( _slot, phaseStatus );
+    else
+        _phaseStatus = phaseStatus;
 }
 
 void ReluConstraint::addAuxiliaryEquations( InputQuery &inputQuery )
@@ -757,6 +814,8 @@ void ReluConstraint::addAuxiliaryEquations( InputQuery &inputQuery )
       Upper bound: when f = 0 and b is minimal, i.e. -b.lb
     */
 
+    ASSERT( !_layer );
+
     // Create the aux variable
     _aux = inputQuery.getNumberOfVariables();
     inputQuery.setNumberOfVariables( _aux + 1 );
@@ -795,8 +854,8 @@ void ReluConstraint::getCostFunctionComponent( Map<unsigned, double> &cost ) con
 
     // Both variables are within bounds and the constraint is not
     // satisfied or fixed.
-    double bValue = _assignment.get( _b );
-    double fValue = _assignment.get( _f );
+    double bValue = getValue( _b );
+    double fValue = getValue( _f );
 
     if ( !cost.exists( _f ) )
         cost[_f] = 0;
@@ -831,13 +890,13 @@ void ReluConstraint::getCostFunctionComponent( Map<unsigned, double> &cost ) con
 
 bool ReluConstraint::haveOutOfBoundVariables() const
 {
-    double bValue = _assignment.get( _b );
-    double fValue = _assignment.get( _f );
+    double bValue = getValue( _b );
+    double fValue = getValue( _f );
 
-    if ( FloatUtils::gt( _lowerBounds[_b], bValue ) || FloatUtils::lt( _upperBounds[_b], bValue ) )
+    if ( FloatUtils::gt( getLowerBound( _b ), bValue ) || FloatUtils::lt( getUpperBound( _b ), bValue ) )
         return true;
 
-    if ( FloatUtils::gt( _lowerBounds[_f], fValue ) || FloatUtils::lt( _upperBounds[_f], fValue ) )
+    if ( FloatUtils::gt( getLowerBound( _f ), fValue ) || FloatUtils::lt( getUpperBound( _f ), fValue ) )
         return true;
 
     return false;
@@ -864,6 +923,13 @@ unsigned ReluConstraint::getF() const
 
 ReluConstraint::PhaseStatus ReluConstraint::getPhaseStatus() const
 {
+    if ( _layer )
+    {
+        // Phases are only fixed when the layer processes its notifications
+        _layer->processPendingNotifications();
+        return _layer->getPhaseStatus( _slot );
+    }
+
     return _phaseStatus;
 }
 
@@ -889,8 +955,8 @@ unsigned ReluConstraint::getAux() const
 
 double ReluConstraint::computePolarity() const
 {
-    double currentLb = _lowerBounds[_b];
-    double currentUb = _upperBounds[_b];
+    double currentLb = getLowerBound( _b );
+    double currentUb = getUpperBound( _b );
     if ( currentLb >= 0 ) return 1;
     if ( currentUb <= 0 ) return -1;
     double width = currentUb - currentLb;
@@ -913,6 +979,102 @@ void ReluConstraint::updateScore()
     _score = std::abs( computePolarity() );
 }
 
+double ReluConstraint::getLowerBound( unsigned variable ) const
+{
+    if ( _layer )
+        return _layer->getLowerBound( _slot, variable );
+
+    return _lowerBounds[variable];
+}
+
+double ReluConstraint::getUpperBound( unsigned variable ) const
+{
+    if ( _layer )
+        return _layer->getUpperBound( _slot, variable );
+
+    return _upperBounds[variable];
+}
+
+bool ReluConstraint::hasLowerBound( unsigned variable ) const
+{
+    if ( _layer )
+        return _layer->hasLowerBound( _slot, variable );
+
+    return _lowerBounds.exists( variable );
+}
+
+bool ReluConstraint::hasUpperBound( unsigned variable ) const
+{
+    if ( _layer )
+        return _layer->hasUpperBound( _slot, variable );
+
+    return _upperBounds.exists( variable );
+}
+
+bool ReluConstraint::hasValue( unsigned variable ) const
+{
+    if ( _layer )
+        return _layer->hasValue( _slot, variable );
+
+    return _assignment.exists( variable );
+}
+
+double ReluConstraint::getValue( unsigned variable ) const
+{
+    if ( _layer )
+        return _layer->getValue( _slot, variable );
+
+    return _assignment.get( variable );
+}
+
+void ReluConstraint::attachToLayer( ReluLayerConstraint *layer, unsigned slot )
+{
+    ASSERT( !_layer );
+
+    layer->clearSlot( slot );
+    for ( const auto &variable : getParticipatingVariables() )
+    {
+        if ( _lowerBounds.exists( variable ) )
+            layer->setLowerBound( slot, variable, _lowerBounds[variable] );
+        if ( _upperBounds.exists( variable ) )
+            layer->setUpperBound( slot, variable, _upperBounds[variable] );
+        if ( _assignment.exists( variable ) )
+            layer->setValue( slot, variable, _assignment[variable] );
+    }
+    layer->setPhaseStatus( slot, _phaseStatus );
+
+    _lowerBounds.clear();
+    _upperBounds.clear();
+    _assignment.clear();
+
+    _layer = layer;
+    _slot = slot;
+}
+
+void ReluConstraint::detachFromLayer()
+{
+    ASSERT( _layer );
+
+    ReluLayerConstraint *layer = _layer;
+    _layer = NULL;
+
+    for ( const auto &variable : getParticipatingVariables() )
+    {
+        if ( layer->hasLowerBound( _slot, variable ) )
+            _lowerBounds[variable] = layer->getLowerBound( _slot, variable );
+        if ( layer->hasUpperBound( _slot, variable ) )
+            _upperBounds[variable] = layer->getUpperBound( _slot, variable );
+        if ( layer->hasValue( _slot, variable ) )
+            _assignment[variable] = layer->getValue( _slot, variable );
+    }
+    _phaseStatus = layer->getPhaseStatus( _slot );
+}
+
+bool ReluConstraint::attachedToLayer() const
+{
+    return _layer != NULL;
+}
+
 //
 // Local Variables:
 // compile-command: "make -C ../.. "
@@ -20,6 +20,8 @@
 #include "PiecewiseLinearConstraint.h"
 #include <cmath>
 
+class ReluLayerConstraint;
+
 class ReluConstraint : public PiecewiseLinearConstraint
 {
 public:
@@ -199,6 +201,22 @@ public:
 
     void updateScore();
 
+    /*
+      Retrieve the current lower and upper bounds, possibly from the
+      layer that this ReLU is attached to.
+    */
+    double getLowerBound( unsigned variable ) const;
+    double getUpperBound( unsigned variable ) const;
+
+    /*
+      Attach the ReLU to a layer, which from now on holds its bounds,
+      assignment and phase and watches its variables; or detach it,
+      moving the state back into the constraint.
+    */
+    void attachToLayer( ReluLayerConstraint *layer, unsigned slot );
+    void detachFromLayer();
+    bool attachedToLayer() const;
+
 private:
     unsigned _b, _f;
     PhaseStatus _phaseStatus;
@@ -216,6 +234,12 @@ private:
 
     bool _haveEliminatedVariables;
 
+    /*
+      The layer this ReLU is attached to, if any, and its slot there.
+    */
+    ReluLayerConstraint *_layer;
+    unsigned _slot;
+
     /*
       Set the phase status.
     */
@@ -227,6 +251,15 @@ private:
       Return true iff b or f are out of bounds.
     */
     bool haveOutOfBoundVariables() const;
+
+    /*
+      Access the stored bounds and assignment, whether they are kept
+      locally or in the layer.
+    */
+    bool hasLowerBound( unsigned variable ) const;
+    bool hasUpperBound( unsigned variable ) const;
+    bool hasValue( unsigned variable ) const;
+    double getValue( unsigned variable ) const;
 };
 
 #endif // __ReluConstraint_h__
@@ -0,0 +1,95 @@
+/*********************                                                        */
+/*! \file ReluDivider.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#include "Debug.h"
+#include "MStringf.h"
+#include "PiecewiseLinearCaseSplit.h"
+#include "PiecewiseLinearConstraint.h"
+#include "ReluDivider.h"
+
+ReluDivider::ReluDivider( IEngine *engine, DivideStrategy divideStrategy )
+    : _engine( engine )
+    , _divideStrategy( divideStrategy )
+{
+}
+
+void ReluDivider::createSubQueries( unsigned numNewSubqueries,
+                                    const String queryIdPrefix,
+                                    const PiecewiseLinearCaseSplit
+                                    &previousSplit,
+                                    const unsigned timeoutInSeconds,
+                                    SubQueries &subQueries )
+{
+    unsigned numBisects = (unsigned)log2( numNewSubqueries );
+
+    List<PiecewiseLinearCaseSplit> splits;
+    splits.append( previousSplit );
+
+    // Repeatedly split every subquery on a ReLU. A subquery in which no
+    // ReLU is left to split on is kept as it is
+    for ( unsigned i = 0; i < numBisects; ++i )
+    {
+        List<PiecewiseLinearCaseSplit> newSplits;
+        for ( const auto &split : splits )
+        {
+            PiecewiseLinearConstraint *constraintToSplit =
+                _engine->pickSplitPLConstraintSnC( split, _divideStrategy );
+            if ( !constraintToSplit )
+            {
+                newSplits.append( split );
+                continue;
+            }
+
+            for ( const auto &caseSplit : constraintToSplit->getCaseSplits() )
+            {
+                PiecewiseLinearCaseSplit newSplit = split;
+                for ( const auto &tightening : caseSplit.getBoundTightenings() )
+                    newSplit.storeBoundTightening( tightening );
+                for ( const auto &equation : caseSplit.getEquations() )
+                    newSplit.addEquation( equation );
+                newSplits.append( newSplit );
+            }
+        }
+        splits = newSplits;
+    }
+
+    unsigned queryIdSuffix = 1; // For query id
+    // Create a new subquery for each of the splits
+    for ( const auto &split : splits )
+    {
+        // Create a new query id
+        String queryId;
+        if ( queryIdPrefix == "" )
+            queryId = queryIdPrefix + Stringf( "%u", queryIdSuffix++ );
+        else
+            queryId = queryIdPrefix + Stringf( "-%u", queryIdSuffix++ );
+
+        // Construct the new subquery and add it to subqueries
+        SubQuery *subQuery = new SubQuery;
+        subQuery->_queryId = queryId;
+        subQuery->_split = std::unique_ptr<PiecewiseLinearCaseSplit>
+            ( new PiecewiseLinearCaseSplit( split ) );
+        subQuery->_timeoutInSeconds = timeoutInSeconds;
+        subQueries.append( subQuery );
+    }
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,57 @@
+/*********************                                                        */
+/*! \file ReluDivider.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#ifndef __ReluDivider_h__
+#define __ReluDivider_h__
+
+#include "DivideStrategy.h"
+#include "IEngine.h"
+#include "QueryDivider.h"
+
+#include <math.h>
+
+/*
+  Divides a subquery by splitting on the phases of its ReLUs, rather
+  than by bisecting its input region, so that the number of subqueries
+  does not depend on the input dimension. The ReLU to split on is
+  picked by the engine, according to the divide strategy; each of its
+  phases is added to the subquery's split.
+*/
+class ReluDivider : public QueryDivider
+{
+public:
+    ReluDivider( IEngine *engine, DivideStrategy divideStrategy );
+
+    void createSubQueries( unsigned numNewSubQueries,
+                           const String queryIdPrefix,
+                           const PiecewiseLinearCaseSplit
+                           &previousSplit,
+                           const unsigned timeoutInSeconds,
+                           SubQueries &subQueries );
+
+private:
+    IEngine *_engine;
+    DivideStrategy _divideStrategy;
+};
+
+#endif // __ReluDivider_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
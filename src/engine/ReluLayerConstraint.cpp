@@ -0,0 +1,462 @@
+/*********************                                                        */
+/*! \file ReluLayerConstraint.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#include "Debug.h"
+#include "FloatUtils.h"
+#include "GlobalConfiguration.h"
+#include "IConstraintBoundTightener.h"
+#include "MarabouError.h"
+#include "ReluLayerConstraint.h"
+#include "Statistics.h"
+
+ReluLayerConstraint::ReluLayerConstraint( const List<ReluConstraint *> &relus )
+    : _size( relus.size() )
+    , _relus( NULL )
+    , _b( NULL )
+    , _f( NULL )
+    , _aux( NULL )
+    , _flags( NULL )
+    , _phases( NULL )
+    , _pending( NULL )
+    , _pendingSlots( NULL )
+    , _numPendingSlots( 0 )
+    , _constraintBoundTightener( NULL )
+    , _statistics( NULL )
+    , _trail( NULL )
+    , _slotCheckpoints( NULL )
+{
+    _relus = new ReluConstraint *[_size];
+    _b = new unsigned[_size];
+    _f = new unsigned[_size];
+    _aux = new unsigned[_size];
+
+    for ( unsigned role = 0; role < 3; ++role )
+    {
+        _lowerBounds[role] = new double[_size];
+        _upperBounds[role] = new double[_size];
+        _values[role] = new double[_size];
+    }
+
+    _flags = new unsigned[_size];
+    _phases = new ReluConstraint::PhaseStatus[_size];
+    _pending = new unsigned[_size];
+    _pendingSlots = new unsigned[_size];
+    _slotCheckpoints = new unsigned[_size];
+
+    if ( !_relus || !_b || !_f || !_aux || !_flags || !_phases || !_pending || !_pendingSlots ||
+         !_slotCheckpoints )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "ReluLayerConstraint" );
+
+    unsigned slot = 0;
+    for ( const auto &relu : relus )
+    {
+        ASSERT( !relu->attachedToLayer() );
+
+        _relus[slot] = relu;
+        _b[slot] = relu->getB();
+        _f[slot] = relu->getF();
+        _aux[slot] = relu->auxVariableInUse() ? relu->getAux() : 0;
+        _flags[slot] = relu->auxVariableInUse() ? AUX_IN_USE : 0;
+        _pending[slot] = 0;
+        _slotCheckpoints[slot] = 0;
+
+        _variableToEntry[_b[slot]] = 3 * slot + ROLE_B;
+        _variableToEntry[_f[slot]] = 3 * slot + ROLE_F;
+        if ( relu->auxVariableInUse() )
+            _variableToEntry[_aux[slot]] = 3 * slot + ROLE_AUX;
+
+        relu->attachToLayer( this, slot );
+        ++slot;
+    }
+}
+
+ReluLayerConstraint::~ReluLayerConstraint()
+{
+    for ( unsigned i = 0; i < _size; ++i )
+        _relus[i]->detachFromLayer();
+
+    for ( unsigned role = 0; role < 3; ++role )
+    {
+        delete[] _lowerBounds[role];
+        delete[] _upperBounds[role];
+        delete[] _values[role];
+    }
+
+    delete[] _relus;
+    delete[] _b;
+    delete[] _f;
+    delete[] _aux;
+    delete[] _flags;
+    delete[] _phases;
+    delete[] _pending;
+    delete[] _pendingSlots;
+    delete[] _slotCheckpoints;
+}
+
+unsigned ReluLayerConstraint::getSize() const
+{
+    return _size;
+}
+
+void ReluLayerConstraint::registerAsWatcher( ITableau *tableau )
+{
+    for ( const auto &entry : _variableToEntry )
+        tableau->registerToWatchVariable( this, entry.first );
+}
+
+void ReluLayerConstraint::unregisterAsWatcher( ITableau *tableau )
+{
+    for ( const auto &entry : _variableToEntry )
+        tableau->unregisterToWatchVariable( this, entry.first );
+}
+
+void ReluLayerConstraint::notifyVariableValue( unsigned variable, double value )
+{
+    ASSERT( _variableToEntry.exists( variable ) );
+    unsigned entry = _variableToEntry[variable];
+    unsigned slot = entry / 3;
+    unsigned role = entry % 3;
+
+    if ( FloatUtils::isZero( value, GlobalConfiguration::RELU_CONSTRAINT_COMPARISON_TOLERANCE ) )
+        value = 0.0;
+
+    _values[role][slot] = value;
+    _flags[slot] |= ( HAS_VALUE << role );
+}
+
+void ReluLayerConstraint::notifyLowerBound( unsigned variable, double bound )
+{
+    if ( _statistics )
+        _statistics->incNumBoundNotificationsPlConstraints();
+
+    ASSERT( _variableToEntry.exists( variable ) );
+    unsigned entry = _variableToEntry[variable];
+    unsigned slot = entry / 3;
+    unsigned role = entry % 3;
+
+    unsigned bit = HAS_LOWER_BOUND << role;
+    if ( ( _flags[slot] & bit ) && !FloatUtils::gt( bound, _lowerBounds[role][slot] ) )
+        return;
+
+    saveSlotIfNeeded( slot );
+
+    _lowerBounds[role][slot] = bound;
+    _flags[slot] |= bit;
+    markPending( slot, bit );
+}
+
+void ReluLayerConstraint::notifyUpperBound( unsigned variable, double bound )
+{
+    if ( _statistics )
+        _statistics->incNumBoundNotificationsPlConstraints();
+
+    ASSERT( _variableToEntry.exists( variable ) );
+    unsigned entry = _variableToEntry[variable];
+    unsigned slot = entry / 3;
+    unsigned role = entry % 3;
+
+    unsigned bit = HAS_UPPER_BOUND << role;
+    if ( ( _flags[slot] & bit ) && !FloatUtils::lt( bound, _upperBounds[role][slot] ) )
+        return;
+
+    saveSlotIfNeeded( slot );
+
+    _upperBounds[role][slot] = bound;
+    _flags[slot] |= bit;
+    markPending( slot, bit );
+}
+
+void ReluLayerConstraint::markPending( unsigned slot, unsigned bit )
+{
+    if ( !_pending[slot] )
+        _pendingSlots[_numPendingSlots++] = slot;
+
+    _pending[slot] |= ( bit | PENDING_LISTED );
+}
+
+bool ReluLayerConstraint::hasPendingNotifications() const
+{
+    return _numPendingSlots > 0;
+}
+
+void ReluLayerConstraint::processPendingNotifications()
+{
+    for ( unsigned i = 0; i < _numPendingSlots; ++i )
+    {
+        unsigned slot = _pendingSlots[i];
+        unsigned pending = _pending[slot] & ~PENDING_LISTED;
+        _pending[slot] = 0;
+
+        if ( !pending )
+            continue;
+
+        // As for individual ReLUs, only active constraints propagate bounds
+        bool propagate = _constraintBoundTightener && _relus[slot]->isActive();
+
+        for ( unsigned role = 0; role < 3; ++role )
+        {
+            if ( pending & ( HAS_LOWER_BOUND << role ) )
+                processLowerBound( slot, role, propagate );
+            if ( pending & ( HAS_UPPER_BOUND << role ) )
+                processUpperBound( slot, role, propagate );
+        }
+    }
+
+    _numPendingSlots = 0;
+}
+
+void ReluLayerConstraint::processLowerBound( unsigned slot, unsigned role, bool propagate )
+{
+    double bound = _lowerBounds[role][slot];
+    bool auxInUse = _flags[slot] & AUX_IN_USE;
+
+    if ( role == ROLE_F && FloatUtils::isPositive( bound ) )
+        _phases[slot] = ReluConstraint::PHASE_ACTIVE;
+    else if ( role == ROLE_B && !FloatUtils::isNegative( bound ) )
+        _phases[slot] = ReluConstraint::PHASE_ACTIVE;
+    else if ( role == ROLE_AUX && FloatUtils::isPositive( bound ) )
+        _phases[slot] = ReluConstraint::PHASE_INACTIVE;
+
+    if ( !propagate )
+        return;
+
+    // A positive lower bound is always propagated between f and b
+    if ( ( role == ROLE_F || role == ROLE_B ) && bound > 0 )
+    {
+        unsigned partner = ( role == ROLE_F ) ? _b[slot] : _f[slot];
+        _constraintBoundTightener->registerTighterLowerBound( partner, bound );
+
+        // If we're in the active phase, aux should be 0
+        if ( auxInUse )
+            _constraintBoundTightener->registerTighterUpperBound( _aux[slot], 0 );
+    }
+
+    // If b is non-negative, we're in the active phase
+    else if ( auxInUse && role == ROLE_B && FloatUtils::isZero( bound ) )
+    {
+        _constraintBoundTightener->registerTighterUpperBound( _aux[slot], 0 );
+    }
+
+    // A positive lower bound for aux means we're inactive: f is 0, b is non-positive
+    // When inactive, b = -aux
+    else if ( auxInUse && role == ROLE_AUX && bound > 0 )
+    {
+        _constraintBoundTightener->registerTighterUpperBound( _b[slot], -bound );
+        _constraintBoundTightener->registerTighterUpperBound( _f[slot], 0 );
+    }
+
+    // A negative lower bound for b could tighten aux's upper bound
+    else if ( auxInUse && role == ROLE_B && bound < 0 )
+    {
+        _constraintBoundTightener->registerTighterUpperBound( _aux[slot], -bound );
+    }
+
+    // Also, if for some reason we only know a negative lower bound for f,
+    // we attempt to tighten it to 0
+    else if ( bound < 0 && role == ROLE_F )
+    {
+        _constraintBoundTightener->registerTighterLowerBound( _f[slot], 0 );
+    }
+}
+
+void ReluLayerConstraint::processUpperBound( unsigned slot, unsigned role, bool propagate )
+{
+    double bound = _upperBounds[role][slot];
+    bool auxInUse = _flags[slot] & AUX_IN_USE;
+
+    if ( ( role == ROLE_F || role == ROLE_B ) && !FloatUtils::isPositive( bound ) )
+        _phases[slot] = ReluConstraint::PHASE_INACTIVE;
+
+    if ( auxInUse && role == ROLE_AUX && FloatUtils::isZero( bound ) )
+        _phases[slot] = ReluConstraint::PHASE_ACTIVE;
+
+    if ( !propagate )
+        return;
+
+    if ( role == ROLE_F )
+    {
+        // Any bound that we learned of f should be propagated to b
+        _constraintBoundTightener->registerTighterUpperBound( _b[slot], bound );
+    }
+    else if ( role == ROLE_B )
+    {
+        if ( !FloatUtils::isPositive( bound ) )
+        {
+            // If b has a non-positive upper bound, f's upper bound is 0
+            _constraintBoundTightener->registerTighterUpperBound( _f[slot], 0 );
+
+            if ( auxInUse )
+            {
+                // Aux's range is minus the range of b
+                _constraintBoundTightener->registerTighterLowerBound( _aux[slot], -bound );
+            }
+        }
+        else
+        {
+            // b has a positive upper bound, propagate to f
+            _constraintBoundTightener->registerTighterUpperBound( _f[slot], bound );
+        }
+    }
+    else if ( auxInUse && role == ROLE_AUX )
+    {
+        _constraintBoundTightener->registerTighterLowerBound( _b[slot], -bound );
+    }
+}
+
+void ReluLayerConstraint::registerConstraintBoundTightener( IConstraintBoundTightener *tightener )
+{
+    _constraintBoundTightener = tightener;
+}
+
+void ReluLayerConstraint::setStatistics( Statistics *statistics )
+{
+    _statistics = statistics;
+}
+
+void ReluLayerConstraint::registerConstraintStateTrail( ConstraintStateTrail *trail )
+{
+    _trail = trail;
+}
+
+void ReluLayerConstraint::saveSlotIfNeeded( unsigned slot )
+{
+    if ( !_trail || _slotCheckpoints[slot] == _trail->getCheckpoint() )
+        return;
+
+    // Checkpoints are only marked when no notifications are pending, so
+    // the saved slot has no pending bounds
+    ASSERT( !( _pending[slot] & ~PENDING_LISTED ) );
+
+    SavedSlot saved;
+    saved._slot = slot;
+    saved._flags = _flags[slot];
+    saved._phase = _phases[slot];
+    for ( unsigned role = 0; role < 3; ++role )
+    {
+        saved._lowerBounds[role] = _lowerBounds[role][slot];
+        saved._upperBounds[role] = _upperBounds[role][slot];
+    }
+
+    _savedSlots.append( saved );
+    _slotCheckpoints[slot] = _trail->getCheckpoint();
+    _trail->record( this );
+}
+
+void ReluLayerConstraint::undoLastChange()
+{
+    SavedSlot saved = _savedSlots.pop();
+    unsigned slot = saved._slot;
+
+    unsigned valueFlags = ( HAS_VALUE | ( HAS_VALUE << 1 ) | ( HAS_VALUE << 2 ) );
+    _flags[slot] = ( saved._flags & ~valueFlags ) | ( _flags[slot] & valueFlags );
+    _phases[slot] = saved._phase;
+    for ( unsigned role = 0; role < 3; ++role )
+    {
+        _lowerBounds[role][slot] = saved._lowerBounds[role];
+        _upperBounds[role][slot] = saved._upperBounds[role];
+    }
+
+    // Any bounds still pending were set after the saved state
+    _pending[slot] &= PENDING_LISTED;
+}
+
+unsigned ReluLayerConstraint::getRole( unsigned slot, unsigned variable ) const
+{
+    if ( variable == _b[slot] )
+        return ROLE_B;
+    if ( variable == _f[slot] )
+        return ROLE_F;
+
+    ASSERT( ( _flags[slot] & AUX_IN_USE ) && variable == _aux[slot] );
+    return ROLE_AUX;
+}
+
+bool ReluLayerConstraint::hasLowerBound( unsigned slot, unsigned variable ) const
+{
+    return _flags[slot] & ( HAS_LOWER_BOUND << getRole( slot, variable ) );
+}
+
+bool ReluLayerConstraint::hasUpperBound( unsigned slot, unsigned variable ) const
+{
+    return _flags[slot] & ( HAS_UPPER_BOUND << getRole( slot, variable ) );
+}
+
+bool ReluLayerConstraint::hasValue( unsigned slot, unsigned variable ) const
+{
+    return _flags[slot] & ( HAS_VALUE << getRole( slot, variable ) );
+}
+
+double ReluLayerConstraint::getLowerBound( unsigned slot, unsigned variable ) const
+{
+    return _lowerBounds[getRole( slot, variable )][slot];
+}
+
+double ReluLayerConstraint::getUpperBound( unsigned slot, unsigned variable ) const
+{
+    return _upperBounds[getRole( slot, variable )][slot];
+}
+
+double ReluLayerConstraint::getValue( unsigned slot, unsigned variable ) const
+{
+    return _values[getRole( slot, variable )][slot];
+}
+
+void ReluLayerConstraint::setLowerBound( unsigned slot, unsigned variable, double bound )
+{
+    unsigned role = getRole( slot, variable );
+    _lowerBounds[role][slot] = bound;
+    _flags[slot] |= ( HAS_LOWER_BOUND << role );
+}
+
+void ReluLayerConstraint::setUpperBound( unsigned slot, unsigned variable, double bound )
+{
+    unsigned role = getRole( slot, variable );
+    _upperBounds[role][slot] = bound;
+    _flags[slot] |= ( HAS_UPPER_BOUND << role );
+}
+
+void ReluLayerConstraint::setValue( unsigned slot, unsigned variable, double value )
+{
+    unsigned role = getRole( slot, variable );
+    _values[role][slot] = value;
+    _flags[slot] |= ( HAS_VALUE << role );
+}
+
+ReluConstraint::PhaseStatus ReluLayerConstraint::getPhaseStatus( unsigned slot ) const
+{
+    return _phases[slot];
+}
+
+void ReluLayerConstraint::setPhaseStatus( unsigned slot, ReluConstraint::PhaseStatus phaseStatus )
+{
+    _phases[slot] = phaseStatus;
+}
+
+void ReluLayerConstraint::clearSlot( unsigned slot )
+{
+    _flags[slot] &= AUX_IN_USE;
+    _phases[slot] = ReluConstraint::PHASE_NOT_FIXED;
+
+    // The slot stays in the pending list, but is skipped when processed
+    _pending[slot] &= PENDING_LISTED;
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
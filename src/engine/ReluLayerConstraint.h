@@ -0,0 +1,208 @@
+/*********************                                                        */
+/*! \file ReluLayerConstraint.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#ifndef __ReluLayerConstraint_h__
+#define __ReluLayerConstraint_h__
+
+#include "ConstraintStateTrail.h"
+#include "HashMap.h"
+#include "ITableau.h"
+#include "List.h"
+#include "ReluConstraint.h"
+#include "Vector.h"
+
+class IConstraintBoundTightener;
+class Statistics;
+
+/*
+  A batch store for the ReLUs of a single network layer.
+
+  The b, f and aux indices, the bounds, the assignment and the phase
+  of every ReLU in the layer are kept in contiguous arrays, indexed by
+  the ReLU's slot in the layer. The layer registers with the tableau
+  as the single watcher for all of these variables: a bound
+  notification only records the new bound and marks the slot as
+  pending, and phase fixing and bound propagation between b, f and aux
+  are later done for all pending slots in one pass.
+
+  The individual ReluConstraint objects remain the piecewise linear
+  constraints seen by the engine and the SMT core. Once attached to a
+  layer they read and write their state through it, and process any
+  pending notifications before answering a query that depends on their
+  phase.
+
+  When a trail is registered, a slot's bounds and phase are saved on
+  it before they first change after a checkpoint.
+*/
+class ReluLayerConstraint
+    : public ITableau::VariableWatcher
+    , public ConstraintStateTrail::Trailable
+{
+public:
+    enum Role {
+        ROLE_B = 0,
+        ROLE_F = 1,
+        ROLE_AUX = 2,
+    };
+
+    /*
+      Create a layer for the given ReLUs, and attach them to it. The
+      ReLUs are detached again when the layer is destroyed.
+    */
+    ReluLayerConstraint( const List<ReluConstraint *> &relus );
+    virtual ~ReluLayerConstraint();
+
+    unsigned getSize() const;
+
+    /*
+      Register/unregister the layer with a tableau, as the watcher of
+      all the participating variables of its ReLUs.
+    */
+    void registerAsWatcher( ITableau *tableau );
+    void unregisterAsWatcher( ITableau *tableau );
+
+    /*
+      The variable watcher callbacks. These only store the new values
+      and bounds.
+    */
+    void notifyVariableValue( unsigned variable, double value );
+    void notifyLowerBound( unsigned variable, double bound );
+    void notifyUpperBound( unsigned variable, double bound );
+
+    /*
+      Fix the phases and propagate the bounds of all ReLUs whose bounds
+      have changed since the last call.
+    */
+    void processPendingNotifications();
+    bool hasPendingNotifications() const;
+
+    void registerConstraintBoundTightener( IConstraintBoundTightener *tightener );
+    void setStatistics( Statistics *statistics );
+
+    /*
+      Register a trail for the bounds and phases of the slots, and
+      restore the last saved slot when its change is undone.
+    */
+    void registerConstraintStateTrail( ConstraintStateTrail *trail );
+    void undoLastChange();
+
+    /*
+      Access to the state of individual ReLUs, by slot.
+    */
+    bool hasLowerBound( unsigned slot, unsigned variable ) const;
+    bool hasUpperBound( unsigned slot, unsigned variable ) const;
+    bool hasValue( unsigned slot, unsigned variable ) const;
+    double getLowerBound( unsigned slot, unsigned variable ) const;
+    double getUpperBound( unsigned slot, unsigned variable ) const;
+    double getValue( unsigned slot, unsigned variable ) const;
+
+    void setLowerBound( unsigned slot, unsigned variable, double bound );
+    void setUpperBound( unsigned slot, unsigned variable, double bound );
+    void setValue( unsigned slot, unsigned variable, double value );
+
+    ReluConstraint::PhaseStatus getPhaseStatus( unsigned slot ) const;
+    void setPhaseStatus( unsigned slot, ReluConstraint::PhaseStatus phaseStatus );
+
+    /*
+      Clear the state of a slot, e.g. before it is restored, and drop
+      any of its pending notifications.
+    */
+    void clearSlot( unsigned slot );
+
+private:
+    /*
+      Per-slot flags. The bound and value flags are shifted by the role
+      of the variable; the pending bits use the same layout as the
+      bound flags, plus a bit marking that the slot is already listed
+      as pending.
+    */
+    enum {
+        HAS_LOWER_BOUND = 1,
+        HAS_UPPER_BOUND = 1 << 3,
+        HAS_VALUE = 1 << 6,
+        AUX_IN_USE = 1 << 9,
+        PENDING_LISTED = 1 << 10,
+    };
+
+    /*
+      The bounds and phase of a slot, as saved on the trail. The
+      assignment is not saved.
+    */
+    struct SavedSlot
+    {
+        unsigned _slot;
+        unsigned _flags;
+        ReluConstraint::PhaseStatus _phase;
+        double _lowerBounds[3];
+        double _upperBounds[3];
+    };
+
+    unsigned _size;
+
+    ReluConstraint **_relus;
+    unsigned *_b;
+    unsigned *_f;
+    unsigned *_aux;
+
+    double *_lowerBounds[3];
+    double *_upperBounds[3];
+    double *_values[3];
+
+    unsigned *_flags;
+    ReluConstraint::PhaseStatus *_phases;
+
+    /*
+      Slots with unprocessed bound notifications, and for each slot the
+      bounds that have changed.
+    */
+    unsigned *_pending;
+    unsigned *_pendingSlots;
+    unsigned _numPendingSlots;
+
+    /*
+      Maps each watched variable to its slot and role, encoded as
+      3 * slot + role.
+    */
+    HashMap<unsigned, unsigned> _variableToEntry;
+
+    IConstraintBoundTightener *_constraintBoundTightener;
+    Statistics *_statistics;
+
+    /*
+      The registered trail, the checkpoint at which each slot was last
+      saved, and the saved slots.
+    */
+    ConstraintStateTrail *_trail;
+    unsigned *_slotCheckpoints;
+    Vector<SavedSlot> _savedSlots;
+
+    void saveSlotIfNeeded( unsigned slot );
+
+    unsigned getRole( unsigned slot, unsigned variable ) const;
+    void markPending( unsigned slot, unsigned bit );
+
+    void processLowerBound( unsigned slot, unsigned role, bool propagate );
+    void processUpperBound( unsigned slot, unsigned role, bool propagate );
+};
+
+#endif // __ReluLayerConstraint_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,34 @@
+/*********************                                                        */
+/*! \file RestartPolicy.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#ifndef __RestartPolicy_h__
+#define __RestartPolicy_h__
+
+enum RestartPolicy
+{
+    NoRestarts = 0,
+    LubyRestarts,      // Restart after the base interval times the Luby sequence
+    GeometricRestarts, // Restart after the base interval times a growing power of a fixed factor
+};
+
+#endif // __RestartPolicy_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,211 @@
+/*********************                                                        */
+/*! \file RuntimeEstimator.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#include "File.h"
+#include "FloatUtils.h"
+#include "MStringf.h"
+#include "RuntimeEstimator.h"
+
+#include <cmath>
+
+RuntimeEstimator::RuntimeEstimator( unsigned minSamples )
+    : _minSamples( minSamples )
+    , _numSamples( 0 )
+{
+    for ( unsigned i = 0; i < NUM_FEATURES; ++i )
+    {
+        _xty[i] = 0;
+        for ( unsigned j = 0; j < NUM_FEATURES; ++j )
+            _xtx[i][j] = 0;
+    }
+}
+
+void RuntimeEstimator::computeFeatures( const SubQuery &subQuery, double *features )
+{
+    features[0] = 1;
+    features[1] = subQuery._numUnfixedConstraints;
+    features[2] = std::log( 1 + FloatUtils::max( subQuery._outputBoundGap, 0 ) );
+    features[3] = std::log( 1 + FloatUtils::max( subQuery._parentTimeInSeconds, 0 ) );
+}
+
+bool RuntimeEstimator::fit( double *weights ) const
+{
+    // Gaussian elimination with partial pivoting, on a copy of the
+    // normal equations. A small ridge term keeps them regular when a
+    // feature does not vary, e.g. before any parent times are known.
+    double a[NUM_FEATURES][NUM_FEATURES + 1];
+    for ( unsigned i = 0; i < NUM_FEATURES; ++i )
+    {
+        for ( unsigned j = 0; j < NUM_FEATURES; ++j )
+            a[i][j] = _xtx[i][j];
+        a[i][i] += 1e-3;
+        a[i][NUM_FEATURES] = _xty[i];
+    }
+
+    for ( unsigned col = 0; col < NUM_FEATURES; ++col )
+    {
+        unsigned pivot = col;
+        for ( unsigned row = col + 1; row < NUM_FEATURES; ++row )
+        {
+            if ( FloatUtils::abs( a[row][col] ) > FloatUtils::abs( a[pivot][col] ) )
+                pivot = row;
+        }
+
+        if ( FloatUtils::isZero( a[pivot][col] ) )
+            return false;
+
+        if ( pivot != col )
+        {
+            for ( unsigned j = 0; j <= NUM_FEATURES; ++j )
+            {
+                double temp = a[col][j];
+                a[col][j] = a[pivot][j];
+                a[pivot][j] = temp;
+            }
+        }
+
+        for ( unsigned row = col + 1; row < NUM_FEATURES; ++row )
+        {
+            double factor = a[row][col] / a[col][col];
+            for ( unsigned j = col; j <= NUM_FEATURES; ++j )
+                a[row][j] -= factor * a[col][j];
+        }
+    }
+
+    for ( int i = NUM_FEATURES - 1; i >= 0; --i )
+    {
+        double sum = a[i][NUM_FEATURES];
+        for ( unsigned j = i + 1; j < NUM_FEATURES; ++j )
+            sum -= a[i][j] * weights[j];
+        weights[i] = sum / a[i][i];
+    }
+
+    return true;
+}
+
+double RuntimeEstimator::predict( const SubQuery &subQuery ) const
+{
+    std::lock_guard<std::mutex> lock( _mutex );
+
+    if ( _numSamples < _minSamples || _numSamples == 0 )
+        return -1;
+
+    double weights[NUM_FEATURES];
+    if ( !fit( weights ) )
+        return -1;
+
+    double features[NUM_FEATURES];
+    computeFeatures( subQuery, features );
+
+    double logTime = 0;
+    for ( unsigned i = 0; i < NUM_FEATURES; ++i )
+        logTime += weights[i] * features[i];
+
+    return FloatUtils::max( std::exp( logTime ) - 1, 0 );
+}
+
+void RuntimeEstimator::record( const SubQuery &subQuery, double timeInSeconds, bool timedOut )
+{
+    double features[NUM_FEATURES];
+    computeFeatures( subQuery, features );
+    double logTime = std::log( 1 + FloatUtils::max( timeInSeconds, 0 ) );
+
+    Record record;
+    record._queryId = subQuery._queryId;
+    record._numUnfixedConstraints = subQuery._numUnfixedConstraints;
+    record._outputBoundGap = subQuery._outputBoundGap;
+    record._parentTimeInSeconds = subQuery._parentTimeInSeconds;
+    record._predictedTimeInSeconds = subQuery._predictedTimeInSeconds;
+    record._timeInSeconds = timeInSeconds;
+    record._timedOut = timedOut;
+
+    std::lock_guard<std::mutex> lock( _mutex );
+
+    for ( unsigned i = 0; i < NUM_FEATURES; ++i )
+    {
+        _xty[i] += features[i] * logTime;
+        for ( unsigned j = 0; j < NUM_FEATURES; ++j )
+            _xtx[i][j] += features[i] * features[j];
+    }
+    ++_numSamples;
+
+    _records.append( record );
+}
+
+unsigned RuntimeEstimator::getNumSamples() const
+{
+    std::lock_guard<std::mutex> lock( _mutex );
+    return _numSamples;
+}
+
+double RuntimeEstimator::getMeanLogError() const
+{
+    std::lock_guard<std::mutex> lock( _mutex );
+
+    double totalError = 0;
+    unsigned numPredicted = 0;
+    for ( const auto &record : _records )
+    {
+        if ( record._predictedTimeInSeconds < 0 )
+            continue;
+
+        totalError += FloatUtils::abs( std::log( 1 + record._predictedTimeInSeconds ) -
+                                       std::log( 1 + record._timeInSeconds ) );
+        ++numPredicted;
+    }
+
+    return numPredicted == 0 ? 0 : totalError / numPredicted;
+}
+
+void RuntimeEstimator::dumpRecords( const String &filePath ) const
+{
+    std::lock_guard<std::mutex> lock( _mutex );
+
+    File file( filePath );
+    file.open( File::MODE_WRITE_TRUNCATE );
+
+    file.write( "queryId,unfixedConstraints,outputBoundGap,parentTime,predictedTime,time,timedOut\n" );
+    for ( const auto &record : _records )
+    {
+        file.write( Stringf( "%s,%u,%.6f,%.6f,%.6f,%.6f,%u\n",
+                             record._queryId.ascii(),
+                             record._numUnfixedConstraints,
+                             record._outputBoundGap,
+                             record._parentTimeInSeconds,
+                             record._predictedTimeInSeconds,
+                             record._timeInSeconds,
+                             record._timedOut ? 1 : 0 ) );
+    }
+}
+
+bool RuntimeEstimator::easierThan( const SubQuery *a, const SubQuery *b )
+{
+    if ( a->_predictedTimeInSeconds >= 0 && b->_predictedTimeInSeconds >= 0 &&
+         a->_predictedTimeInSeconds != b->_predictedTimeInSeconds )
+        return a->_predictedTimeInSeconds < b->_predictedTimeInSeconds;
+
+    if ( a->_numUnfixedConstraints != b->_numUnfixedConstraints )
+        return a->_numUnfixedConstraints < b->_numUnfixedConstraints;
+
+    return a->_outputBoundGap < b->_outputBoundGap;
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
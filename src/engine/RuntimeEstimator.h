@@ -0,0 +1,119 @@
+/*********************                                                        */
+/*! \file RuntimeEstimator.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#ifndef __RuntimeEstimator_h__
+#define __RuntimeEstimator_h__
+
+#include "List.h"
+#include "MString.h"
+#include "SubQuery.h"
+
+#include <mutex>
+
+/*
+  An online model of the time it takes to solve a DnC subquery, given
+  the difficulty estimate stored in the subquery. It is shared by the
+  DnC workers, which record the time spent on each subquery, and use
+  the predictions to order the subqueries they create and to set their
+  time budgets.
+
+  The model is a least-squares fit of log( 1 + time ) to the number of
+  unfixed constraints, log( 1 + output bound gap ) and
+  log( 1 + parent time ), refitted from the accumulated normal
+  equations on every prediction. Subqueries that timed out are
+  recorded with their budget as their time, which underestimates them.
+*/
+class RuntimeEstimator
+{
+public:
+    enum {
+        NUM_FEATURES = 4,
+    };
+
+    struct Record
+    {
+        String _queryId;
+        unsigned _numUnfixedConstraints;
+        double _outputBoundGap;
+        double _parentTimeInSeconds;
+        double _predictedTimeInSeconds;
+        double _timeInSeconds;
+        bool _timedOut;
+    };
+
+    RuntimeEstimator( unsigned minSamples );
+
+    /*
+      The predicted time, in seconds, to solve the subquery. Returns a
+      negative value until enough subqueries have been recorded.
+    */
+    double predict( const SubQuery &subQuery ) const;
+
+    /*
+      Record the time spent on a subquery, and whether it timed out
+    */
+    void record( const SubQuery &subQuery, double timeInSeconds, bool timedOut );
+
+    unsigned getNumSamples() const;
+
+    /*
+      The mean of | log( 1 + predicted ) - log( 1 + actual ) | over the
+      recorded subqueries that had a prediction, or 0 if there are none
+    */
+    double getMeanLogError() const;
+
+    /*
+      Write the recorded subqueries, with their predicted and actual
+      times, to a CSV file for tuning
+    */
+    void dumpRecords( const String &filePath ) const;
+
+    /*
+      Order subqueries from the easiest to the hardest: by predicted
+      time if both have one, and otherwise by their difficulty
+      estimates
+    */
+    static bool easierThan( const SubQuery *a, const SubQuery *b );
+
+private:
+    unsigned _minSamples;
+
+    // The normal equations X^T X w = X^T y, accumulated over the samples
+    double _xtx[NUM_FEATURES][NUM_FEATURES];
+    double _xty[NUM_FEATURES];
+    unsigned _numSamples;
+
+    List<Record> _records;
+
+    mutable std::mutex _mutex;
+
+    static void computeFeatures( const SubQuery &subQuery, double *features );
+
+    /*
+      Solve the normal equations for the weights of the model. Returns
+      false if they are singular.
+    */
+    bool fit( double *weights ) const;
+};
+
+#endif // __RuntimeEstimator_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
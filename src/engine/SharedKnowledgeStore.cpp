@@ -0,0 +1,166 @@
+/*********************                                                        */
+/*! \file SharedKnowledgeStore.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#include "MarabouError.h"
+#include "SharedKnowledgeStore.h"
+
+SharedKnowledgeStore::SharedKnowledgeStore( unsigned maxEntries )
+    : _maxEntries( maxEntries )
+    , _numEntries( 0 )
+    , _head( NULL )
+{
+}
+
+SharedKnowledgeStore::~SharedKnowledgeStore()
+{
+    Entry *entry = _head.load();
+    while ( entry )
+    {
+        Entry *next = entry->_next;
+        delete entry;
+        entry = next;
+    }
+    _head = NULL;
+}
+
+void SharedKnowledgeStore::boxFromSplit( const PiecewiseLinearCaseSplit &split,
+                                         Map<unsigned, double> &lowerBounds,
+                                         Map<unsigned, double> &upperBounds )
+{
+    for ( const auto &bound : split.getBoundTightenings() )
+    {
+        if ( bound._type == Tightening::LB )
+        {
+            if ( !lowerBounds.exists( bound._variable ) || lowerBounds[bound._variable] < bound._value )
+                lowerBounds[bound._variable] = bound._value;
+        }
+        else
+        {
+            if ( !upperBounds.exists( bound._variable ) || upperBounds[bound._variable] > bound._value )
+                upperBounds[bound._variable] = bound._value;
+        }
+    }
+}
+
+bool SharedKnowledgeStore::contains( const Entry &entry,
+                                     const Map<unsigned, double> &lowerBounds,
+                                     const Map<unsigned, double> &upperBounds )
+{
+    for ( const auto &bound : entry._lowerBounds )
+    {
+        if ( !lowerBounds.exists( bound.first ) || lowerBounds[bound.first] < bound.second )
+            return false;
+    }
+
+    for ( const auto &bound : entry._upperBounds )
+    {
+        if ( !upperBounds.exists( bound.first ) || upperBounds[bound.first] > bound.second )
+            return false;
+    }
+
+    return true;
+}
+
+bool SharedKnowledgeStore::publish( const PiecewiseLinearCaseSplit &scope,
+                                    const List<Tightening> &bounds,
+                                    const List<Vector<unsigned>> &clauses )
+{
+    if ( bounds.empty() && clauses.empty() )
+        return true;
+
+    // Reserve a slot
+    if ( _numEntries.fetch_add( 1 ) >= _maxEntries )
+    {
+        --_numEntries;
+        return false;
+    }
+
+    Entry *entry = new Entry;
+    if ( !entry )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "SharedKnowledgeStore::entry" );
+
+    boxFromSplit( scope, entry->_lowerBounds, entry->_upperBounds );
+    entry->_bounds = bounds;
+    entry->_clauses = clauses;
+
+    // Link the entry in. Readers that load the new head see the
+    // complete entry.
+    entry->_next = _head.load( std::memory_order_relaxed );
+    while ( !_head.compare_exchange_weak( entry->_next, entry,
+                                          std::memory_order_release,
+                                          std::memory_order_relaxed ) );
+
+    return true;
+}
+
+bool SharedKnowledgeStore::import( const PiecewiseLinearCaseSplit &scope,
+                                   List<Tightening> &bounds,
+                                   List<Vector<unsigned>> &clauses ) const
+{
+    Map<unsigned, double> lowerBounds;
+    Map<unsigned, double> upperBounds;
+    boxFromSplit( scope, lowerBounds, upperBounds );
+
+    Map<unsigned, double> tightestLowerBounds;
+    Map<unsigned, double> tightestUpperBounds;
+    bool found = false;
+
+    for ( const Entry *entry = _head.load( std::memory_order_acquire ); entry; entry = entry->_next )
+    {
+        if ( !contains( *entry, lowerBounds, upperBounds ) )
+            continue;
+
+        found = true;
+
+        for ( const auto &bound : entry->_bounds )
+        {
+            if ( bound._type == Tightening::LB )
+            {
+                if ( !tightestLowerBounds.exists( bound._variable ) ||
+                     tightestLowerBounds[bound._variable] < bound._value )
+                    tightestLowerBounds[bound._variable] = bound._value;
+            }
+            else
+            {
+                if ( !tightestUpperBounds.exists( bound._variable ) ||
+                     tightestUpperBounds[bound._variable] > bound._value )
+                    tightestUpperBounds[bound._variable] = bound._value;
+            }
+        }
+
+        for ( const auto &clause : entry->_clauses )
+            clauses.append( clause );
+    }
+
+    for ( const auto &bound : tightestLowerBounds )
+        bounds.append( Tightening( bound.first, bound.second, Tightening::LB ) );
+    for ( const auto &bound : tightestUpperBounds )
+        bounds.append( Tightening( bound.first, bound.second, Tightening::UB ) );
+
+    return found;
+}
+
+unsigned SharedKnowledgeStore::size() const
+{
+    return _numEntries.load();
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
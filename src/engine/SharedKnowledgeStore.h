@@ -0,0 +1,103 @@
+/*********************                                                        */
+/*! \file SharedKnowledgeStore.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#ifndef __SharedKnowledgeStore_h__
+#define __SharedKnowledgeStore_h__
+
+#include "List.h"
+#include "Map.h"
+#include "PiecewiseLinearCaseSplit.h"
+#include "Tightening.h"
+#include "Vector.h"
+
+#include <atomic>
+
+/*
+  Facts learned by the DnC workers, shared among all of them. Each fact
+  is tagged with the scope in which it holds: the box of the subquery
+  whose solving derived it, given by the bound tightenings of its DnC
+  split. A worker publishes the bounds it derived at the root of a
+  subquery, and the ReLU phase clauses it learned from conflicts (see
+  PhaseClauseDatabase), when the subquery times out. Before solving a
+  subquery, a worker imports the facts of every scope that contains
+  the subquery's box, e.g. those learned for its ancestors.
+
+  The store is lock-free: it is an append-only list of entries that
+  are never changed once published, and are only freed with the store.
+  Publishing reserves a slot with an atomic counter, and links the
+  entry in with a compare-and-swap on the head of the list.
+*/
+class SharedKnowledgeStore
+{
+public:
+    SharedKnowledgeStore( unsigned maxEntries );
+    ~SharedKnowledgeStore();
+
+    /*
+      Publish facts that hold throughout the given scope. Returns false,
+      and publishes nothing, if the store is full.
+    */
+    bool publish( const PiecewiseLinearCaseSplit &scope,
+                  const List<Tightening> &bounds,
+                  const List<Vector<unsigned>> &clauses );
+
+    /*
+      Collect the facts published for the scopes that contain the
+      given scope. Of the bounds on each variable, only the tightest
+      are kept. Returns false if there are no such scopes.
+    */
+    bool import( const PiecewiseLinearCaseSplit &scope,
+                 List<Tightening> &bounds,
+                 List<Vector<unsigned>> &clauses ) const;
+
+    unsigned size() const;
+
+private:
+    struct Entry
+    {
+        Map<unsigned, double> _lowerBounds;
+        Map<unsigned, double> _upperBounds;
+        List<Tightening> _bounds;
+        List<Vector<unsigned>> _clauses;
+        Entry *_next;
+    };
+
+    unsigned _maxEntries;
+    std::atomic_uint _numEntries;
+
+    // The most recently published entry
+    std::atomic<Entry *> _head;
+
+    static void boxFromSplit( const PiecewiseLinearCaseSplit &split,
+                              Map<unsigned, double> &lowerBounds,
+                              Map<unsigned, double> &upperBounds );
+
+    /*
+      Check whether the box of the entry contains the given box
+    */
+    static bool contains( const Entry &entry,
+                          const Map<unsigned, double> &lowerBounds,
+                          const Map<unsigned, double> &upperBounds );
+};
+
+#endif // __SharedKnowledgeStore_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -186,6 +186,16 @@ String SignConstraint::serializeToString() const
     return Stringf( "sign,%u,%u", _f, _b );
 }
 
+unsigned SignConstraint::getB() const
+{
+    return _b;
+}
+
+unsigned SignConstraint::getF() const
+{
+    return _f;
+}
+
 bool SignConstraint::haveOutOfBoundVariables() const
 {
     double bValue = _assignment.get( _b );
@@ -235,6 +245,8 @@ void SignConstraint::notifyLowerBound( unsigned variable, double bound )
     if ( _lowerBounds.exists( variable ) && !FloatUtils::gt( bound, _lowerBounds[variable] ) )
         return;
 
+    saveStateIfNeeded();
+
     // Otherwise - update bound
     _lowerBounds[variable] = bound;
 
@@ -266,6 +278,8 @@ void SignConstraint::notifyUpperBound( unsigned variable, double bound )
     if ( _upperBounds.exists( variable ) && !FloatUtils::lt( bound, _upperBounds[variable] ) )
         return;
 
+    saveStateIfNeeded();
+
     // Otherwise - update bound
     _upperBounds[variable] = bound;
 
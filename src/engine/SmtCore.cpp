@@ -21,9 +21,12 @@
 #include "IEngine.h"
 #include "MStringf.h"
 #include "MarabouError.h"
+#include "Options.h"
 #include "ReluConstraint.h"
 #include "SmtCore.h"
 
+#include <cmath>
+
 SmtCore::SmtCore( IEngine *engine )
     : _statistics( NULL )
     , _engine( engine )
@@ -32,6 +35,10 @@ SmtCore::SmtCore( IEngine *engine )
     , _stateId( 0 )
     , _constraintViolationThreshold
       ( GlobalConfiguration::CONSTRAINT_VIOLATION_THRESHOLD )
+    , _splittingStrategy( Options::get()->getSplittingStrategy() )
+    , _restartPolicy( Options::get()->getRestartPolicy() )
+    , _numRestarts( 0 )
+    , _numVisitedTreeStatesAtRestart( 0 )
 {
 }
 
@@ -58,12 +65,15 @@ void SmtCore::reportViolatedConstraint( PiecewiseLinearConstraint *constraint )
 
     ++_constraintToViolationCount[constraint];
 
+    if ( !_constraintToTotalViolationCount.exists( constraint ) )
+        _constraintToTotalViolationCount[constraint] = 0;
+    ++_constraintToTotalViolationCount[constraint];
+
     if ( _constraintToViolationCount[constraint] >=
          _constraintViolationThreshold )
     {
         _needToSplit = true;
-        if ( GlobalConfiguration::SPLITTING_HEURISTICS ==
-             DivideStrategy::ReLUViolation || !pickSplitPLConstraint() )
+        if ( _splittingStrategy == DivideStrategy::ReLUViolation || !pickSplitPLConstraint() )
             // If pickSplitConstraint failed to pick one, use the native
             // relu-violation based splitting heuristic.
             _constraintForSplitting = constraint;
@@ -78,6 +88,14 @@ unsigned SmtCore::getViolationCounts( PiecewiseLinearConstraint *constraint ) co
     return _constraintToViolationCount[constraint];
 }
 
+unsigned SmtCore::getTotalViolationCounts( PiecewiseLinearConstraint *constraint ) const
+{
+    if ( !_constraintToTotalViolationCount.exists( constraint ) )
+        return 0;
+
+    return _constraintToTotalViolationCount[constraint];
+}
+
 bool SmtCore::needToSplit() const
 {
     return _needToSplit;
@@ -113,6 +131,7 @@ void SmtCore::performSplit()
     List<PiecewiseLinearCaseSplit> splits = _constraintForSplitting->getCaseSplits();
     ASSERT( !splits.empty() );
     ASSERT( splits.size() >= 2 ); // Not really necessary, can add code to handle this case.
+    orderSplitsBySavedPhase( splits );
     _constraintForSplitting->setActiveConstraint( false );
 
     // Obtain the current state of the engine
@@ -122,10 +141,9 @@ void SmtCore::performSplit()
     _engine->storeState( *stateBeforeSplits, true );
 
     SmtStackEntry *stackEntry = new SmtStackEntry;
-    // Perform the first split: add bounds and equations
     List<PiecewiseLinearCaseSplit>::iterator split = splits.begin();
-    _engine->applySplit( *split );
     stackEntry->_activeSplit = *split;
+    stackEntry->_decisionLiteral = getPhaseLiteral( _constraintForSplitting, *split );
 
     // Store the remaining splits on the stack, for later
     stackEntry->_engineState = stateBeforeSplits;
@@ -136,7 +154,12 @@ void SmtCore::performSplit()
         ++split;
     }
 
+    // Perform the first split: add bounds and equations. The entry is
+    // pushed first, so that the new bounds are attributed to its level
     _stack.append( stackEntry );
+    recordDecision( stackEntry );
+    _engine->applySplit( stackEntry->_activeSplit );
+
     if ( _statistics )
     {
         _statistics->setCurrentStackDepth( getStackDepth() );
@@ -197,7 +220,7 @@ bool SmtCore::popSplit()
 
     // Restore the state of the engine
     SMT_LOG( "\tRestoring engine state..." );
-    _engine->restoreState( *( stackEntry->_engineState ) );
+    _engine->restoreState( *( stackEntry->_engineState ), true );
     SMT_LOG( "\tRestoring engine state - DONE" );
 
     // Apply the new split and erase it from the list
@@ -206,6 +229,12 @@ bool SmtCore::popSplit()
     // Erase any valid splits that were learned using the split we just popped
     stackEntry->_impliedValidSplits.clear();
 
+    // The alternative of a split on a ReLU is its other phase
+    _phaseClauses.backtrack( getStackDepth() - 1 );
+    if ( stackEntry->_decisionLiteral != PhaseClauseDatabase::NO_LITERAL )
+        stackEntry->_decisionLiteral = PhaseClauseDatabase::negate( stackEntry->_decisionLiteral );
+    recordDecision( stackEntry );
+
     SMT_LOG( "\tApplying new split..." );
     _engine->applySplit( *split );
     SMT_LOG( "\tApplying new split - DONE" );
@@ -225,19 +254,290 @@ bool SmtCore::popSplit()
     return true;
 }
 
+bool SmtCore::backjump( unsigned conflictLevel )
+{
+    if ( !GlobalConfiguration::USE_CONFLICT_DRIVEN_CLAUSE_LEARNING )
+    {
+        if ( !shouldRestart() )
+            return popSplit();
+
+        restart();
+        return true;
+    }
+
+    // The bound levels do not account for the equations added by the
+    // splits, so the conflict may depend on all of them
+    unsigned highestLevelWithEquations = getHighestLevelWithEquations();
+    if ( conflictLevel < highestLevelWithEquations )
+        conflictLevel = highestLevelWithEquations;
+    if ( conflictLevel > getStackDepth() )
+        conflictLevel = getStackDepth();
+
+    SMT_LOG( Stringf( "Conflict at level %u, current level %u",
+                      conflictLevel, getStackDepth() ).ascii() );
+
+    learnClause( conflictLevel );
+
+    if ( conflictLevel < getStackDepth() && _statistics )
+        _statistics->incNumBackjumps();
+
+    // The splits above the conflict level did not contribute to the
+    // conflict, and their alternatives would fail in the same way
+    while ( getStackDepth() > conflictLevel )
+    {
+        SmtStackEntry *stackEntry = _stack.back();
+        if ( _statistics )
+            _statistics->incNumPrunedTreeStates( stackEntry->_alternativeSplits.size() );
+
+        delete stackEntry->_engineState;
+        delete stackEntry;
+        _stack.popBack();
+    }
+
+    // A conflict that does not depend on any split means that the
+    // query is unsat
+    if ( conflictLevel == 0 )
+    {
+        if ( _statistics )
+            _statistics->setCurrentStackDepth( 0 );
+        return false;
+    }
+
+    if ( shouldRestart() )
+    {
+        restart();
+        return true;
+    }
+
+    return popSplit();
+}
+
+void SmtCore::restart()
+{
+    if ( _stack.empty() )
+        return;
+
+    SMT_LOG( Stringf( "Restarting from level %u", getStackDepth() ).ascii() );
+
+    struct timespec start = TimeUtils::sampleMicro();
+
+    // The first split stored the state of the root
+    _engine->restoreState( *( _stack.front()->_engineState ), true );
+    freeMemory();
+    _phaseClauses.backtrack( 0 );
+
+    ++_numRestarts;
+    if ( _statistics )
+    {
+        _statistics->incNumRestarts();
+        _numVisitedTreeStatesAtRestart = _statistics->getNumVisitedTreeStates();
+        _statistics->setCurrentStackDepth( 0 );
+        struct timespec end = TimeUtils::sampleMicro();
+        _statistics->addTimeSmtCore( TimeUtils::timePassed( start, end ) );
+    }
+}
+
+unsigned SmtCore::luby( unsigned index )
+{
+    // Find the smallest complete subsequence, of length 2^k - 1, that
+    // contains the index, then descend into the copy of the previous
+    // subsequence that the index falls in
+    unsigned size = 1;
+    unsigned power = 0;
+    while ( size < index + 1 )
+    {
+        ++power;
+        size = 2 * size + 1;
+    }
+
+    while ( size - 1 != index )
+    {
+        size = ( size - 1 ) >> 1;
+        --power;
+        index = index % size;
+    }
+
+    return 1 << power;
+}
+
+bool SmtCore::shouldRestart() const
+{
+    if ( _restartPolicy == RestartPolicy::NoRestarts || _stack.empty() || !_statistics )
+        return false;
+
+    double interval = GlobalConfiguration::RESTART_BASE_INTERVAL;
+    if ( _restartPolicy == RestartPolicy::LubyRestarts )
+        interval *= luby( _numRestarts );
+    else
+        interval *= std::pow( GlobalConfiguration::RESTART_GEOMETRIC_FACTOR, _numRestarts );
+
+    return _statistics->getNumVisitedTreeStates() - _numVisitedTreeStatesAtRestart >= interval;
+}
+
+bool SmtCore::propagateLearnedClauses( unsigned &conflictLevel )
+{
+    if ( !GlobalConfiguration::USE_CONFLICT_DRIVEN_CLAUSE_LEARNING )
+        return true;
+
+    List<unsigned> impliedLiterals;
+    if ( !_phaseClauses.propagate( getStackDepth(), impliedLiterals, conflictLevel ) )
+        return false;
+
+    for ( const auto &literal : impliedLiterals )
+    {
+        // Fixing the sign of the ReLU's input fixes its phase, and the
+        // rest of the phase is then applied as a valid case split
+        unsigned variable = PhaseClauseDatabase::getVariable( literal );
+        PiecewiseLinearCaseSplit split;
+        if ( PhaseClauseDatabase::isActive( literal ) )
+            split.storeBoundTightening( Tightening( variable, 0.0, Tightening::LB ) );
+        else
+            split.storeBoundTightening( Tightening( variable, 0.0, Tightening::UB ) );
+
+        recordImpliedValidSplit( split );
+        savePhase( literal );
+        _engine->applySplit( split );
+
+        if ( _statistics )
+            _statistics->incNumPrunedTreeStates();
+    }
+
+    return true;
+}
+
+unsigned SmtCore::getPhaseLiteral( const PiecewiseLinearConstraint *constraint,
+                                   const PiecewiseLinearCaseSplit &split )
+{
+    if ( !constraint || constraint->getType() != RELU )
+        return PhaseClauseDatabase::NO_LITERAL;
+
+    unsigned b = ( (const ReluConstraint *)constraint )->getB();
+    for ( const auto &bound : split.getBoundTightenings() )
+    {
+        if ( bound._variable == b )
+            return PhaseClauseDatabase::literal( b, bound._type == Tightening::LB );
+    }
+
+    return PhaseClauseDatabase::NO_LITERAL;
+}
+
+void SmtCore::recordDecision( const SmtStackEntry *stackEntry )
+{
+    if ( stackEntry->_decisionLiteral == PhaseClauseDatabase::NO_LITERAL )
+        return;
+
+    if ( GlobalConfiguration::USE_CONFLICT_DRIVEN_CLAUSE_LEARNING )
+        _phaseClauses.assign( stackEntry->_decisionLiteral, getStackDepth() );
+    savePhase( stackEntry->_decisionLiteral );
+}
+
+void SmtCore::savePhase( unsigned literal )
+{
+    if ( _restartPolicy != RestartPolicy::NoRestarts )
+        _savedPhases[PhaseClauseDatabase::getVariable( literal )] = PhaseClauseDatabase::isActive( literal );
+}
+
+void SmtCore::orderSplitsBySavedPhase( List<PiecewiseLinearCaseSplit> &splits ) const
+{
+    if ( _restartPolicy == RestartPolicy::NoRestarts )
+        return;
+
+    unsigned literal = getPhaseLiteral( _constraintForSplitting, splits.front() );
+    if ( literal == PhaseClauseDatabase::NO_LITERAL )
+        return;
+
+    unsigned variable = PhaseClauseDatabase::getVariable( literal );
+    if ( !_savedPhases.exists( variable ) ||
+         _savedPhases.at( variable ) == PhaseClauseDatabase::isActive( literal ) )
+        return;
+
+    // The saved phase is the other split of the ReLU
+    splits.appendHead( splits.back() );
+    splits.popBack();
+}
+
+void SmtCore::learnClause( unsigned conflictLevel )
+{
+    if ( conflictLevel == 0 )
+        return;
+
+    // The clause states that not all of the decisions hold
+    Vector<unsigned> clause;
+    for ( const auto &stackEntry : _stack )
+    {
+        if ( clause.size() == conflictLevel )
+            break;
+
+        // Only clauses over ReLU phases are learned
+        if ( stackEntry->_decisionLiteral == PhaseClauseDatabase::NO_LITERAL )
+            return;
+
+        clause.append( PhaseClauseDatabase::negate( stackEntry->_decisionLiteral ) );
+    }
+
+    _phaseClauses.addClause( clause );
+    _learnedClauses.append( clause );
+
+    if ( _statistics )
+        _statistics->incNumLearnedPhaseClauses();
+}
+
+void SmtCore::getLearnedClauses( List<Vector<unsigned>> &clauses ) const
+{
+    clauses = _learnedClauses;
+}
+
+void SmtCore::addClauses( const List<Vector<unsigned>> &clauses )
+{
+    if ( !GlobalConfiguration::USE_CONFLICT_DRIVEN_CLAUSE_LEARNING )
+        return;
+
+    for ( const auto &clause : clauses )
+        _phaseClauses.addClause( clause );
+}
+
+unsigned SmtCore::getHighestLevelWithEquations() const
+{
+    unsigned highestLevel = 0;
+    unsigned level = 0;
+    for ( const auto &stackEntry : _stack )
+    {
+        ++level;
+
+        bool addedEquations = !stackEntry->_activeSplit.getEquations().empty();
+        for ( const auto &impliedSplit : stackEntry->_impliedValidSplits )
+            if ( !impliedSplit.getEquations().empty() )
+                addedEquations = true;
+
+        if ( addedEquations )
+            highestLevel = level;
+    }
+
+    return highestLevel;
+}
+
 void SmtCore::resetReportedViolations()
 {
     _constraintToViolationCount.clear();
     _needToSplit = false;
 }
 
-void SmtCore::recordImpliedValidSplit( PiecewiseLinearCaseSplit &validSplit )
+void SmtCore::recordImpliedValidSplit( PiecewiseLinearCaseSplit &validSplit,
+                                       const PiecewiseLinearConstraint *constraint )
 {
     if ( _stack.empty() )
         _impliedValidSplitsAtRoot.append( validSplit );
     else
         _stack.back()->_impliedValidSplits.append( validSplit );
 
+    unsigned literal = getPhaseLiteral( constraint, validSplit );
+    if ( literal != PhaseClauseDatabase::NO_LITERAL )
+    {
+        if ( GlobalConfiguration::USE_CONFLICT_DRIVEN_CLAUSE_LEARNING )
+            _phaseClauses.assign( literal, getStackDepth() );
+        savePhase( literal );
+    }
+
     checkSkewFromDebuggingSolution();
 }
 
@@ -415,12 +715,12 @@ void SmtCore::replaySmtStackEntry( SmtStackEntry *stackEntry )
     stackEntry->_engineState = stateBeforeSplits;
 
     // Apply all the splits
+    _stack.append( stackEntry );
+    recordDecision( stackEntry );
     _engine->applySplit( stackEntry->_activeSplit );
     for ( const auto &impliedSplit : stackEntry->_impliedValidSplits )
         _engine->applySplit( impliedSplit );
 
-    _stack.append( stackEntry );
-
     if ( _statistics )
     {
         _statistics->setCurrentStackDepth( getStackDepth() );
@@ -446,6 +746,12 @@ bool SmtCore::pickSplitPLConstraint()
     return _constraintForSplitting != NULL;
 }
 
+void SmtCore::setConstraintForSplitting( PiecewiseLinearConstraint *constraint )
+{
+    _constraintForSplitting = constraint;
+    _needToSplit = true;
+}
+
 //
 // Local Variables:
 // compile-command: "make -C ../.. "
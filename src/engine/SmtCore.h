@@ -16,6 +16,9 @@
 #ifndef __SmtCore_h__
 #define __SmtCore_h__
 
+#include "DivideStrategy.h"
+#include "PhaseClauseDatabase.h"
+#include "RestartPolicy.h"
 #include "PiecewiseLinearCaseSplit.h"
 #include "PiecewiseLinearConstraint.h"
 #include "SmtState.h"
@@ -56,6 +59,13 @@ public:
     */
     void resetReportedViolations();
 
+    /*
+      Get the number of times a specific PL constraint has been reported
+      as violated since the SMT core was created. Unlike the counts
+      above, these are not reset when backtracking.
+    */
+    unsigned getTotalViolationCounts( PiecewiseLinearConstraint *constraint ) const;
+
     /*
       Returns true iff the SMT core wants to perform a case split.
     */
@@ -73,15 +83,54 @@ public:
     */
     bool popSplit();
 
+    /*
+      Handle a conflict that already holds given the decisions up to
+      conflictLevel. Learn a clause over the phases of these decisions
+      if they are all ReLU splits, discard the splits above the level
+      together with their alternatives, and pop. Return false if the
+      whole query is unsat.
+    */
+    bool backjump( unsigned conflictLevel );
+
+    /*
+      Abandon the current search tree and restore the state at its
+      root. The learned clauses, and the phases saved for the ReLUs,
+      are kept: splits on a ReLU first try the phase it last had.
+    */
+    void restart();
+
+    /*
+      The Luby sequence 1, 1, 2, 1, 1, 2, 4, 1, ..., indexed from 0.
+    */
+    static unsigned luby( unsigned index );
+
+    /*
+      Propagate the phases fixed so far through the learned clauses,
+      and apply the implied phases. Return false if a learned clause
+      is violated, and store in conflictLevel the level at which it
+      became violated.
+    */
+    bool propagateLearnedClauses( unsigned &conflictLevel );
+
+    /*
+      The clauses learned from conflicts by this SmtCore. Clauses
+      learned elsewhere over the same query, e.g. by other DnC workers,
+      can be added before the search starts.
+    */
+    void getLearnedClauses( List<Vector<unsigned>> &clauses ) const;
+    void addClauses( const List<Vector<unsigned>> &clauses );
+
     /*
       The current stack depth.
     */
     unsigned getStackDepth() const;
 
     /*
-      Let the smt core know of an implied valid case split that was discovered.
+      Let the smt core know of an implied valid case split that was
+      discovered, and of the constraint that it came from, if known.
     */
-    void recordImpliedValidSplit( PiecewiseLinearCaseSplit &validSplit );
+    void recordImpliedValidSplit( PiecewiseLinearCaseSplit &validSplit,
+                                  const PiecewiseLinearConstraint *constraint = NULL );
 
     /*
       Return a list of all splits performed so far, both SMT-originating and valid ones,
@@ -118,6 +167,12 @@ public:
     */
     bool pickSplitPLConstraint();
 
+    /*
+      Request a split on the given constraint, regardless of its
+      violation count.
+    */
+    void setConstraintForSplitting( PiecewiseLinearConstraint *constraint );
+
     /*
       For debugging purposes only - store a correct possible solution
     */
@@ -156,6 +211,7 @@ private:
       Count how many times each constraint has been violated.
     */
     Map<PiecewiseLinearConstraint *, unsigned> _constraintToViolationCount;
+    Map<PiecewiseLinearConstraint *, unsigned> _constraintToTotalViolationCount;
 
     /*
       For debugging purposes only
@@ -172,6 +228,65 @@ private:
       Split when some relu has been violated for this many times
     */
     unsigned _constraintViolationThreshold;
+
+    /*
+      The heuristic used for picking the constraint to split on
+    */
+    DivideStrategy _splittingStrategy;
+
+    /*
+      The clauses learned from conflicts, and the ReLU phases fixed by
+      the splits on the stack.
+    */
+    PhaseClauseDatabase _phaseClauses;
+    List<Vector<unsigned>> _learnedClauses;
+
+    /*
+      When to restart, the number of restarts so far, and the number
+      of visited tree states at the last restart.
+    */
+    RestartPolicy _restartPolicy;
+    unsigned _numRestarts;
+    unsigned _numVisitedTreeStatesAtRestart;
+
+    /*
+      The last phase of each ReLU, by its input variable: true if
+      active.
+    */
+    HashMap<unsigned, bool> _savedPhases;
+
+    /*
+      The phase literal of a split on a ReLU, or NO_LITERAL for other
+      constraints.
+    */
+    static unsigned getPhaseLiteral( const PiecewiseLinearConstraint *constraint,
+                                     const PiecewiseLinearCaseSplit &split );
+
+    void recordDecision( const SmtStackEntry *stackEntry );
+    void savePhase( unsigned literal );
+
+    /*
+      If the constraint being split on is a ReLU with a saved phase,
+      move the split for that phase to the front.
+    */
+    void orderSplitsBySavedPhase( List<PiecewiseLinearCaseSplit> &splits ) const;
+
+    /*
+      Whether enough tree states were visited since the last restart.
+    */
+    bool shouldRestart() const;
+
+    /*
+      Learn the clause that forbids the decisions up to the given
+      level.
+    */
+    void learnClause( unsigned conflictLevel );
+
+    /*
+      The highest level, up to the current one, whose splits added
+      equations to the tableau.
+    */
+    unsigned getHighestLevelWithEquations() const;
 };
 
 #endif // __SmtCore_h__
@@ -17,20 +17,30 @@
 #define __SmtStackEntry_h__
 
 #include "EngineState.h"
+#include "PhaseClauseDatabase.h"
 #include "PiecewiseLinearCaseSplit.h"
 
 /*
   A stack entry consists of the engine state before the split,
   the active split, the alternative splits (in case of backtrack),
   and also any implied splits that were discovered subsequently.
+  When the split is on a ReLU, the phase literal of the active split
+  is kept for conflict analysis.
 */
 struct SmtStackEntry
 {
 public:
+    SmtStackEntry()
+        : _engineState( NULL )
+        , _decisionLiteral( PhaseClauseDatabase::NO_LITERAL )
+    {
+    }
+
     PiecewiseLinearCaseSplit _activeSplit;
     List<PiecewiseLinearCaseSplit> _impliedValidSplits;
     List<PiecewiseLinearCaseSplit> _alternativeSplits;
     EngineState *_engineState;
+    unsigned _decisionLiteral;
 
     /*
       Create a copy of the SmtStackEntry on the stack and returns a pointer to
@@ -46,6 +56,7 @@ public:
         copy->_impliedValidSplits = _impliedValidSplits;
         copy->_alternativeSplits = _alternativeSplits;
         copy->_engineState = NULL;
+        copy->_decisionLiteral = _decisionLiteral;
 
         return copy;
     }
@@ -21,13 +21,19 @@
 #include "PiecewiseLinearCaseSplit.h"
 #include "SmtState.h"
 
-#include <boost/lockfree/queue.hpp>
+#include <memory>
 #include <utility>
 
 // Struct representing a subquery
 struct SubQuery
 {
     SubQuery()
+        : _timeoutInSeconds( 0 )
+        , _numUnfixedConstraints( 0 )
+        , _outputBoundGap( 0 )
+        , _parentTimeInSeconds( 0 )
+        , _predictedTimeInSeconds( -1 )
+        , _fromEagerSplit( false )
     {
     }
 
@@ -37,6 +43,11 @@ struct SubQuery
         , _split( std::move( split ) )
         , _smtState ( nullptr )
         , _timeoutInSeconds( timeoutInSeconds )
+        , _numUnfixedConstraints( 0 )
+        , _outputBoundGap( 0 )
+        , _parentTimeInSeconds( 0 )
+        , _predictedTimeInSeconds( -1 )
+        , _fromEagerSplit( false )
     {
     }
 
@@ -44,11 +55,29 @@ struct SubQuery
     std::unique_ptr<PiecewiseLinearCaseSplit> _split;
     std::unique_ptr<SmtState> _smtState;
     unsigned _timeoutInSeconds;
-};
 
-// Synchronized Queue containing the Sub-Queries shared by workers
-typedef boost::lockfree::queue<SubQuery *, boost::lockfree::
-  fixed_sized<false>>WorkerQueue;
+    /*
+      A cheap estimate of the difficulty of the subquery: the number
+      of piecewise-linear constraints left unfixed by bound propagation
+      over its box, the total width of the output bounds, and the time
+      spent on the subquery it was divided from
+    */
+    unsigned _numUnfixedConstraints;
+    double _outputBoundGap;
+    double _parentTimeInSeconds;
+
+    /*
+      The predicted time to solve the subquery, or a negative value if
+      no prediction was made
+    */
+    double _predictedTimeInSeconds;
+
+    /*
+      Whether the subquery was created by dividing a subquery without
+      solving it first
+    */
+    bool _fromEagerSplit;
+};
 
 // A vector of Sub-Queries
 
@@ -0,0 +1,170 @@
+/*********************                                                        */
+/*! \file SubQuerySerializer.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#include "MarabouError.h"
+#include "SubQuerySerializer.h"
+
+SubQueryWriter::SubQueryWriter( std::string &data )
+    : _data( data )
+{
+}
+
+void SubQueryWriter::writeString( const String &string )
+{
+    write<unsigned>( string.length() );
+    _data.append( string.ascii(), string.length() );
+}
+
+void SubQueryWriter::writeBounds( const List<Tightening> &bounds )
+{
+    write<unsigned>( bounds.size() );
+    for ( const auto &bound : bounds )
+    {
+        write<unsigned>( bound._variable );
+        write<unsigned char>( bound._type );
+        write<double>( bound._value );
+    }
+}
+
+void SubQueryWriter::writeSplit( const PiecewiseLinearCaseSplit &split )
+{
+    writeBounds( split.getBoundTightenings() );
+
+    const List<Equation> &equations = split.getEquations();
+    write<unsigned>( equations.size() );
+    for ( const auto &equation : equations )
+    {
+        write<unsigned char>( equation._type );
+        write<double>( equation._scalar );
+        write<unsigned>( equation._addends.size() );
+        for ( const auto &addend : equation._addends )
+        {
+            write<unsigned>( addend._variable );
+            write<double>( addend._coefficient );
+        }
+    }
+}
+
+void SubQueryWriter::writeSubQuery( const SubQuery &subQuery )
+{
+    writeString( subQuery._queryId );
+    write<unsigned>( subQuery._timeoutInSeconds );
+    writeSplit( *subQuery._split );
+}
+
+SubQueryReader::SubQueryReader( const std::string &data )
+    : _data( data )
+    , _position( 0 )
+{
+}
+
+bool SubQueryReader::readString( String &string )
+{
+    unsigned length;
+    if ( !read( length ) || _data.size() - _position < length )
+        return false;
+
+    string = String( _data.data() + _position, length );
+    _position += length;
+    return true;
+}
+
+bool SubQueryReader::readBounds( List<Tightening> &bounds )
+{
+    unsigned numBounds;
+    if ( !read( numBounds ) )
+        return false;
+
+    for ( unsigned i = 0; i < numBounds; ++i )
+    {
+        unsigned variable;
+        unsigned char type;
+        double value;
+        if ( !read( variable ) || !read( type ) || !read( value ) ||
+             type > Tightening::UB )
+            return false;
+
+        bounds.append( Tightening( variable, value, (Tightening::BoundType)type ) );
+    }
+
+    return true;
+}
+
+bool SubQueryReader::readSplit( PiecewiseLinearCaseSplit &split )
+{
+    List<Tightening> bounds;
+    if ( !readBounds( bounds ) )
+        return false;
+
+    for ( const auto &bound : bounds )
+        split.storeBoundTightening( bound );
+
+    unsigned numEquations;
+    if ( !read( numEquations ) )
+        return false;
+
+    for ( unsigned i = 0; i < numEquations; ++i )
+    {
+        unsigned char type;
+        double scalar;
+        unsigned numAddends;
+        if ( !read( type ) || !read( scalar ) || !read( numAddends ) ||
+             type > Equation::LE )
+            return false;
+
+        Equation equation( (Equation::EquationType)type );
+        equation.setScalar( scalar );
+        for ( unsigned j = 0; j < numAddends; ++j )
+        {
+            unsigned variable;
+            double coefficient;
+            if ( !read( variable ) || !read( coefficient ) )
+                return false;
+            equation.addAddend( coefficient, variable );
+        }
+
+        split.addEquation( equation );
+    }
+
+    return true;
+}
+
+bool SubQueryReader::readSubQuery( SubQuery *&subQuery )
+{
+    String queryId;
+    unsigned timeoutInSeconds;
+    auto split = std::unique_ptr<PiecewiseLinearCaseSplit>( new PiecewiseLinearCaseSplit );
+    if ( !readString( queryId ) || !read( timeoutInSeconds ) || !readSplit( *split ) )
+        return false;
+
+    subQuery = new SubQuery( queryId, split, timeoutInSeconds );
+    if ( !subQuery )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "SubQueryReader::subQuery" );
+
+    return true;
+}
+
+bool SubQueryReader::done() const
+{
+    return _position == _data.size();
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
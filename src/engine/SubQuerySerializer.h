@@ -0,0 +1,101 @@
+/*********************                                                        */
+/*! \file SubQuerySerializer.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#ifndef __SubQuerySerializer_h__
+#define __SubQuerySerializer_h__
+
+#include "List.h"
+#include "MString.h"
+#include "PiecewiseLinearCaseSplit.h"
+#include "SubQuery.h"
+#include "Tightening.h"
+
+#include <cstring>
+#include <string>
+
+/*
+  A binary encoding of DnC subqueries, used for saving them to
+  checkpoints and for sending them to worker processes. A subquery is
+  encoded as its id, its timeout and its split; its SmtState is not
+  encoded. Numbers are stored in the native byte order.
+*/
+class SubQueryWriter
+{
+public:
+    SubQueryWriter( std::string &data );
+
+    template <typename T>
+    void write( T value )
+    {
+        _data.append( (const char *)&value, sizeof( T ) );
+    }
+
+    void writeString( const String &string );
+    void writeBounds( const List<Tightening> &bounds );
+    void writeSplit( const PiecewiseLinearCaseSplit &split );
+    void writeSubQuery( const SubQuery &subQuery );
+
+private:
+    std::string &_data;
+};
+
+/*
+  Reads what a SubQueryWriter wrote. All reads return false once the
+  data runs out or turns out to be malformed.
+*/
+class SubQueryReader
+{
+public:
+    SubQueryReader( const std::string &data );
+
+    template <typename T>
+    bool read( T &value )
+    {
+        if ( _data.size() - _position < sizeof( T ) )
+            return false;
+
+        memcpy( &value, _data.data() + _position, sizeof( T ) );
+        _position += sizeof( T );
+        return true;
+    }
+
+    bool readString( String &string );
+    bool readBounds( List<Tightening> &bounds );
+    bool readSplit( PiecewiseLinearCaseSplit &split );
+
+    /*
+      Create the next subquery. The caller owns it.
+    */
+    bool readSubQuery( SubQuery *&subQuery );
+
+    /*
+      Whether all of the data has been read
+    */
+    bool done() const;
+
+private:
+    const std::string &_data;
+    size_t _position;
+};
+
+#endif // __SubQuerySerializer_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -59,6 +59,10 @@ Tableau::Tableau()
     , _statistics( NULL )
     , _costFunctionManager( NULL )
     , _rhsIsAllZeros( true )
+    , _deferValueNotifications( false )
+    , _valueNotificationPending( NULL )
+    , _pendingValueNotifications( NULL )
+    , _numPendingValueNotifications( 0 )
 {
 }
 
@@ -165,6 +169,19 @@ void Tableau::freeMemoryIfNeeded()
         _nonBasicAssignment = NULL;
     }
 
+    if ( _valueNotificationPending )
+    {
+        delete[] _valueNotificationPending;
+        _valueNotificationPending = NULL;
+    }
+
+    if ( _pendingValueNotifications )
+    {
+        delete[] _pendingValueNotifications;
+        _pendingValueNotifications = NULL;
+    }
+    _numPendingValueNotifications = 0;
+
     if ( _lowerBounds )
     {
         delete[] _lowerBounds;
@@ -279,6 +296,16 @@ void Tableau::setDimensions( unsigned m, unsigned n )
     if ( !_nonBasicAssignment )
         throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::nonBasicAssignment" );
 
+    _valueNotificationPending = new bool[n];
+    if ( !_valueNotificationPending )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::valueNotificationPending" );
+    std::fill_n( _valueNotificationPending, n, false );
+
+    _pendingValueNotifications = new unsigned[n];
+    if ( !_pendingValueNotifications )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::pendingValueNotifications" );
+    _numPendingValueNotifications = 0;
+
     _lowerBounds = new double[n];
     if ( !_lowerBounds )
         throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::lowerBounds" );
@@ -1670,6 +1697,12 @@ void Tableau::restoreState( const TableauState &state )
     // Restore the merged varaibles
     _mergedVariables = state._mergedVariables;
 
+    // The watchers do not restore their assignment with the rest of
+    // their state. Re-deliver the non-basic values; the basic ones are
+    // re-delivered by computeAssignment()
+    for ( unsigned i = 0; i < _n - _m; ++i )
+        notifyVariableValue( _nonBasicIndexToVariable[i], _nonBasicAssignment[i] );
+
     computeAssignment();
     _costFunctionManager->initialize();
     computeCostFunction();
@@ -2028,6 +2061,23 @@ void Tableau::addRow()
     _lowerBounds[_n] = FloatUtils::negativeInfinity();
     _upperBounds[_n] = FloatUtils::infinity();
 
+    // Allocate larger deferred notification structures, keep the pending ones
+    bool *newValueNotificationPending = new bool[newN];
+    if ( !newValueNotificationPending )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::newValueNotificationPending" );
+    memcpy( newValueNotificationPending, _valueNotificationPending, _n * sizeof(bool) );
+    newValueNotificationPending[_n] = false;
+    delete[] _valueNotificationPending;
+    _valueNotificationPending = newValueNotificationPending;
+
+    unsigned *newPendingValueNotifications = new unsigned[newN];
+    if ( !newPendingValueNotifications )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::newPendingValueNotifications" );
+    memcpy( newPendingValueNotifications, _pendingValueNotifications,
+            _numPendingValueNotifications * sizeof(unsigned) );
+    delete[] _pendingValueNotifications;
+    _pendingValueNotifications = newPendingValueNotifications;
+
     // Allocate a larger basis factorization
     IBasisFactorization *newBasisFactorization =
         BasisFactorizationFactory::createBasisFactorization( newM, *this );
@@ -2085,6 +2135,46 @@ void Tableau::registerResizeWatcher( ResizeWatcher *watcher )
 }
 
 void Tableau::notifyVariableValue( unsigned variable, double value )
+{
+    if ( _deferValueNotifications )
+    {
+        if ( !_valueNotificationPending[variable] )
+        {
+            _valueNotificationPending[variable] = true;
+            _pendingValueNotifications[_numPendingValueNotifications++] = variable;
+        }
+        return;
+    }
+
+    dispatchVariableValue( variable, value );
+}
+
+void Tableau::setDeferValueNotifications( bool defer )
+{
+    if ( !defer )
+        notifyPendingVariableValues();
+
+    _deferValueNotifications = defer;
+}
+
+void Tableau::notifyPendingVariableValues()
+{
+    for ( unsigned i = 0; i < _numPendingValueNotifications; ++i )
+    {
+        unsigned variable = _pendingValueNotifications[i];
+        _valueNotificationPending[variable] = false;
+
+        double value = _basicVariables.exists( variable ) ?
+            _basicAssignment[_variableToIndex[variable]] :
+            _nonBasicAssignment[_variableToIndex[variable]];
+
+        dispatchVariableValue( variable, value );
+    }
+
+    _numPendingValueNotifications = 0;
+}
+
+void Tableau::dispatchVariableValue( unsigned variable, double value )
 {
     for ( auto &watcher : _globalWatchers )
         watcher->notifyVariableValue( variable, value );
@@ -372,6 +372,16 @@ public:
     void notifyLowerBound( unsigned variable, double bound );
     void notifyUpperBound( unsigned variable, double bound );
 
+    /*
+      When value notifications are deferred, notifyVariableValue only
+      marks the variable as changed. The watchers are informed of the
+      current values of all changed variables, once per variable, when
+      notifyPendingVariableValues() is called. Turning deferral off
+      flushes any pending notifications.
+    */
+    void setDeferValueNotifications( bool defer );
+    void notifyPendingVariableValues();
+
     /*
       Have the Tableau start reporting statistics.
      */
@@ -605,6 +615,21 @@ private:
      */
     bool _rhsIsAllZeros;
 
+    /*
+      Deferred value notifications: a flag per variable marking that
+      its value has changed since the watchers were last informed, and
+      the list of these variables.
+    */
+    bool _deferValueNotifications;
+    bool *_valueNotificationPending;
+    unsigned *_pendingValueNotifications;
+    unsigned _numPendingValueNotifications;
+
+    /*
+      Inform the watchers of a variable of its new value.
+    */
+    void dispatchVariableValue( unsigned variable, double value );
+
     /*
       Free all allocated memory.
     */
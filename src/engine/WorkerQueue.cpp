@@ -0,0 +1,183 @@
+/*********************                                                        */
+/*! \file WorkerQueue.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#include "MarabouError.h"
+#include "WorkerQueue.h"
+
+#include <chrono>
+
+WorkerQueue::WorkerQueue( unsigned numWorkers )
+    : _numPushes( 0 )
+    , _size( 0 )
+    , _numSteals( 0 )
+{
+    if ( numWorkers == 0 )
+        numWorkers = 1;
+
+    for ( unsigned i = 0; i < numWorkers; ++i )
+    {
+        WorkerDeque *deque = new WorkerDeque;
+        if ( !deque )
+            throw MarabouError( MarabouError::ALLOCATION_FAILED, "WorkerQueue::deque" );
+        _deques.append( deque );
+    }
+}
+
+WorkerQueue::~WorkerQueue()
+{
+    for ( auto &deque : _deques )
+    {
+        for ( auto &subQuery : deque->_subQueries )
+            delete subQuery;
+        delete deque;
+    }
+    _deques.clear();
+}
+
+void WorkerQueue::push( SubQuery *subQuery, unsigned worker )
+{
+    WorkerDeque *deque = _deques[worker % _deques.size()];
+    {
+        std::lock_guard<std::mutex> lock( deque->_mutex );
+        deque->_subQueries.push_back( subQuery );
+    }
+    ++_size;
+
+    // The count is changed under the lock, so that a worker that is
+    // about to park sees it
+    {
+        std::lock_guard<std::mutex> lock( _parkMutex );
+        ++_numPushes;
+    }
+    _parkCondition.notify_one();
+}
+
+bool WorkerQueue::pop( unsigned worker, SubQuery *&subQuery )
+{
+    return popOwn( worker, subQuery ) || steal( worker, subQuery );
+}
+
+bool WorkerQueue::pop( SubQuery *&subQuery )
+{
+    return steal( _deques.size() - 1, subQuery ) || popOwn( _deques.size() - 1, subQuery );
+}
+
+bool WorkerQueue::popOwn( unsigned worker, SubQuery *&subQuery )
+{
+    WorkerDeque *deque = _deques[worker % _deques.size()];
+    std::lock_guard<std::mutex> lock( deque->_mutex );
+    if ( deque->_subQueries.empty() )
+        return false;
+
+    subQuery = deque->_subQueries.back();
+    deque->_subQueries.pop_back();
+    --_size;
+    return true;
+}
+
+bool WorkerQueue::steal( unsigned worker, SubQuery *&subQuery )
+{
+    // Look at the other workers in turn, starting from the next one,
+    // so that the victims are spread out
+    unsigned numDeques = _deques.size();
+    for ( unsigned i = 1; i < numDeques; ++i )
+    {
+        WorkerDeque *deque = _deques[( worker + i ) % numDeques];
+        std::lock_guard<std::mutex> lock( deque->_mutex );
+        if ( deque->_subQueries.empty() )
+            continue;
+
+        subQuery = deque->_subQueries.front();
+        deque->_subQueries.pop_front();
+        --_size;
+        ++_numSteals;
+        return true;
+    }
+
+    return false;
+}
+
+bool WorkerQueue::waitAndPop( unsigned worker, SubQuery *&subQuery,
+                              const std::atomic_bool &shouldQuit )
+{
+    while ( true )
+    {
+        unsigned long long numPushes;
+        {
+            std::lock_guard<std::mutex> lock( _parkMutex );
+            numPushes = _numPushes;
+        }
+
+        if ( pop( worker, subQuery ) )
+            return true;
+
+        if ( shouldQuit.load() )
+            return false;
+
+        // Park until something is pushed after the failed pop
+        std::unique_lock<std::mutex> lock( _parkMutex );
+        _parkCondition.wait( lock, [&]()
+        {
+            return _numPushes != numPushes || shouldQuit.load();
+        } );
+    }
+}
+
+void WorkerQueue::notifyQuit()
+{
+    {
+        std::lock_guard<std::mutex> lock( _parkMutex );
+    }
+    _parkCondition.notify_all();
+    _quitCondition.notify_all();
+}
+
+void WorkerQueue::waitForQuit( const std::atomic_bool &shouldQuit,
+                               unsigned long long timeoutInMicroseconds )
+{
+    std::unique_lock<std::mutex> lock( _parkMutex );
+    _quitCondition.wait_for( lock, std::chrono::microseconds( timeoutInMicroseconds ), [&]()
+    {
+        return shouldQuit.load();
+    } );
+}
+
+bool WorkerQueue::empty() const
+{
+    return _size.load() == 0;
+}
+
+unsigned WorkerQueue::size() const
+{
+    return _size.load();
+}
+
+unsigned WorkerQueue::getNumWorkers() const
+{
+    return _deques.size();
+}
+
+unsigned WorkerQueue::getNumSteals() const
+{
+    return _numSteals.load();
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
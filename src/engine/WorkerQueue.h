@@ -0,0 +1,123 @@
+/*********************                                                        */
+/*! \file WorkerQueue.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#ifndef __WorkerQueue_h__
+#define __WorkerQueue_h__
+
+#include "SubQuery.h"
+#include "Vector.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+/*
+  The subqueries shared by the DnC workers, kept in a deque per
+  worker.
+
+  A worker pushes the subqueries it creates to the back of its own
+  deque, and pops from the back as well, so that it goes on with the
+  children of the query it just divided. A worker whose deque is empty
+  steals from the front of the other deques, taking the oldest, and
+  typically largest, subqueries. Workers that find no work at all are
+  parked until a subquery is pushed or the search is over.
+*/
+class WorkerQueue
+{
+public:
+    WorkerQueue( unsigned numWorkers );
+    ~WorkerQueue();
+
+    /*
+      Push a subquery to the deque of the given worker.
+    */
+    void push( SubQuery *subQuery, unsigned worker = 0 );
+
+    /*
+      Pop a subquery for the given worker: from the back of its own
+      deque, or else from the front of another. Returns false if all
+      deques are empty.
+    */
+    bool pop( unsigned worker, SubQuery *&subQuery );
+
+    /*
+      Pop any subquery, e.g. for clearing the queue.
+    */
+    bool pop( SubQuery *&subQuery );
+
+    /*
+      As pop, but if no subquery is available, park the worker until
+      one is pushed or shouldQuit is set. Returns false if shouldQuit
+      was set while no subquery was available.
+    */
+    bool waitAndPop( unsigned worker, SubQuery *&subQuery,
+                     const std::atomic_bool &shouldQuit );
+
+    /*
+      Wake up all parked workers, and the manager, after shouldQuit
+      has been set.
+    */
+    void notifyQuit();
+
+    /*
+      Wait until shouldQuit is set, or until the given time passes.
+    */
+    void waitForQuit( const std::atomic_bool &shouldQuit,
+                      unsigned long long timeoutInMicroseconds );
+
+    bool empty() const;
+    unsigned size() const;
+    unsigned getNumWorkers() const;
+
+    /*
+      The number of subqueries taken from other workers' deques so far.
+    */
+    unsigned getNumSteals() const;
+
+private:
+    struct WorkerDeque
+    {
+        std::mutex _mutex;
+        std::deque<SubQuery *> _subQueries;
+    };
+
+    Vector<WorkerDeque *> _deques;
+
+    /*
+      Parked workers wait for the push count to change; the manager
+      waits for the quit flag.
+    */
+    std::mutex _parkMutex;
+    std::condition_variable _parkCondition;
+    std::condition_variable _quitCondition;
+    unsigned long long _numPushes;
+
+    std::atomic_uint _size;
+    std::atomic_uint _numSteals;
+
+    bool popOwn( unsigned worker, SubQuery *&subQuery );
+    bool steal( unsigned worker, SubQuery *&subQuery );
+};
+
+#endif // __WorkerQueue_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
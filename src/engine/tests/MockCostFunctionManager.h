@@ -85,6 +85,10 @@ public:
     {
     }
 
+    void computeGivenCostFunction( const Map<unsigned, double> &/* cost */ )
+    {
+    }
+
     double *nextCostFunction;
     const double *getCostFunction() const
     {
@@ -17,6 +17,7 @@
 #define __MockEngine_h__
 
 #include "IEngine.h"
+#include "InputQuery.h"
 #include "List.h"
 #include "PiecewiseLinearCaseSplit.h"
 #include "PiecewiseLinearConstraint.h"
@@ -30,6 +31,9 @@ public:
         wasDiscarded = false;
 
         lastStoredState = NULL;
+
+        nextNumUnfixedConstraints = 0;
+        nextOutputBoundGap = 0;
     }
     
     ~MockEngine()
@@ -89,14 +93,14 @@ public:
         }
     }
 
-    mutable EngineState *lastStoredState;
-    void storeState( EngineState &state, bool /* storeAlsoTableauState */ ) const
+    EngineState *lastStoredState;
+    void storeState( EngineState &state, bool /* storeAlsoTableauState */ )
     {
         lastStoredState = &state;
     }
 
     const EngineState *lastRestoredState;
-    void restoreState( const EngineState &state )
+    void restoreState( const EngineState &state, bool /* restoreAlsoPlConstraintStates */ )
     {
         lastRestoredState = &state;
     }
@@ -129,6 +133,13 @@ public:
         return _exitCode;
     }
 
+    Map<unsigned, double> nextSolution;
+    void extractSolution( InputQuery &inputQuery )
+    {
+        for ( const auto &value : nextSolution )
+            inputQuery.setSolutionValue( value.first, value.second );
+    }
+
     void reset()
     {
     }
@@ -144,6 +155,30 @@ public:
         return _inputVariables;
     }
 
+    List<Tightening> rootBounds;
+    void getRootBounds( List<Tightening> &bounds ) const
+    {
+        bounds = rootBounds;
+    }
+
+    List<Vector<unsigned>> learnedClauses;
+    void getLearnedClauses( List<Vector<unsigned>> &clauses ) const
+    {
+        clauses = learnedClauses;
+    }
+
+    List<Vector<unsigned>> lastAddedClauses;
+    void addLearnedClauses( const List<Vector<unsigned>> &clauses )
+    {
+        lastAddedClauses = clauses;
+    }
+
+    Map<unsigned, double> inputSensitivity;
+    void getInputSensitivity( Map<unsigned, double> &sensitivity ) const
+    {
+        sensitivity = inputSensitivity;
+    }
+
     mutable SmtState *lastRestoredSmtState;
     bool restoreSmtState( SmtState &smtState )
     {
@@ -165,6 +200,31 @@ public:
     {
         return NULL;
     }
+
+    List<PiecewiseLinearConstraint *> nextConstraintsToSplit;
+    List<PiecewiseLinearCaseSplit> lastSplitsToDivide;
+    PiecewiseLinearConstraint *pickSplitPLConstraintSnC( const PiecewiseLinearCaseSplit &split,
+                                                         DivideStrategy /* strategy */ )
+    {
+        lastSplitsToDivide.append( split );
+        if ( nextConstraintsToSplit.empty() )
+            return NULL;
+
+        PiecewiseLinearConstraint *constraint = nextConstraintsToSplit.front();
+        nextConstraintsToSplit.erase( nextConstraintsToSplit.begin() );
+        return constraint;
+    }
+
+    unsigned nextNumUnfixedConstraints;
+    double nextOutputBoundGap;
+    bool estimateSubQueryDifficulty( const PiecewiseLinearCaseSplit &/* split */,
+                                     unsigned &numUnfixedConstraints,
+                                     double &outputBoundGap )
+    {
+        numUnfixedConstraints = nextNumUnfixedConstraints;
+        outputBoundGap = nextOutputBoundGap;
+        return true;
+    }
 };
 
 #endif // __MockEngine_h__
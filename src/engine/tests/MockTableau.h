@@ -45,6 +45,9 @@ public:
         lastCostFunctionManager = NULL;
 
         nextLinearlyDependentResult = false;
+
+        nextLowerBounds = NULL;
+        nextUpperBounds = NULL;
     }
 
     ~MockTableau()
@@ -196,14 +199,16 @@ public:
         upperBounds[variable] = value;
     }
 
+    const double *nextLowerBounds;
     const double *getLowerBounds() const
     {
-        return NULL;
+        return nextLowerBounds;
     }
 
+    const double *nextUpperBounds;
     const double *getUpperBounds() const
     {
-        return NULL;
+        return nextUpperBounds;
     }
 
     bool allBoundsValid() const
@@ -493,6 +498,14 @@ public:
     {
     }
 
+    void setDeferValueNotifications( bool /* defer */ )
+    {
+    }
+
+    void notifyPendingVariableValues()
+    {
+    }
+
     Set<ResizeWatcher *> lastResizeWatchers;
     void registerResizeWatcher( ResizeWatcher *watcher )
     {
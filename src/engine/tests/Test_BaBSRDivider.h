@@ -0,0 +1,121 @@
+/*********************                                                        */
+/*! \file Test_BaBSRDivider.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include <cxxtest/TestSuite.h>
+
+#include "BaBSRDivider.h"
+#include "FloatUtils.h"
+#include "List.h"
+#include "MockEngine.h"
+#include "SubQuery.h"
+
+class BaBSRDividerTestSuite : public CxxTest::TestSuite
+{
+public:
+    MockEngine *engine;
+    List<unsigned> inputVariables;
+
+    void setUp()
+    {
+        TS_ASSERT( engine = new MockEngine );
+
+        // inputVariables x1 x2
+        inputVariables.append( 1 );
+        inputVariables.append( 2 );
+    }
+
+    void tearDown()
+    {
+        inputVariables.clear();
+        TS_ASSERT_THROWS_NOTHING( delete engine );
+    }
+
+    void divide( BaBSRDivider &divider, SubQueries &subQueries )
+    {
+        //   -2 <= x1 <= 2
+        //    3 <= x2 <= 5
+        PiecewiseLinearCaseSplit previousSplit;
+        previousSplit.storeBoundTightening( Tightening( 1, -2.0, Tightening::LB ) );
+        previousSplit.storeBoundTightening( Tightening( 1, 2.0, Tightening::UB ) );
+        previousSplit.storeBoundTightening( Tightening( 2, 3.0, Tightening::LB ) );
+        previousSplit.storeBoundTightening( Tightening( 2, 5.0, Tightening::UB ) );
+
+        divider.createSubQueries( 2, "mock", previousSplit, 10, subQueries );
+        TS_ASSERT_EQUALS( subQueries.size(), 2U );
+    }
+
+    double getBound( const SubQuery &subQuery, unsigned variable, Tightening::BoundType type )
+    {
+        for ( const auto &bound : subQuery._split->getBoundTightenings() )
+        {
+            if ( bound._variable == variable && bound._type == type )
+                return bound._value;
+        }
+
+        TS_ASSERT( false );
+        return 0;
+    }
+
+    void clearSubQueries( SubQueries &subQueries )
+    {
+        for ( const auto &subQuery : subQueries )
+            delete subQuery;
+        subQueries.clear();
+    }
+
+    void test_split_most_sensitive_input()
+    {
+        BaBSRDivider divider( inputVariables, engine );
+
+        // x2's interval is smaller, but the output is more sensitive to it
+        engine->inputSensitivity[1] = 0.1;
+        engine->inputSensitivity[2] = 1;
+
+        SubQueries subQueries;
+        divide( divider, subQueries );
+
+        const SubQuery &first = **subQueries.begin();
+        TS_ASSERT_EQUALS( first._queryId, "mock-1" );
+        TS_ASSERT( FloatUtils::areEqual( getBound( first, 1, Tightening::LB ), -2 ) );
+        TS_ASSERT( FloatUtils::areEqual( getBound( first, 1, Tightening::UB ), 2 ) );
+        TS_ASSERT( FloatUtils::areEqual( getBound( first, 2, Tightening::LB ), 3 ) );
+        TS_ASSERT( FloatUtils::areEqual( getBound( first, 2, Tightening::UB ), 4 ) );
+
+        clearSubQueries( subQueries );
+    }
+
+    void test_fall_back_to_largest_interval()
+    {
+        BaBSRDivider divider( inputVariables, engine );
+
+        SubQueries subQueries;
+        divide( divider, subQueries );
+
+        const SubQuery &first = **subQueries.begin();
+        TS_ASSERT( FloatUtils::areEqual( getBound( first, 1, Tightening::LB ), -2 ) );
+        TS_ASSERT( FloatUtils::areEqual( getBound( first, 1, Tightening::UB ), 0 ) );
+        TS_ASSERT( FloatUtils::areEqual( getBound( first, 2, Tightening::UB ), 5 ) );
+
+        clearSubQueries( subQueries );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
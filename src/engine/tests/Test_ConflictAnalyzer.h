@@ -0,0 +1,178 @@
+/*********************                                                        */
+/*! \file Test_ConflictAnalyzer.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include <cxxtest/TestSuite.h>
+
+#include "ConflictAnalyzer.h"
+#include "GlobalConfiguration.h"
+#include "MockCostFunctionManager.h"
+#include "MockEngine.h"
+#include "MockErrno.h"
+#include "MockTableau.h"
+#include "ReluConstraint.h"
+#include "SmtCore.h"
+
+class MockForConflictAnalyzer
+    : public MockErrno
+{
+public:
+};
+
+class ConflictAnalyzerTestSuite : public CxxTest::TestSuite
+{
+public:
+    MockForConflictAnalyzer *mock;
+    MockEngine *engine;
+    MockTableau *tableau;
+
+    void setUp()
+    {
+        TS_ASSERT( mock = new MockForConflictAnalyzer );
+        TS_ASSERT( engine = new MockEngine );
+        TS_ASSERT( tableau = new MockTableau );
+    }
+
+    void tearDown()
+    {
+        TS_ASSERT_THROWS_NOTHING( delete tableau );
+        TS_ASSERT_THROWS_NOTHING( delete engine );
+        TS_ASSERT_THROWS_NOTHING( delete mock );
+    }
+
+    void split( SmtCore &smtCore, ReluConstraint &relu )
+    {
+        for ( unsigned i = 0; i < GlobalConfiguration::CONSTRAINT_VIOLATION_THRESHOLD; ++i )
+            smtCore.reportViolatedConstraint( &relu );
+        smtCore.performSplit();
+    }
+
+    void test_bound_levels()
+    {
+        tableau->setDimensions( 1, 4 );
+
+        SmtCore smtCore( engine );
+        ConflictAnalyzer analyzer;
+        analyzer.setSmtCore( &smtCore );
+        analyzer.registerWithTableau( tableau );
+
+        ReluConstraint relu1( 0, 1 );
+        ReluConstraint relu2( 2, 3 );
+
+        split( smtCore, relu1 );
+        analyzer.notifyLowerBound( 1, 0.5 );
+
+        split( smtCore, relu2 );
+        analyzer.notifyUpperBound( 3, 0.2 );
+
+        TS_ASSERT_EQUALS( analyzer.getLowerBoundLevel( 0 ), 0U );
+        TS_ASSERT_EQUALS( analyzer.getLowerBoundLevel( 1 ), 1U );
+        TS_ASSERT_EQUALS( analyzer.getUpperBoundLevel( 1 ), 0U );
+        TS_ASSERT_EQUALS( analyzer.getUpperBoundLevel( 3 ), 2U );
+
+        // Levels above the current one are stale
+        TS_ASSERT( smtCore.popSplit() );
+        TS_ASSERT( smtCore.popSplit() );
+        TS_ASSERT_EQUALS( smtCore.getStackDepth(), 1U );
+        TS_ASSERT_EQUALS( analyzer.getUpperBoundLevel( 3 ), 1U );
+    }
+
+    void test_analyze_invalid_bounds()
+    {
+        tableau->setDimensions( 1, 4 );
+
+        double lowerBounds[4] = { -1, 0, -1, 0 };
+        double upperBounds[4] = { 1, 1, 1, 1 };
+        tableau->nextLowerBounds = lowerBounds;
+        tableau->nextUpperBounds = upperBounds;
+
+        SmtCore smtCore( engine );
+        ConflictAnalyzer analyzer;
+        analyzer.setSmtCore( &smtCore );
+        analyzer.registerWithTableau( tableau );
+
+        ReluConstraint relu1( 0, 1 );
+        ReluConstraint relu2( 2, 3 );
+
+        split( smtCore, relu1 );
+        lowerBounds[1] = 2;
+        analyzer.notifyLowerBound( 1, 2 );
+
+        split( smtCore, relu2 );
+        lowerBounds[3] = 3;
+        analyzer.notifyLowerBound( 3, 3 );
+
+        // Both x1 and x3 prove the conflict, and x1 does so at a lower
+        // level
+        analyzer.analyzeInvalidBounds( *tableau );
+        TS_ASSERT_EQUALS( analyzer.extractConflictLevel(), 1U );
+
+        // Once extracted, the conflict is at the current level
+        TS_ASSERT_EQUALS( analyzer.extractConflictLevel(), 2U );
+
+        analyzer.setConflictLevel( 0 );
+        TS_ASSERT_EQUALS( analyzer.extractConflictLevel(), 0U );
+
+        tableau->nextLowerBounds = NULL;
+        tableau->nextUpperBounds = NULL;
+    }
+
+    void test_analyze_simplex_failure()
+    {
+        // x3 is basic, x0, x1 and x2 are non-basic
+        tableau->setDimensions( 1, 4 );
+        tableau->nextBasicIndexToVariable[0] = 3;
+        tableau->nextNonBasicIndexToVariable[0] = 0;
+        tableau->nextNonBasicIndexToVariable[1] = 1;
+        tableau->nextNonBasicIndexToVariable[2] = 2;
+        tableau->nextBasicTooHigh.insert( 0 );
+
+        MockCostFunctionManager costFunctionManager;
+        costFunctionManager.nextCostFunction = new double[3];
+        costFunctionManager.nextCostFunction[0] = 1;
+        costFunctionManager.nextCostFunction[1] = 0;
+        costFunctionManager.nextCostFunction[2] = -1;
+        costFunctionManager.nextBasicCost[0] = 1;
+
+        SmtCore smtCore( engine );
+        ConflictAnalyzer analyzer;
+        analyzer.setSmtCore( &smtCore );
+        analyzer.registerWithTableau( tableau );
+
+        ReluConstraint relu1( 4, 5 );
+        ReluConstraint relu2( 6, 7 );
+        ReluConstraint relu3( 8, 9 );
+
+        split( smtCore, relu1 );
+        analyzer.notifyUpperBound( 2, 0 );
+
+        split( smtCore, relu2 );
+        analyzer.notifyLowerBound( 3, 1 );
+
+        // x1 has a zero reduced cost, so its bound is not needed
+        split( smtCore, relu3 );
+        analyzer.notifyLowerBound( 1, 1 );
+
+        analyzer.analyzeSimplexFailure( *tableau, costFunctionManager );
+        TS_ASSERT_EQUALS( analyzer.extractConflictLevel(), 2U );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,216 @@
+/*********************                                                        */
+/*! \file Test_ConstraintStateTrail.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include <cxxtest/TestSuite.h>
+
+#include "ConstraintStateTrail.h"
+#include "MockErrno.h"
+#include "ReluConstraint.h"
+#include "ReluLayerConstraint.h"
+
+class MockForConstraintStateTrail
+    : public MockErrno
+{
+public:
+};
+
+class MockTrailable : public ConstraintStateTrail::Trailable
+{
+public:
+    MockTrailable( unsigned id, List<unsigned> &undone )
+        : _id( id )
+        , _undone( undone )
+    {
+    }
+
+    void undoLastChange()
+    {
+        _undone.append( _id );
+    }
+
+    unsigned _id;
+    List<unsigned> &_undone;
+};
+
+class ConstraintStateTrailTestSuite : public CxxTest::TestSuite
+{
+public:
+    MockForConstraintStateTrail *mock;
+
+    void setUp()
+    {
+        TS_ASSERT( mock = new MockForConstraintStateTrail );
+    }
+
+    void tearDown()
+    {
+        TS_ASSERT_THROWS_NOTHING( delete mock );
+    }
+
+    void test_record_and_undo()
+    {
+        ConstraintStateTrail trail;
+        List<unsigned> undone;
+        MockTrailable first( 1, undone );
+        MockTrailable second( 2, undone );
+
+        TS_ASSERT_EQUALS( trail.size(), 0U );
+
+        unsigned checkpoint = trail.getCheckpoint();
+        trail.checkpoint();
+        TS_ASSERT_DIFFERS( trail.getCheckpoint(), checkpoint );
+
+        trail.record( &first );
+        trail.record( &second );
+        trail.record( &first );
+        TS_ASSERT_EQUALS( trail.size(), 3U );
+
+        // Changes are undone in reverse order
+        checkpoint = trail.getCheckpoint();
+        TS_ASSERT_THROWS_NOTHING( trail.undoTo( 1 ) );
+        TS_ASSERT_EQUALS( trail.size(), 1U );
+        TS_ASSERT_EQUALS( undone, List<unsigned>( { 1, 2 } ) );
+
+        // Undoing marks a new checkpoint
+        TS_ASSERT_DIFFERS( trail.getCheckpoint(), checkpoint );
+
+        // Nothing to undo past the end of the trail
+        TS_ASSERT_THROWS_NOTHING( trail.undoTo( 5 ) );
+        TS_ASSERT_EQUALS( trail.size(), 1U );
+
+        TS_ASSERT_THROWS_NOTHING( trail.undoTo( 0 ) );
+        TS_ASSERT_EQUALS( undone, List<unsigned>( { 1, 2, 1 } ) );
+    }
+
+    void test_relu_constraint()
+    {
+        ConstraintStateTrail trail;
+        ReluConstraint relu( 0, 2 );
+        relu.registerConstraintStateTrail( &trail );
+
+        // Before the first checkpoint, nothing is recorded
+        relu.notifyLowerBound( 0, -5 );
+        relu.notifyUpperBound( 0, 5 );
+        TS_ASSERT_EQUALS( trail.size(), 0U );
+
+        trail.checkpoint();
+
+        // The state is saved once per checkpoint
+        relu.notifyLowerBound( 0, 1 );
+        relu.notifyUpperBound( 0, 3 );
+        TS_ASSERT_EQUALS( trail.size(), 1U );
+        TS_ASSERT( relu.phaseFixed() );
+
+        // Notifications that change nothing are not recorded
+        trail.checkpoint();
+        relu.notifyLowerBound( 0, 0 );
+        TS_ASSERT_EQUALS( trail.size(), 1U );
+
+        relu.setActiveConstraint( false );
+        TS_ASSERT_EQUALS( trail.size(), 2U );
+
+        // Assignment changes are not recorded
+        trail.checkpoint();
+        relu.notifyVariableValue( 0, 2 );
+        TS_ASSERT_EQUALS( trail.size(), 2U );
+
+        trail.undoTo( 1 );
+        TS_ASSERT( relu.isActive() );
+        TS_ASSERT( relu.phaseFixed() );
+        TS_ASSERT_EQUALS( relu.getUpperBound( 0 ), 3 );
+
+        trail.undoTo( 0 );
+        TS_ASSERT( !relu.phaseFixed() );
+        TS_ASSERT_EQUALS( relu.getLowerBound( 0 ), -5 );
+        TS_ASSERT_EQUALS( relu.getUpperBound( 0 ), 5 );
+
+        // Changes after undoing are recorded again
+        relu.notifyUpperBound( 0, -1 );
+        TS_ASSERT_EQUALS( trail.size(), 1U );
+        TS_ASSERT_EQUALS( relu.getPhaseStatus(), ReluConstraint::PHASE_INACTIVE );
+        trail.undoTo( 0 );
+        TS_ASSERT( !relu.phaseFixed() );
+    }
+
+    void test_relu_layer()
+    {
+        ConstraintStateTrail trail;
+        ReluConstraint relu1( 0, 2 );
+        ReluConstraint relu2( 1, 3 );
+        ReluLayerConstraint layer( List<ReluConstraint *>( { &relu1, &relu2 } ) );
+
+        relu1.registerConstraintStateTrail( &trail );
+        relu2.registerConstraintStateTrail( &trail );
+        layer.registerConstraintStateTrail( &trail );
+
+        for ( unsigned i = 0; i < 4; ++i )
+        {
+            layer.notifyLowerBound( i, -10 );
+            layer.notifyUpperBound( i, 10 );
+            layer.notifyVariableValue( i, 1 );
+        }
+        layer.processPendingNotifications();
+        TS_ASSERT_EQUALS( trail.size(), 0U );
+
+        trail.checkpoint();
+
+        // A slot is saved once per checkpoint
+        layer.notifyLowerBound( 0, 1 );
+        layer.notifyUpperBound( 2, 5 );
+        layer.notifyUpperBound( 1, -1 );
+        TS_ASSERT_EQUALS( trail.size(), 2U );
+
+        TS_ASSERT_EQUALS( relu1.getPhaseStatus(), ReluConstraint::PHASE_ACTIVE );
+        TS_ASSERT_EQUALS( relu2.getPhaseStatus(), ReluConstraint::PHASE_INACTIVE );
+
+        trail.checkpoint();
+
+        // An attached ReLU saves its own state when deactivated
+        relu1.setActiveConstraint( false );
+        TS_ASSERT_EQUALS( trail.size(), 3U );
+
+        // Pending bounds are dropped when their slot is restored
+        layer.notifyLowerBound( 3, 2 );
+        TS_ASSERT( layer.hasPendingNotifications() );
+        TS_ASSERT_EQUALS( trail.size(), 4U );
+
+        trail.undoTo( 2 );
+        TS_ASSERT( relu1.isActive() );
+        TS_ASSERT_EQUALS( relu1.getPhaseStatus(), ReluConstraint::PHASE_ACTIVE );
+        TS_ASSERT_EQUALS( relu1.getLowerBound( 0 ), 1 );
+        TS_ASSERT_EQUALS( relu2.getPhaseStatus(), ReluConstraint::PHASE_INACTIVE );
+        TS_ASSERT_EQUALS( relu2.getLowerBound( 3 ), -10 );
+        layer.processPendingNotifications();
+        TS_ASSERT_EQUALS( relu2.getPhaseStatus(), ReluConstraint::PHASE_INACTIVE );
+
+        trail.undoTo( 0 );
+        TS_ASSERT( !relu1.phaseFixed() );
+        TS_ASSERT( !relu2.phaseFixed() );
+        TS_ASSERT_EQUALS( relu1.getLowerBound( 0 ), -10 );
+        TS_ASSERT_EQUALS( relu1.getUpperBound( 2 ), 10 );
+        TS_ASSERT_EQUALS( relu2.getUpperBound( 1 ), 10 );
+
+        // The assignment is kept
+        TS_ASSERT( relu1.satisfied() );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -183,6 +183,54 @@ public:
 
         TS_ASSERT_THROWS_NOTHING( delete manager );
     }
+
+    void test_compute_given_cost_function()
+    {
+        CostFunctionManager *manager = NULL;
+        MockTableau tableau;
+
+        unsigned n = 5;
+        unsigned m = 3;
+        tableau.setDimensions( m, n );
+
+        TS_ASSERT( manager = new CostFunctionManager( &tableau ) );
+        TS_ASSERT_THROWS_NOTHING( manager->initialize() );
+
+        double multipliers[3] = { 0, 2, -3 };
+        memcpy( tableau.nextBtranOutput, multipliers, sizeof(double) * 3 );
+        tableau.nextNonBasicIndexToVariable[0] = 2;
+        tableau.nextNonBasicIndexToVariable[1] = 0;
+        double columnZero[] = { 1, -1, 2 };
+        double columnTwo[] = { 3, 1, 0 };
+        tableau.nextAColumn[0] = columnZero;
+        tableau.nextAColumn[2] = columnTwo;
+
+        // Cost: 3x5 - x2. Variable 5 is basic #1, variable 2 is non-basic #0
+        Map<unsigned, double> cost;
+        tableau.nextVariableToIndex[5] = 1;
+        tableau.nextIsBasic.insert( 5 );
+        cost[5] = 3;
+        tableau.nextVariableToIndex[2] = 0;
+        cost[2] = -1;
+
+        TS_ASSERT_THROWS_NOTHING( manager->computeGivenCostFunction( cost ) );
+
+        // Only the given costs of basic variables are sent to BTRAN
+        double expectedBTranInput[] = { 0, 3, 0 };
+        TS_ASSERT_SAME_DATA( tableau.lastBtranInput, expectedBTranInput, sizeof(double) * m );
+
+        const double *costFucntion = manager->getCostFunction();
+        TS_ASSERT_EQUALS( costFucntion[0], -( 0 + 2 + 0 ) - 1 );
+        TS_ASSERT_EQUALS( costFucntion[1], -( 0 - 2 - 6 ) );
+
+        // All basic variables are treated as within bounds
+        for ( unsigned i = 0; i < m; ++i )
+            TS_ASSERT_EQUALS( manager->getBasicCost( i ), 0 );
+
+        TS_ASSERT( manager->costFunctionJustComputed() );
+
+        TS_ASSERT_THROWS_NOTHING( delete manager );
+    }
 };
 
 //
@@ -0,0 +1,144 @@
+/*********************                                                        */
+/*! \file Test_DnCChannel.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include <cxxtest/TestSuite.h>
+
+#include "DnCChannel.h"
+#include "MockErrno.h"
+
+#include <thread>
+#include <unistd.h>
+
+class MockForDnCChannel
+    : public MockErrno
+{
+public:
+};
+
+class DnCChannelTestSuite : public CxxTest::TestSuite
+{
+public:
+    MockForDnCChannel *mock;
+
+    void setUp()
+    {
+        TS_ASSERT( mock = new MockForDnCChannel );
+    }
+
+    void tearDown()
+    {
+        TS_ASSERT_THROWS_NOTHING( delete mock );
+    }
+
+    void test_send_and_receive()
+    {
+        int first;
+        int second;
+        TS_ASSERT_THROWS_NOTHING( DnCChannel::createLocalPair( first, second ) );
+        DnCChannel coordinator( first );
+        DnCChannel worker( second );
+
+        TS_ASSERT( coordinator.send( DnCChannel::SOLVE, std::string( "a\0b", 3 ) ) );
+        TS_ASSERT( coordinator.send( DnCChannel::QUIT, "" ) );
+
+        DnCChannel::MessageType type;
+        std::string payload;
+        TS_ASSERT( worker.receive( type, payload ) );
+        TS_ASSERT_EQUALS( type, DnCChannel::SOLVE );
+        TS_ASSERT( payload == std::string( "a\0b", 3 ) );
+
+        TS_ASSERT( worker.receive( type, payload ) );
+        TS_ASSERT_EQUALS( type, DnCChannel::QUIT );
+        TS_ASSERT( payload.empty() );
+
+        TS_ASSERT( worker.send( DnCChannel::RESULT, "done" ) );
+        TS_ASSERT( coordinator.receive( type, payload ) );
+        TS_ASSERT_EQUALS( type, DnCChannel::RESULT );
+        TS_ASSERT( payload == "done" );
+    }
+
+    void test_large_message()
+    {
+        int first;
+        int second;
+        DnCChannel::createLocalPair( first, second );
+        DnCChannel coordinator( first );
+        DnCChannel worker( second );
+
+        // Larger than the socket buffers, so that it is sent in pieces
+        std::string large;
+        for ( unsigned i = 0; i < 4000000; ++i )
+            large += (char)( i % 251 );
+
+        bool sent = false;
+        std::thread sender( [&]()
+        {
+            sent = coordinator.send( DnCChannel::SOLVE, large );
+        } );
+
+        DnCChannel::MessageType type;
+        std::string payload;
+        TS_ASSERT( worker.receive( type, payload ) );
+        sender.join();
+
+        TS_ASSERT( sent );
+        TS_ASSERT( payload == large );
+    }
+
+    void test_closed_channel()
+    {
+        int first;
+        int second;
+        DnCChannel::createLocalPair( first, second );
+        DnCChannel coordinator( first );
+        DnCChannel *worker = new DnCChannel( second );
+
+        // A message cut short by the other side closing is not received
+        unsigned header[2] = { DnCChannel::RESULT, 10 };
+        TS_ASSERT_EQUALS( write( second, header, sizeof( header ) ), (ssize_t)sizeof( header ) );
+        TS_ASSERT_THROWS_NOTHING( delete worker );
+
+        DnCChannel::MessageType type;
+        std::string payload;
+        TS_ASSERT( !coordinator.receive( type, payload ) );
+
+        // Sending to a closed channel fails, without raising SIGPIPE
+        TS_ASSERT( !coordinator.send( DnCChannel::SOLVE, "subquery" ) );
+    }
+
+    void test_invalid_message_type()
+    {
+        int first;
+        int second;
+        DnCChannel::createLocalPair( first, second );
+        DnCChannel coordinator( first );
+        DnCChannel worker( second );
+
+        unsigned header[2] = { 7, 0 };
+        TS_ASSERT_EQUALS( write( second, header, sizeof( header ) ), (ssize_t)sizeof( header ) );
+
+        DnCChannel::MessageType type;
+        std::string payload;
+        TS_ASSERT( !coordinator.receive( type, payload ) );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
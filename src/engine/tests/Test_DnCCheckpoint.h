@@ -0,0 +1,235 @@
+/*********************                                                        */
+/*! \file Test_DnCCheckpoint.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include <cxxtest/TestSuite.h>
+
+#include "DnCCheckpoint.h"
+#include "InputQuery.h"
+#include "MockErrno.h"
+
+#include <cstdio>
+
+class MockForDnCCheckpoint
+    : public MockErrno
+{
+public:
+};
+
+class DnCCheckpointTestSuite : public CxxTest::TestSuite
+{
+public:
+    MockForDnCCheckpoint *mock;
+
+    void setUp()
+    {
+        TS_ASSERT( mock = new MockForDnCCheckpoint );
+    }
+
+    void tearDown()
+    {
+        TS_ASSERT_THROWS_NOTHING( delete mock );
+    }
+
+    SubQuery *createSubQuery( const String &queryId, double lb, double ub,
+                              unsigned timeoutInSeconds )
+    {
+        auto split = std::unique_ptr<PiecewiseLinearCaseSplit>
+            ( new PiecewiseLinearCaseSplit );
+        split->storeBoundTightening( Tightening( 0, lb, Tightening::LB ) );
+        split->storeBoundTightening( Tightening( 0, ub, Tightening::UB ) );
+        return new SubQuery( queryId, split, timeoutInSeconds );
+    }
+
+    void deleteSubQueries( SubQueries &subQueries )
+    {
+        for ( auto &subQuery : subQueries )
+            delete subQuery;
+        subQueries.clear();
+    }
+
+    void test_track_subqueries()
+    {
+        DnCCheckpoint checkpoint( 7 );
+
+        SubQuery *first = createSubQuery( "1", 0, 1, 5 );
+        SubQuery *second = createSubQuery( "2", 1, 2, 5 );
+        checkpoint.addSubQuery( *first );
+        checkpoint.addSubQuery( *second );
+        TS_ASSERT_EQUALS( checkpoint.getNumOpenSubQueries(), 2U );
+
+        // The first subquery times out, and is divided in two
+        SubQueries children;
+        children.append( createSubQuery( "1-1", 0, 0.5, 7 ) );
+        children.append( createSubQuery( "1-2", 0.5, 1, 7 ) );
+        checkpoint.markDivided( "1", children );
+        TS_ASSERT_EQUALS( checkpoint.getNumOpenSubQueries(), 3U );
+
+        checkpoint.markSolved( "2" );
+        checkpoint.markSolved( "1-1" );
+        TS_ASSERT_EQUALS( checkpoint.getNumOpenSubQueries(), 1U );
+        TS_ASSERT_EQUALS( checkpoint.getNumSolvedSubQueries(), 2U );
+
+        // Unknown subqueries are ignored
+        TS_ASSERT_THROWS_NOTHING( checkpoint.markSolved( "3" ) );
+        TS_ASSERT_EQUALS( checkpoint.getNumSolvedSubQueries(), 2U );
+
+        SubQueries open;
+        checkpoint.getOpenSubQueries( open );
+        TS_ASSERT_EQUALS( open.size(), 1U );
+        TS_ASSERT_EQUALS( open.front()->_queryId, "1-2" );
+        TS_ASSERT_EQUALS( open.front()->_timeoutInSeconds, 7U );
+        TS_ASSERT( *open.front()->_split == *children.back()->_split );
+
+        List<List<Tightening>> regions;
+        checkpoint.getSolvedRegions( regions );
+        TS_ASSERT_EQUALS( regions.size(), 2U );
+        TS_ASSERT_EQUALS( regions.front().back()._value, 2 );
+        TS_ASSERT_EQUALS( regions.back().back()._value, 0.5 );
+
+        deleteSubQueries( open );
+        deleteSubQueries( children );
+        delete first;
+        delete second;
+    }
+
+    void test_serialize_and_deserialize()
+    {
+        DnCCheckpoint checkpoint( 7 );
+
+        SubQuery *subQuery = createSubQuery( "1", -1, 1, 3 );
+        Equation equation( Equation::LE );
+        equation.addAddend( 1, 0 );
+        equation.addAddend( -2.5, 3 );
+        equation.setScalar( 4 );
+        subQuery->_split->addEquation( equation );
+        checkpoint.addSubQuery( *subQuery );
+
+        SubQuery *solved = createSubQuery( "2", 1, 3, 3 );
+        checkpoint.addSubQuery( *solved );
+        checkpoint.markSolved( "2" );
+
+        std::string data;
+        checkpoint.serialize( data );
+
+        DnCCheckpoint restored( 7 );
+        TS_ASSERT( restored.deserialize( data ) );
+        TS_ASSERT_EQUALS( restored.getNumOpenSubQueries(), 1U );
+        TS_ASSERT_EQUALS( restored.getNumSolvedSubQueries(), 1U );
+
+        SubQueries open;
+        restored.getOpenSubQueries( open );
+        TS_ASSERT_EQUALS( open.size(), 1U );
+        TS_ASSERT_EQUALS( open.front()->_queryId, "1" );
+        TS_ASSERT_EQUALS( open.front()->_timeoutInSeconds, 3U );
+        TS_ASSERT( *open.front()->_split == *subQuery->_split );
+
+        // The restored checkpoint serializes to the same data
+        std::string restoredData;
+        restored.serialize( restoredData );
+        TS_ASSERT( restoredData == data );
+
+        deleteSubQueries( open );
+        delete subQuery;
+        delete solved;
+    }
+
+    void test_reject_invalid_data()
+    {
+        DnCCheckpoint checkpoint( 7 );
+        SubQuery *subQuery = createSubQuery( "1", 0, 1, 5 );
+        checkpoint.addSubQuery( *subQuery );
+
+        std::string data;
+        checkpoint.serialize( data );
+
+        DnCCheckpoint restored( 7 );
+        SubQuery *other = createSubQuery( "2", 0, 1, 5 );
+        restored.addSubQuery( *other );
+
+        // Another query
+        DnCCheckpoint otherQuery( 8 );
+        TS_ASSERT( !otherQuery.deserialize( data ) );
+
+        // Truncated or extended data
+        TS_ASSERT( !restored.deserialize( data.substr( 0, data.size() - 1 ) ) );
+        TS_ASSERT( !restored.deserialize( data + "x" ) );
+        TS_ASSERT( !restored.deserialize( "" ) );
+
+        // Another format
+        std::string corrupt = data;
+        corrupt[0] = 'X';
+        TS_ASSERT( !restored.deserialize( corrupt ) );
+
+        // A failed restore leaves the checkpoint unchanged
+        SubQueries open;
+        restored.getOpenSubQueries( open );
+        TS_ASSERT_EQUALS( open.size(), 1U );
+        TS_ASSERT_EQUALS( open.front()->_queryId, "2" );
+
+        deleteSubQueries( open );
+        delete subQuery;
+        delete other;
+    }
+
+    void test_save_and_load()
+    {
+        DnCCheckpoint checkpoint( 7 );
+        SubQuery *subQuery = createSubQuery( "1", 0, 1, 5 );
+        checkpoint.addSubQuery( *subQuery );
+
+        String path = "Test_DnCCheckpoint.checkpoint";
+        TS_ASSERT( checkpoint.save( path ) );
+
+        DnCCheckpoint restored( 7 );
+        TS_ASSERT( restored.load( path ) );
+        TS_ASSERT_EQUALS( restored.getNumOpenSubQueries(), 1U );
+
+        remove( path.ascii() );
+        TS_ASSERT( !restored.load( path ) );
+
+        delete subQuery;
+    }
+
+    void test_fingerprint()
+    {
+        InputQuery inputQuery;
+        inputQuery.setNumberOfVariables( 3 );
+        inputQuery.markInputVariable( 0, 0 );
+        inputQuery.setLowerBound( 0, -1 );
+        inputQuery.setUpperBound( 0, 1 );
+
+        InputQuery same = inputQuery;
+        TS_ASSERT_EQUALS( DnCCheckpoint::fingerprint( inputQuery ),
+                          DnCCheckpoint::fingerprint( same ) );
+
+        InputQuery otherBounds = inputQuery;
+        otherBounds.setUpperBound( 0, 2 );
+        TS_ASSERT_DIFFERS( DnCCheckpoint::fingerprint( inputQuery ),
+                           DnCCheckpoint::fingerprint( otherBounds ) );
+
+        InputQuery otherSize = inputQuery;
+        otherSize.setNumberOfVariables( 4 );
+        TS_ASSERT_DIFFERS( DnCCheckpoint::fingerprint( inputQuery ),
+                           DnCCheckpoint::fingerprint( otherSize ) );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
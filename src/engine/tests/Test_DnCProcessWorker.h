@@ -0,0 +1,182 @@
+/*********************                                                        */
+/*! \file Test_DnCProcessWorker.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include <cxxtest/TestSuite.h>
+
+#include "DnCProcessWorker.h"
+#include "MockEngine.h"
+#include "MockErrno.h"
+#include "SubQuerySerializer.h"
+
+#include <thread>
+
+class MockForDnCProcessWorker
+    : public MockErrno
+{
+public:
+};
+
+class DnCProcessWorkerTestSuite : public CxxTest::TestSuite
+{
+public:
+    MockForDnCProcessWorker *mock;
+
+    void setUp()
+    {
+        TS_ASSERT( mock = new MockForDnCProcessWorker );
+    }
+
+    void tearDown()
+    {
+        TS_ASSERT_THROWS_NOTHING( delete mock );
+    }
+
+    SubQuery *createSubQuery( const String &queryId, unsigned timeoutInSeconds )
+    {
+        auto split = std::unique_ptr<PiecewiseLinearCaseSplit>
+            ( new PiecewiseLinearCaseSplit );
+        split->storeBoundTightening( Tightening( 1, -2, Tightening::LB ) );
+        split->storeBoundTightening( Tightening( 1, 2, Tightening::UB ) );
+        split->storeBoundTightening( Tightening( 2, 3, Tightening::LB ) );
+        split->storeBoundTightening( Tightening( 2, 5, Tightening::UB ) );
+        return new SubQuery( queryId, split, timeoutInSeconds );
+    }
+
+    void solve( DnCChannel &coordinator, const String &queryId,
+                DnCProcessWorker::Result &result )
+    {
+        SubQuery *subQuery = createSubQuery( queryId, 5 );
+        std::string payload;
+        SubQueryWriter( payload ).writeSubQuery( *subQuery );
+        delete subQuery;
+
+        TS_ASSERT( coordinator.send( DnCChannel::SOLVE, payload ) );
+
+        DnCChannel::MessageType type;
+        TS_ASSERT( coordinator.receive( type, payload ) );
+        TS_ASSERT_EQUALS( type, DnCChannel::RESULT );
+        TS_ASSERT( DnCProcessWorker::decodeResult( payload, result ) );
+        TS_ASSERT_EQUALS( result._queryId, queryId );
+    }
+
+    void test_encode_and_decode_result()
+    {
+        DnCProcessWorker::Result result;
+        result._queryId = "1-2";
+        result._exitCode = IEngine::TIMEOUT;
+        result._subQueries.append( createSubQuery( "1-2-1", 7 ) );
+        result._subQueries.append( createSubQuery( "1-2-2", 8 ) );
+        result._solution.append( 0.5 );
+
+        std::string payload;
+        DnCProcessWorker::encodeResult( result, payload );
+
+        DnCProcessWorker::Result decoded;
+        TS_ASSERT( DnCProcessWorker::decodeResult( payload, decoded ) );
+        TS_ASSERT_EQUALS( decoded._queryId, "1-2" );
+        TS_ASSERT_EQUALS( decoded._exitCode, IEngine::TIMEOUT );
+        TS_ASSERT_EQUALS( decoded._subQueries.size(), 2U );
+        TS_ASSERT_EQUALS( decoded._subQueries.back()->_queryId, "1-2-2" );
+        TS_ASSERT_EQUALS( decoded._subQueries.back()->_timeoutInSeconds, 8U );
+        TS_ASSERT( *decoded._subQueries.back()->_split == *result._subQueries.back()->_split );
+        TS_ASSERT_EQUALS( decoded._solution.size(), 1U );
+        TS_ASSERT_EQUALS( decoded._solution[0], 0.5 );
+
+        // Truncated results are rejected
+        DnCProcessWorker::Result truncated;
+        TS_ASSERT( !DnCProcessWorker::decodeResult( payload.substr( 0, payload.size() - 1 ),
+                                                    truncated ) );
+
+        for ( auto &subQuery : result._subQueries )
+            delete subQuery;
+        for ( auto &subQuery : decoded._subQueries )
+            delete subQuery;
+        for ( auto &subQuery : truncated._subQueries )
+            delete subQuery;
+    }
+
+    void test_solve_subqueries()
+    {
+        auto engine = std::make_shared<MockEngine>();
+        List<unsigned> inputVariables = { 1, 2 };
+        engine->setInputVariables( inputVariables );
+
+        InputQuery inputQuery;
+        inputQuery.setNumberOfVariables( 3 );
+
+        int first;
+        int second;
+        DnCChannel::createLocalPair( first, second );
+        DnCChannel coordinator( first );
+        DnCChannel workerChannel( second );
+
+        DnCProcessWorker worker( &workerChannel, engine, &inputQuery, 0, 1, 2,
+                                 DivideStrategy::LargestInterval );
+        std::thread process( [&]()
+        {
+            worker.run();
+        } );
+
+        // Each subquery is solved on its own
+        engine->setTimeToSolve( 10 );
+        engine->setExitCode( IEngine::UNSAT );
+        DnCProcessWorker::Result unsat;
+        solve( coordinator, "1", unsat );
+        TS_ASSERT_EQUALS( unsat._exitCode, IEngine::UNSAT );
+        TS_ASSERT( unsat._subQueries.empty() );
+
+        engine->setExitCode( IEngine::UNSAT );
+        DnCProcessWorker::Result again;
+        solve( coordinator, "2", again );
+        TS_ASSERT_EQUALS( again._exitCode, IEngine::UNSAT );
+
+        // A subquery that times out is divided, and the new subqueries
+        // are sent back with their budgets
+        engine->setExitCode( IEngine::TIMEOUT );
+        DnCProcessWorker::Result timeout;
+        solve( coordinator, "3", timeout );
+        TS_ASSERT_EQUALS( timeout._exitCode, IEngine::TIMEOUT );
+        TS_ASSERT_EQUALS( timeout._subQueries.size(), 2U );
+        for ( const auto &subQuery : timeout._subQueries )
+        {
+            TS_ASSERT( subQuery->_queryId.contains( "3-" ) );
+            TS_ASSERT_EQUALS( subQuery->_timeoutInSeconds, 10U );
+            delete subQuery;
+        }
+
+        // A satisfiable subquery comes with the assignment
+        engine->setExitCode( IEngine::SAT );
+        engine->nextSolution[0] = 1.5;
+        engine->nextSolution[1] = 0;
+        engine->nextSolution[2] = -1;
+        DnCProcessWorker::Result sat;
+        solve( coordinator, "4", sat );
+        TS_ASSERT_EQUALS( sat._exitCode, IEngine::SAT );
+        TS_ASSERT_EQUALS( sat._solution.size(), 3U );
+        TS_ASSERT_EQUALS( sat._solution[0], 1.5 );
+        TS_ASSERT_EQUALS( sat._solution[2], -1 );
+
+        TS_ASSERT( coordinator.send( DnCChannel::QUIT, "" ) );
+        process.join();
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -97,7 +97,7 @@ public:
         subQuery->_queryId = "";
         subQuery->_split = std::move( split );
         subQuery->_timeoutInSeconds = 5;
-        TS_ASSERT( _workload->push( std::move( subQuery ) ) );
+        TS_ASSERT_THROWS_NOTHING( _workload->push( subQuery ) );
     }
 
     // Test different branches of DnCWorker.popOneSubQueryAndSolve()
@@ -252,6 +252,70 @@ public:
         TS_ASSERT( numUnsolvedSubQueries.load() == 1 );
         TS_ASSERT( shouldQuitSolving.load() );
     }
+
+    void test_shared_knowledge()
+    {
+        SharedKnowledgeStore sharedKnowledge( 10 );
+
+        //  A subQuery times out after its root bounds have been derived,
+        //  and clauses have been learned. These are published under the
+        //  subQuery's box, except for the clauses that are too long
+        TS_ASSERT( clearSubQueries() == 0 );
+
+        createPlaceHolderSubQuery();
+        _engine->setTimeToSolve( 10 );
+        _engine->setExitCode( IEngine::TIMEOUT );
+        _engine->rootBounds = {
+            Tightening( 1, -1.0, Tightening::LB ),
+            Tightening( 7, 0.5, Tightening::LB ),
+            Tightening( 7, 4.0, Tightening::UB ),
+        };
+
+        Vector<unsigned> shortClause;
+        shortClause.append( 4 );
+        shortClause.append( 9 );
+        Vector<unsigned> longClause;
+        for ( unsigned i = 0; i <= GlobalConfiguration::DNC_SHARED_CLAUSE_MAX_LENGTH; ++i )
+            longClause.append( 2 * i );
+        _engine->learnedClauses = { shortClause, longClause };
+
+        std::atomic_uint numUnsolvedSubQueries( 1 );
+        std::atomic_bool shouldQuitSolving( false );
+        DnCWorker dncWorker( _workload, _engine, numUnsolvedSubQueries,
+                             shouldQuitSolving, 0, 1, 1,
+                             DivideStrategy::LargestInterval, 0,
+                             &sharedKnowledge );
+
+        dncWorker.popOneSubQueryAndSolve();
+        TS_ASSERT_EQUALS( sharedKnowledge.size(), 1U );
+        TS_ASSERT_EQUALS( numUnsolvedSubQueries.load(), 2U );
+
+        //  The children of the subQuery start from the published bounds
+        //  and clauses
+        _engine->lastLowerBounds.clear();
+        _engine->lastUpperBounds.clear();
+        _engine->setExitCode( IEngine::UNSAT );
+        dncWorker.popOneSubQueryAndSolve();
+
+        bool foundLowerBound = false;
+        for ( const auto &bound : _engine->lastLowerBounds )
+        {
+            if ( bound._variable == 7 && bound._bound == 0.5 )
+                foundLowerBound = true;
+        }
+        TS_ASSERT( foundLowerBound );
+
+        bool foundUpperBound = false;
+        for ( const auto &bound : _engine->lastUpperBounds )
+        {
+            if ( bound._variable == 7 && bound._bound == 4.0 )
+                foundUpperBound = true;
+        }
+        TS_ASSERT( foundUpperBound );
+
+        TS_ASSERT_EQUALS( _engine->lastAddedClauses.size(), 1U );
+        TS_ASSERT_EQUALS( _engine->lastAddedClauses.front(), shortClause );
+    }
 };
 
 //
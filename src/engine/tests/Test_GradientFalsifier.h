@@ -0,0 +1,249 @@
+/*********************                                                        */
+/*! \file Test_GradientFalsifier.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include <cxxtest/TestSuite.h>
+
+#include "FloatUtils.h"
+#include "GradientFalsifier.h"
+#include "MockTableau.h"
+#include "NetworkLevelReasoner.h"
+
+class MockForGradientFalsifier
+{
+public:
+};
+
+class GradientFalsifierTestSuite : public CxxTest::TestSuite
+{
+public:
+    MockForGradientFalsifier *mock;
+
+    void setUp()
+    {
+        TS_ASSERT( mock = new MockForGradientFalsifier );
+    }
+
+    void tearDown()
+    {
+        TS_ASSERT_THROWS_NOTHING( delete mock );
+    }
+
+    void populateNetwork( NLR::NetworkLevelReasoner &nlr )
+    {
+        /*
+                a
+          x           d    f
+                b
+          y           e    g
+                c
+        */
+
+        nlr.addLayer( 0, NLR::Layer::INPUT, 2 );
+        nlr.addLayer( 1, NLR::Layer::WEIGHTED_SUM, 3 );
+        nlr.addLayer( 2, NLR::Layer::RELU, 3 );
+        nlr.addLayer( 3, NLR::Layer::WEIGHTED_SUM, 2 );
+        nlr.addLayer( 4, NLR::Layer::RELU, 2 );
+        nlr.addLayer( 5, NLR::Layer::WEIGHTED_SUM, 2 );
+
+        for ( unsigned i = 1; i <= 5; ++i )
+            nlr.addLayerDependency( i - 1, i );
+
+        nlr.setWeight( 0, 0, 1, 0, 1 );
+        nlr.setWeight( 0, 0, 1, 1, 2 );
+        nlr.setWeight( 0, 1, 1, 1, -3 );
+        nlr.setWeight( 0, 1, 1, 2, 1 );
+
+        nlr.setWeight( 2, 0, 3, 0, 1 );
+        nlr.setWeight( 2, 0, 3, 1, -1 );
+        nlr.setWeight( 2, 1, 3, 0, 1 );
+        nlr.setWeight( 2, 1, 3, 1, 1 );
+        nlr.setWeight( 2, 2, 3, 0, -1 );
+        nlr.setWeight( 2, 2, 3, 1, -1 );
+
+        nlr.setWeight( 4, 0, 5, 0, 1 );
+        nlr.setWeight( 4, 0, 5, 1, 1 );
+        nlr.setWeight( 4, 1, 5, 1, 3 );
+
+        nlr.setBias( 1, 0, 1 );
+        nlr.setBias( 3, 1, 2 );
+
+        nlr.addActivationSource( 1, 0, 2, 0 );
+        nlr.addActivationSource( 1, 1, 2, 1 );
+        nlr.addActivationSource( 1, 2, 2, 2 );
+
+        nlr.addActivationSource( 3, 0, 4, 0 );
+        nlr.addActivationSource( 3, 1, 4, 1 );
+
+        nlr.setNeuronVariable( NLR::NeuronIndex( 0, 0 ), 0 );
+        nlr.setNeuronVariable( NLR::NeuronIndex( 0, 1 ), 1 );
+
+        nlr.setNeuronVariable( NLR::NeuronIndex( 1, 0 ), 2 );
+        nlr.setNeuronVariable( NLR::NeuronIndex( 1, 1 ), 4 );
+        nlr.setNeuronVariable( NLR::NeuronIndex( 1, 2 ), 6 );
+
+        nlr.setNeuronVariable( NLR::NeuronIndex( 2, 0 ), 3 );
+        nlr.setNeuronVariable( NLR::NeuronIndex( 2, 1 ), 5 );
+        nlr.setNeuronVariable( NLR::NeuronIndex( 2, 2 ), 7 );
+
+        nlr.setNeuronVariable( NLR::NeuronIndex( 3, 0 ), 8 );
+        nlr.setNeuronVariable( NLR::NeuronIndex( 3, 1 ), 10 );
+
+        nlr.setNeuronVariable( NLR::NeuronIndex( 4, 0 ), 9 );
+        nlr.setNeuronVariable( NLR::NeuronIndex( 4, 1 ), 11 );
+
+        nlr.setNeuronVariable( NLR::NeuronIndex( 5, 0 ), 12 );
+        nlr.setNeuronVariable( NLR::NeuronIndex( 5, 1 ), 13 );
+    }
+
+    void setLooseBounds( MockTableau &tableau, unsigned n )
+    {
+        tableau.lastN = n;
+        for ( unsigned i = 0; i < n; ++i )
+        {
+            tableau.setLowerBound( i, -1000 );
+            tableau.setUpperBound( i, 1000 );
+        }
+
+        tableau.setLowerBound( 0, -1 );
+        tableau.setUpperBound( 0, 1 );
+        tableau.setLowerBound( 1, -1 );
+        tableau.setUpperBound( 1, 1 );
+    }
+
+    void test_falsify_output_bound()
+    {
+        NLR::NetworkLevelReasoner nlr;
+        populateNetwork( nlr );
+
+        MockTableau tableau;
+        setLooseBounds( tableau, 14 );
+
+        // f >= 3 does not hold at the center of the box
+        tableau.setLowerBound( 12, 3 );
+
+        List<Equation> equations;
+        GradientFalsifier falsifier( &nlr, equations, &tableau );
+
+        TS_ASSERT( falsifier.run( 5, 0 ) );
+        TS_ASSERT( falsifier.getNumberOfAttempts() >= 1 );
+        TS_ASSERT( falsifier.getNumberOfAttempts() <= 5 );
+
+        // The assignment is consistent with the network
+        double input[2] = { falsifier.getValue( 0 ), falsifier.getValue( 1 ) };
+        double output[2];
+        nlr.evaluate( input, output );
+
+        TS_ASSERT( FloatUtils::gte( input[0], -1 ) && FloatUtils::lte( input[0], 1 ) );
+        TS_ASSERT( FloatUtils::gte( input[1], -1 ) && FloatUtils::lte( input[1], 1 ) );
+        TS_ASSERT( FloatUtils::areEqual( output[0], falsifier.getValue( 12 ) ) );
+        TS_ASSERT( FloatUtils::gte( falsifier.getValue( 12 ), 3 ) );
+    }
+
+    void test_falsify_derived_variable()
+    {
+        NLR::NetworkLevelReasoner nlr;
+        populateNetwork( nlr );
+
+        MockTableau tableau;
+        setLooseBounds( tableau, 16 );
+
+        // x14 = f - g, x15 = x14 - x0, and x15 must be in [-6, -5]
+        Equation equation1;
+        equation1.addAddend( 1, 12 );
+        equation1.addAddend( -1, 13 );
+        equation1.addAddend( -1, 14 );
+        equation1.setScalar( 0 );
+
+        Equation equation2;
+        equation2.addAddend( 1, 14 );
+        equation2.addAddend( -1, 0 );
+        equation2.addAddend( -1, 15 );
+        equation2.setScalar( 0 );
+
+        tableau.setLowerBound( 15, -6 );
+        tableau.setUpperBound( 15, -5 );
+
+        List<Equation> equations;
+        equations.append( equation2 );
+        equations.append( equation1 );
+
+        GradientFalsifier falsifier( &nlr, equations, &tableau );
+        TS_ASSERT( falsifier.run( 10, 0 ) );
+
+        double x14 = falsifier.getValue( 12 ) - falsifier.getValue( 13 );
+        TS_ASSERT( FloatUtils::areEqual( falsifier.getValue( 14 ), x14 ) );
+        TS_ASSERT( FloatUtils::areEqual( falsifier.getValue( 15 ), x14 - falsifier.getValue( 0 ) ) );
+        TS_ASSERT( FloatUtils::gte( falsifier.getValue( 15 ), -6 ) );
+        TS_ASSERT( FloatUtils::lte( falsifier.getValue( 15 ), -5 ) );
+    }
+
+    void test_infeasible_query()
+    {
+        NLR::NetworkLevelReasoner nlr;
+        populateNetwork( nlr );
+
+        MockTableau tableau;
+        setLooseBounds( tableau, 14 );
+
+        // f is at most 7 within the box
+        tableau.setLowerBound( 12, 100 );
+
+        List<Equation> equations;
+        GradientFalsifier falsifier( &nlr, equations, &tableau );
+
+        TS_ASSERT( !falsifier.run( 3, 0 ) );
+        TS_ASSERT_EQUALS( falsifier.getNumberOfAttempts(), 3U );
+    }
+
+    void test_unsupported_query()
+    {
+        NLR::NetworkLevelReasoner nlr;
+        populateNetwork( nlr );
+
+        MockTableau tableau;
+        setLooseBounds( tableau, 16 );
+
+        // Two unknowns in the same equation
+        Equation equation;
+        equation.addAddend( 1, 12 );
+        equation.addAddend( -1, 14 );
+        equation.addAddend( -1, 15 );
+        equation.setScalar( 0 );
+
+        List<Equation> equations;
+        equations.append( equation );
+
+        GradientFalsifier falsifier( &nlr, equations, &tableau );
+        TS_ASSERT( !falsifier.run( 3, 0 ) );
+        TS_ASSERT_EQUALS( falsifier.getNumberOfAttempts(), 0U );
+
+        // Unbounded inputs are not supported either
+        MockTableau unboundedTableau;
+        setLooseBounds( unboundedTableau, 14 );
+        unboundedTableau.setUpperBound( 0, FloatUtils::infinity() );
+
+        List<Equation> noEquations;
+        GradientFalsifier unboundedFalsifier( &nlr, noEquations, &unboundedTableau );
+        TS_ASSERT( !unboundedFalsifier.run( 3, 0 ) );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
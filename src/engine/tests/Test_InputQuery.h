@@ -15,12 +15,16 @@
 
 #include <cxxtest/TestSuite.h>
 
+#include "AbsoluteValueConstraint.h"
 #include "Engine.h"
 #include "FloatUtils.h"
 #include "InputQuery.h"
+#include "MaxConstraint.h"
 #include "MockErrno.h"
 #include "MockFileFactory.h"
+#include "NetworkLevelReasoner.h"
 #include "ReluConstraint.h"
+#include "SignConstraint.h"
 #include "MarabouError.h"
 
 #include <string.h>
@@ -181,6 +185,68 @@ public:
 
         delete inputQuery;
     }
+
+    void test_construct_network_level_reasoner_abs_sign_max()
+    {
+        /*
+          x2 = x0 + x1
+          x3 = x0 - x1
+          x4 = | x2 |
+          x5 = sign( x3 )
+          x6 = max( x4, x5 )
+        */
+        InputQuery inputQuery;
+        inputQuery.setNumberOfVariables( 7 );
+        inputQuery.markInputVariable( 0, 0 );
+        inputQuery.markInputVariable( 1, 1 );
+        inputQuery.markOutputVariable( 6, 0 );
+
+        Equation equation1;
+        equation1.addAddend( 1, 0 );
+        equation1.addAddend( 1, 1 );
+        equation1.addAddend( -1, 2 );
+        equation1.setScalar( 0 );
+        inputQuery.addEquation( equation1 );
+
+        Equation equation2;
+        equation2.addAddend( 1, 0 );
+        equation2.addAddend( -1, 1 );
+        equation2.addAddend( -1, 3 );
+        equation2.setScalar( 0 );
+        inputQuery.addEquation( equation2 );
+
+        inputQuery.addPiecewiseLinearConstraint( new AbsoluteValueConstraint( 2, 4 ) );
+        inputQuery.addPiecewiseLinearConstraint( new SignConstraint( 3, 5 ) );
+        inputQuery.addPiecewiseLinearConstraint( new MaxConstraint( 6, Set<unsigned>( { 4, 5 } ) ) );
+
+        TS_ASSERT( inputQuery.constructNetworkLevelReasoner() );
+
+        NLR::NetworkLevelReasoner *nlr = inputQuery.getNetworkLevelReasoner();
+        TS_ASSERT( nlr );
+        TS_ASSERT_EQUALS( nlr->getNumberOfLayers(), 5U );
+
+        TS_ASSERT_EQUALS( nlr->getLayer( 0 )->getLayerType(), NLR::Layer::INPUT );
+        TS_ASSERT_EQUALS( nlr->getLayer( 1 )->getLayerType(), NLR::Layer::WEIGHTED_SUM );
+        TS_ASSERT_EQUALS( nlr->getLayer( 2 )->getLayerType(), NLR::Layer::ABSOLUTE_VALUE );
+        TS_ASSERT_EQUALS( nlr->getLayer( 3 )->getLayerType(), NLR::Layer::SIGN );
+        TS_ASSERT_EQUALS( nlr->getLayer( 4 )->getLayerType(), NLR::Layer::MAX );
+
+        TS_ASSERT_EQUALS( nlr->getLayer( 4 )->neuronToVariable( 0 ), 6U );
+        TS_ASSERT_EQUALS( nlr->getLayer( 4 )->getActivationSources( 0 ).size(), 2U );
+
+        double input[2];
+        double output[1];
+
+        input[0] = 1;
+        input[1] = 2;
+        TS_ASSERT_THROWS_NOTHING( nlr->evaluate( input, output ) );
+        TS_ASSERT( FloatUtils::areEqual( output[0], 3 ) );
+
+        input[0] = 0.5;
+        input[1] = 0.25;
+        TS_ASSERT_THROWS_NOTHING( nlr->evaluate( input, output ) );
+        TS_ASSERT( FloatUtils::areEqual( output[0], 1 ) );
+    }
 };
 
 //
@@ -0,0 +1,234 @@
+/*********************                                                        */
+/*! \file Test_NativeLPSolver.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include <cxxtest/TestSuite.h>
+
+#include "FloatUtils.h"
+#include "MString.h"
+#include "MarabouError.h"
+#include "MockErrno.h"
+#include "NativeLPSolver.h"
+
+class NativeLPSolverTestSuite : public CxxTest::TestSuite
+{
+public:
+    MockErrno *mockErrno;
+
+    void setUp()
+    {
+        TS_ASSERT( mockErrno = new MockErrno );
+    }
+
+    void tearDown()
+    {
+        TS_ASSERT_THROWS_NOTHING( delete mockErrno );
+    }
+
+    double solveFor( NativeLPSolver &solver, const String &variable, bool maximize )
+    {
+        List<ILPSolver::Term> terms = { ILPSolver::Term( 1, variable ) };
+
+        solver.reset();
+        if ( maximize )
+            solver.setObjective( terms );
+        else
+            solver.setCost( terms );
+        solver.solve();
+
+        TS_ASSERT( solver.optimal() );
+
+        Map<String, double> dontCare;
+        double result = 0;
+        solver.extractSolution( dontCare, result );
+
+        TS_ASSERT( FloatUtils::areEqual( result, solver.getObjectiveBound() ) );
+        return result;
+    }
+
+    void test_optimize()
+    {
+        NativeLPSolver solver;
+
+        solver.addVariable( "x", 0, 3 );
+        solver.addVariable( "y", 0, 3 );
+        solver.addVariable( "z", 0, 3 );
+
+        // x + y + z <= 5
+        List<ILPSolver::Term> contraint = {
+            ILPSolver::Term( 1, "x" ),
+            ILPSolver::Term( 1, "y" ),
+            ILPSolver::Term( 1, "z" ),
+        };
+
+        solver.addLeqConstraint( contraint, 5 );
+
+        // Cost: -x - 2y + z
+        List<ILPSolver::Term> cost = {
+            ILPSolver::Term( -1, "x" ),
+            ILPSolver::Term( -2, "y" ),
+            ILPSolver::Term( +1, "z" ),
+        };
+
+        solver.setCost( cost );
+
+        TS_ASSERT_THROWS_NOTHING( solver.solve() );
+        TS_ASSERT( solver.optimal() );
+        TS_ASSERT( !solver.infeasbile() );
+        TS_ASSERT( !solver.timeout() );
+
+        Map<String, double> solution;
+        double costValue;
+
+        TS_ASSERT_THROWS_NOTHING( solver.extractSolution( solution, costValue ) );
+
+        TS_ASSERT( FloatUtils::areEqual( solution["x"], 2 ) );
+        TS_ASSERT( FloatUtils::areEqual( solution["y"], 3 ) );
+        TS_ASSERT( FloatUtils::areEqual( solution["z"], 0 ) );
+
+        TS_ASSERT( FloatUtils::areEqual( costValue, -8 ) );
+    }
+
+    void test_relu_triangle_relaxation_with_warm_start()
+    {
+        NativeLPSolver solver;
+
+        // y = ReLU( x ), x in [-1, 2]
+        solver.addVariable( "x", -1, 2 );
+        solver.addVariable( "y", 0, 2 );
+
+        // y >= x
+        solver.addGeqConstraint( { ILPSolver::Term( 1, "y" ), ILPSolver::Term( -1, "x" ) }, 0 );
+
+        // y <= 2/3 x + 2/3
+        solver.addLeqConstraint( { ILPSolver::Term( 1, "y" ), ILPSolver::Term( -2.0 / 3, "x" ) }, 2.0 / 3 );
+
+        TS_ASSERT( FloatUtils::areEqual( solveFor( solver, "y", true ), 2 ) );
+        TS_ASSERT( FloatUtils::areEqual( solveFor( solver, "y", false ), 0 ) );
+        TS_ASSERT( FloatUtils::areEqual( solveFor( solver, "x", true ), 2 ) );
+        TS_ASSERT( FloatUtils::areEqual( solveFor( solver, "x", false ), -1 ) );
+
+        // Tightening a bound keeps the model
+        solver.setUpperBound( "x", 1 );
+        TS_ASSERT( FloatUtils::areEqual( solveFor( solver, "y", true ), 4.0 / 3 ) );
+
+        solver.setLowerBound( "y", 0.5 );
+        TS_ASSERT( FloatUtils::areEqual( solveFor( solver, "x", false ), -0.25 ) );
+
+        // Loosening a bound is also supported
+        solver.setUpperBound( "x", 2 );
+        solver.setLowerBound( "y", 0 );
+        TS_ASSERT( FloatUtils::areEqual( solveFor( solver, "y", true ), 2 ) );
+        TS_ASSERT( FloatUtils::areEqual( solveFor( solver, "x", false ), -1 ) );
+    }
+
+    void test_equality_constraints()
+    {
+        NativeLPSolver solver;
+
+        solver.addVariable( "x", 0, 5 );
+        solver.addVariable( "y", 0, 2 );
+        solver.addVariable( "z", -10, 10 );
+
+        // x - y = 1, z = x + y
+        solver.addEqConstraint( { ILPSolver::Term( 1, "x" ), ILPSolver::Term( -1, "y" ) }, 1 );
+        solver.addEqConstraint( { ILPSolver::Term( 1, "z" ),
+                                  ILPSolver::Term( -1, "x" ),
+                                  ILPSolver::Term( -1, "y" ) }, 0 );
+
+        TS_ASSERT( FloatUtils::areEqual( solveFor( solver, "x", true ), 3 ) );
+        TS_ASSERT( FloatUtils::areEqual( solveFor( solver, "x", false ), 1 ) );
+        TS_ASSERT( FloatUtils::areEqual( solveFor( solver, "z", true ), 5 ) );
+        TS_ASSERT( FloatUtils::areEqual( solveFor( solver, "z", false ), 1 ) );
+    }
+
+    void test_infeasible()
+    {
+        NativeLPSolver solver;
+
+        solver.addVariable( "x", 0, 3 );
+        solver.addVariable( "y", 0, 3 );
+
+        solver.addLeqConstraint( { ILPSolver::Term( 1, "x" ), ILPSolver::Term( -1, "y" ) }, -1 );
+        solver.setCost( { ILPSolver::Term( 1, "x" ) } );
+
+        solver.solve();
+        TS_ASSERT( solver.optimal() );
+
+        // x - y <= -1 and x >= 2.5, y <= 3
+        solver.setLowerBound( "x", 2.5 );
+        solver.reset();
+        solver.solve();
+        TS_ASSERT( !solver.optimal() );
+        TS_ASSERT( solver.infeasbile() );
+
+        // Crossing bounds
+        solver.setUpperBound( "x", 2 );
+        solver.reset();
+        solver.solve();
+        TS_ASSERT( solver.infeasbile() );
+    }
+
+    void test_no_constraints()
+    {
+        NativeLPSolver solver;
+
+        solver.addVariable( "x", -1, 3 );
+        solver.addVariable( "y", 2, 4 );
+
+        solver.setObjective( { ILPSolver::Term( 1, "x" ), ILPSolver::Term( -2, "y" ) } );
+        solver.solve();
+
+        TS_ASSERT( solver.optimal() );
+
+        Map<String, double> solution;
+        double objective;
+        solver.extractSolution( solution, objective );
+
+        TS_ASSERT( FloatUtils::areEqual( solution["x"], 3 ) );
+        TS_ASSERT( FloatUtils::areEqual( solution["y"], 2 ) );
+        TS_ASSERT( FloatUtils::areEqual( objective, -1 ) );
+    }
+
+    void test_unsupported_queries()
+    {
+        NativeLPSolver solver;
+
+        TS_ASSERT_THROWS_EQUALS( solver.addVariable( "b", 0, 1, ILPSolver::BINARY ),
+                                 const MarabouError &e,
+                                 e.getCode(),
+                                 MarabouError::FEATURE_NOT_YET_SUPPORTED );
+
+        // Unbounded variables yield the trivial bound
+        solver.addVariable( "x", 0, FloatUtils::infinity() );
+        solver.addVariable( "y", 0, 1 );
+        solver.addLeqConstraint( { ILPSolver::Term( 1, "y" ), ILPSolver::Term( -1, "x" ) }, 0 );
+
+        solver.setObjective( { ILPSolver::Term( 1, "x" ) } );
+        solver.solve();
+
+        TS_ASSERT( !solver.optimal() );
+        TS_ASSERT( solver.timeout() );
+        TS_ASSERT_EQUALS( solver.getObjectiveBound(), FloatUtils::infinity() );
+        TS_ASSERT( !solver.cutoffOccurred() );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
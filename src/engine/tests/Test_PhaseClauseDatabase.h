@@ -0,0 +1,177 @@
+/*********************                                                        */
+/*! \file Test_PhaseClauseDatabase.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include <cxxtest/TestSuite.h>
+
+#include "MockErrno.h"
+#include "PhaseClauseDatabase.h"
+
+class MockForPhaseClauseDatabase
+    : public MockErrno
+{
+public:
+};
+
+class PhaseClauseDatabaseTestSuite : public CxxTest::TestSuite
+{
+public:
+    MockForPhaseClauseDatabase *mock;
+
+    void setUp()
+    {
+        TS_ASSERT( mock = new MockForPhaseClauseDatabase );
+    }
+
+    void tearDown()
+    {
+        TS_ASSERT_THROWS_NOTHING( delete mock );
+    }
+
+    unsigned active( unsigned variable )
+    {
+        return PhaseClauseDatabase::literal( variable, true );
+    }
+
+    unsigned inactive( unsigned variable )
+    {
+        return PhaseClauseDatabase::literal( variable, false );
+    }
+
+    void test_literals()
+    {
+        unsigned literal = PhaseClauseDatabase::literal( 7, true );
+        TS_ASSERT_EQUALS( PhaseClauseDatabase::getVariable( literal ), 7U );
+        TS_ASSERT( PhaseClauseDatabase::isActive( literal ) );
+
+        unsigned negated = PhaseClauseDatabase::negate( literal );
+        TS_ASSERT_EQUALS( negated, PhaseClauseDatabase::literal( 7, false ) );
+        TS_ASSERT_EQUALS( PhaseClauseDatabase::getVariable( negated ), 7U );
+        TS_ASSERT( !PhaseClauseDatabase::isActive( negated ) );
+        TS_ASSERT_EQUALS( PhaseClauseDatabase::negate( negated ), literal );
+    }
+
+    void test_assign_and_backtrack()
+    {
+        PhaseClauseDatabase database;
+
+        database.assign( active( 1 ), 1 );
+        database.assign( inactive( 3 ), 2 );
+        database.assign( active( 5 ), 2 );
+
+        TS_ASSERT( database.isTrue( active( 1 ) ) );
+        TS_ASSERT( database.isFalse( inactive( 1 ) ) );
+        TS_ASSERT( database.isTrue( inactive( 3 ) ) );
+        TS_ASSERT_EQUALS( database.getLevel( 5 ), 2U );
+
+        // A variable keeps its first assignment
+        database.assign( active( 3 ), 2 );
+        TS_ASSERT( database.isTrue( inactive( 3 ) ) );
+
+        database.backtrack( 1 );
+        TS_ASSERT( database.isTrue( active( 1 ) ) );
+        TS_ASSERT( !database.isTrue( inactive( 3 ) ) );
+        TS_ASSERT( !database.isFalse( inactive( 3 ) ) );
+        TS_ASSERT( !database.isTrue( active( 5 ) ) );
+
+        database.backtrack( 0 );
+        TS_ASSERT( !database.isTrue( active( 1 ) ) );
+    }
+
+    void test_propagation()
+    {
+        PhaseClauseDatabase database;
+
+        // Not all of x1 active, x3 active and x5 inactive
+        database.addClause( Vector<unsigned>( { inactive( 1 ), inactive( 3 ), active( 5 ) } ) );
+        TS_ASSERT_EQUALS( database.getNumClauses(), 1U );
+
+        List<unsigned> implied;
+        unsigned conflictLevel = 0;
+
+        database.assign( active( 1 ), 1 );
+        TS_ASSERT( database.propagate( 1, implied, conflictLevel ) );
+        TS_ASSERT( implied.empty() );
+
+        // With two of the phases fixed, the third is implied
+        database.assign( active( 3 ), 2 );
+        TS_ASSERT( database.propagate( 2, implied, conflictLevel ) );
+        TS_ASSERT_EQUALS( implied, List<unsigned>( { active( 5 ) } ) );
+        TS_ASSERT( database.isTrue( active( 5 ) ) );
+        TS_ASSERT_EQUALS( database.getLevel( 5 ), 2U );
+
+        // The implication is undone with its level
+        database.backtrack( 1 );
+        TS_ASSERT( !database.isTrue( active( 5 ) ) );
+
+        // A satisfied clause implies nothing
+        implied.clear();
+        database.assign( active( 5 ), 2 );
+        database.assign( active( 3 ), 3 );
+        TS_ASSERT( database.propagate( 3, implied, conflictLevel ) );
+        TS_ASSERT( implied.empty() );
+
+        // A violated clause is a conflict at its highest level
+        database.backtrack( 1 );
+        database.assign( inactive( 5 ), 2 );
+        database.assign( active( 3 ), 3 );
+        TS_ASSERT( !database.propagate( 3, implied, conflictLevel ) );
+        TS_ASSERT_EQUALS( conflictLevel, 3U );
+    }
+
+    void test_learned_clause()
+    {
+        PhaseClauseDatabase database;
+        List<unsigned> implied;
+        unsigned conflictLevel = 0;
+
+        // Decisions on x1, x3 and x5 lead to a conflict that depends on
+        // the first two
+        database.assign( inactive( 1 ), 1 );
+        database.assign( inactive( 3 ), 2 );
+        database.assign( inactive( 5 ), 3 );
+        TS_ASSERT( database.propagate( 3, implied, conflictLevel ) );
+
+        database.addClause( Vector<unsigned>( { active( 1 ), active( 3 ) } ) );
+
+        // Backtracking past the second decision makes the clause unit
+        database.backtrack( 1 );
+        TS_ASSERT( database.propagate( 1, implied, conflictLevel ) );
+        TS_ASSERT_EQUALS( implied, List<unsigned>( { active( 3 ) } ) );
+
+        // A clause with a single literal holds at every level
+        implied.clear();
+        database.addClause( Vector<unsigned>( { active( 7 ) } ) );
+        database.assign( inactive( 7 ), 1 );
+        TS_ASSERT( !database.propagate( 1, implied, conflictLevel ) );
+        TS_ASSERT_EQUALS( conflictLevel, 1U );
+
+        database.backtrack( 0 );
+        TS_ASSERT( database.propagate( 0, implied, conflictLevel ) );
+        TS_ASSERT_EQUALS( implied, List<unsigned>( { active( 7 ) } ) );
+        TS_ASSERT_EQUALS( database.getLevel( 7 ), 0U );
+
+        database.clear();
+        TS_ASSERT_EQUALS( database.getNumClauses(), 0U );
+        TS_ASSERT( !database.isTrue( active( 7 ) ) );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
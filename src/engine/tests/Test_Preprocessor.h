@@ -749,6 +749,77 @@ public:
         TS_ASSERT_EQUALS( output, 1 );
     }
 
+    void test_network_simplification_after_relu_fixing()
+    {
+        /*
+              2      R       1
+          x0 --- x2 ---> x4 --- x6
+            \    /              /
+           1 \  /              /
+              \/           -1 /
+              /\             /
+           3 /  \           /
+            /    \   R     /
+          x1 --- x3 ---> x5
+             -1
+
+          With x0, x1 in [1, 2], x2 is positive and x3 is negative,
+          so both ReLUs are fixed and the network collapses into
+          x6 = 2x0 + 3x1.
+        */
+        InputQuery inputQuery;
+
+        inputQuery.setNumberOfVariables( 7 );
+
+        inputQuery.markInputVariable( 0, 0 );
+        inputQuery.markInputVariable( 1, 1 );
+        inputQuery.markOutputVariable( 6, 0 );
+
+        for ( unsigned i = 0; i < 7; ++i )
+        {
+            inputQuery.setLowerBound( i, -20 );
+            inputQuery.setUpperBound( i, 20 );
+        }
+
+        inputQuery.setLowerBound( 0, 1 );
+        inputQuery.setUpperBound( 0, 2 );
+        inputQuery.setLowerBound( 1, 1 );
+        inputQuery.setUpperBound( 1, 2 );
+
+        inputQuery.addPiecewiseLinearConstraint( new ReluConstraint( 2, 4 ) );
+        inputQuery.addPiecewiseLinearConstraint( new ReluConstraint( 3, 5 ) );
+
+        Equation equation1;
+        equation1.addAddend( 2, 0 );
+        equation1.addAddend( 3, 1 );
+        equation1.addAddend( -1, 2 );
+        equation1.setScalar( 0 );
+        inputQuery.addEquation( equation1 );
+
+        Equation equation2;
+        equation2.addAddend( -1, 0 );
+        equation2.addAddend( -1, 1 );
+        equation2.addAddend( -1, 3 );
+        equation2.setScalar( 0 );
+        inputQuery.addEquation( equation2 );
+
+        Equation equation3;
+        equation3.addAddend( 1, 4 );
+        equation3.addAddend( -1, 5 );
+        equation3.addAddend( -1, 6 );
+        equation3.setScalar( 0 );
+        inputQuery.addEquation( equation3 );
+
+        InputQuery processed = Preprocessor().preprocess( inputQuery );
+
+        TS_ASSERT( processed.getPiecewiseLinearConstraints().empty() );
+        TS_ASSERT_EQUALS( processed.getEquations().size(), 1U );
+        TS_ASSERT_EQUALS( processed.getNumberOfVariables(), 3U );
+
+        TS_ASSERT_EQUALS( processed.getLowerBound( processed.outputVariableByIndex( 0 ) ), 5 );
+        TS_ASSERT_EQUALS( processed.getUpperBound( processed.outputVariableByIndex( 0 ) ), 10 );
+    }
+
     void test_todo()
     {
         TS_TRACE( "In test_variable_elimination, test something about updated bounds and updated PL constraints" );
@@ -0,0 +1,137 @@
+/*********************                                                        */
+/*! \file Test_ReluDivider.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include <cxxtest/TestSuite.h>
+
+#include "MockEngine.h"
+#include "MStringf.h"
+#include "ReluConstraint.h"
+#include "ReluDivider.h"
+#include "SubQuery.h"
+
+class ReluDividerTestSuite : public CxxTest::TestSuite
+{
+public:
+    MockEngine *engine;
+
+    void setUp()
+    {
+        TS_ASSERT( engine = new MockEngine );
+    }
+
+    void tearDown()
+    {
+        TS_ASSERT_THROWS_NOTHING( delete engine );
+    }
+
+    bool hasBound( const PiecewiseLinearCaseSplit &split, unsigned variable,
+                   double value, Tightening::BoundType type )
+    {
+        for ( const auto &bound : split.getBoundTightenings() )
+        {
+            if ( bound._variable == variable && bound._value == value &&
+                 bound._type == type )
+                return true;
+        }
+        return false;
+    }
+
+    void test_create_subqueries()
+    {
+        //   Input region: -1 <= x0 <= 1
+        //
+        //   The engine picks the ReLU x2 = relu( x1 ) for the first
+        //   split, and x4 = relu( x3 ) for both halves
+        ReluConstraint relu1( 1, 2 );
+        ReluConstraint relu2( 3, 4 );
+        engine->nextConstraintsToSplit.append( &relu1 );
+        engine->nextConstraintsToSplit.append( &relu2 );
+        engine->nextConstraintsToSplit.append( &relu2 );
+
+        PiecewiseLinearCaseSplit previousSplit;
+        previousSplit.storeBoundTightening( Tightening( 0, -1, Tightening::LB ) );
+        previousSplit.storeBoundTightening( Tightening( 0, 1, Tightening::UB ) );
+
+        ReluDivider divider( engine, DivideStrategy::EarliestReLU );
+        SubQueries subQueries;
+        divider.createSubQueries( 4, "3", previousSplit, 10, subQueries );
+
+        TS_ASSERT_EQUALS( subQueries.size(), 4U );
+        TS_ASSERT_EQUALS( engine->lastSplitsToDivide.size(), 3U );
+        TS_ASSERT_EQUALS( *engine->lastSplitsToDivide.begin(), previousSplit );
+
+        unsigned queryIndex = 1;
+        unsigned numActive1 = 0;
+        unsigned numActive2 = 0;
+        for ( const auto &subQuery : subQueries )
+        {
+            TS_ASSERT_EQUALS( subQuery->_queryId, Stringf( "3-%u", queryIndex++ ) );
+            TS_ASSERT_EQUALS( subQuery->_timeoutInSeconds, 10U );
+
+            const PiecewiseLinearCaseSplit &split = *subQuery->_split;
+
+            // The input region is kept
+            TS_ASSERT( hasBound( split, 0, -1, Tightening::LB ) );
+            TS_ASSERT( hasBound( split, 0, 1, Tightening::UB ) );
+
+            // Each subquery fixes a phase of both ReLUs
+            bool active1 = hasBound( split, 1, 0, Tightening::LB );
+            bool inactive1 = hasBound( split, 1, 0, Tightening::UB );
+            TS_ASSERT( active1 != inactive1 );
+            if ( active1 )
+                ++numActive1;
+
+            bool active2 = hasBound( split, 3, 0, Tightening::LB );
+            bool inactive2 = hasBound( split, 3, 0, Tightening::UB );
+            TS_ASSERT( active2 != inactive2 );
+            if ( active2 )
+                ++numActive2;
+        }
+
+        TS_ASSERT_EQUALS( numActive1, 2U );
+        TS_ASSERT_EQUALS( numActive2, 2U );
+
+        for ( auto &subQuery : subQueries )
+            delete subQuery;
+    }
+
+    void test_nothing_to_split()
+    {
+        // When the engine finds no ReLU to split on, the subquery is
+        // kept as it is
+        PiecewiseLinearCaseSplit previousSplit;
+        previousSplit.storeBoundTightening( Tightening( 0, -1, Tightening::LB ) );
+        previousSplit.storeBoundTightening( Tightening( 0, 1, Tightening::UB ) );
+
+        ReluDivider divider( engine, DivideStrategy::Polarity );
+        SubQueries subQueries;
+        divider.createSubQueries( 2, "", previousSplit, 5, subQueries );
+
+        TS_ASSERT_EQUALS( subQueries.size(), 1U );
+        TS_ASSERT_EQUALS( ( *subQueries.begin() )->_queryId, "1" );
+        TS_ASSERT_EQUALS( *( *subQueries.begin() )->_split, previousSplit );
+
+        for ( auto &subQuery : subQueries )
+            delete subQuery;
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,199 @@
+/*********************                                                        */
+/*! \file Test_ReluLayerConstraint.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include <cxxtest/TestSuite.h>
+
+#include "MockConstraintBoundTightener.h"
+#include "MockErrno.h"
+#include "MockTableau.h"
+#include "ReluConstraint.h"
+#include "ReluLayerConstraint.h"
+
+class MockForReluLayerConstraint
+    : public MockErrno
+{
+public:
+};
+
+class ReluLayerConstraintTestSuite : public CxxTest::TestSuite
+{
+public:
+    MockForReluLayerConstraint *mock;
+
+    void setUp()
+    {
+        TS_ASSERT( mock = new MockForReluLayerConstraint );
+    }
+
+    void tearDown()
+    {
+        TS_ASSERT_THROWS_NOTHING( delete mock );
+    }
+
+    void test_attach_and_detach()
+    {
+        ReluConstraint relu1( 0, 2 );
+        ReluConstraint relu2( 1, 3 );
+
+        relu1.notifyLowerBound( 0, -1 );
+        relu1.notifyUpperBound( 0, 2 );
+        relu1.notifyVariableValue( 0, 1 );
+        relu1.notifyVariableValue( 2, 1 );
+        relu2.notifyUpperBound( 1, -1 );
+
+        TS_ASSERT( !relu1.phaseFixed() );
+        TS_ASSERT( relu2.phaseFixed() );
+
+        {
+            ReluLayerConstraint layer( List<ReluConstraint *>( { &relu1, &relu2 } ) );
+            TS_ASSERT_EQUALS( layer.getSize(), 2U );
+
+            TS_ASSERT( relu1.attachedToLayer() );
+            TS_ASSERT( relu2.attachedToLayer() );
+
+            // The existing state is moved into the layer
+            TS_ASSERT_EQUALS( relu1.getLowerBound( 0 ), -1 );
+            TS_ASSERT_EQUALS( relu1.getUpperBound( 0 ), 2 );
+            TS_ASSERT( relu1.satisfied() );
+            TS_ASSERT( !relu1.phaseFixed() );
+            TS_ASSERT_EQUALS( relu2.getPhaseStatus(), ReluConstraint::PHASE_INACTIVE );
+
+            // New values go through the layer
+            layer.notifyVariableValue( 2, 3 );
+            TS_ASSERT( !relu1.satisfied() );
+            layer.notifyLowerBound( 0, 0.5 );
+        }
+
+        // The state is moved back when the layer is destroyed
+        TS_ASSERT( !relu1.attachedToLayer() );
+        TS_ASSERT( !relu2.attachedToLayer() );
+        TS_ASSERT_EQUALS( relu1.getLowerBound( 0 ), 0.5 );
+        TS_ASSERT( !relu1.satisfied() );
+        TS_ASSERT_EQUALS( relu2.getPhaseStatus(), ReluConstraint::PHASE_INACTIVE );
+    }
+
+    void test_register_as_watcher()
+    {
+        ReluConstraint relu1( 0, 2 );
+        ReluConstraint relu2( 1, 3 );
+        ReluLayerConstraint layer( List<ReluConstraint *>( { &relu1, &relu2 } ) );
+
+        MockTableau tableau;
+
+        // Attached ReLUs do not register themselves
+        relu1.registerAsWatcher( &tableau );
+        TS_ASSERT( tableau.lastRegisteredVariableToWatcher.empty() );
+
+        layer.registerAsWatcher( &tableau );
+        TS_ASSERT_EQUALS( tableau.lastRegisteredVariableToWatcher.size(), 4U );
+        for ( unsigned i = 0; i < 4; ++i )
+        {
+            TS_ASSERT_EQUALS( tableau.lastRegisteredVariableToWatcher[i].size(), 1U );
+            TS_ASSERT( tableau.lastRegisteredVariableToWatcher[i].exists( &layer ) );
+        }
+
+        layer.unregisterAsWatcher( &tableau );
+        TS_ASSERT_EQUALS( tableau.lastUnregisteredVariableToWatcher.size(), 4U );
+    }
+
+    void test_batched_phase_fixing_and_tightening()
+    {
+        MockConstraintBoundTightener tightener;
+        List<Tightening> tightenings;
+
+        ReluConstraint relu1( 0, 2 );
+        ReluConstraint relu2( 1, 3 );
+        relu1.registerConstraintBoundTightener( &tightener );
+        relu2.registerConstraintBoundTightener( &tightener );
+
+        ReluLayerConstraint layer( List<ReluConstraint *>( { &relu1, &relu2 } ) );
+        layer.registerConstraintBoundTightener( &tightener );
+
+        for ( unsigned i = 0; i < 4; ++i )
+        {
+            layer.notifyLowerBound( i, -10 );
+            layer.notifyUpperBound( i, 10 );
+        }
+        layer.processPendingNotifications();
+        tightener.getConstraintTightenings( tightenings );
+
+        TS_ASSERT( !layer.hasPendingNotifications() );
+        TS_ASSERT( !relu1.phaseFixed() );
+        TS_ASSERT( !relu2.phaseFixed() );
+
+        // Notifications are only recorded
+        layer.notifyLowerBound( 0, 1 );
+        layer.notifyUpperBound( 1, -2 );
+        layer.notifyUpperBound( 1, -1 );
+
+        TS_ASSERT( layer.hasPendingNotifications() );
+        tightener.getConstraintTightenings( tightenings );
+        TS_ASSERT( tightenings.empty() );
+
+        layer.processPendingNotifications();
+        TS_ASSERT( !layer.hasPendingNotifications() );
+
+        TS_ASSERT_EQUALS( relu1.getPhaseStatus(), ReluConstraint::PHASE_ACTIVE );
+        TS_ASSERT_EQUALS( relu2.getPhaseStatus(), ReluConstraint::PHASE_INACTIVE );
+
+        tightener.getConstraintTightenings( tightenings );
+        TS_ASSERT( tightenings.exists( Tightening( 2, 1, Tightening::LB ) ) );
+        TS_ASSERT( tightenings.exists( Tightening( 3, 0, Tightening::UB ) ) );
+
+        // Querying a ReLU processes the pending notifications
+        ReluConstraint relu3( 4, 5 );
+        ReluConstraint relu4( 6, 7 );
+        ReluLayerConstraint otherLayer( List<ReluConstraint *>( { &relu3, &relu4 } ) );
+        otherLayer.notifyLowerBound( 5, 3 );
+        TS_ASSERT( relu3.phaseFixed() );
+        TS_ASSERT( !otherLayer.hasPendingNotifications() );
+    }
+
+    void test_duplicate_and_restore()
+    {
+        ReluConstraint relu1( 0, 2 );
+        ReluConstraint relu2( 1, 3 );
+        ReluLayerConstraint layer( List<ReluConstraint *>( { &relu1, &relu2 } ) );
+
+        layer.notifyLowerBound( 0, -5 );
+        layer.notifyUpperBound( 0, 5 );
+
+        PiecewiseLinearConstraint *snapshot = relu1.duplicateConstraint();
+        TS_ASSERT( !( (ReluConstraint *)snapshot )->attachedToLayer() );
+        TS_ASSERT_EQUALS( snapshot->getUpperBound( 0 ), 5 );
+
+        layer.notifyLowerBound( 0, 1 );
+        TS_ASSERT( relu1.phaseFixed() );
+
+        relu1.restoreState( snapshot );
+        TS_ASSERT( relu1.attachedToLayer() );
+        TS_ASSERT( !relu1.phaseFixed() );
+        TS_ASSERT_EQUALS( relu1.getLowerBound( 0 ), -5 );
+
+        // Notifications after the restoration are tracked as usual
+        layer.notifyUpperBound( 0, -1 );
+        TS_ASSERT_EQUALS( relu1.getPhaseStatus(), ReluConstraint::PHASE_INACTIVE );
+
+        delete snapshot;
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,144 @@
+/*********************                                                        */
+/*! \file Test_RuntimeEstimator.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include <cxxtest/TestSuite.h>
+
+#include "FloatUtils.h"
+#include "MockErrno.h"
+#include "MStringf.h"
+#include "RuntimeEstimator.h"
+
+#include <cmath>
+
+class MockForRuntimeEstimator
+    : public MockErrno
+{
+public:
+};
+
+class RuntimeEstimatorTestSuite : public CxxTest::TestSuite
+{
+public:
+    MockForRuntimeEstimator *mock;
+
+    void setUp()
+    {
+        TS_ASSERT( mock = new MockForRuntimeEstimator );
+    }
+
+    void tearDown()
+    {
+        TS_ASSERT_THROWS_NOTHING( delete mock );
+    }
+
+    void setSubQuery( SubQuery &subQuery, unsigned numUnfixed, double gap, double parentTime )
+    {
+        subQuery._numUnfixedConstraints = numUnfixed;
+        subQuery._outputBoundGap = gap;
+        subQuery._parentTimeInSeconds = parentTime;
+    }
+
+    void test_no_prediction_before_min_samples()
+    {
+        RuntimeEstimator estimator( 3 );
+
+        SubQuery subQuery;
+        setSubQuery( subQuery, 10, 1, 0 );
+
+        TS_ASSERT( estimator.predict( subQuery ) < 0 );
+
+        estimator.record( subQuery, 1, false );
+        estimator.record( subQuery, 1, false );
+        TS_ASSERT( estimator.predict( subQuery ) < 0 );
+        TS_ASSERT_EQUALS( estimator.getNumSamples(), 2U );
+
+        estimator.record( subQuery, 1, false );
+        TS_ASSERT( estimator.predict( subQuery ) >= 0 );
+    }
+
+    void test_fit()
+    {
+        RuntimeEstimator estimator( 1 );
+
+        // log( 1 + time ) = 0.1 * unfixed + 0.5 * log( 1 + gap ) + 0.2
+        SubQuery subQuery;
+        for ( unsigned unfixed = 0; unfixed < 20; unfixed += 2 )
+        {
+            for ( double gap = 0; gap < 10; gap += 3 )
+            {
+                setSubQuery( subQuery, unfixed, gap, unfixed * 0.5 );
+                double time = std::exp( 0.1 * unfixed + 0.5 * std::log( 1 + gap ) + 0.2 ) - 1;
+                estimator.record( subQuery, time, false );
+            }
+        }
+
+        setSubQuery( subQuery, 15, 4, 7.5 );
+        double expected = std::exp( 0.1 * 15 + 0.5 * std::log( 5 ) + 0.2 ) - 1;
+        TS_ASSERT( FloatUtils::areEqual( estimator.predict( subQuery ), expected, 0.05 ) );
+
+        // More unfixed constraints mean a harder subquery
+        SubQuery easier;
+        setSubQuery( easier, 5, 4, 2.5 );
+        TS_ASSERT( estimator.predict( easier ) < estimator.predict( subQuery ) );
+    }
+
+    void test_mean_log_error()
+    {
+        RuntimeEstimator estimator( 1 );
+
+        SubQuery subQuery;
+        setSubQuery( subQuery, 3, 1, 0 );
+
+        // Records without a prediction do not count
+        estimator.record( subQuery, 5, false );
+        TS_ASSERT_EQUALS( estimator.getMeanLogError(), 0 );
+
+        subQuery._predictedTimeInSeconds = std::exp( 2 ) - 1;
+        estimator.record( subQuery, std::exp( 1 ) - 1, true );
+        subQuery._predictedTimeInSeconds = std::exp( 1 ) - 1;
+        estimator.record( subQuery, std::exp( 4 ) - 1, false );
+
+        TS_ASSERT( FloatUtils::areEqual( estimator.getMeanLogError(), 2 ) );
+    }
+
+    void test_easier_than()
+    {
+        SubQuery a;
+        SubQuery b;
+
+        // Without predictions, by unfixed constraints and then by gap
+        setSubQuery( a, 3, 5, 0 );
+        setSubQuery( b, 4, 1, 0 );
+        TS_ASSERT( RuntimeEstimator::easierThan( &a, &b ) );
+        TS_ASSERT( !RuntimeEstimator::easierThan( &b, &a ) );
+
+        setSubQuery( b, 3, 6, 0 );
+        TS_ASSERT( RuntimeEstimator::easierThan( &a, &b ) );
+
+        // Predictions come first
+        a._predictedTimeInSeconds = 10;
+        b._predictedTimeInSeconds = 1;
+        TS_ASSERT( RuntimeEstimator::easierThan( &b, &a ) );
+        TS_ASSERT( !RuntimeEstimator::easierThan( &a, &b ) );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,225 @@
+/*********************                                                        */
+/*! \file Test_SharedKnowledgeStore.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include <cxxtest/TestSuite.h>
+
+#include "PiecewiseLinearCaseSplit.h"
+#include "SharedKnowledgeStore.h"
+
+#include <list>
+#include <thread>
+
+class MockForSharedKnowledgeStore
+{
+public:
+};
+
+class SharedKnowledgeStoreTestSuite : public CxxTest::TestSuite
+{
+public:
+    MockForSharedKnowledgeStore *mock;
+
+    void setUp()
+    {
+        TS_ASSERT( mock = new MockForSharedKnowledgeStore );
+    }
+
+    void tearDown()
+    {
+        TS_ASSERT_THROWS_NOTHING( delete mock );
+    }
+
+    PiecewiseLinearCaseSplit box( double lb0, double ub0, double lb1, double ub1 )
+    {
+        PiecewiseLinearCaseSplit split;
+        split.storeBoundTightening( Tightening( 0, lb0, Tightening::LB ) );
+        split.storeBoundTightening( Tightening( 0, ub0, Tightening::UB ) );
+        split.storeBoundTightening( Tightening( 1, lb1, Tightening::LB ) );
+        split.storeBoundTightening( Tightening( 1, ub1, Tightening::UB ) );
+        return split;
+    }
+
+    List<Tightening> bounds( unsigned variable, double lb, double ub )
+    {
+        return { Tightening( variable, lb, Tightening::LB ),
+                 Tightening( variable, ub, Tightening::UB ) };
+    }
+
+    Vector<unsigned> clause( unsigned first, unsigned second )
+    {
+        Vector<unsigned> result;
+        result.append( first );
+        result.append( second );
+        return result;
+    }
+
+    void test_import_from_containing_scopes()
+    {
+        SharedKnowledgeStore store( 10 );
+        List<Tightening> result;
+        List<Vector<unsigned>> clauses;
+
+        TS_ASSERT( !store.import( box( 0, 1, 0, 1 ), result, clauses ) );
+
+        TS_ASSERT( store.publish( box( 0, 4, 0, 4 ), bounds( 5, -10, 10 ), {} ) );
+        TS_ASSERT( store.publish( box( 0, 2, 0, 4 ), bounds( 5, -3, 3 ), {} ) );
+        TS_ASSERT( store.publish( box( 2, 4, 0, 4 ), bounds( 5, 1, 2 ), {} ) );
+        TS_ASSERT_EQUALS( store.size(), 3U );
+
+        // The tightest bounds of all the containing scopes are used
+        TS_ASSERT( store.import( box( 0, 1, 0, 4 ), result, clauses ) );
+        TS_ASSERT_EQUALS( result, bounds( 5, -3, 3 ) );
+
+        result.clear();
+        TS_ASSERT( store.import( box( 3, 4, 1, 2 ), result, clauses ) );
+        TS_ASSERT_EQUALS( result, bounds( 5, 1, 2 ) );
+
+        // Boxes that straddle the split only get the parent's bounds
+        result.clear();
+        TS_ASSERT( store.import( box( 1, 3, 0, 4 ), result, clauses ) );
+        TS_ASSERT_EQUALS( result, bounds( 5, -10, 10 ) );
+
+        // No published scope contains this one
+        result.clear();
+        TS_ASSERT( !store.import( box( 1, 5, 0, 4 ), result, clauses ) );
+        TS_ASSERT( result.empty() );
+
+        // A box with an unbounded dimension is not contained either
+        PiecewiseLinearCaseSplit partial;
+        partial.storeBoundTightening( Tightening( 0, 1, Tightening::LB ) );
+        partial.storeBoundTightening( Tightening( 0, 2, Tightening::UB ) );
+        TS_ASSERT( !store.import( partial, result, clauses ) );
+
+        TS_ASSERT( clauses.empty() );
+    }
+
+    void test_bounds_are_combined()
+    {
+        SharedKnowledgeStore store( 10 );
+
+        // Different scopes may tighten different sides
+        store.publish( box( 0, 4, 0, 4 ), { Tightening( 5, -1, Tightening::LB ),
+                                            Tightening( 5, 8, Tightening::UB ) }, {} );
+        store.publish( box( 0, 2, 0, 4 ), { Tightening( 5, -4, Tightening::LB ),
+                                            Tightening( 5, 6, Tightening::UB ),
+                                            Tightening( 6, 0, Tightening::LB ) }, {} );
+
+        List<Tightening> result;
+        List<Vector<unsigned>> clauses;
+        TS_ASSERT( store.import( box( 0, 1, 0, 4 ), result, clauses ) );
+
+        List<Tightening> expected = { Tightening( 5, -1, Tightening::LB ),
+                                      Tightening( 6, 0, Tightening::LB ),
+                                      Tightening( 5, 6, Tightening::UB ) };
+        TS_ASSERT_EQUALS( result, expected );
+    }
+
+    void test_clauses()
+    {
+        SharedKnowledgeStore store( 10 );
+
+        store.publish( box( 0, 4, 0, 4 ), {}, { clause( 2, 5 ) } );
+        store.publish( box( 0, 2, 0, 4 ), {}, { clause( 7, 9 ), clause( 11, 12 ) } );
+        store.publish( box( 2, 4, 0, 4 ), {}, { clause( 3, 4 ) } );
+
+        List<Tightening> result;
+        List<Vector<unsigned>> clauses;
+        TS_ASSERT( store.import( box( 0, 1, 0, 4 ), result, clauses ) );
+        TS_ASSERT( result.empty() );
+        TS_ASSERT_EQUALS( clauses.size(), 3U );
+
+        bool found = false;
+        for ( const auto &learned : clauses )
+        {
+            TS_ASSERT( !( learned == clause( 3, 4 ) ) );
+            if ( learned == clause( 2, 5 ) )
+                found = true;
+        }
+        TS_ASSERT( found );
+    }
+
+    void test_capacity()
+    {
+        SharedKnowledgeStore store( 2 );
+        List<Tightening> result;
+        List<Vector<unsigned>> clauses;
+
+        TS_ASSERT( store.publish( box( 0, 4, 0, 4 ), bounds( 5, -10, 10 ), {} ) );
+        TS_ASSERT( store.publish( box( 0, 2, 0, 4 ), bounds( 5, -3, 3 ), {} ) );
+
+        // Once full, nothing more is published
+        TS_ASSERT( !store.publish( box( 2, 4, 0, 4 ), bounds( 5, 1, 2 ), {} ) );
+        TS_ASSERT_EQUALS( store.size(), 2U );
+
+        TS_ASSERT( store.import( box( 3, 4, 1, 2 ), result, clauses ) );
+        TS_ASSERT_EQUALS( result, bounds( 5, -10, 10 ) );
+
+        // Nothing to publish takes no space
+        TS_ASSERT( store.publish( box( 2, 4, 0, 4 ), {}, {} ) );
+
+        // A store of size 0 stores nothing
+        SharedKnowledgeStore disabled( 0 );
+        TS_ASSERT( !disabled.publish( box( 0, 4, 0, 4 ), bounds( 5, -10, 10 ), {} ) );
+        TS_ASSERT_EQUALS( disabled.size(), 0U );
+        TS_ASSERT( !disabled.import( box( 0, 4, 0, 4 ), result, clauses ) );
+    }
+
+    void test_concurrent_publish_and_import()
+    {
+        enum {
+            NUM_THREADS = 4,
+            NUM_ENTRIES_PER_THREAD = 200,
+        };
+
+        SharedKnowledgeStore store( NUM_THREADS * NUM_ENTRIES_PER_THREAD );
+
+        // Every thread publishes nested scopes, and imports as it goes
+        auto work = [&]( unsigned thread )
+        {
+            for ( unsigned i = 0; i < NUM_ENTRIES_PER_THREAD; ++i )
+            {
+                store.publish( box( 0, 1000 - i, 0, 4 ),
+                               bounds( 10 + thread, -(double)i, i ),
+                               { clause( 2 * thread, 2 * i ) } );
+
+                List<Tightening> result;
+                List<Vector<unsigned>> clauses;
+                store.import( box( 0, 1, 0, 4 ), result, clauses );
+            }
+        };
+
+        std::list<std::thread> threads;
+        for ( unsigned i = 0; i < NUM_THREADS; ++i )
+            threads.push_back( std::thread( work, i ) );
+        for ( auto &thread : threads )
+            thread.join();
+
+        TS_ASSERT_EQUALS( store.size(), (unsigned)NUM_THREADS * NUM_ENTRIES_PER_THREAD );
+
+        List<Tightening> result;
+        List<Vector<unsigned>> clauses;
+        TS_ASSERT( store.import( box( 0, 1, 0, 4 ), result, clauses ) );
+        TS_ASSERT_EQUALS( clauses.size(), (unsigned)NUM_THREADS * NUM_ENTRIES_PER_THREAD );
+        TS_ASSERT_EQUALS( result.size(), 2U * NUM_THREADS );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -22,6 +22,7 @@
 #include "PiecewiseLinearConstraint.h"
 #include "ReluConstraint.h"
 #include "SmtCore.h"
+#include "Statistics.h"
 
 #include <string.h>
 
@@ -584,6 +585,162 @@ public:
         smtState._impliedValidSplitsAtRoot = List<PiecewiseLinearCaseSplit>();
     }
 
+    void test_backjump()
+    {
+        if ( !GlobalConfiguration::USE_CONFLICT_DRIVEN_CLAUSE_LEARNING )
+            return;
+
+        // ReLU(x0, x1), ..., ReLU(x6, x7), with aux variables so that the
+        // splits add no equations
+
+        InputQuery inputQuery;
+        inputQuery.setNumberOfVariables( 8 );
+
+        Vector<ReluConstraint *> relus;
+        for ( unsigned i = 0; i < 4; ++i )
+        {
+            ReluConstraint *relu = new ReluConstraint( 2 * i, 2 * i + 1 );
+            relu->notifyLowerBound( 2 * i, -1 );
+            relu->notifyUpperBound( 2 * i, 1 );
+            relu->notifyLowerBound( 2 * i + 1, 0 );
+            relu->notifyUpperBound( 2 * i + 1, 1 );
+            relu->addAuxiliaryEquations( inputQuery );
+            relus.append( relu );
+        }
+
+        SmtCore smtCore( engine );
+        Statistics statistics;
+        smtCore.setStatistics( &statistics );
+
+        for ( unsigned i = 0; i < 3; ++i )
+        {
+            for ( unsigned j = 0; j < GlobalConfiguration::CONSTRAINT_VIOLATION_THRESHOLD; ++j )
+                smtCore.reportViolatedConstraint( relus[i] );
+            TS_ASSERT_THROWS_NOTHING( smtCore.performSplit() );
+        }
+
+        TS_ASSERT_EQUALS( smtCore.getStackDepth(), 3U );
+
+        // A conflict that only depends on the first split skips the
+        // alternatives of the other two
+        TS_ASSERT( smtCore.backjump( 1 ) );
+        TS_ASSERT_EQUALS( smtCore.getStackDepth(), 1U );
+
+        TS_ASSERT_EQUALS( statistics.getNumLearnedPhaseClauses(), 1U );
+        TS_ASSERT_EQUALS( statistics.getNumBackjumps(), 1U );
+        TS_ASSERT_EQUALS( statistics.getNumPrunedTreeStates(), 2U );
+
+        // The learned clause holds for the other phase of the first ReLU
+        unsigned conflictLevel = 0;
+        TS_ASSERT( smtCore.propagateLearnedClauses( conflictLevel ) );
+
+        // The learned clause can be handed to another SmtCore, which
+        // does not count it as its own
+        List<Vector<unsigned>> learnedClauses;
+        smtCore.getLearnedClauses( learnedClauses );
+        TS_ASSERT_EQUALS( learnedClauses.size(), 1U );
+        TS_ASSERT_EQUALS( learnedClauses.front().size(), 1U );
+
+        SmtCore otherSmtCore( engine );
+        TS_ASSERT_THROWS_NOTHING( otherSmtCore.addClauses( learnedClauses ) );
+        List<Vector<unsigned>> otherLearnedClauses;
+        otherSmtCore.getLearnedClauses( otherLearnedClauses );
+        TS_ASSERT( otherLearnedClauses.empty() );
+
+        // A conflict that depends on no split means that the query is
+        // unsat
+        for ( unsigned i = 0; i < GlobalConfiguration::CONSTRAINT_VIOLATION_THRESHOLD; ++i )
+            smtCore.reportViolatedConstraint( relus[3] );
+        TS_ASSERT_THROWS_NOTHING( smtCore.performSplit() );
+        TS_ASSERT_EQUALS( smtCore.getStackDepth(), 2U );
+
+        TS_ASSERT( !smtCore.backjump( 0 ) );
+        TS_ASSERT_EQUALS( smtCore.getStackDepth(), 0U );
+
+        for ( const auto &relu : relus )
+            delete relu;
+    }
+
+    void test_set_constraint_for_splitting()
+    {
+        ReluConstraint relu1( 0, 1 );
+        ReluConstraint relu2( 2, 3 );
+
+        SmtCore smtCore( engine );
+
+        for ( unsigned i = 0; i < GlobalConfiguration::CONSTRAINT_VIOLATION_THRESHOLD; ++i )
+            smtCore.reportViolatedConstraint( &relu1 );
+        TS_ASSERT( smtCore.needToSplit() );
+
+        // The split is performed on the requested constraint instead
+        TS_ASSERT_THROWS_NOTHING( smtCore.setConstraintForSplitting( &relu2 ) );
+        TS_ASSERT( smtCore.needToSplit() );
+        TS_ASSERT_THROWS_NOTHING( smtCore.performSplit() );
+        TS_ASSERT( relu1.isActive() );
+        TS_ASSERT( !relu2.isActive() );
+
+        // A split can also be requested when none is needed
+        smtCore.resetReportedViolations();
+        TS_ASSERT( !smtCore.needToSplit() );
+        TS_ASSERT_THROWS_NOTHING( smtCore.setConstraintForSplitting( &relu1 ) );
+        TS_ASSERT( smtCore.needToSplit() );
+        TS_ASSERT_THROWS_NOTHING( smtCore.performSplit() );
+        TS_ASSERT( !relu1.isActive() );
+        TS_ASSERT_EQUALS( smtCore.getStackDepth(), 2U );
+    }
+
+    void test_luby()
+    {
+        unsigned expected[] = { 1, 1, 2, 1, 1, 2, 4, 1, 1, 2, 1, 1, 2, 4, 8, 1 };
+        for ( unsigned i = 0; i < sizeof( expected ) / sizeof( unsigned ); ++i )
+            TS_ASSERT_EQUALS( SmtCore::luby( i ), expected[i] );
+    }
+
+    void test_restart()
+    {
+        ReluConstraint relu1( 0, 1 );
+        ReluConstraint relu2( 2, 3 );
+
+        SmtCore smtCore( engine );
+        Statistics statistics;
+        smtCore.setStatistics( &statistics );
+
+        for ( unsigned i = 0; i < GlobalConfiguration::CONSTRAINT_VIOLATION_THRESHOLD; ++i )
+            smtCore.reportViolatedConstraint( &relu1 );
+        TS_ASSERT_THROWS_NOTHING( smtCore.performSplit() );
+        EngineState *rootState = engine->lastStoredState;
+
+        for ( unsigned i = 0; i < GlobalConfiguration::CONSTRAINT_VIOLATION_THRESHOLD; ++i )
+            smtCore.reportViolatedConstraint( &relu2 );
+        TS_ASSERT_THROWS_NOTHING( smtCore.performSplit() );
+
+        // Move relu2 to its second phase
+        TS_ASSERT( smtCore.popSplit() );
+        PiecewiseLinearCaseSplit secondPhase = *( ++relu2.getCaseSplits().begin() );
+
+        // The search returns to the root
+        engine->lastRestoredState = NULL;
+        TS_ASSERT_THROWS_NOTHING( smtCore.restart() );
+        TS_ASSERT_EQUALS( smtCore.getStackDepth(), 0U );
+        TS_ASSERT_EQUALS( engine->lastRestoredState, rootState );
+        TS_ASSERT_EQUALS( statistics.getNumRestarts(), 1U );
+
+        // A new split on relu2 starts from its saved phase
+        relu2.setActiveConstraint( true );
+        for ( unsigned i = 0; i < GlobalConfiguration::CONSTRAINT_VIOLATION_THRESHOLD; ++i )
+            smtCore.reportViolatedConstraint( &relu2 );
+        TS_ASSERT_THROWS_NOTHING( smtCore.performSplit() );
+
+        SmtState smtState;
+        smtCore.storeSmtState( smtState );
+        TS_ASSERT_EQUALS( smtState._stack.size(), 1U );
+
+        if ( GlobalConfiguration::RESTART_POLICY != RestartPolicy::NoRestarts )
+            TS_ASSERT( ( *smtState._stack.begin() )->_activeSplit == secondPhase );
+
+        clearSmtState( smtState );
+    }
+
     void test_todo()
     {
         // Reason: the inefficiency in resizing the tableau mutliple times
@@ -35,9 +35,13 @@ class MockVariableWatcher : public ITableau::VariableWatcher
 {
 public:
     Map<unsigned, double> lastNotifiedValues;
+    Map<unsigned, unsigned> numValueNotifications;
     void notifyVariableValue( unsigned variable, double value )
     {
         lastNotifiedValues[variable] = value;
+        if ( !numValueNotifications.exists( variable ) )
+            numValueNotifications[variable] = 0;
+        ++numValueNotifications[variable];
     }
 
     Map<unsigned, double> lastNotifiedLowerBounds;
@@ -227,6 +231,76 @@ public:
         TS_ASSERT_THROWS_NOTHING( delete tableau );
     }
 
+    void test_watcher__deferred_value_changes()
+    {
+        Tableau *tableau = NULL;
+        MockCostFunctionManager costFunctionManager;
+
+        TS_ASSERT( tableau = new Tableau );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setDimensions( 3, 7 ) );
+        tableau->registerCostFunctionManager( &costFunctionManager );
+        initializeTableauValues( *tableau );
+
+        for ( unsigned i = 0; i < 4; ++i )
+        {
+            TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( i, 1 ) );
+            TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( i, 2 ) );
+        }
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 4, 218 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 4, 228 ) );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 5, 112 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 5, 114 ) );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 6, 400 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 6, 402 ) );
+
+        MockVariableWatcher watcher;
+
+        TS_ASSERT_THROWS_NOTHING( tableau->registerToWatchVariable( &watcher, 3 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->registerToWatchVariable( &watcher, 4 ) );
+
+        List<unsigned> basics = { 4, 5, 6 };
+        TS_ASSERT_THROWS_NOTHING( tableau->initializeTableau( basics ) );
+        TS_ASSERT_EQUALS( watcher.lastNotifiedValues[4], 217.0 );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setDeferValueNotifications( true ) );
+        watcher.lastNotifiedValues.clear();
+        watcher.numValueNotifications.clear();
+
+        // Changes are only recorded
+        TS_ASSERT_THROWS_NOTHING( tableau->setNonBasicAssignment( 3, 2, true ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setNonBasicAssignment( 3, 1, true ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setNonBasicAssignment( 3, 2, true ) );
+        TS_ASSERT( watcher.lastNotifiedValues.empty() );
+
+        // And delivered once per variable, with the current values
+        TS_ASSERT_THROWS_NOTHING( tableau->notifyPendingVariableValues() );
+        TS_ASSERT_EQUALS( watcher.numValueNotifications[3], 1U );
+        TS_ASSERT_EQUALS( watcher.numValueNotifications[4], 1U );
+        TS_ASSERT_EQUALS( watcher.lastNotifiedValues[3], 2.0 );
+        TS_ASSERT_EQUALS( watcher.lastNotifiedValues[4], tableau->getValue( 4 ) );
+
+        // Nothing is left to deliver
+        watcher.numValueNotifications.clear();
+        TS_ASSERT_THROWS_NOTHING( tableau->notifyPendingVariableValues() );
+        TS_ASSERT( watcher.numValueNotifications.empty() );
+
+        // Turning deferral off flushes the pending notifications
+        TS_ASSERT_THROWS_NOTHING( tableau->setNonBasicAssignment( 3, 1, true ) );
+        TS_ASSERT( watcher.numValueNotifications.empty() );
+        TS_ASSERT_THROWS_NOTHING( tableau->setDeferValueNotifications( false ) );
+        TS_ASSERT_EQUALS( watcher.lastNotifiedValues[3], 1.0 );
+        TS_ASSERT_EQUALS( watcher.lastNotifiedValues[4], tableau->getValue( 4 ) );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setNonBasicAssignment( 3, 2, true ) );
+        TS_ASSERT_EQUALS( watcher.lastNotifiedValues[3], 2.0 );
+
+        TS_ASSERT_THROWS_NOTHING( delete tableau );
+    }
+
     void test_get_entering_variable__have_eligible_variables()
     {
         Tableau *tableau = NULL;
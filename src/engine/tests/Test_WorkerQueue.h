@@ -0,0 +1,234 @@
+/*********************                                                        */
+/*! \file Test_WorkerQueue.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include <cxxtest/TestSuite.h>
+
+#include "MockErrno.h"
+#include "MStringf.h"
+#include "WorkerQueue.h"
+
+#include <chrono>
+#include <list>
+#include <thread>
+
+class MockForWorkerQueue
+    : public MockErrno
+{
+public:
+};
+
+class WorkerQueueTestSuite : public CxxTest::TestSuite
+{
+public:
+    MockForWorkerQueue *mock;
+
+    void setUp()
+    {
+        TS_ASSERT( mock = new MockForWorkerQueue );
+    }
+
+    void tearDown()
+    {
+        TS_ASSERT_THROWS_NOTHING( delete mock );
+    }
+
+    SubQuery *createSubQuery( const String &queryId )
+    {
+        SubQuery *subQuery = new SubQuery;
+        subQuery->_queryId = queryId;
+        subQuery->_timeoutInSeconds = 0;
+        return subQuery;
+    }
+
+    void popAndCheck( WorkerQueue &queue, unsigned worker, const String &expectedId )
+    {
+        SubQuery *subQuery = NULL;
+        TS_ASSERT( queue.pop( worker, subQuery ) );
+        TS_ASSERT( subQuery );
+        if ( subQuery )
+        {
+            TS_ASSERT_EQUALS( subQuery->_queryId, expectedId );
+            delete subQuery;
+        }
+    }
+
+    void test_local_pops_are_lifo()
+    {
+        WorkerQueue queue( 2 );
+        TS_ASSERT( queue.empty() );
+
+        queue.push( createSubQuery( "1" ), 0 );
+        queue.push( createSubQuery( "2" ), 0 );
+        queue.push( createSubQuery( "3" ), 0 );
+        TS_ASSERT_EQUALS( queue.size(), 3U );
+
+        popAndCheck( queue, 0, "3" );
+        popAndCheck( queue, 0, "2" );
+        popAndCheck( queue, 0, "1" );
+
+        TS_ASSERT( queue.empty() );
+        TS_ASSERT_EQUALS( queue.getNumSteals(), 0U );
+    }
+
+    void test_steals_are_fifo()
+    {
+        WorkerQueue queue( 3 );
+        TS_ASSERT_EQUALS( queue.getNumWorkers(), 3U );
+
+        queue.push( createSubQuery( "1" ), 0 );
+        queue.push( createSubQuery( "2" ), 0 );
+        queue.push( createSubQuery( "3" ), 0 );
+
+        // Worker 1 has nothing of its own, and takes the oldest of worker 0
+        popAndCheck( queue, 1, "1" );
+        TS_ASSERT_EQUALS( queue.getNumSteals(), 1U );
+
+        // Own subqueries come first
+        queue.push( createSubQuery( "4" ), 2 );
+        popAndCheck( queue, 2, "4" );
+        popAndCheck( queue, 2, "2" );
+        TS_ASSERT_EQUALS( queue.getNumSteals(), 2U );
+
+        popAndCheck( queue, 0, "3" );
+
+        SubQuery *subQuery = NULL;
+        TS_ASSERT( !queue.pop( 0, subQuery ) );
+        TS_ASSERT( !queue.pop( subQuery ) );
+    }
+
+    void test_pop_any()
+    {
+        WorkerQueue queue( 0 );
+        TS_ASSERT_EQUALS( queue.getNumWorkers(), 1U );
+
+        // Worker indices wrap around the number of deques
+        queue.push( createSubQuery( "1" ), 5 );
+
+        SubQuery *subQuery = NULL;
+        TS_ASSERT( queue.pop( subQuery ) );
+        TS_ASSERT_EQUALS( subQuery->_queryId, "1" );
+        delete subQuery;
+
+        // Subqueries left in the queue are deleted with it
+        WorkerQueue *other = new WorkerQueue( 2 );
+        other->push( createSubQuery( "2" ), 1 );
+        TS_ASSERT_THROWS_NOTHING( delete other );
+    }
+
+    void test_wait_and_pop()
+    {
+        WorkerQueue queue( 2 );
+        std::atomic_bool shouldQuit( false );
+
+        SubQuery *subQuery = NULL;
+        queue.push( createSubQuery( "1" ), 1 );
+        TS_ASSERT( queue.waitAndPop( 0, subQuery, shouldQuit ) );
+        TS_ASSERT_EQUALS( subQuery->_queryId, "1" );
+        delete subQuery;
+
+        // A parked worker is woken up by a push
+        std::thread pusher( [&]()
+        {
+            std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+            queue.push( createSubQuery( "2" ), 1 );
+        } );
+
+        subQuery = NULL;
+        TS_ASSERT( queue.waitAndPop( 0, subQuery, shouldQuit ) );
+        pusher.join();
+        TS_ASSERT( subQuery );
+        if ( subQuery )
+        {
+            TS_ASSERT_EQUALS( subQuery->_queryId, "2" );
+            delete subQuery;
+        }
+
+        // ... or by the end of the search
+        std::thread quitter( [&]()
+        {
+            std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+            shouldQuit = true;
+            queue.notifyQuit();
+        } );
+
+        TS_ASSERT( !queue.waitAndPop( 0, subQuery, shouldQuit ) );
+        quitter.join();
+
+        // The manager is not kept waiting once the search is over
+        TS_ASSERT_THROWS_NOTHING( queue.waitForQuit( shouldQuit, 60000000 ) );
+    }
+
+    void test_concurrent_workers()
+    {
+        enum {
+            NUM_WORKERS = 4,
+            NUM_SUBQUERIES = 1000,
+        };
+
+        WorkerQueue queue( NUM_WORKERS );
+        std::atomic_bool shouldQuit( false );
+        std::atomic_uint numUnsolved( NUM_SUBQUERIES );
+
+        for ( unsigned i = 0; i < NUM_SUBQUERIES; ++i )
+            queue.push( createSubQuery( Stringf( "%u", i ) ), 0 );
+
+        // Each worker splits some of the subqueries it pops in two, and
+        // the search ends when all are done
+        std::atomic_uint numSolved( 0 );
+        auto work = [&]( unsigned worker )
+        {
+            SubQuery *subQuery = NULL;
+            while ( queue.waitAndPop( worker, subQuery, shouldQuit ) )
+            {
+                if ( subQuery->_queryId.length() == 1 )
+                {
+                    numUnsolved += 2;
+                    queue.push( createSubQuery( subQuery->_queryId + "a" ), worker );
+                    queue.push( createSubQuery( subQuery->_queryId + "b" ), worker );
+                }
+
+                delete subQuery;
+                ++numSolved;
+
+                if ( --numUnsolved == 0 )
+                {
+                    shouldQuit = true;
+                    queue.notifyQuit();
+                }
+            }
+        };
+
+        std::list<std::thread> threads;
+        for ( unsigned i = 0; i < NUM_WORKERS; ++i )
+            threads.push_back( std::thread( work, i ) );
+
+        queue.waitForQuit( shouldQuit, 60000000 );
+        TS_ASSERT( shouldQuit.load() );
+
+        for ( auto &thread : threads )
+            thread.join();
+
+        TS_ASSERT( queue.empty() );
+        TS_ASSERT_EQUALS( numSolved.load(), NUM_SUBQUERIES + 20U );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -19,20 +19,46 @@
 #include "Layer.h"
 #include "MStringf.h"
 #include "NLRError.h"
+#include "NativeLPSolver.h"
+#include "Options.h"
 #include "TimeUtils.h"
 
+#include <thread>
+
 namespace NLR {
 
 LPFormulator::LPFormulator( LayerOwner *layerOwner )
     : _layerOwner( layerOwner )
     , _cutoffInUse( false )
     , _cutoffValue( 0 )
+    , _lpSolver( NULL )
 {
-    _gurobi.setTimeLimit( GlobalConfiguration::MILPSolverTimeoutValueInSeconds );
+    _lpSolver = createLPSolver();
 }
 
 LPFormulator::~LPFormulator()
 {
+    if ( _lpSolver )
+    {
+        delete _lpSolver;
+        _lpSolver = NULL;
+    }
+
+    for ( const auto &solver : _workerLpSolvers )
+        delete solver;
+    _workerLpSolvers.clear();
+}
+
+ILPSolver *LPFormulator::createLPSolver() const
+{
+    ILPSolver *solver;
+    if ( Options::get()->nativeLpSolverInUse() )
+        solver = new NativeLPSolver;
+    else
+        solver = new GurobiWrapper;
+
+    solver->setTimeLimit( GlobalConfiguration::MILPSolverTimeoutValueInSeconds );
+    return solver;
 }
 
 double LPFormulator::solveLPRelaxation( const Map<unsigned, Layer *> &layers,
@@ -40,35 +66,54 @@ double LPFormulator::solveLPRelaxation( const Map<unsigned, Layer *> &layers,
                                         String variableName,
                                         unsigned lastLayer )
 {
-    _gurobi.resetModel();
-    createLPRelaxation( layers, _gurobi, lastLayer );
+    _lpSolver->resetModel();
+    createLPRelaxation( layers, *_lpSolver, lastLayer );
+
+    return optimizeVariable( *_lpSolver, minOrMax, variableName, TimeUtils::sampleMicro() );
+}
+
+double LPFormulator::optimizeVariable( ILPSolver &solver,
+                                       MinOrMax minOrMax,
+                                       const String &variableName,
+                                       const struct timespec &neuronStart )
+{
+    double timeLeft =
+        GlobalConfiguration::LP_TIGHTENING_TIME_BUDGET_PER_NEURON_IN_SECONDS -
+        TimeUtils::timePassed( neuronStart, TimeUtils::sampleMicro() ) / 1000000.0;
+
+    // Out of time: return the trivial bound
+    if ( timeLeft <= 0 )
+        return minOrMax == MAX ? FloatUtils::infinity() : FloatUtils::negativeInfinity();
 
-    List<GurobiWrapper::Term> terms;
-    terms.append( GurobiWrapper::Term( 1, variableName ) );
+    solver.setTimeLimit( FloatUtils::min( timeLeft, GlobalConfiguration::MILPSolverTimeoutValueInSeconds ) );
 
+    List<ILPSolver::Term> terms;
+    terms.append( ILPSolver::Term( 1, variableName ) );
+
+    solver.reset();
     if ( minOrMax == MAX )
-        _gurobi.setObjective( terms );
+        solver.setObjective( terms );
     else
-        _gurobi.setCost( terms );
+        solver.setCost( terms );
 
-    _gurobi.solve();
+    solver.solve();
 
-    if ( _gurobi.infeasbile() )
+    if ( solver.infeasbile() )
         throw InfeasibleQueryException();
 
-    if ( _gurobi.cutoffOccurred() )
+    if ( solver.cutoffOccurred() )
         return _cutoffValue;
 
-    if ( _gurobi.optimal() )
+    if ( solver.optimal() )
     {
         Map<String, double> dontCare;
         double result = 0;
-        _gurobi.extractSolution( dontCare, result );
+        solver.extractSolution( dontCare, result );
         return result;
     }
-    else if ( _gurobi.timeout() )
+    else if ( solver.timeout() )
     {
-        return _gurobi.getObjectiveBound();
+        return solver.getObjectiveBound();
     }
 
     throw NLRError( NLRError::UNEXPECTED_RETURN_STATUS_FROM_GUROBI );
@@ -76,10 +121,8 @@ double LPFormulator::solveLPRelaxation( const Map<unsigned, Layer *> &layers,
 
 void LPFormulator::optimizeBoundsWithIncrementalLpRelaxation( const Map<unsigned, Layer *> &layers )
 {
-    _gurobi.resetModel();
+    _lpSolver->resetModel();
 
-    List<GurobiWrapper::Term> terms;
-    Map<String, double> dontCare;
     double lb = 0;
     double ub = 0;
     double currentLb = 0;
@@ -104,7 +147,7 @@ void LPFormulator::optimizeBoundsWithIncrementalLpRelaxation( const Map<unsigned
         */
         ASSERT( layers.exists( i ) );
         Layer *layer = layers[i];
-        addLayerToModel( _gurobi, layer );
+        addLayerToModel( *_lpSolver, layer );
 
         for ( unsigned j = 0; j < layer->getSize(); ++j )
         {
@@ -120,38 +163,15 @@ void LPFormulator::optimizeBoundsWithIncrementalLpRelaxation( const Map<unsigned
             unsigned variable = layer->neuronToVariable( j );
             Stringf variableName( "x%u", variable );
 
-            terms.clear();
-            terms.append( GurobiWrapper::Term( 1, variableName ) );
+            struct timespec neuronStart = TimeUtils::sampleMicro();
 
             // Maximize
-            _gurobi.reset();
-            _gurobi.setObjective( terms );
-            _gurobi.solve();
-
-            if ( _gurobi.infeasbile() )
-                throw InfeasibleQueryException();
-
-            if ( _gurobi.cutoffOccurred() )
-            {
-                ub = _cutoffValue;
-            }
-            else if ( _gurobi.optimal() )
-            {
-                _gurobi.extractSolution( dontCare, ub );
-            }
-            else if ( _gurobi.timeout() )
-            {
-                ub = _gurobi.getObjectiveBound();
-            }
-            else
-            {
-                throw NLRError( NLRError::UNEXPECTED_RETURN_STATUS_FROM_GUROBI );
-            }
+            ub = optimizeVariable( *_lpSolver, MinOrMax::MAX, variableName, neuronStart );
 
             // If the bound is tighter, store it
             if ( ub < currentUb )
             {
-                _gurobi.setUpperBound( variableName, ub );
+                _lpSolver->setUpperBound( variableName, ub );
 
                 if ( FloatUtils::isPositive( currentUb ) &&
                      !FloatUtils::isPositive( ub ) )
@@ -171,34 +191,12 @@ void LPFormulator::optimizeBoundsWithIncrementalLpRelaxation( const Map<unsigned
             }
 
             // Minimize
-            _gurobi.reset();
-            _gurobi.setCost( terms );
-            _gurobi.solve();
-
-            if ( _gurobi.infeasbile() )
-                throw InfeasibleQueryException();
-
-            if ( _gurobi.cutoffOccurred() )
-            {
-                lb = _cutoffValue;
-            }
-            else if ( _gurobi.optimal() )
-            {
-                _gurobi.extractSolution( dontCare, lb );
-            }
-            else if ( _gurobi.timeout() )
-            {
-                lb = _gurobi.getObjectiveBound();
-            }
-            else
-            {
-                throw NLRError( NLRError::UNEXPECTED_RETURN_STATUS_FROM_GUROBI );
-            }
+            lb = optimizeVariable( *_lpSolver, MinOrMax::MIN, variableName, neuronStart );
 
             // If the bound is tighter, store it
             if ( lb > currentLb )
             {
-                _gurobi.setLowerBound( variableName, lb );
+                _lpSolver->setLowerBound( variableName, lb );
 
                 if ( FloatUtils::isNegative( currentLb ) &&
                      !FloatUtils::isNegative( lb ) )
@@ -221,9 +219,9 @@ void LPFormulator::optimizeBoundsWithIncrementalLpRelaxation( const Map<unsigned
 
     gurobiEnd = TimeUtils::sampleMicro();
 
-    LPFormulator_LOG( Stringf( "Number of tighter bounds found by Gurobi: %u. Sign changes: %u. Cutoffs: %u\n",
+    LPFormulator_LOG( Stringf( "Number of tighter bounds found by the LP solver: %u. Sign changes: %u. Cutoffs: %u\n",
                                tighterBoundCounter, signChanges, cutoffs ).ascii() );
-    LPFormulator_LOG( Stringf( "Seconds spent Gurobiing: %llu\n", TimeUtils::timePassed( gurobiStart, gurobiEnd ) / 1000000 ).ascii() );
+    LPFormulator_LOG( Stringf( "Seconds spent solving LPs: %llu\n", TimeUtils::timePassed( gurobiStart, gurobiEnd ) / 1000000 ).ascii() );
 }
 
 void LPFormulator::optimizeBoundsWithLpRelaxation( const Map<unsigned, Layer *> &layers )
@@ -249,6 +247,16 @@ void LPFormulator::optimizeBoundsWithLpRelaxation( const Map<unsigned, Layer *>
     {
         Layer *layer = currentLayer.second;
 
+        /*
+          The bounds of the preceding layers are final by now, so the
+          model is built once per layer. The neurons of the layer are
+          then optimized one by one, changing only the objective and
+          the bounds tightened along the way, so that the solver can
+          warm-start from the previous solution.
+        */
+        _lpSolver->resetModel();
+        createLPRelaxation( layers, *_lpSolver, layer->getLayerIndex() );
+
         for ( unsigned i = 0; i < layer->getSize(); ++i )
         {
             if ( layer->neuronEliminated( i ) )
@@ -263,14 +271,15 @@ void LPFormulator::optimizeBoundsWithLpRelaxation( const Map<unsigned, Layer *>
             unsigned variable = layer->neuronToVariable( i );
             Stringf variableName( "x%u", variable );
 
-            ub = solveLPRelaxation( layers,
-                                    MinOrMax::MAX,
-                                    variableName,
-                                    layer->getLayerIndex() );
+            struct timespec neuronStart = TimeUtils::sampleMicro();
+
+            ub = optimizeVariable( *_lpSolver, MinOrMax::MAX, variableName, neuronStart );
 
             // Store the new bound if it is tighter
             if ( ub < currentUb )
             {
+                _lpSolver->setUpperBound( variableName, ub );
+
                 if ( FloatUtils::isPositive( currentUb ) &&
                      !FloatUtils::isPositive( ub ) )
                     ++signChanges;
@@ -288,14 +297,13 @@ void LPFormulator::optimizeBoundsWithLpRelaxation( const Map<unsigned, Layer *>
                 }
             }
 
-            lb = solveLPRelaxation( layers,
-                                    MinOrMax::MIN,
-                                    variableName,
-                                    layer->getLayerIndex() );
+            lb = optimizeVariable( *_lpSolver, MinOrMax::MIN, variableName, neuronStart );
 
             // Store the new bound if it is tighter
             if ( lb > currentLb )
             {
+                _lpSolver->setLowerBound( variableName, lb );
+
                 if ( FloatUtils::isNegative( currentLb ) &&
                      !FloatUtils::isNegative( lb ) )
                     ++signChanges;
@@ -317,13 +325,201 @@ void LPFormulator::optimizeBoundsWithLpRelaxation( const Map<unsigned, Layer *>
 
     gurobiEnd = TimeUtils::sampleMicro();
 
-    LPFormulator_LOG( Stringf( "Number of tighter bounds found by Gurobi: %u. Sign changes: %u. Cutoffs: %u\n",
+    LPFormulator_LOG( Stringf( "Number of tighter bounds found by the LP solver: %u. Sign changes: %u. Cutoffs: %u\n",
                                tighterBoundCounter, signChanges, cutoffs ).ascii() );
-    LPFormulator_LOG( Stringf( "Seconds spent Gurobiing: %llu\n", TimeUtils::timePassed( gurobiStart, gurobiEnd ) / 1000000 ).ascii() );
+    LPFormulator_LOG( Stringf( "Seconds spent solving LPs: %llu\n", TimeUtils::timePassed( gurobiStart, gurobiEnd ) / 1000000 ).ascii() );
+}
+
+void LPFormulator::optimizeBoundsWithParallelLpRelaxation( const Map<unsigned, Layer *> &layers,
+                                                            unsigned numberOfWorkers )
+{
+    if ( numberOfWorkers <= 1 )
+    {
+        optimizeBoundsWithLpRelaxation( layers );
+        return;
+    }
+
+    // The solvers are created up front, on this thread
+    while ( _workerLpSolvers.size() < numberOfWorkers - 1 )
+        _workerLpSolvers.append( createLPSolver() );
+
+    unsigned tighterBoundCounter = 0;
+    unsigned signChanges = 0;
+    unsigned cutoffs = 0;
+
+    struct timespec gurobiStart;
+    (void) gurobiStart;
+    struct timespec gurobiEnd;
+    (void) gurobiEnd;
+
+    gurobiStart = TimeUtils::sampleMicro();
+
+    for ( const auto &currentLayer : layers )
+    {
+        Layer *layer = currentLayer.second;
+
+        // Collect the neurons that need to be optimized
+        Vector<unsigned> neurons;
+        for ( unsigned i = 0; i < layer->getSize(); ++i )
+        {
+            if ( layer->neuronEliminated( i ) )
+                continue;
+
+            double currentLb = layer->getLb( i );
+            double currentUb = layer->getUb( i );
+
+            if ( _cutoffInUse && ( currentLb > _cutoffValue || currentUb < _cutoffValue ) )
+                continue;
+
+            neurons.append( i );
+        }
+
+        if ( neurons.empty() )
+            continue;
+
+        Vector<double> newLbs( neurons.size() );
+        Vector<double> newUbs( neurons.size() );
+        for ( unsigned i = 0; i < neurons.size(); ++i )
+        {
+            newLbs[i] = layer->getLb( neurons[i] );
+            newUbs[i] = layer->getUb( neurons[i] );
+        }
+
+        unsigned activeWorkers =
+            numberOfWorkers < neurons.size() ? numberOfWorkers : neurons.size();
+        Vector<std::exception_ptr> errors( activeWorkers, nullptr );
+        std::atomic_bool abort( false );
+
+        List<std::thread *> threads;
+        for ( unsigned w = 0; w < activeWorkers; ++w )
+        {
+            ILPSolver *solver = ( w == 0 ) ? _lpSolver : _workerLpSolvers[w - 1];
+            threads.append( new std::thread( &LPFormulator::optimizeNeuronsInParallel,
+                                             this,
+                                             std::ref( layers ),
+                                             layer,
+                                             solver,
+                                             std::ref( neurons ),
+                                             w,
+                                             activeWorkers,
+                                             std::ref( newLbs ),
+                                             std::ref( newUbs ),
+                                             std::ref( abort ),
+                                             std::ref( errors[w] ) ) );
+        }
+
+        for ( auto &thread : threads )
+        {
+            thread->join();
+            delete thread;
+        }
+
+        for ( const auto &error : errors )
+            if ( error )
+                std::rethrow_exception( error );
+
+        // Merge the results, in neuron order
+        for ( unsigned i = 0; i < neurons.size(); ++i )
+        {
+            unsigned neuron = neurons[i];
+            unsigned variable = layer->neuronToVariable( neuron );
+            double currentLb = layer->getLb( neuron );
+            double currentUb = layer->getUb( neuron );
+
+            if ( newUbs[i] < currentUb )
+            {
+                if ( FloatUtils::isPositive( currentUb ) &&
+                     !FloatUtils::isPositive( newUbs[i] ) )
+                    ++signChanges;
+
+                layer->setUb( neuron, newUbs[i] );
+                _layerOwner->receiveTighterBound( Tightening( variable,
+                                                              newUbs[i],
+                                                              Tightening::UB ) );
+                ++tighterBoundCounter;
+
+                if ( _cutoffInUse && newUbs[i] < _cutoffValue )
+                    ++cutoffs;
+            }
+
+            if ( newLbs[i] > currentLb )
+            {
+                if ( FloatUtils::isNegative( currentLb ) &&
+                     !FloatUtils::isNegative( newLbs[i] ) )
+                    ++signChanges;
+
+                layer->setLb( neuron, newLbs[i] );
+                _layerOwner->receiveTighterBound( Tightening( variable,
+                                                              newLbs[i],
+                                                              Tightening::LB ) );
+                ++tighterBoundCounter;
+
+                if ( _cutoffInUse && newLbs[i] > _cutoffValue )
+                    ++cutoffs;
+            }
+        }
+    }
+
+    gurobiEnd = TimeUtils::sampleMicro();
+
+    LPFormulator_LOG( Stringf( "Number of tighter bounds found by the LP solver: %u. Sign changes: %u. Cutoffs: %u\n",
+                               tighterBoundCounter, signChanges, cutoffs ).ascii() );
+    LPFormulator_LOG( Stringf( "Seconds spent solving LPs: %llu\n", TimeUtils::timePassed( gurobiStart, gurobiEnd ) / 1000000 ).ascii() );
+}
+
+void LPFormulator::optimizeNeuronsInParallel( const Map<unsigned, Layer *> &layers,
+                                              const Layer *layer,
+                                              ILPSolver *solver,
+                                              const Vector<unsigned> &neurons,
+                                              unsigned firstNeuron,
+                                              unsigned numberOfWorkers,
+                                              Vector<double> &newLbs,
+                                              Vector<double> &newUbs,
+                                              std::atomic_bool &abort,
+                                              std::exception_ptr &error )
+{
+    try
+    {
+        solver->resetModel();
+        createLPRelaxation( layers, *solver, layer->getLayerIndex() );
+
+        for ( unsigned i = firstNeuron; i < neurons.size(); i += numberOfWorkers )
+        {
+            if ( abort.load() )
+                return;
+
+            unsigned variable = layer->neuronToVariable( neurons.get( i ) );
+            Stringf variableName( "x%u", variable );
+
+            struct timespec neuronStart = TimeUtils::sampleMicro();
+
+            double ub = optimizeVariable( *solver, MinOrMax::MAX, variableName, neuronStart );
+            if ( ub < newUbs[i] )
+            {
+                newUbs[i] = ub;
+                solver->setUpperBound( variableName, ub );
+
+                if ( _cutoffInUse && ub < _cutoffValue )
+                    continue;
+            }
+
+            double lb = optimizeVariable( *solver, MinOrMax::MIN, variableName, neuronStart );
+            if ( lb > newLbs[i] )
+            {
+                newLbs[i] = lb;
+                solver->setLowerBound( variableName, lb );
+            }
+        }
+    }
+    catch ( ... )
+    {
+        error = std::current_exception();
+        abort = true;
+    }
 }
 
 void LPFormulator::createLPRelaxation( const Map<unsigned, Layer *> &layers,
-                                       GurobiWrapper &gurobi,
+                                       ILPSolver &solver,
                                        unsigned lastLayer )
 {
     for ( const auto &layer : layers )
@@ -331,24 +527,40 @@ void LPFormulator::createLPRelaxation( const Map<unsigned, Layer *> &layers,
         if ( layer.second->getLayerIndex() > lastLayer )
             continue;
 
-        addLayerToModel( gurobi, layer.second );
+        addLayerToModel( solver, layer.second );
     }
 }
 
-void LPFormulator::addLayerToModel( GurobiWrapper &gurobi, const Layer *layer )
+void LPFormulator::addLayerToModel( ILPSolver &solver, const Layer *layer )
 {
     switch ( layer->getLayerType() )
     {
     case Layer::INPUT:
-        addInputLayerToLpRelaxation( gurobi, layer );
+        addInputLayerToLpRelaxation( solver, layer );
         break;
 
     case Layer::RELU:
-        addReluLayerToLpRelaxation( gurobi, layer );
+        addReluLayerToLpRelaxation( solver, layer );
+        break;
+
+    case Layer::ABSOLUTE_VALUE:
+        addAbsoluteValueLayerToLpRelaxation( solver, layer );
+        break;
+
+    case Layer::SIGN:
+        addSignLayerToLpRelaxation( solver, layer );
+        break;
+
+    case Layer::MAX:
+        addMaxLayerToLpRelaxation( solver, layer );
         break;
 
     case Layer::WEIGHTED_SUM:
-        addWeightedSumLayerToLpRelaxation( gurobi, layer );
+        addWeightedSumLayerToLpRelaxation( solver, layer );
+        break;
+
+    case Layer::CONVOLUTION:
+        addConvolutionLayerToLpRelaxation( solver, layer );
         break;
 
     default:
@@ -357,19 +569,19 @@ void LPFormulator::addLayerToModel( GurobiWrapper &gurobi, const Layer *layer )
     }
 }
 
-void LPFormulator::addInputLayerToLpRelaxation( GurobiWrapper &gurobi,
+void LPFormulator::addInputLayerToLpRelaxation( ILPSolver &solver,
                                                 const Layer *layer )
 {
     for ( unsigned i = 0; i < layer->getSize(); ++i )
     {
         unsigned variable = layer->neuronToVariable( i );
-        gurobi.addVariable( Stringf( "x%u", variable ),
+        solver.addVariable( Stringf( "x%u", variable ),
                             layer->getLb( i ),
                             layer->getUb( i ) );
     }
 }
 
-void LPFormulator::addReluLayerToLpRelaxation( GurobiWrapper &gurobi,
+void LPFormulator::addReluLayerToLpRelaxation( ILPSolver &solver,
                                                const Layer *layer )
 {
     for ( unsigned i = 0; i < layer->getSize(); ++i )
@@ -388,7 +600,7 @@ void LPFormulator::addReluLayerToLpRelaxation( GurobiWrapper &gurobi,
                 double sourceValue = sourceLayer->getEliminatedNeuronValue( sourceNeuron );
                 double targetValue = sourceValue > 0 ? sourceValue : 0;
 
-                gurobi.addVariable( Stringf( "x%u", targetVariable ),
+                solver.addVariable( Stringf( "x%u", targetVariable ),
                                     targetValue,
                                     targetValue );
 
@@ -399,7 +611,7 @@ void LPFormulator::addReluLayerToLpRelaxation( GurobiWrapper &gurobi,
             double sourceLb = sourceLayer->getLb( sourceNeuron );
             double sourceUb = sourceLayer->getUb( sourceNeuron );
 
-            gurobi.addVariable( Stringf( "x%u", targetVariable ),
+            solver.addVariable( Stringf( "x%u", targetVariable ),
                                 0,
                                 layer->getUb( i ) );
 
@@ -409,17 +621,17 @@ void LPFormulator::addReluLayerToLpRelaxation( GurobiWrapper &gurobi,
                 if ( sourceLb < 0 )
                     sourceLb = 0;
 
-                List<GurobiWrapper::Term> terms;
-                terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-                terms.append( GurobiWrapper::Term( -1, Stringf( "x%u", sourceVariable ) ) );
-                gurobi.addEqConstraint( terms, 0 );
+                List<ILPSolver::Term> terms;
+                terms.append( ILPSolver::Term( 1, Stringf( "x%u", targetVariable ) ) );
+                terms.append( ILPSolver::Term( -1, Stringf( "x%u", sourceVariable ) ) );
+                solver.addEqConstraint( terms, 0 );
             }
             else if ( !FloatUtils::isPositive( sourceUb ) )
             {
                 // The ReLU is inactive, y = 0
-                List<GurobiWrapper::Term> terms;
-                terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-                gurobi.addEqConstraint( terms, 0 );
+                List<ILPSolver::Term> terms;
+                terms.append( ILPSolver::Term( 1, Stringf( "x%u", targetVariable ) ) );
+                solver.addEqConstraint( terms, 0 );
             }
             else
             {
@@ -434,15 +646,15 @@ void LPFormulator::addReluLayerToLpRelaxation( GurobiWrapper &gurobi,
                 */
 
                 // y >= 0
-                List<GurobiWrapper::Term> terms;
-                terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-                gurobi.addGeqConstraint( terms, 0 );
+                List<ILPSolver::Term> terms;
+                terms.append( ILPSolver::Term( 1, Stringf( "x%u", targetVariable ) ) );
+                solver.addGeqConstraint( terms, 0 );
 
                 // y >= x, i.e. y - x >= 0
                 terms.clear();
-                terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-                terms.append( GurobiWrapper::Term( -1, Stringf( "x%u", sourceVariable ) ) );
-                gurobi.addGeqConstraint( terms, 0 );
+                terms.append( ILPSolver::Term( 1, Stringf( "x%u", targetVariable ) ) );
+                terms.append( ILPSolver::Term( -1, Stringf( "x%u", sourceVariable ) ) );
+                solver.addGeqConstraint( terms, 0 );
 
                 /*
                          u        ul
@@ -450,15 +662,199 @@ void LPFormulator::addReluLayerToLpRelaxation( GurobiWrapper &gurobi,
                        u - l     u - l
                 */
                 terms.clear();
-                terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-                terms.append( GurobiWrapper::Term( -sourceUb / ( sourceUb - sourceLb ), Stringf( "x%u", sourceVariable ) ) );
-                gurobi.addLeqConstraint( terms, ( -sourceUb * sourceLb ) / ( sourceUb - sourceLb ) );
+                terms.append( ILPSolver::Term( 1, Stringf( "x%u", targetVariable ) ) );
+                terms.append( ILPSolver::Term( -sourceUb / ( sourceUb - sourceLb ), Stringf( "x%u", sourceVariable ) ) );
+                solver.addLeqConstraint( terms, ( -sourceUb * sourceLb ) / ( sourceUb - sourceLb ) );
+            }
+        }
+    }
+}
+
+void LPFormulator::addAbsoluteValueLayerToLpRelaxation( ILPSolver &solver,
+                                                        const Layer *layer )
+{
+    for ( unsigned i = 0; i < layer->getSize(); ++i )
+    {
+        if ( layer->neuronEliminated( i ) )
+            continue;
+
+        unsigned targetVariable = layer->neuronToVariable( i );
+
+        List<NeuronIndex> sources = layer->getActivationSources( i );
+        const Layer *sourceLayer = _layerOwner->getLayer( sources.begin()->_layer );
+        unsigned sourceNeuron = sources.begin()->_neuron;
+
+        if ( sourceLayer->neuronEliminated( sourceNeuron ) )
+        {
+            // If the source neuron has been eliminated, this neuron is constant
+            double targetValue = FloatUtils::abs( sourceLayer->getEliminatedNeuronValue( sourceNeuron ) );
+
+            solver.addVariable( Stringf( "x%u", targetVariable ),
+                                targetValue,
+                                targetValue );
+
+            continue;
+        }
+
+        unsigned sourceVariable = sourceLayer->neuronToVariable( sourceNeuron );
+        double sourceLb = sourceLayer->getLb( sourceNeuron );
+        double sourceUb = sourceLayer->getUb( sourceNeuron );
+
+        solver.addVariable( Stringf( "x%u", targetVariable ),
+                            0,
+                            layer->getUb( i ) );
+
+        List<ILPSolver::Term> terms;
+        if ( !FloatUtils::isNegative( sourceLb ) )
+        {
+            // Positive phase, y = x
+            terms.append( ILPSolver::Term( 1, Stringf( "x%u", targetVariable ) ) );
+            terms.append( ILPSolver::Term( -1, Stringf( "x%u", sourceVariable ) ) );
+            solver.addEqConstraint( terms, 0 );
+        }
+        else if ( !FloatUtils::isPositive( sourceUb ) )
+        {
+            // Negative phase, y = -x
+            terms.append( ILPSolver::Term( 1, Stringf( "x%u", targetVariable ) ) );
+            terms.append( ILPSolver::Term( 1, Stringf( "x%u", sourceVariable ) ) );
+            solver.addEqConstraint( terms, 0 );
+        }
+        else
+        {
+            /*
+              The phase is not yet fixed. For y = |x|, we add:
+
+              1. y >= x
+              2. y >= -x
+              3. y is below the line that crosses (x.lb,-x.lb) and (x.ub,x.ub)
+            */
+
+            // y - x >= 0
+            terms.append( ILPSolver::Term( 1, Stringf( "x%u", targetVariable ) ) );
+            terms.append( ILPSolver::Term( -1, Stringf( "x%u", sourceVariable ) ) );
+            solver.addGeqConstraint( terms, 0 );
+
+            // y + x >= 0
+            terms.clear();
+            terms.append( ILPSolver::Term( 1, Stringf( "x%u", targetVariable ) ) );
+            terms.append( ILPSolver::Term( 1, Stringf( "x%u", sourceVariable ) ) );
+            solver.addGeqConstraint( terms, 0 );
+
+            /*
+                     u + l
+              y <=  ------- ( x - l ) - l
+                     u - l
+            */
+            double slope = ( sourceUb + sourceLb ) / ( sourceUb - sourceLb );
+            terms.clear();
+            terms.append( ILPSolver::Term( 1, Stringf( "x%u", targetVariable ) ) );
+            terms.append( ILPSolver::Term( -slope, Stringf( "x%u", sourceVariable ) ) );
+            solver.addLeqConstraint( terms, -slope * sourceLb - sourceLb );
+        }
+    }
+}
+
+void LPFormulator::addSignLayerToLpRelaxation( ILPSolver &solver,
+                                               const Layer *layer )
+{
+    for ( unsigned i = 0; i < layer->getSize(); ++i )
+    {
+        if ( layer->neuronEliminated( i ) )
+            continue;
+
+        unsigned targetVariable = layer->neuronToVariable( i );
+
+        List<NeuronIndex> sources = layer->getActivationSources( i );
+        const Layer *sourceLayer = _layerOwner->getLayer( sources.begin()->_layer );
+        unsigned sourceNeuron = sources.begin()->_neuron;
+
+        double sourceLb = sourceLayer->getLb( sourceNeuron );
+        double sourceUb = sourceLayer->getUb( sourceNeuron );
+
+        // The sign is fixed if the source is constant or of fixed phase
+        if ( !FloatUtils::isNegative( sourceLb ) || FloatUtils::isNegative( sourceUb ) )
+        {
+            double targetValue = FloatUtils::isNegative( sourceLb ) ? -1 : 1;
+            solver.addVariable( Stringf( "x%u", targetVariable ),
+                                targetValue,
+                                targetValue );
+            continue;
+        }
+
+        unsigned sourceVariable = sourceLayer->neuronToVariable( sourceNeuron );
+
+        solver.addVariable( Stringf( "x%u", targetVariable ),
+                            FloatUtils::max( layer->getLb( i ), -1 ),
+                            FloatUtils::min( layer->getUb( i ), 1 ) );
+
+        /*
+          The phase is not yet fixed, and l < 0 <= u. For y = sign(x),
+          we add:
+
+          1. y >= -1 + 2/u * x   (if u > 0)
+          2. y <=  1 - 2/l * x
+        */
+        List<ILPSolver::Term> terms;
+        if ( FloatUtils::isPositive( sourceUb ) )
+        {
+            terms.append( ILPSolver::Term( 1, Stringf( "x%u", targetVariable ) ) );
+            terms.append( ILPSolver::Term( -2 / sourceUb, Stringf( "x%u", sourceVariable ) ) );
+            solver.addGeqConstraint( terms, -1 );
+        }
+
+        terms.clear();
+        terms.append( ILPSolver::Term( 1, Stringf( "x%u", targetVariable ) ) );
+        terms.append( ILPSolver::Term( 2 / sourceLb, Stringf( "x%u", sourceVariable ) ) );
+        solver.addLeqConstraint( terms, 1 );
+    }
+}
+
+void LPFormulator::addMaxLayerToLpRelaxation( ILPSolver &solver,
+                                              const Layer *layer )
+{
+    for ( unsigned i = 0; i < layer->getSize(); ++i )
+    {
+        if ( layer->neuronEliminated( i ) )
+            continue;
+
+        unsigned targetVariable = layer->neuronToVariable( i );
+        Stringf targetName( "x%u", targetVariable );
+
+        solver.addVariable( targetName,
+                            layer->getLb( i ),
+                            layer->getUb( i ) );
+
+        /*
+          For y = max( x_1, ..., x_n ), we add y >= x_i for every i, and
+          bound y from above by the largest upper bound of any x_i
+        */
+        double maxUb = FloatUtils::negativeInfinity();
+        for ( const auto &source : layer->getActivationSources( i ) )
+        {
+            const Layer *sourceLayer = _layerOwner->getLayer( source._layer );
+            maxUb = FloatUtils::max( maxUb, sourceLayer->getUb( source._neuron ) );
+
+            List<ILPSolver::Term> terms;
+            terms.append( ILPSolver::Term( 1, targetName ) );
+
+            if ( sourceLayer->neuronEliminated( source._neuron ) )
+            {
+                solver.addGeqConstraint( terms, sourceLayer->getEliminatedNeuronValue( source._neuron ) );
+            }
+            else
+            {
+                terms.append( ILPSolver::Term( -1, Stringf( "x%u", sourceLayer->neuronToVariable( source._neuron ) ) ) );
+                solver.addGeqConstraint( terms, 0 );
             }
         }
+
+        List<ILPSolver::Term> terms;
+        terms.append( ILPSolver::Term( 1, targetName ) );
+        solver.addLeqConstraint( terms, maxUb );
     }
 }
 
-void LPFormulator::addWeightedSumLayerToLpRelaxation( GurobiWrapper &gurobi, const Layer *layer )
+void LPFormulator::addWeightedSumLayerToLpRelaxation( ILPSolver &solver, const Layer *layer )
 {
     for ( unsigned i = 0; i < layer->getSize(); ++i )
     {
@@ -466,12 +862,12 @@ void LPFormulator::addWeightedSumLayerToLpRelaxation( GurobiWrapper &gurobi, con
         {
             unsigned variable = layer->neuronToVariable( i );
 
-            gurobi.addVariable( Stringf( "x%u", variable ),
+            solver.addVariable( Stringf( "x%u", variable ),
                                 layer->getLb( i ),
                                 layer->getUb( i ) );
 
-            List<GurobiWrapper::Term> terms;
-            terms.append( GurobiWrapper::Term( -1, Stringf( "x%u", variable ) ) );
+            List<ILPSolver::Term> terms;
+            terms.append( ILPSolver::Term( -1, Stringf( "x%u", variable ) ) );
 
             double bias = -layer->getBias( i );
 
@@ -487,7 +883,7 @@ void LPFormulator::addWeightedSumLayerToLpRelaxation( GurobiWrapper &gurobi, con
                     {
                         Stringf sourceVariableName( "x%u",
                                                     sourceLayer->neuronToVariable( j ) );
-                        terms.append( GurobiWrapper::Term( weight, sourceVariableName ) );
+                        terms.append( ILPSolver::Term( weight, sourceVariableName ) );
                     }
                     else
                     {
@@ -496,7 +892,49 @@ void LPFormulator::addWeightedSumLayerToLpRelaxation( GurobiWrapper &gurobi, con
                 }
             }
 
-            gurobi.addEqConstraint( terms, bias );
+            solver.addEqConstraint( terms, bias );
+        }
+    }
+}
+
+void LPFormulator::addConvolutionLayerToLpRelaxation( ILPSolver &solver, const Layer *layer )
+{
+    const Layer *sourceLayer = _layerOwner->getLayer( layer->getSourceLayers().begin()->first );
+
+    for ( unsigned i = 0; i < layer->getSize(); ++i )
+    {
+        if ( !layer->neuronEliminated( i ) )
+        {
+            unsigned variable = layer->neuronToVariable( i );
+
+            solver.addVariable( Stringf( "x%u", variable ),
+                                layer->getLb( i ),
+                                layer->getUb( i ) );
+
+            List<ILPSolver::Term> terms;
+            terms.append( ILPSolver::Term( -1, Stringf( "x%u", variable ) ) );
+
+            double bias = -layer->getBias( i );
+
+            // Only the receptive field of the neuron contributes to it
+            for ( const auto &tap : layer->getConvolutionTaps( i ) )
+            {
+                unsigned j = tap.first();
+                double weight = tap.second();
+
+                if ( !sourceLayer->neuronEliminated( j ) )
+                {
+                    Stringf sourceVariableName( "x%u",
+                                                sourceLayer->neuronToVariable( j ) );
+                    terms.append( ILPSolver::Term( weight, sourceVariableName ) );
+                }
+                else
+                {
+                    bias += weight * sourceLayer->getEliminatedNeuronValue( j );
+                }
+            }
+
+            solver.addEqConstraint( terms, bias );
         }
     }
 }
@@ -16,9 +16,14 @@
 #ifndef __LPFormulator_h__
 #define __LPFormulator_h__
 
-#include "GurobiWrapper.h"
+#include "ILPSolver.h"
 #include "LayerOwner.h"
+#include "TimeUtils.h"
+#include "Vector.h"
+
+#include <atomic>
 #include <climits>
+#include <exception>
 
 namespace NLR {
 
@@ -40,11 +45,28 @@ public:
       if the LPFormulator is used in stand-alone mode. The process can
       also be performed incrementally, which means that the underlying
       LP model is adjusted from the previous call, instead of being
-      constructed from scratch
+      constructed from scratch.
+
+      The LPs are solved by Gurobi if it is available, and otherwise by
+      the built-in simplex (see NativeLPSolver). Either way, the time
+      spent on each neuron is limited by
+      GlobalConfiguration::LP_TIGHTENING_TIME_BUDGET_PER_NEURON_IN_SECONDS.
     */
     void optimizeBoundsWithLpRelaxation( const Map<unsigned, Layer *> &layers );
     void optimizeBoundsWithIncrementalLpRelaxation( const Map<unsigned, Layer *> &layers );
 
+    /*
+      A parallel version of optimizeBoundsWithLpRelaxation. The neurons
+      of each layer are split among the workers, each of which owns an
+      LP model that it builds once per layer. The bounds discovered by
+      the workers are merged into the layer before the next layer is
+      processed. A worker only sees its own tightenings within the
+      current layer, so the bounds may be slightly looser than those of
+      the sequential version.
+    */
+    void optimizeBoundsWithParallelLpRelaxation( const Map<unsigned, Layer *> &layers,
+                                                 unsigned numberOfWorkers );
+
     /*
       When optimizing, we compute lower and upper bounds for each
       varibale. If a cutoff value is set, once one of these bounds
@@ -59,28 +81,78 @@ public:
       tightening
     */
     void createLPRelaxation( const Map<unsigned, Layer *> &layers,
-                             GurobiWrapper &gurobi,
+                             ILPSolver &solver,
                              unsigned lastLayer = UINT_MAX);
 
     double solveLPRelaxation( const Map<unsigned, Layer *> &layers,
                               MinOrMax minOrMax,
                               String variableName,
                               unsigned lastLayer = UINT_MAX );
-    void addLayerToModel( GurobiWrapper &gurobi, const Layer *layer );
+    void addLayerToModel( ILPSolver &solver, const Layer *layer );
 
 private:
     LayerOwner *_layerOwner;
     bool _cutoffInUse;
     double _cutoffValue;
-    GurobiWrapper _gurobi;
+    ILPSolver *_lpSolver;
 
-    void addInputLayerToLpRelaxation( GurobiWrapper &gurobi,
+    /*
+      The additional LP models used by the workers of the parallel
+      mode. The first worker uses _lpSolver.
+    */
+    Vector<ILPSolver *> _workerLpSolvers;
+
+    ILPSolver *createLPSolver() const;
+
+    /*
+      The body of a worker in the parallel mode: build the LP relaxation
+      up to the given layer, and then optimize every numberOfWorkers'th
+      neuron in the given list, starting from the firstNeuron'th one.
+      The results are stored in the corresponding entries of newLbs and
+      newUbs. Any exception is stored in error, after which abort is
+      set so that the remaining workers stop early.
+    */
+    void optimizeNeuronsInParallel( const Map<unsigned, Layer *> &layers,
+                                    const Layer *layer,
+                                    ILPSolver *solver,
+                                    const Vector<unsigned> &neurons,
+                                    unsigned firstNeuron,
+                                    unsigned numberOfWorkers,
+                                    Vector<double> &newLbs,
+                                    Vector<double> &newUbs,
+                                    std::atomic_bool &abort,
+                                    std::exception_ptr &error );
+
+    /*
+      Minimize or maximize a variable over the current model, within
+      what is left of the time budget of the neuron whose optimization
+      started at neuronStart. If the solver times out, the best bound
+      it knows of is returned.
+    */
+    double optimizeVariable( ILPSolver &solver,
+                             MinOrMax minOrMax,
+                             const String &variableName,
+                             const struct timespec &neuronStart );
+
+    void addInputLayerToLpRelaxation( ILPSolver &solver,
                                       const Layer *layer );
 
-    void addReluLayerToLpRelaxation( GurobiWrapper &gurobi,
+    void addReluLayerToLpRelaxation( ILPSolver &solver,
+                                     const Layer *layer );
+
+    void addAbsoluteValueLayerToLpRelaxation( ILPSolver &solver,
+                                              const Layer *layer );
+
+    void addSignLayerToLpRelaxation( ILPSolver &solver,
                                      const Layer *layer );
 
-    void addWeightedSumLayerToLpRelaxation( GurobiWrapper &gurobi,
+    void addMaxLayerToLpRelaxation( ILPSolver &solver,
+                                    const Layer *layer );
+
+    void addWeightedSumLayerToLpRelaxation( ILPSolver &solver,
+                                            const Layer *layer );
+
+    void addConvolutionLayerToLpRelaxation( ILPSolver &solver,
                                             const Layer *layer );
 };
 
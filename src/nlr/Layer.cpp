@@ -13,8 +13,12 @@
 
  **/
 
+#include "InputQuery.h"
 #include "Layer.h"
 
+#include <cmath>
+#include <limits>
+
 namespace NLR {
 
 Layer::~Layer()
@@ -33,6 +37,12 @@ Layer::Layer( unsigned index, Type type, unsigned size, LayerOwner *layerOwner )
     , _size( size )
     , _layerOwner( layerOwner )
     , _bias( NULL )
+    , _weightsSharedWithCopies( false )
+    , _weightsShared( false )
+    , _kernel( NULL )
+    , _tapStart( NULL )
+    , _tapSourceNeuron( NULL )
+    , _tapKernelIndex( NULL )
     , _assignment( NULL )
     , _lb( NULL )
     , _ub( NULL )
@@ -51,7 +61,7 @@ Layer::Layer( unsigned index, Type type, unsigned size, LayerOwner *layerOwner )
 
 void Layer::allocateMemory()
 {
-    if ( _type == WEIGHTED_SUM )
+    if ( _type == WEIGHTED_SUM || _type == CONVOLUTION )
     {
         _bias = new double[_size];
         std::fill_n( _bias, _size, 0 );
@@ -94,8 +104,10 @@ void Layer::allocateMemory()
 
 void Layer::setAssignment( const double *values )
 {
-    ASSERT( _eliminatedNeurons.empty() );
     memcpy( _assignment, values, _size * sizeof(double) );
+
+    for ( const auto &eliminated : _eliminatedNeurons )
+        _assignment[eliminated.first] = eliminated.second;
 }
 
 const double *Layer::getAssignment() const
@@ -131,6 +143,19 @@ void Layer::computeAssignment()
         }
     }
 
+    else if ( _type == CONVOLUTION )
+    {
+        const Layer *sourceLayer = _layerOwner->getLayer( _sourceLayers.begin()->first );
+        const double *sourceAssignment = sourceLayer->getAssignment();
+
+        for ( unsigned i = 0; i < _size; ++i )
+        {
+            _assignment[i] = _bias[i];
+            for ( unsigned tap = _tapStart[i]; tap < _tapStart[i + 1]; ++tap )
+                _assignment[i] += sourceAssignment[_tapSourceNeuron[tap]] * _kernel[_tapKernelIndex[tap]];
+        }
+    }
+
     else if ( _type == RELU )
     {
         for ( unsigned i = 0; i < _size; ++i )
@@ -153,6 +178,17 @@ void Layer::computeAssignment()
         }
     }
 
+    else if ( _type == SIGN )
+    {
+        for ( unsigned i = 0; i < _size; ++i )
+        {
+            NeuronIndex sourceIndex = *_neuronToActivationSources[i].begin();
+            double inputValue = _layerOwner->getLayer( sourceIndex._layer )->getAssignment( sourceIndex._neuron );
+
+            _assignment[i] = FloatUtils::isNegative( inputValue ) ? -1 : 1;
+        }
+    }
+
     else if ( _type == MAX )
     {
         for ( unsigned i = 0; i < _size; ++i )
@@ -181,6 +217,107 @@ void Layer::computeAssignment()
         _assignment[eliminated.first] = eliminated.second;
 }
 
+void Layer::backPropagate( Map<unsigned, double *> &gradients, bool useBounds ) const
+{
+    if ( _type == INPUT )
+        return;
+
+    // Eliminated neurons have no effect on their sources
+    double *gradient = new double[_size];
+    memcpy( gradient, gradients[_layerIndex], sizeof(double) * _size );
+    for ( const auto &eliminated : _eliminatedNeurons )
+        gradient[eliminated.first] = 0;
+
+    if ( _type == WEIGHTED_SUM )
+    {
+        for ( const auto &sourceLayerEntry : _sourceLayers )
+        {
+            double *sourceGradient = gradients[sourceLayerEntry.first];
+            const double *weights = _layerToWeights[sourceLayerEntry.first];
+
+            for ( unsigned i = 0; i < sourceLayerEntry.second; ++i )
+                for ( unsigned j = 0; j < _size; ++j )
+                    sourceGradient[i] += weights[i * _size + j] * gradient[j];
+        }
+    }
+
+    else if ( _type == CONVOLUTION )
+    {
+        double *sourceGradient = gradients[_sourceLayers.begin()->first];
+
+        for ( unsigned i = 0; i < _size; ++i )
+            for ( unsigned tap = _tapStart[i]; tap < _tapStart[i + 1]; ++tap )
+                sourceGradient[_tapSourceNeuron[tap]] += _kernel[_tapKernelIndex[tap]] * gradient[i];
+    }
+
+    else if ( ( _type == RELU || _type == ABSOLUTE_VALUE ) && useBounds )
+    {
+        for ( unsigned i = 0; i < _size; ++i )
+        {
+            NeuronIndex sourceIndex = *_neuronToActivationSources[i].begin();
+            const Layer *sourceLayer = _layerOwner->getLayer( sourceIndex._layer );
+            double lb = sourceLayer->getLb( sourceIndex._neuron );
+            double ub = sourceLayer->getUb( sourceIndex._neuron );
+
+            // The slope of the upper line of the triangle relaxation
+            double slope;
+            if ( lb >= 0 )
+                slope = 1;
+            else if ( ub <= 0 )
+                slope = _type == RELU ? 0 : -1;
+            else if ( _type == RELU )
+                slope = ub / ( ub - lb );
+            else
+                slope = ( ub + lb ) / ( ub - lb );
+
+            gradients[sourceIndex._layer][sourceIndex._neuron] += slope * gradient[i];
+        }
+    }
+
+    else if ( _type == RELU || _type == ABSOLUTE_VALUE )
+    {
+        for ( unsigned i = 0; i < _size; ++i )
+        {
+            NeuronIndex sourceIndex = *_neuronToActivationSources[i].begin();
+            double inputValue = _layerOwner->getLayer( sourceIndex._layer )->getAssignment( sourceIndex._neuron );
+
+            if ( inputValue > 0 )
+                gradients[sourceIndex._layer][sourceIndex._neuron] += gradient[i];
+            else if ( inputValue < 0 && _type == ABSOLUTE_VALUE )
+                gradients[sourceIndex._layer][sourceIndex._neuron] -= gradient[i];
+        }
+    }
+
+    else if ( _type == MAX )
+    {
+        // The gradient flows to the source that attains the maximum, or
+        // that has the largest upper bound when using the bounds
+        for ( unsigned i = 0; i < _size; ++i )
+        {
+            NeuronIndex maxIndex = *_neuronToActivationSources[i].begin();
+            double maxValue = FloatUtils::negativeInfinity();
+
+            for ( const auto &input : _neuronToActivationSources[i] )
+            {
+                const Layer *sourceLayer = _layerOwner->getLayer( input._layer );
+                double value = useBounds ?
+                    sourceLayer->getUb( input._neuron ) : sourceLayer->getAssignment( input._neuron );
+                if ( value > maxValue )
+                {
+                    maxValue = value;
+                    maxIndex = input;
+                }
+            }
+
+            gradients[maxIndex._layer][maxIndex._neuron] += gradient[i];
+        }
+    }
+
+    // Sign layers are piecewise constant, and propagate nothing
+
+    delete[] gradient;
+}
+
 void Layer::addSourceLayer( unsigned layerNumber, unsigned layerSize )
 {
     ASSERT( _type != INPUT );
@@ -209,6 +346,11 @@ const Map<unsigned, unsigned> &Layer::getSourceLayers() const
 
 void Layer::setWeight( unsigned sourceLayer, unsigned sourceNeuron, unsigned targetNeuron, double weight )
 {
+    ASSERT( _type == WEIGHTED_SUM );
+    ASSERT( !_weightsSharedWithCopies );
+
+    unshareWeights();
+
     unsigned index = sourceNeuron * _size + targetNeuron;
     _layerToWeights[sourceLayer][index] = weight;
 
@@ -228,23 +370,427 @@ double Layer::getWeight( unsigned sourceLayer,
                          unsigned sourceNeuron,
                          unsigned targetNeuron ) const
 {
+    if ( _type == CONVOLUTION )
+    {
+        ASSERT( _sourceLayers.exists( sourceLayer ) );
+
+        for ( unsigned tap = _tapStart[targetNeuron]; tap < _tapStart[targetNeuron + 1]; ++tap )
+        {
+            if ( _tapSourceNeuron[tap] == sourceNeuron )
+                return _kernel[_tapKernelIndex[tap]];
+        }
+
+        return 0;
+    }
+
     unsigned index = sourceNeuron * _size + targetNeuron;
     return _layerToWeights[sourceLayer][index];
 }
 
 void Layer::setBias( unsigned neuron, double bias )
 {
+    ASSERT( !_weightsSharedWithCopies );
+
+    unshareWeights();
     _bias[neuron] = bias;
 }
 
+void Layer::shareWeightsWithCopies()
+{
+    _weightsSharedWithCopies = true;
+}
+
+bool Layer::weightsShared() const
+{
+    return _weightsShared;
+}
+
+void Layer::unshareWeights()
+{
+    if ( !_weightsShared )
+        return;
+
+    for ( auto &weights : _layerToWeights )
+    {
+        unsigned size = _sourceLayers[weights.first] * _size;
+        double *copy = new double[size];
+        memcpy( copy, weights.second, sizeof(double) * size );
+        weights.second = copy;
+    }
+
+    for ( auto &weights : _layerToPositiveWeights )
+    {
+        unsigned size = _sourceLayers[weights.first] * _size;
+        double *copy = new double[size];
+        memcpy( copy, weights.second, sizeof(double) * size );
+        weights.second = copy;
+    }
+
+    for ( auto &weights : _layerToNegativeWeights )
+    {
+        unsigned size = _sourceLayers[weights.first] * _size;
+        double *copy = new double[size];
+        memcpy( copy, weights.second, sizeof(double) * size );
+        weights.second = copy;
+    }
+
+    if ( _bias )
+    {
+        double *copy = new double[_size];
+        memcpy( copy, _bias, sizeof(double) * _size );
+        _bias = copy;
+    }
+
+    _weightsShared = false;
+}
+
 double Layer::getBias( unsigned neuron ) const
 {
     return _bias[neuron];
 }
 
+Layer::ConvolutionParameters::ConvolutionParameters()
+    : _inputChannels( 0 )
+    , _inputHeight( 0 )
+    , _inputWidth( 0 )
+    , _outputChannels( 0 )
+    , _kernelHeight( 0 )
+    , _kernelWidth( 0 )
+    , _stride( 1 )
+    , _padding( 0 )
+{
+}
+
+unsigned Layer::ConvolutionParameters::getOutputHeight() const
+{
+    return ( _inputHeight + 2 * _padding - _kernelHeight ) / _stride + 1;
+}
+
+unsigned Layer::ConvolutionParameters::getOutputWidth() const
+{
+    return ( _inputWidth + 2 * _padding - _kernelWidth ) / _stride + 1;
+}
+
+unsigned Layer::ConvolutionParameters::getInputSize() const
+{
+    return _inputChannels * _inputHeight * _inputWidth;
+}
+
+unsigned Layer::ConvolutionParameters::getOutputSize() const
+{
+    return _outputChannels * getOutputHeight() * getOutputWidth();
+}
+
+unsigned Layer::ConvolutionParameters::getKernelSize() const
+{
+    return _outputChannels * _inputChannels * _kernelHeight * _kernelWidth;
+}
+
+void Layer::setConvolutionParameters( const ConvolutionParameters &parameters )
+{
+    ASSERT( _type == CONVOLUTION );
+    ASSERT( _sourceLayers.size() == 1 );
+    ASSERT( parameters._stride > 0 );
+    ASSERT( parameters._kernelHeight <= parameters._inputHeight + 2 * parameters._padding );
+    ASSERT( parameters._kernelWidth <= parameters._inputWidth + 2 * parameters._padding );
+    ASSERT( parameters.getInputSize() == _sourceLayers.begin()->second );
+    ASSERT( parameters.getOutputSize() == _size );
+
+    freeConvolutionMemoryIfNeeded();
+
+    _convolution = parameters;
+    _kernel = new double[_convolution.getKernelSize()];
+    std::fill_n( _kernel, _convolution.getKernelSize(), 0 );
+
+    computeConvolutionTaps();
+}
+
+const Layer::ConvolutionParameters &Layer::getConvolutionParameters() const
+{
+    return _convolution;
+}
+
+unsigned Layer::kernelIndex( unsigned outputChannel,
+                             unsigned inputChannel,
+                             unsigned row,
+                             unsigned column ) const
+{
+    return ( ( outputChannel * _convolution._inputChannels + inputChannel )
+             * _convolution._kernelHeight + row ) * _convolution._kernelWidth + column;
+}
+
+void Layer::setKernelWeight( unsigned outputChannel,
+                             unsigned inputChannel,
+                             unsigned row,
+                             unsigned column,
+                             double weight )
+{
+    ASSERT( _kernel );
+    _kernel[kernelIndex( outputChannel, inputChannel, row, column )] = weight;
+}
+
+double Layer::getKernelWeight( unsigned outputChannel,
+                               unsigned inputChannel,
+                               unsigned row,
+                               unsigned column ) const
+{
+    ASSERT( _kernel );
+    return _kernel[kernelIndex( outputChannel, inputChannel, row, column )];
+}
+
+List<Pair<unsigned, double>> Layer::getConvolutionTaps( unsigned neuron ) const
+{
+    ASSERT( _type == CONVOLUTION );
+
+    List<Pair<unsigned, double>> taps;
+    for ( unsigned tap = _tapStart[neuron]; tap < _tapStart[neuron + 1]; ++tap )
+        taps.append( Pair<unsigned, double>( _tapSourceNeuron[tap], _kernel[_tapKernelIndex[tap]] ) );
+
+    return taps;
+}
+
+void Layer::computeConvolutionTaps()
+{
+    unsigned outputHeight = _convolution.getOutputHeight();
+    unsigned outputWidth = _convolution.getOutputWidth();
+    unsigned inputHeight = _convolution._inputHeight;
+    unsigned inputWidth = _convolution._inputWidth;
+    unsigned padding = _convolution._padding;
+
+    if ( _tapStart )
+        delete[] _tapStart;
+    _tapStart = new unsigned[_size + 1];
+
+    /*
+      The first pass counts the taps of each neuron, and the second
+      pass stores them. Taps that fall on the padding are skipped.
+    */
+    for ( unsigned pass = 0; pass < 2; ++pass )
+    {
+        unsigned count = 0;
+        unsigned neuron = 0;
+
+        for ( unsigned o = 0; o < _convolution._outputChannels; ++o )
+        {
+            for ( unsigned y = 0; y < outputHeight; ++y )
+            {
+                for ( unsigned x = 0; x < outputWidth; ++x )
+                {
+                    _tapStart[neuron] = count;
+
+                    for ( unsigned c = 0; c < _convolution._inputChannels; ++c )
+                    {
+                        for ( unsigned ki = 0; ki < _convolution._kernelHeight; ++ki )
+                        {
+                            unsigned row = y * _convolution._stride + ki;
+                            if ( row < padding || row - padding >= inputHeight )
+                                continue;
+
+                            for ( unsigned kj = 0; kj < _convolution._kernelWidth; ++kj )
+                            {
+                                unsigned column = x * _convolution._stride + kj;
+                                if ( column < padding || column - padding >= inputWidth )
+                                    continue;
+
+                                if ( pass == 1 )
+                                {
+                                    _tapSourceNeuron[count] =
+                                        ( c * inputHeight + row - padding ) * inputWidth + column - padding;
+                                    _tapKernelIndex[count] = kernelIndex( o, c, ki, kj );
+                                }
+
+                                ++count;
+                            }
+                        }
+                    }
+
+                    ++neuron;
+                }
+            }
+        }
+
+        _tapStart[_size] = count;
+
+        if ( pass == 0 )
+        {
+            if ( _tapSourceNeuron )
+                delete[] _tapSourceNeuron;
+            if ( _tapKernelIndex )
+                delete[] _tapKernelIndex;
+
+            _tapSourceNeuron = new unsigned[count];
+            _tapKernelIndex = new unsigned[count];
+        }
+    }
+}
+
+bool Layer::detectConvolution()
+{
+    if ( _type != WEIGHTED_SUM || _sourceLayers.size() != 1 )
+        return false;
+
+    ASSERT( !_weightsSharedWithCopies );
+    unshareWeights();
+
+    unsigned sourceLayerIndex = _sourceLayers.begin()->first;
+    unsigned sourceLayerSize = _sourceLayers.begin()->second;
+    const double *weights = _layerToWeights[sourceLayerIndex];
+
+    // The number of non-zero weights feeding each neuron
+    Vector<unsigned> nonZeroWeights( _size, 0 );
+    for ( unsigned i = 0; i < sourceLayerSize; ++i )
+        for ( unsigned j = 0; j < _size; ++j )
+            if ( weights[i * _size + j] != 0 )
+                ++nonZeroWeights[j];
+
+    /*
+      Try every square image shape that matches the size of the
+      source layer, and every kernel size, stride and padding for
+      which the output has the right size and is not a single pixel.
+    */
+    ConvolutionParameters parameters;
+    for ( unsigned channels = 1; channels <= sourceLayerSize; ++channels )
+    {
+        if ( sourceLayerSize % channels != 0 )
+            continue;
+
+        unsigned side = (unsigned)std::lround( std::sqrt( (double)( sourceLayerSize / channels ) ) );
+        if ( side * side != sourceLayerSize / channels )
+            continue;
+
+        parameters._inputChannels = channels;
+        parameters._inputHeight = side;
+        parameters._inputWidth = side;
+
+        unsigned maxKernelSize = std::min( side, GlobalConfiguration::CONVOLUTION_DETECTION_MAX_KERNEL_SIZE );
+        for ( unsigned kernelSize = 1; kernelSize <= maxKernelSize; ++kernelSize )
+        {
+            parameters._kernelHeight = kernelSize;
+            parameters._kernelWidth = kernelSize;
+
+            unsigned maxStride = std::min( kernelSize, GlobalConfiguration::CONVOLUTION_DETECTION_MAX_STRIDE );
+            for ( unsigned stride = 1; stride <= maxStride; ++stride )
+            {
+                parameters._stride = stride;
+
+                for ( unsigned padding = 0; padding <= kernelSize / 2; ++padding )
+                {
+                    parameters._padding = padding;
+
+                    unsigned outputSide = parameters.getOutputHeight();
+                    if ( outputSide < 2 || _size % ( outputSide * outputSide ) != 0 )
+                        continue;
+
+                    parameters._outputChannels = _size / ( outputSide * outputSide );
+
+                    double *kernel = new double[parameters.getKernelSize()];
+                    if ( !matchConvolution( parameters, weights, nonZeroWeights, kernel ) )
+                    {
+                        delete[] kernel;
+                        continue;
+                    }
+
+                    // Switch to the convolution representation
+                    _type = CONVOLUTION;
+                    _convolution = parameters;
+                    _kernel = kernel;
+                    computeConvolutionTaps();
+
+                    delete[] _layerToWeights[sourceLayerIndex];
+                    delete[] _layerToPositiveWeights[sourceLayerIndex];
+                    delete[] _layerToNegativeWeights[sourceLayerIndex];
+                    _layerToWeights.clear();
+                    _layerToPositiveWeights.clear();
+                    _layerToNegativeWeights.clear();
+
+                    return true;
+                }
+            }
+        }
+    }
+
+    return false;
+}
+
+bool Layer::matchConvolution( const ConvolutionParameters &parameters,
+                              const double *weights,
+                              const Vector<unsigned> &nonZeroWeights,
+                              double *kernel ) const
+{
+    unsigned kernelSize = parameters.getKernelSize();
+    unsigned outputHeight = parameters.getOutputHeight();
+    unsigned outputWidth = parameters.getOutputWidth();
+    unsigned inputHeight = parameters._inputHeight;
+    unsigned inputWidth = parameters._inputWidth;
+    unsigned padding = parameters._padding;
+
+    // Kernel entries that only ever fall on the padding remain zero
+    std::fill_n( kernel, kernelSize, 0 );
+    Vector<unsigned> seen( kernelSize, 0 );
+
+    unsigned neuron = 0;
+    for ( unsigned o = 0; o < parameters._outputChannels; ++o )
+    {
+        for ( unsigned y = 0; y < outputHeight; ++y )
+        {
+            for ( unsigned x = 0; x < outputWidth; ++x )
+            {
+                unsigned nonZeroTaps = 0;
+
+                for ( unsigned c = 0; c < parameters._inputChannels; ++c )
+                {
+                    for ( unsigned ki = 0; ki < parameters._kernelHeight; ++ki )
+                    {
+                        unsigned row = y * parameters._stride + ki;
+                        if ( row < padding || row - padding >= inputHeight )
+                            continue;
+
+                        for ( unsigned kj = 0; kj < parameters._kernelWidth; ++kj )
+                        {
+                            unsigned column = x * parameters._stride + kj;
+                            if ( column < padding || column - padding >= inputWidth )
+                                continue;
+
+                            unsigned sourceNeuron =
+                                ( c * inputHeight + row - padding ) * inputWidth + column - padding;
+                            double weight = weights[sourceNeuron * _size + neuron];
+
+                            unsigned index =
+                                ( ( o * parameters._inputChannels + c ) * parameters._kernelHeight + ki )
+                                * parameters._kernelWidth + kj;
+
+                            // The weights must be shared exactly
+                            if ( !seen[index] )
+                            {
+                                seen[index] = 1;
+                                kernel[index] = weight;
+                            }
+                            else if ( kernel[index] != weight )
+                            {
+                                return false;
+                            }
+
+                            if ( weight != 0 )
+                                ++nonZeroTaps;
+                        }
+                    }
+                }
+
+                // Weights outside of the receptive field must be zero
+                if ( nonZeroTaps != nonZeroWeights.get( neuron ) )
+                    return false;
+
+                ++neuron;
+            }
+        }
+    }
+
+    return true;
+}
+
 void Layer::addActivationSource( unsigned sourceLayer, unsigned sourceNeuron, unsigned targetNeuron )
 {
-    ASSERT( _type == RELU || _type == ABSOLUTE_VALUE || _type == MAX );
+    ASSERT( _type == RELU || _type == ABSOLUTE_VALUE || _type == MAX || _type == SIGN );
 
     if ( !_neuronToActivationSources.exists( targetNeuron ) )
         _neuronToActivationSources[targetNeuron] = List<NeuronIndex>();
@@ -252,7 +798,7 @@ void Layer::addActivationSource( unsigned sourceLayer, unsigned sourceNeuron, un
     _neuronToActivationSources[targetNeuron].append( NeuronIndex( sourceLayer, sourceNeuron ) );
 
     DEBUG({
-            if ( _type == RELU || _type == ABSOLUTE_VALUE )
+            if ( _type == RELU || _type == ABSOLUTE_VALUE || _type == SIGN )
                 ASSERT( _neuronToActivationSources[targetNeuron].size() == 1 );
         });
 }
@@ -280,15 +826,64 @@ void Layer::setNeuronVariable( unsigned neuron, unsigned variable )
     _variableToNeuron[variable] = neuron;
 }
 
-void Layer::obtainCurrentBounds()
+void Layer::getCurrentBoundsFromTableau( unsigned neuron, double &lb, double &ub ) const
+{
+    if ( _neuronToVariable.exists( neuron ) )
+    {
+        unsigned variable = _neuronToVariable[neuron];
+        lb = _layerOwner->getTableau()->getLowerBound( variable );
+        ub = _layerOwner->getTableau()->getUpperBound( variable );
+    }
+    else
+    {
+        ASSERT( _eliminatedNeurons.exists( neuron ) );
+        lb = _eliminatedNeurons[neuron];
+        ub = _eliminatedNeurons[neuron];
+    }
+}
+
+bool Layer::obtainCurrentBounds()
+{
+    /*
+      The bounds currently stored in the layer are those that were
+      in effect after the last propagation, including any tightenings
+      it discovered. If the Tableau's bounds are the same (up to
+      floating point noise), the layer is left untouched.
+    */
+    bool boundsChanged = false;
+    double lb;
+    double ub;
+
+    for ( unsigned i = 0; i < _size; ++i )
+    {
+        getCurrentBoundsFromTableau( i, lb, ub );
+
+        if ( ( lb != _lb[i] && !FloatUtils::areEqual( lb, _lb[i] ) ) ||
+             ( ub != _ub[i] && !FloatUtils::areEqual( ub, _ub[i] ) ) )
+        {
+            boundsChanged = true;
+            break;
+        }
+    }
+
+    if ( !boundsChanged )
+        return false;
+
+    for ( unsigned i = 0; i < _size; ++i )
+        getCurrentBoundsFromTableau( i, _lb[i], _ub[i] );
+
+    return true;
+}
+
+void Layer::obtainCurrentBounds( const InputQuery &inputQuery )
 {
     for ( unsigned i = 0; i < _size; ++i )
     {
         if ( _neuronToVariable.exists( i ) )
         {
             unsigned variable = _neuronToVariable[i];
-            _lb[i] = _layerOwner->getTableau()->getLowerBound( variable );
-            _ub[i] = _layerOwner->getTableau()->getUpperBound( variable );
+            _lb[i] = inputQuery.getLowerBound( variable );
+            _ub[i] = inputQuery.getUpperBound( variable );
         }
         else
         {
@@ -337,6 +932,10 @@ void Layer::computeIntervalArithmeticBounds()
         computeIntervalArithmeticBoundsForWeightedSum();
         break;
 
+    case CONVOLUTION:
+        computeIntervalArithmeticBoundsForConvolution();
+        break;
+
     case RELU:
         computeIntervalArithmeticBoundsForRelu();
         break;
@@ -345,7 +944,13 @@ void Layer::computeIntervalArithmeticBounds()
         computeIntervalArithmeticBoundsForAbs();
         break;
 
+    case SIGN:
+        computeIntervalArithmeticBoundsForSign();
+        break;
+
     case MAX:
+        computeIntervalArithmeticBoundsForMax();
+        break;
 
     default:
         printf( "Error! Actiation type %u unsupported\n", _type );
@@ -356,8 +961,18 @@ void Layer::computeIntervalArithmeticBounds()
 
 void Layer::computeIntervalArithmeticBoundsForWeightedSum()
 {
-    double *newLb = new double[_size];
+    /*
+      Each source interval [lb, ub] is written as center +- radius.
+      The new center is then W * center, and the new radius is
+      |W| * radius = W+ * radius - W- * radius, so that three
+      matrix-vector products replace the branching on the sign of
+      every weight. Sources with infinite bounds have no center, and
+      are handled weight by weight.
+    */
+    double *newLb = new double[_size];
     double *newUb = new double[_size];
+    double *center = new double[_size];
+    double *radius = new double[_size];
 
     for ( unsigned i = 0; i < _size; ++i )
     {
@@ -365,6 +980,9 @@ void Layer::computeIntervalArithmeticBoundsForWeightedSum()
         newUb[i] = _bias[i];
     }
 
+    std::fill_n( center, _size, 0 );
+    std::fill_n( radius, _size, 0 );
+
     for ( const auto &sourceLayerEntry : _sourceLayers )
     {
         unsigned sourceLayerIndex = sourceLayerEntry.first;
@@ -372,28 +990,77 @@ void Layer::computeIntervalArithmeticBoundsForWeightedSum()
         const Layer *sourceLayer = _layerOwner->getLayer( sourceLayerIndex );
         const double *weights = _layerToWeights[sourceLayerIndex];
 
-        for ( unsigned i = 0; i < _size; ++i )
+        double *sourceCenter = new double[sourceLayerSize];
+        double *sourceRadius = new double[sourceLayerSize];
+
+        bool finite = true;
+        for ( unsigned j = 0; j < sourceLayerSize; ++j )
+        {
+            double previousLb = sourceLayer->getLb( j );
+            double previousUb = sourceLayer->getUb( j );
+
+            if ( !FloatUtils::isFinite( previousLb ) || !FloatUtils::isFinite( previousUb ) )
+                finite = false;
+
+            sourceCenter[j] = ( previousUb + previousLb ) / 2;
+            sourceRadius[j] = ( previousUb - previousLb ) / 2;
+        }
+
+        if ( finite )
         {
+            matrixMultiplication( sourceCenter, weights, center, 1, sourceLayerSize, _size );
+            matrixMultiplication( sourceRadius, _layerToPositiveWeights[sourceLayerIndex],
+                                  radius, 1, sourceLayerSize, _size );
+
             for ( unsigned j = 0; j < sourceLayerSize; ++j )
+                sourceRadius[j] = -sourceRadius[j];
+            matrixMultiplication( sourceRadius, _layerToNegativeWeights[sourceLayerIndex],
+                                  radius, 1, sourceLayerSize, _size );
+        }
+        else
+        {
+            for ( unsigned i = 0; i < _size; ++i )
             {
-                double previousLb = sourceLayer->getLb( j );
-                double previousUb = sourceLayer->getUb( j );
-                double weight = weights[j * _size + i];
-
-                if ( weight > 0 )
+                for ( unsigned j = 0; j < sourceLayerSize; ++j )
                 {
-                    newLb[i] += weight * previousLb;
-                    newUb[i] += weight * previousUb;
-                }
-                else
-                {
-                    newLb[i] += weight * previousUb;
-                    newUb[i] += weight * previousLb;
+                    double previousLb = sourceLayer->getLb( j );
+                    double previousUb = sourceLayer->getUb( j );
+                    double weight = weights[j * _size + i];
+
+                    if ( weight > 0 )
+                    {
+                        newLb[i] += weight * previousLb;
+                        newUb[i] += weight * previousUb;
+                    }
+                    else
+                    {
+                        newLb[i] += weight * previousUb;
+                        newUb[i] += weight * previousLb;
+                    }
                 }
             }
         }
+
+        delete[] sourceCenter;
+        delete[] sourceRadius;
     }
 
+    for ( unsigned i = 0; i < _size; ++i )
+    {
+        newLb[i] += center[i] - radius[i];
+        newUb[i] += center[i] + radius[i];
+    }
+
+    storeTighterBounds( newLb, newUb );
+
+    delete[] newLb;
+    delete[] newUb;
+    delete[] center;
+    delete[] radius;
+}
+
+void Layer::storeTighterBounds( const double *newLb, const double *newUb )
+{
     for ( unsigned i = 0; i < _size; ++i )
     {
         if ( _eliminatedNeurons.exists( i ) )
@@ -410,12 +1077,110 @@ void Layer::computeIntervalArithmeticBoundsForWeightedSum()
             _layerOwner->receiveTighterBound( Tightening( _neuronToVariable[i], _ub[i], Tightening::UB ) );
         }
     }
+}
+
+void Layer::getActivationSourceBounds( double *sourceLb, double *sourceUb ) const
+{
+    for ( unsigned i = 0; i < _size; ++i )
+    {
+        if ( _eliminatedNeurons.exists( i ) )
+        {
+            sourceLb[i] = 0;
+            sourceUb[i] = 0;
+            continue;
+        }
+
+        NeuronIndex sourceIndex = *_neuronToActivationSources[i].begin();
+        const Layer *sourceLayer = _layerOwner->getLayer( sourceIndex._layer );
+
+        sourceLb[i] = sourceLayer->getLb( sourceIndex._neuron );
+        sourceUb[i] = sourceLayer->getUb( sourceIndex._neuron );
+    }
+}
+
+void Layer::computeIntervalArithmeticBoundsForConvolution()
+{
+    double *newLb = new double[_size];
+    double *newUb = new double[_size];
+
+    const Layer *sourceLayer = _layerOwner->getLayer( _sourceLayers.begin()->first );
+
+    for ( unsigned i = 0; i < _size; ++i )
+    {
+        newLb[i] = _bias[i];
+        newUb[i] = _bias[i];
+
+        for ( unsigned tap = _tapStart[i]; tap < _tapStart[i + 1]; ++tap )
+        {
+            double previousLb = sourceLayer->getLb( _tapSourceNeuron[tap] );
+            double previousUb = sourceLayer->getUb( _tapSourceNeuron[tap] );
+            double weight = _kernel[_tapKernelIndex[tap]];
+
+            if ( weight > 0 )
+            {
+                newLb[i] += weight * previousLb;
+                newUb[i] += weight * previousUb;
+            }
+            else
+            {
+                newLb[i] += weight * previousUb;
+                newUb[i] += weight * previousLb;
+            }
+        }
+    }
+
+    storeTighterBounds( newLb, newUb );
 
     delete[] newLb;
     delete[] newUb;
 }
 
 void Layer::computeIntervalArithmeticBoundsForRelu()
+{
+    double *newLb = new double[_size];
+    double *newUb = new double[_size];
+
+    getActivationSourceBounds( newLb, newUb );
+
+    // Branch-free, so that the compiler can vectorize it
+    for ( unsigned i = 0; i < _size; ++i )
+        newLb[i] = std::max( newLb[i], 0.0 );
+
+    storeTighterBounds( newLb, newUb );
+
+    delete[] newLb;
+    delete[] newUb;
+}
+
+void Layer::computeIntervalArithmeticBoundsForAbs()
+{
+    double *sourceLb = new double[_size];
+    double *sourceUb = new double[_size];
+    double *newLb = new double[_size];
+    double *newUb = new double[_size];
+
+    getActivationSourceBounds( sourceLb, sourceUb );
+
+    /*
+      |x| is in [lb, ub] if lb > 0, in [-ub, -lb] if ub < 0, and in
+      [0, max(ub, -lb)] otherwise. The expressions below cover all
+      three cases without branching.
+    */
+    for ( unsigned i = 0; i < _size; ++i )
+    {
+        newLb[i] = std::max( std::max( sourceLb[i], -sourceUb[i] ), 0.0 );
+        newUb[i] = std::max( sourceUb[i], -sourceLb[i] );
+    }
+
+    storeTighterBounds( newLb, newUb );
+
+    delete[] sourceLb;
+    delete[] sourceUb;
+    delete[] newLb;
+    delete[] newUb;
+}
+
+void Layer::computeIntervalArithmeticBoundsForSign()
 {
     for ( unsigned i = 0; i < _size; ++i )
     {
@@ -428,75 +1193,56 @@ void Layer::computeIntervalArithmeticBoundsForRelu()
         double lb = sourceLayer->getLb( sourceIndex._neuron );
         double ub = sourceLayer->getUb( sourceIndex._neuron );
 
-        if ( lb < 0 )
-            lb = 0;
+        double newLb = -1;
+        double newUb = 1;
 
-        if ( lb > _lb[i] )
+        if ( !FloatUtils::isNegative( lb ) )
+            newLb = 1;
+        else if ( FloatUtils::isNegative( ub ) )
+            newUb = -1;
+
+        if ( newLb > _lb[i] )
         {
-            _lb[i] = lb;
+            _lb[i] = newLb;
             _layerOwner->receiveTighterBound( Tightening( _neuronToVariable[i], _lb[i], Tightening::LB ) );
         }
-        if ( ub < _ub[i] )
+        if ( newUb < _ub[i] )
         {
-            _ub[i] = ub;
+            _ub[i] = newUb;
             _layerOwner->receiveTighterBound( Tightening( _neuronToVariable[i], _ub[i], Tightening::UB ) );
         }
     }
 }
 
-void Layer::computeIntervalArithmeticBoundsForAbs()
+void Layer::computeIntervalArithmeticBoundsForMax()
 {
     for ( unsigned i = 0; i < _size; ++i )
     {
         if ( _eliminatedNeurons.exists( i ) )
             continue;
 
-        NeuronIndex sourceIndex = *_neuronToActivationSources[i].begin();
-        const Layer *sourceLayer = _layerOwner->getLayer( sourceIndex._layer );
+        // The max is at least as large as the largest lower bound,
+        // and at most as large as the largest upper bound
+        double lb = FloatUtils::negativeInfinity();
+        double ub = FloatUtils::negativeInfinity();
 
-        double lb = sourceLayer->getLb( sourceIndex._neuron );
-        double ub = sourceLayer->getUb( sourceIndex._neuron );
-
-        if ( lb > 0 )
+        for ( const auto &sourceIndex : _neuronToActivationSources[i] )
         {
-            if ( lb > _lb[i] )
-            {
-                _lb[i] = lb;
-                _layerOwner->receiveTighterBound( Tightening( _neuronToVariable[i], _lb[i], Tightening::LB ) );
-            }
-            if ( ub < _ub[i] )
-            {
-                _ub[i] = ub;
-                _layerOwner->receiveTighterBound( Tightening( _neuronToVariable[i], _ub[i], Tightening::UB ) );
-            }
+            const Layer *sourceLayer = _layerOwner->getLayer( sourceIndex._layer );
+
+            lb = FloatUtils::max( lb, sourceLayer->getLb( sourceIndex._neuron ) );
+            ub = FloatUtils::max( ub, sourceLayer->getUb( sourceIndex._neuron ) );
         }
-        else if ( ub < 0 )
+
+        if ( lb > _lb[i] )
         {
-            if ( -ub > _lb[i] )
-            {
-                _lb[i] = -ub;
-                _layerOwner->receiveTighterBound( Tightening( _neuronToVariable[i], _lb[i], Tightening::LB ) );
-            }
-            if ( -lb < _ub[i] )
-            {
-                _ub[i] = -lb;
-                _layerOwner->receiveTighterBound( Tightening( _neuronToVariable[i], _ub[i], Tightening::UB ) );
-            }
+            _lb[i] = lb;
+            _layerOwner->receiveTighterBound( Tightening( _neuronToVariable[i], _lb[i], Tightening::LB ) );
         }
-        else
+        if ( ub < _ub[i] )
         {
-            // lb < 0 < ub
-            if ( _lb[i] < 0 )
-            {
-                _lb[i] = 0;
-                _layerOwner->receiveTighterBound( Tightening( _neuronToVariable[i], _lb[i], Tightening::LB ) );
-            }
-
-            if ( FloatUtils::max( ub, -lb ) < _ub[i] )
-            {
-                _ub[i] = FloatUtils::max( ub, -lb );
-                _layerOwner->receiveTighterBound( Tightening( _neuronToVariable[i], _ub[i], Tightening::UB ) );
-            }
+            _ub[i] = ub;
+            _layerOwner->receiveTighterBound( Tightening( _neuronToVariable[i], _ub[i], Tightening::UB ) );
         }
     }
 }
@@ -514,6 +1260,10 @@ void Layer::computeSymbolicBounds()
         computeSymbolicBoundsForWeightedSum();
         break;
 
+    case CONVOLUTION:
+        computeSymbolicBoundsForConvolution();
+        break;
+
     case RELU:
         computeSymbolicBoundsForRelu();
         break;
@@ -522,7 +1272,13 @@ void Layer::computeSymbolicBounds()
         computeSymbolicBoundsForAbsoluteValue();
         break;
 
+    case SIGN:
+        computeSymbolicBoundsForSign();
+        break;
+
     case MAX:
+        computeSymbolicBoundsForMax();
+        break;
 
     default:
         printf( "Error! Actiation type %u unsupported\n", _type );
@@ -742,100 +1498,331 @@ void Layer::computeSymbolicBoundsForAbsoluteValue()
             _symbolicLbOfUb[i] = _eliminatedNeurons[i];
             _symbolicUbOfUb[i] = _eliminatedNeurons[i];
 
-            continue;
+            continue;
+        }
+
+        AbsoluteValueConstraint::PhaseStatus absPhase = AbsoluteValueConstraint::PHASE_NOT_FIXED;
+
+        ASSERT( _neuronToActivationSources.exists( i ) );
+        NeuronIndex sourceIndex = *_neuronToActivationSources[i].begin();
+        const Layer *sourceLayer = _layerOwner->getLayer( sourceIndex._layer );
+
+        unsigned sourceLayerSize = sourceLayer->getSize();
+        const double *sourceSymbolicLb = sourceLayer->getSymbolicLb();
+        const double *sourceSymbolicUb = sourceLayer->getSymbolicUb();
+
+        for ( unsigned j = 0; j < _inputLayerSize; ++j )
+        {
+            _symbolicLb[j * _size + i] = sourceSymbolicLb[j * sourceLayerSize + sourceIndex._neuron];
+            _symbolicUb[j * _size + i] = sourceSymbolicUb[j * sourceLayerSize + sourceIndex._neuron];
+        }
+
+        _symbolicLowerBias[i] = sourceLayer->getSymbolicLowerBias()[sourceIndex._neuron];
+        _symbolicUpperBias[i] = sourceLayer->getSymbolicUpperBias()[sourceIndex._neuron];
+
+        double sourceLb = sourceLayer->getLb( sourceIndex._neuron );
+        double sourceUb = sourceLayer->getUb( sourceIndex._neuron );
+
+        _symbolicLbOfLb[i] = sourceLayer->getSymbolicLbOfLb( sourceIndex._neuron );
+        _symbolicUbOfLb[i] = sourceLayer->getSymbolicUbOfLb( sourceIndex._neuron );
+        _symbolicLbOfUb[i] = sourceLayer->getSymbolicLbOfUb( sourceIndex._neuron );
+        _symbolicUbOfUb[i] = sourceLayer->getSymbolicUbOfUb( sourceIndex._neuron );
+
+        if ( sourceLb >= 0 )
+            absPhase = AbsoluteValueConstraint::PHASE_POSITIVE;
+        else if ( sourceUb <= 0 )
+            absPhase = AbsoluteValueConstraint::PHASE_NEGATIVE;
+
+        if ( absPhase == AbsoluteValueConstraint::PHASE_NOT_FIXED )
+        {
+            // If we got here, we know that lbOfLb < 0 < ubOfUb. In this case,
+            // we do naive concretization: lb is 0, ub is the max between
+            // -lb and ub of the input neuron
+            for ( unsigned j = 0; j < _inputLayerSize; ++j )
+            {
+                _symbolicLb[j * _size + i] = 0;
+                _symbolicUb[j * _size + i] = 0;
+            }
+
+            _symbolicLowerBias[i] = 0;
+            _symbolicUpperBias[i] = FloatUtils::max( -sourceLb, sourceUb );
+
+            _symbolicLbOfLb[i] = 0;
+            _symbolicUbOfLb[i] = _symbolicUpperBias[i];
+            _symbolicLbOfUb[i] = 0;
+            _symbolicUbOfUb[i] = _symbolicUpperBias[i];
+        }
+        else
+        {
+            // The phase of this AbsoluteValueConstraint is fixed!
+            if ( absPhase == AbsoluteValueConstraint::PHASE_POSITIVE )
+            {
+                // Positive AbsoluteValue, bounds are propagated as is
+            }
+            else
+            {
+                // Negative AbsoluteValue, bounds are negated and flipped
+                double temp;
+                for ( unsigned j = 0; j < _inputLayerSize; ++j )
+                {
+                    temp = _symbolicUb[j * _size + i];
+                    _symbolicUb[j * _size + i] = -_symbolicLb[j * _size + i];
+                    _symbolicLb[j * _size + i] = -temp;
+                }
+
+                temp = _symbolicLowerBias[i];
+                _symbolicLowerBias[i] = -_symbolicUpperBias[i];
+                _symbolicUpperBias[i] = -temp;
+
+                // Old lb, negated, is the new ub
+                temp = _symbolicLbOfLb[i];
+                _symbolicLbOfLb[i] = -_symbolicUbOfUb[i];
+                _symbolicUbOfUb[i] = -temp;
+
+                temp = _symbolicUbOfLb[i];
+                _symbolicUbOfLb[i] = -_symbolicLbOfUb[i];
+                _symbolicLbOfUb[i] = -temp;
+            }
+        }
+
+        // In extreme cases (constraint set externally), _symbolicLbOfLb
+        // could be negative - so adjust this
+        if ( _symbolicLbOfLb[i] < 0 )
+            _symbolicLbOfLb[i] = 0;
+
+        /*
+          We now have the tightest bounds we can for the abs
+          variable. If they are tigheter than what was previously
+          known, store them.
+        */
+        if ( _lb[i] < _symbolicLbOfLb[i] )
+        {
+            _lb[i] = _symbolicLbOfLb[i];
+            _layerOwner->receiveTighterBound( Tightening( _neuronToVariable[i], _lb[i], Tightening::LB ) );
+        }
+
+        if ( _ub[i] > _symbolicUbOfUb[i] )
+        {
+            _ub[i] = _symbolicUbOfUb[i];
+            _layerOwner->receiveTighterBound( Tightening( _neuronToVariable[i], _ub[i], Tightening::UB ) );
+        }
+    }
+}
+
+void Layer::computeSymbolicBoundsForSign()
+{
+    std::fill_n( _symbolicLb, _size * _inputLayerSize, 0 );
+    std::fill_n( _symbolicUb, _size * _inputLayerSize, 0 );
+
+    for ( unsigned i = 0; i < _size; ++i )
+    {
+        if ( _eliminatedNeurons.exists( i ) )
+        {
+            _symbolicLowerBias[i] = _eliminatedNeurons[i];
+            _symbolicUpperBias[i] = _eliminatedNeurons[i];
+
+            _symbolicLbOfLb[i] = _eliminatedNeurons[i];
+            _symbolicUbOfLb[i] = _eliminatedNeurons[i];
+            _symbolicLbOfUb[i] = _eliminatedNeurons[i];
+            _symbolicUbOfUb[i] = _eliminatedNeurons[i];
+
+            continue;
+        }
+
+        ASSERT( _neuronToActivationSources.exists( i ) );
+        NeuronIndex sourceIndex = *_neuronToActivationSources[i].begin();
+        const Layer *sourceLayer = _layerOwner->getLayer( sourceIndex._layer );
+
+        unsigned sourceLayerSize = sourceLayer->getSize();
+        const double *sourceSymbolicLb = sourceLayer->getSymbolicLb();
+        const double *sourceSymbolicUb = sourceLayer->getSymbolicUb();
+
+        double sourceLb = sourceLayer->getLb( sourceIndex._neuron );
+        double sourceUb = sourceLayer->getUb( sourceIndex._neuron );
+
+        /*
+          The lower and upper bounds start out as the constants -1 and
+          1, and are refined below.
+        */
+        _symbolicLowerBias[i] = -1;
+        _symbolicUpperBias[i] = 1;
+
+        _symbolicLbOfLb[i] = -1;
+        _symbolicUbOfLb[i] = -1;
+        _symbolicLbOfUb[i] = 1;
+        _symbolicUbOfUb[i] = 1;
+
+        if ( !FloatUtils::isNegative( sourceLb ) )
+        {
+            // Positive phase, the sign is 1
+            _symbolicLowerBias[i] = 1;
+            _symbolicLbOfLb[i] = 1;
+            _symbolicUbOfLb[i] = 1;
+        }
+        else if ( FloatUtils::isNegative( sourceUb ) )
+        {
+            // Negative phase, the sign is -1
+            _symbolicUpperBias[i] = -1;
+            _symbolicLbOfUb[i] = -1;
+            _symbolicUbOfUb[i] = -1;
+        }
+        else
+        {
+            /*
+              If we got here, we know that sourceLb < 0 <= sourceUb. The
+              sign is bounded by the lines that pass through (0, -1)
+              and (sourceUb, 1), and through (sourceLb, -1) and (0, 1):
+
+                 -1 + 2/sourceUb * x  <=  sign( x )  <=  1 - 2/sourceLb * x
+
+              Both slopes are positive, so the lower line is applied to
+              the symbolic lower bound of x, and the upper line to its
+              symbolic upper bound.
+            */
+            if ( FloatUtils::isPositive( sourceUb ) )
+            {
+                double slope = 2 / sourceUb;
+                for ( unsigned j = 0; j < _inputLayerSize; ++j )
+                    _symbolicLb[j * _size + i] =
+                        slope * sourceSymbolicLb[j * sourceLayerSize + sourceIndex._neuron];
+
+                _symbolicLowerBias[i] =
+                    slope * sourceLayer->getSymbolicLowerBias()[sourceIndex._neuron] - 1;
+                _symbolicLbOfLb[i] = slope * sourceLayer->getSymbolicLbOfLb( sourceIndex._neuron ) - 1;
+                _symbolicUbOfLb[i] = slope * sourceLayer->getSymbolicUbOfLb( sourceIndex._neuron ) - 1;
+            }
+
+            double slope = -2 / sourceLb;
+            for ( unsigned j = 0; j < _inputLayerSize; ++j )
+                _symbolicUb[j * _size + i] =
+                    slope * sourceSymbolicUb[j * sourceLayerSize + sourceIndex._neuron];
+
+            _symbolicUpperBias[i] =
+                slope * sourceLayer->getSymbolicUpperBias()[sourceIndex._neuron] + 1;
+            _symbolicLbOfUb[i] = slope * sourceLayer->getSymbolicLbOfUb( sourceIndex._neuron ) + 1;
+            _symbolicUbOfUb[i] = slope * sourceLayer->getSymbolicUbOfUb( sourceIndex._neuron ) + 1;
+
+            // The concrete bounds never leave [-1, 1]
+            if ( _symbolicLbOfLb[i] < -1 )
+                _symbolicLbOfLb[i] = -1;
+            if ( _symbolicUbOfUb[i] > 1 )
+                _symbolicUbOfUb[i] = 1;
+        }
+
+        /*
+          We now have the tightest bounds we can for the sign
+          variable. If they are tigheter than what was previously
+          known, store them.
+        */
+        if ( _lb[i] < _symbolicLbOfLb[i] )
+        {
+            _lb[i] = _symbolicLbOfLb[i];
+            _layerOwner->receiveTighterBound( Tightening( _neuronToVariable[i], _lb[i], Tightening::LB ) );
+        }
+
+        if ( _ub[i] > _symbolicUbOfUb[i] )
+        {
+            _ub[i] = _symbolicUbOfUb[i];
+            _layerOwner->receiveTighterBound( Tightening( _neuronToVariable[i], _ub[i], Tightening::UB ) );
+        }
+    }
+}
+
+void Layer::computeSymbolicBoundsForMax()
+{
+    std::fill_n( _symbolicLb, _size * _inputLayerSize, 0 );
+    std::fill_n( _symbolicUb, _size * _inputLayerSize, 0 );
+
+    for ( unsigned i = 0; i < _size; ++i )
+    {
+        if ( _eliminatedNeurons.exists( i ) )
+        {
+            _symbolicLowerBias[i] = _eliminatedNeurons[i];
+            _symbolicUpperBias[i] = _eliminatedNeurons[i];
+
+            _symbolicLbOfLb[i] = _eliminatedNeurons[i];
+            _symbolicUbOfLb[i] = _eliminatedNeurons[i];
+            _symbolicLbOfUb[i] = _eliminatedNeurons[i];
+            _symbolicUbOfUb[i] = _eliminatedNeurons[i];
+
+            continue;
+        }
+
+        ASSERT( _neuronToActivationSources.exists( i ) );
+
+        /*
+          Find the source with the largest lower bound, and the largest
+          upper bound among the other sources.
+        */
+        NeuronIndex argMax = *_neuronToActivationSources[i].begin();
+        double maxLb = FloatUtils::negativeInfinity();
+        double maxUb = FloatUtils::negativeInfinity();
+
+        for ( const auto &sourceIndex : _neuronToActivationSources[i] )
+        {
+            const Layer *sourceLayer = _layerOwner->getLayer( sourceIndex._layer );
+            double sourceLb = sourceLayer->getLb( sourceIndex._neuron );
+            double sourceUb = sourceLayer->getUb( sourceIndex._neuron );
+
+            if ( sourceLb > maxLb )
+            {
+                maxLb = sourceLb;
+                argMax = sourceIndex;
+            }
+
+            if ( sourceUb > maxUb )
+                maxUb = sourceUb;
         }
 
-        AbsoluteValueConstraint::PhaseStatus absPhase = AbsoluteValueConstraint::PHASE_NOT_FIXED;
+        double maxUbOfOthers = FloatUtils::negativeInfinity();
+        for ( const auto &sourceIndex : _neuronToActivationSources[i] )
+        {
+            if ( sourceIndex == argMax )
+                continue;
 
-        ASSERT( _neuronToActivationSources.exists( i ) );
-        NeuronIndex sourceIndex = *_neuronToActivationSources[i].begin();
-        const Layer *sourceLayer = _layerOwner->getLayer( sourceIndex._layer );
+            const Layer *sourceLayer = _layerOwner->getLayer( sourceIndex._layer );
+            maxUbOfOthers = FloatUtils::max( maxUbOfOthers, sourceLayer->getUb( sourceIndex._neuron ) );
+        }
 
+        /*
+          The max is always at least as large as the source with the
+          largest lower bound, so that source's symbolic lower bound is
+          inherited. If that source also dominates all the others, the
+          phase is fixed and its upper bound is inherited as well.
+          Otherwise, the upper bound is concretized to the largest upper
+          bound of any source.
+        */
+        const Layer *sourceLayer = _layerOwner->getLayer( argMax._layer );
         unsigned sourceLayerSize = sourceLayer->getSize();
         const double *sourceSymbolicLb = sourceLayer->getSymbolicLb();
         const double *sourceSymbolicUb = sourceLayer->getSymbolicUb();
 
         for ( unsigned j = 0; j < _inputLayerSize; ++j )
-        {
-            _symbolicLb[j * _size + i] = sourceSymbolicLb[j * sourceLayerSize + sourceIndex._neuron];
-            _symbolicUb[j * _size + i] = sourceSymbolicUb[j * sourceLayerSize + sourceIndex._neuron];
-        }
-
-        _symbolicLowerBias[i] = sourceLayer->getSymbolicLowerBias()[sourceIndex._neuron];
-        _symbolicUpperBias[i] = sourceLayer->getSymbolicUpperBias()[sourceIndex._neuron];
-
-        double sourceLb = sourceLayer->getLb( sourceIndex._neuron );
-        double sourceUb = sourceLayer->getUb( sourceIndex._neuron );
-
-        _symbolicLbOfLb[i] = sourceLayer->getSymbolicLbOfLb( sourceIndex._neuron );
-        _symbolicUbOfLb[i] = sourceLayer->getSymbolicUbOfLb( sourceIndex._neuron );
-        _symbolicLbOfUb[i] = sourceLayer->getSymbolicLbOfUb( sourceIndex._neuron );
-        _symbolicUbOfUb[i] = sourceLayer->getSymbolicUbOfUb( sourceIndex._neuron );
+            _symbolicLb[j * _size + i] = sourceSymbolicLb[j * sourceLayerSize + argMax._neuron];
 
-        if ( sourceLb >= 0 )
-            absPhase = AbsoluteValueConstraint::PHASE_POSITIVE;
-        else if ( sourceUb <= 0 )
-            absPhase = AbsoluteValueConstraint::PHASE_NEGATIVE;
+        _symbolicLowerBias[i] = sourceLayer->getSymbolicLowerBias()[argMax._neuron];
+        _symbolicLbOfLb[i] = sourceLayer->getSymbolicLbOfLb( argMax._neuron );
+        _symbolicUbOfLb[i] = sourceLayer->getSymbolicUbOfLb( argMax._neuron );
 
-        if ( absPhase == AbsoluteValueConstraint::PHASE_NOT_FIXED )
+        if ( maxLb >= maxUbOfOthers )
         {
-            // If we got here, we know that lbOfLb < 0 < ubOfUb. In this case,
-            // we do naive concretization: lb is 0, ub is the max between
-            // -lb and ub of the input neuron
+            // The phase of this Max is fixed!
             for ( unsigned j = 0; j < _inputLayerSize; ++j )
-            {
-                _symbolicLb[j * _size + i] = 0;
-                _symbolicUb[j * _size + i] = 0;
-            }
-
-            _symbolicLowerBias[i] = 0;
-            _symbolicUpperBias[i] = FloatUtils::max( -sourceLb, sourceUb );
+                _symbolicUb[j * _size + i] = sourceSymbolicUb[j * sourceLayerSize + argMax._neuron];
 
-            _symbolicLbOfLb[i] = 0;
-            _symbolicUbOfLb[i] = _symbolicUpperBias[i];
-            _symbolicLbOfUb[i] = 0;
-            _symbolicUbOfUb[i] = _symbolicUpperBias[i];
+            _symbolicUpperBias[i] = sourceLayer->getSymbolicUpperBias()[argMax._neuron];
+            _symbolicLbOfUb[i] = sourceLayer->getSymbolicLbOfUb( argMax._neuron );
+            _symbolicUbOfUb[i] = sourceLayer->getSymbolicUbOfUb( argMax._neuron );
         }
         else
         {
-            // The phase of this AbsoluteValueConstraint is fixed!
-            if ( absPhase == AbsoluteValueConstraint::PHASE_POSITIVE )
-            {
-                // Positive AbsoluteValue, bounds are propagated as is
-            }
-            else
-            {
-                // Negative AbsoluteValue, bounds are negated and flipped
-                double temp;
-                for ( unsigned j = 0; j < _inputLayerSize; ++j )
-                {
-                    temp = _symbolicUb[j * _size + i];
-                    _symbolicUb[j * _size + i] = -_symbolicLb[j * _size + i];
-                    _symbolicLb[j * _size + i] = -temp;
-                }
-
-                temp = _symbolicLowerBias[i];
-                _symbolicLowerBias[i] = -_symbolicUpperBias[i];
-                _symbolicUpperBias[i] = -temp;
-
-                // Old lb, negated, is the new ub
-                temp = _symbolicLbOfLb[i];
-                _symbolicLbOfLb[i] = -_symbolicUbOfUb[i];
-                _symbolicUbOfUb[i] = -temp;
-
-                temp = _symbolicUbOfLb[i];
-                _symbolicUbOfLb[i] = -_symbolicLbOfUb[i];
-                _symbolicLbOfUb[i] = -temp;
-            }
+            _symbolicUpperBias[i] = maxUb;
+            _symbolicLbOfUb[i] = maxUb;
+            _symbolicUbOfUb[i] = maxUb;
         }
 
-        // In extreme cases (constraint set externally), _symbolicLbOfLb
-        // could be negative - so adjust this
-        if ( _symbolicLbOfLb[i] < 0 )
-            _symbolicLbOfLb[i] = 0;
-
         /*
-          We now have the tightest bounds we can for the abs
+          We now have the tightest bounds we can for the max
           variable. If they are tigheter than what was previously
           known, store them.
         */
@@ -890,18 +1877,22 @@ void Layer::computeSymbolicBoundsForWeightedSum()
           newLB = oldUB * negWeights + oldLB * posWeights
         */
 
-        matrixMultiplication( sourceLayer->getSymbolicUb(), _layerToPositiveWeights[sourceLayerIndex],
-                              _symbolicUb, _inputLayerSize,
-                              sourceLayerSize, _size );
-        matrixMultiplication( sourceLayer->getSymbolicLb(), _layerToNegativeWeights[sourceLayerIndex],
-                              _symbolicUb, _inputLayerSize,
-                              sourceLayerSize, _size );
-        matrixMultiplication( sourceLayer->getSymbolicLb(), _layerToPositiveWeights[sourceLayerIndex],
-                              _symbolicLb, _inputLayerSize,
-                              sourceLayerSize, _size);
-        matrixMultiplication( sourceLayer->getSymbolicUb(), _layerToNegativeWeights[sourceLayerIndex],
-                              _symbolicLb, _inputLayerSize,
-                              sourceLayerSize, _size);
+        if ( !_layerOwner->singlePrecisionSymbolicBoundsInUse() ||
+             !addSourceSymbolicBoundsInSinglePrecision( sourceLayer, sourceLayerIndex, sourceLayerSize ) )
+        {
+            matrixMultiplication( sourceLayer->getSymbolicUb(), _layerToPositiveWeights[sourceLayerIndex],
+                                  _symbolicUb, _inputLayerSize,
+                                  sourceLayerSize, _size );
+            matrixMultiplication( sourceLayer->getSymbolicLb(), _layerToNegativeWeights[sourceLayerIndex],
+                                  _symbolicUb, _inputLayerSize,
+                                  sourceLayerSize, _size );
+            matrixMultiplication( sourceLayer->getSymbolicLb(), _layerToPositiveWeights[sourceLayerIndex],
+                                  _symbolicLb, _inputLayerSize,
+                                  sourceLayerSize, _size);
+            matrixMultiplication( sourceLayer->getSymbolicUb(), _layerToNegativeWeights[sourceLayerIndex],
+                                  _symbolicLb, _inputLayerSize,
+                                  sourceLayerSize, _size);
+        }
 
         // Restore the zero bound on eliminated neurons
         unsigned index;
@@ -942,7 +1933,103 @@ void Layer::computeSymbolicBoundsForWeightedSum()
         }
     }
 
+    concretizeSymbolicBounds();
+}
+
+void Layer::computeSymbolicBoundsForConvolution()
+{
+    std::fill_n( _symbolicLb, _size * _inputLayerSize, 0 );
+    std::fill_n( _symbolicUb, _size * _inputLayerSize, 0 );
+
+    const Layer *sourceLayer = _layerOwner->getLayer( _sourceLayers.begin()->first );
+    unsigned sourceLayerSize = _sourceLayers.begin()->second;
+    const double *sourceSymbolicLb = sourceLayer->getSymbolicLb();
+    const double *sourceSymbolicUb = sourceLayer->getSymbolicUb();
+    const double *sourceLowerBias = sourceLayer->getSymbolicLowerBias();
+    const double *sourceUpperBias = sourceLayer->getSymbolicUpperBias();
+
+    /*
+      The same products as for a weighted sum layer, but only over
+      the receptive field of each neuron:
+
+      newUB = oldUB * posWeights + oldLB * negWeights
+      newLB = oldUB * negWeights + oldLB * posWeights
+    */
+    for ( unsigned j = 0; j < _inputLayerSize; ++j )
+    {
+        const double *sourceLbRow = sourceSymbolicLb + j * sourceLayerSize;
+        const double *sourceUbRow = sourceSymbolicUb + j * sourceLayerSize;
+        double *lbRow = _symbolicLb + j * _size;
+        double *ubRow = _symbolicUb + j * _size;
+
+        for ( unsigned i = 0; i < _size; ++i )
+        {
+            for ( unsigned tap = _tapStart[i]; tap < _tapStart[i + 1]; ++tap )
+            {
+                unsigned sourceNeuron = _tapSourceNeuron[tap];
+                double weight = _kernel[_tapKernelIndex[tap]];
+
+                if ( weight > 0 )
+                {
+                    lbRow[i] += weight * sourceLbRow[sourceNeuron];
+                    ubRow[i] += weight * sourceUbRow[sourceNeuron];
+                }
+                else
+                {
+                    lbRow[i] += weight * sourceUbRow[sourceNeuron];
+                    ubRow[i] += weight * sourceLbRow[sourceNeuron];
+                }
+            }
+        }
+    }
+
+    for ( unsigned i = 0; i < _size; ++i )
+    {
+        if ( _eliminatedNeurons.exists( i ) )
+        {
+            // Restore the zero bound on eliminated neurons
+            for ( unsigned j = 0; j < _inputLayerSize; ++j )
+            {
+                _symbolicLb[j * _size + i] = 0;
+                _symbolicUb[j * _size + i] = 0;
+            }
+
+            _symbolicLowerBias[i] = _eliminatedNeurons[i];
+            _symbolicUpperBias[i] = _eliminatedNeurons[i];
+
+            _symbolicLbOfLb[i] = _eliminatedNeurons[i];
+            _symbolicUbOfLb[i] = _eliminatedNeurons[i];
+            _symbolicLbOfUb[i] = _eliminatedNeurons[i];
+            _symbolicUbOfUb[i] = _eliminatedNeurons[i];
+            continue;
+        }
+
+        _symbolicLowerBias[i] = _bias[i];
+        _symbolicUpperBias[i] = _bias[i];
+
+        for ( unsigned tap = _tapStart[i]; tap < _tapStart[i + 1]; ++tap )
+        {
+            unsigned sourceNeuron = _tapSourceNeuron[tap];
+            double weight = _kernel[_tapKernelIndex[tap]];
+
+            if ( weight > 0 )
+            {
+                _symbolicLowerBias[i] += sourceLowerBias[sourceNeuron] * weight;
+                _symbolicUpperBias[i] += sourceUpperBias[sourceNeuron] * weight;
+            }
+            else
+            {
+                _symbolicLowerBias[i] += sourceUpperBias[sourceNeuron] * weight;
+                _symbolicUpperBias[i] += sourceLowerBias[sourceNeuron] * weight;
+            }
+        }
+    }
+
+    concretizeSymbolicBounds();
+}
 
+void Layer::concretizeSymbolicBounds()
+{
     /*
       We now have the symbolic representation for the current
       layer. Next, we compute new lower and upper bounds for
@@ -1010,6 +2097,133 @@ void Layer::computeSymbolicBoundsForWeightedSum()
     }
 }
 
+bool Layer::addSourceSymbolicBoundsInSinglePrecision( const Layer *sourceLayer,
+                                                      unsigned sourceLayerIndex,
+                                                      unsigned sourceLayerSize )
+{
+    /*
+      Every entry of the products is a dot product of length
+      2 * sourceLayerSize. With its operands rounded to single
+      precision, the error of such a product is at most
+
+        gamma_n * sum_k |a_k| * |w_k|,     gamma_n = n * u / ( 1 - n * u )
+
+      where n = 2 * sourceLayerSize + 2 and u is the unit roundoff,
+      regardless of the order of summation (Higham, "Accuracy and
+      Stability of Numerical Algorithms", Section 3.1). Underflow adds
+      at most n times the smallest subnormal. The sum on the right is
+      bounded by multiplying max( |lb|, |ub| ) of the source symbolic
+      bounds by |weights|, once more in single precision, and then
+      scaled by ( 1 + gamma_n ) to account for that product's own
+      error.
+    */
+    double u = std::numeric_limits<float>::epsilon() / 2;
+    double n = 2.0 * sourceLayerSize + 2;
+    if ( n * u >= 0.5 )
+        return false;
+
+    double gamma = n * u / ( 1 - n * u );
+    double underflow = n * std::numeric_limits<float>::denorm_min();
+
+    unsigned symbolicSize = _inputLayerSize * sourceLayerSize;
+    unsigned weightsSize = sourceLayerSize * _size;
+    unsigned resultSize = _inputLayerSize * _size;
+
+    const double *symbolicLb = sourceLayer->getSymbolicLb();
+    const double *symbolicUb = sourceLayer->getSymbolicUb();
+    const double *positiveWeights = _layerToPositiveWeights[sourceLayerIndex];
+    const double *negativeWeights = _layerToNegativeWeights[sourceLayerIndex];
+
+    float *sourceLb = new float[symbolicSize];
+    float *sourceUb = new float[symbolicSize];
+    float *sourceMagnitude = new float[symbolicSize];
+    for ( unsigned i = 0; i < symbolicSize; ++i )
+    {
+        sourceLb[i] = (float)symbolicLb[i];
+        sourceUb[i] = (float)symbolicUb[i];
+        sourceMagnitude[i] = (float)FloatUtils::max( FloatUtils::abs( symbolicLb[i] ),
+                                                     FloatUtils::abs( symbolicUb[i] ) );
+    }
+
+    float *positive = new float[weightsSize];
+    float *negative = new float[weightsSize];
+    float *magnitude = new float[weightsSize];
+    for ( unsigned i = 0; i < weightsSize; ++i )
+    {
+        positive[i] = (float)positiveWeights[i];
+        negative[i] = (float)negativeWeights[i];
+        magnitude[i] = positive[i] - negative[i];
+    }
+
+    float *newLb = new float[resultSize];
+    float *newUb = new float[resultSize];
+    float *errors = new float[resultSize];
+    std::fill_n( newLb, resultSize, 0 );
+    std::fill_n( newUb, resultSize, 0 );
+    std::fill_n( errors, resultSize, 0 );
+
+    matrixMultiplication( sourceUb, positive, newUb, _inputLayerSize, sourceLayerSize, _size );
+    matrixMultiplication( sourceLb, negative, newUb, _inputLayerSize, sourceLayerSize, _size );
+    matrixMultiplication( sourceLb, positive, newLb, _inputLayerSize, sourceLayerSize, _size );
+    matrixMultiplication( sourceUb, negative, newLb, _inputLayerSize, sourceLayerSize, _size );
+    matrixMultiplication( sourceMagnitude, magnitude, errors, _inputLayerSize, sourceLayerSize, _size );
+
+    bool finite = true;
+    for ( unsigned i = 0; i < resultSize; ++i )
+    {
+        if ( !std::isfinite( newLb[i] ) || !std::isfinite( newUb[i] ) || !std::isfinite( errors[i] ) )
+        {
+            finite = false;
+            break;
+        }
+    }
+
+    if ( finite )
+    {
+        for ( unsigned i = 0; i < resultSize; ++i )
+        {
+            _symbolicLb[i] += newLb[i];
+            _symbolicUb[i] += newUb[i];
+        }
+
+        /*
+          An error of e in the coefficient of input j changes the value
+          of the bound by at most e * max( |lb_j|, |ub_j| ) over the
+          input region. The total is absorbed by the biases.
+        */
+        const Layer *inputLayer = _layerOwner->getLayer( 0 );
+        for ( unsigned i = 0; i < _size; ++i )
+        {
+            if ( _eliminatedNeurons.exists( i ) )
+                continue;
+
+            double slack = 0;
+            for ( unsigned j = 0; j < _inputLayerSize; ++j )
+            {
+                double inputMagnitude = FloatUtils::max( FloatUtils::abs( inputLayer->getLb( j ) ),
+                                                         FloatUtils::abs( inputLayer->getUb( j ) ) );
+                double error = gamma * ( 1 + gamma ) * errors[j * _size + i] + underflow;
+                slack += error * inputMagnitude;
+            }
+
+            _symbolicLowerBias[i] -= slack;
+            _symbolicUpperBias[i] += slack;
+        }
+    }
+
+    delete[] sourceLb;
+    delete[] sourceUb;
+    delete[] sourceMagnitude;
+    delete[] positive;
+    delete[] negative;
+    delete[] magnitude;
+    delete[] newLb;
+    delete[] newUb;
+    delete[] errors;
+
+    return finite;
+}
+
 void Layer::eliminateVariable( unsigned variable, double value )
 {
     if ( !_variableToNeuron.exists( variable ) )
@@ -1071,6 +2285,46 @@ void Layer::updateVariableIndices( const Map<unsigned, unsigned> &oldIndexToNewI
     }
 }
 
+void Layer::storeState( LayerState &state ) const
+{
+    ASSERT( GlobalConfiguration::USE_SYMBOLIC_BOUND_TIGHTENING );
+
+    state.allocate( _size, _inputLayerSize );
+
+    memcpy( state._lb, _lb, sizeof(double) * _size );
+    memcpy( state._ub, _ub, sizeof(double) * _size );
+
+    memcpy( state._symbolicLb, _symbolicLb, sizeof(double) * _size * _inputLayerSize );
+    memcpy( state._symbolicUb, _symbolicUb, sizeof(double) * _size * _inputLayerSize );
+    memcpy( state._symbolicLowerBias, _symbolicLowerBias, sizeof(double) * _size );
+    memcpy( state._symbolicUpperBias, _symbolicUpperBias, sizeof(double) * _size );
+
+    memcpy( state._symbolicLbOfLb, _symbolicLbOfLb, sizeof(double) * _size );
+    memcpy( state._symbolicUbOfLb, _symbolicUbOfLb, sizeof(double) * _size );
+    memcpy( state._symbolicLbOfUb, _symbolicLbOfUb, sizeof(double) * _size );
+    memcpy( state._symbolicUbOfUb, _symbolicUbOfUb, sizeof(double) * _size );
+}
+
+void Layer::restoreState( const LayerState &state )
+{
+    ASSERT( GlobalConfiguration::USE_SYMBOLIC_BOUND_TIGHTENING );
+    ASSERT( state._size == _size );
+    ASSERT( state._inputLayerSize == _inputLayerSize );
+
+    memcpy( _lb, state._lb, sizeof(double) * _size );
+    memcpy( _ub, state._ub, sizeof(double) * _size );
+
+    memcpy( _symbolicLb, state._symbolicLb, sizeof(double) * _size * _inputLayerSize );
+    memcpy( _symbolicUb, state._symbolicUb, sizeof(double) * _size * _inputLayerSize );
+    memcpy( _symbolicLowerBias, state._symbolicLowerBias, sizeof(double) * _size );
+    memcpy( _symbolicUpperBias, state._symbolicUpperBias, sizeof(double) * _size );
+
+    memcpy( _symbolicLbOfLb, state._symbolicLbOfLb, sizeof(double) * _size );
+    memcpy( _symbolicUbOfLb, state._symbolicUbOfLb, sizeof(double) * _size );
+    memcpy( _symbolicLbOfUb, state._symbolicLbOfUb, sizeof(double) * _size );
+    memcpy( _symbolicUbOfUb, state._symbolicUbOfUb, sizeof(double) * _size );
+}
+
 unsigned Layer::getLayerIndex() const
 {
     return _layerIndex;
@@ -1078,6 +2332,12 @@ unsigned Layer::getLayerIndex() const
 
 Layer::Layer( const Layer *other )
     : _bias( NULL )
+    , _weightsSharedWithCopies( false )
+    , _weightsShared( false )
+    , _kernel( NULL )
+    , _tapStart( NULL )
+    , _tapSourceNeuron( NULL )
+    , _tapKernelIndex( NULL )
     , _assignment( NULL )
     , _lb( NULL )
     , _ub( NULL )
@@ -1098,8 +2358,31 @@ Layer::Layer( const Layer *other )
 
     allocateMemory();
 
+    // The dense weights and biases are either shared with the other
+    // layer, or copied
+    bool shareWeights = other->_weightsSharedWithCopies || other->_weightsShared;
+
     for ( auto &sourceLayerEntry : other->_sourceLayers )
     {
+        if ( shareWeights )
+        {
+            _sourceLayers[sourceLayerEntry.first] = sourceLayerEntry.second;
+
+            if ( other->_layerToWeights.exists( sourceLayerEntry.first ) )
+                _layerToWeights[sourceLayerEntry.first] =
+                    other->_layerToWeights[sourceLayerEntry.first];
+
+            if ( other->_layerToPositiveWeights.exists( sourceLayerEntry.first ) )
+                _layerToPositiveWeights[sourceLayerEntry.first] =
+                    other->_layerToPositiveWeights[sourceLayerEntry.first];
+
+            if ( other->_layerToNegativeWeights.exists( sourceLayerEntry.first ) )
+                _layerToNegativeWeights[sourceLayerEntry.first] =
+                    other->_layerToNegativeWeights[sourceLayerEntry.first];
+
+            continue;
+        }
+
         addSourceLayer( sourceLayerEntry.first, sourceLayerEntry.second );
 
         if ( other->_layerToWeights.exists( sourceLayerEntry.first ) )
@@ -1119,7 +2402,25 @@ Layer::Layer( const Layer *other )
     }
 
     if ( other->_bias )
-        memcpy( _bias, other->_bias, sizeof(double) * _size );
+    {
+        if ( shareWeights )
+        {
+            delete[] _bias;
+            _bias = other->_bias;
+        }
+        else
+            memcpy( _bias, other->_bias, sizeof(double) * _size );
+    }
+
+    _weightsShared = shareWeights;
+
+    if ( other->_kernel )
+    {
+        _convolution = other->_convolution;
+        _kernel = new double[_convolution.getKernelSize()];
+        memcpy( _kernel, other->_kernel, sizeof(double) * _convolution.getKernelSize() );
+        computeConvolutionTaps();
+    }
 
     _neuronToActivationSources = other->_neuronToActivationSources;
 
@@ -1172,24 +2473,30 @@ double Layer::getSymbolicUbOfUb( unsigned neuron ) const
 
 void Layer::freeMemoryIfNeeded()
 {
-    for ( const auto &weights : _layerToWeights )
-        delete[] weights.second;
-    _layerToWeights.clear();
+    // Shared weights are freed by the layer that owns them
+    if ( !_weightsShared )
+    {
+        for ( const auto &weights : _layerToWeights )
+            delete[] weights.second;
 
-    for ( const auto &weights : _layerToPositiveWeights )
-        delete[] weights.second;
-    _layerToPositiveWeights.clear();
+        for ( const auto &weights : _layerToPositiveWeights )
+            delete[] weights.second;
 
-    for ( const auto &weights : _layerToNegativeWeights )
-        delete[] weights.second;
-    _layerToNegativeWeights.clear();
+        for ( const auto &weights : _layerToNegativeWeights )
+            delete[] weights.second;
 
-    if ( _bias )
-    {
-        delete[] _bias;
-        _bias = NULL;
+        if ( _bias )
+            delete[] _bias;
     }
 
+    _layerToWeights.clear();
+    _layerToPositiveWeights.clear();
+    _layerToNegativeWeights.clear();
+    _bias = NULL;
+    _weightsShared = false;
+
+    freeConvolutionMemoryIfNeeded();
+
     if ( _assignment )
     {
         delete[] _assignment;
@@ -1257,6 +2564,33 @@ void Layer::freeMemoryIfNeeded()
     }
 }
 
+void Layer::freeConvolutionMemoryIfNeeded()
+{
+    if ( _kernel )
+    {
+        delete[] _kernel;
+        _kernel = NULL;
+    }
+
+    if ( _tapStart )
+    {
+        delete[] _tapStart;
+        _tapStart = NULL;
+    }
+
+    if ( _tapSourceNeuron )
+    {
+        delete[] _tapSourceNeuron;
+        _tapSourceNeuron = NULL;
+    }
+
+    if ( _tapKernelIndex )
+    {
+        delete[] _tapKernelIndex;
+        _tapKernelIndex = NULL;
+    }
+}
+
 String Layer::typeToString( Type type )
 {
     switch ( type )
@@ -1269,6 +2603,10 @@ String Layer::typeToString( Type type )
         return "WEIGHTED_SUM";
         break;
 
+    case CONVOLUTION:
+        return "CONVOLUTION";
+        break;
+
     case RELU:
         return "RELU";
         break;
@@ -1281,6 +2619,10 @@ String Layer::typeToString( Type type )
         return "MAX";
         break;
 
+    case SIGN:
+        return "SIGN";
+        break;
+
     default:
         return "UNKNOWN TYPE";
         break;
@@ -1334,9 +2676,53 @@ void Layer::dump() const
         printf( "\n" );
         break;
 
+    case CONVOLUTION:
+    {
+        printf( "\t\tKernel %ux%u, stride %u, padding %u, from %u channels of %ux%u to %u channels of %ux%u\n",
+                _convolution._kernelHeight,
+                _convolution._kernelWidth,
+                _convolution._stride,
+                _convolution._padding,
+                _convolution._inputChannels,
+                _convolution._inputHeight,
+                _convolution._inputWidth,
+                _convolution._outputChannels,
+                _convolution.getOutputHeight(),
+                _convolution.getOutputWidth() );
+
+        const Layer *sourceLayer = _layerOwner->getLayer( _sourceLayers.begin()->first );
+        for ( unsigned i = 0; i < _size; ++i )
+        {
+            if ( _eliminatedNeurons.exists( i ) )
+            {
+                printf( "\t\tNeuron %u = %+.4lf\t[ELIMINATED]\n", i, _eliminatedNeurons[i] );
+                continue;
+            }
+
+            printf( "\t\tx%u = %+.4lf\n\t\t\t", _neuronToVariable[i], _bias[i] );
+            for ( unsigned tap = _tapStart[i]; tap < _tapStart[i + 1]; ++tap )
+            {
+                unsigned j = _tapSourceNeuron[tap];
+                double weight = _kernel[_tapKernelIndex[tap]];
+                if ( !FloatUtils::isZero( weight ) )
+                {
+                    if ( sourceLayer->_neuronToVariable.exists( j ) )
+                        printf( "%+.5lfx%u ", weight, sourceLayer->_neuronToVariable[j] );
+                    else
+                        printf( "%+.5lf", weight * sourceLayer->_eliminatedNeurons[j] );
+                }
+            }
+            printf( "\n" );
+        }
+
+        printf( "\n" );
+        break;
+    }
+
     case RELU:
     case ABSOLUTE_VALUE:
     case MAX:
+    case SIGN:
 
         for ( unsigned i = 0; i < _size; ++i )
         {
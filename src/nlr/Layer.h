@@ -20,10 +20,15 @@
 #include "Debug.h"
 #include "FloatUtils.h"
 #include "LayerOwner.h"
+#include "LayerState.h"
 #include "MarabouError.h"
 #include "MatrixMultiplication.h"
 #include "NeuronIndex.h"
+#include "Pair.h"
 #include "ReluConstraint.h"
+#include "Vector.h"
+
+class InputQuery;
 
 namespace NLR {
 
@@ -34,11 +39,40 @@ public:
         // Linear layers
         INPUT = 0,
         WEIGHTED_SUM,
+        CONVOLUTION,
 
         // Activation functions
         RELU,
         ABSOLUTE_VALUE,
         MAX,
+        SIGN,
+    };
+
+    /*
+      The shape of a convolution layer. The neurons of the source
+      layer and of the convolution layer itself are laid out
+      channel-major: the neuron for channel c, row y and column x is
+      ( c * height + y ) * width + x. The kernel is shared by all
+      output positions, instead of being stored as dense weights.
+    */
+    struct ConvolutionParameters
+    {
+        ConvolutionParameters();
+
+        unsigned getOutputHeight() const;
+        unsigned getOutputWidth() const;
+        unsigned getInputSize() const;
+        unsigned getOutputSize() const;
+        unsigned getKernelSize() const;
+
+        unsigned _inputChannels;
+        unsigned _inputHeight;
+        unsigned _inputWidth;
+        unsigned _outputChannels;
+        unsigned _kernelHeight;
+        unsigned _kernelWidth;
+        unsigned _stride;
+        unsigned _padding;
     };
 
     /*
@@ -64,6 +98,43 @@ public:
     void setBias( unsigned neuron, double bias );
     double getBias( unsigned neuron ) const;
 
+    /*
+      Let copies of this layer share its dense weights and biases,
+      instead of copying them. The weights of this layer must not
+      change afterwards, and it must outlive its copies. A copy whose
+      weights are changed first makes a private copy of them.
+    */
+    void shareWeightsWithCopies();
+    bool weightsShared() const;
+
+    /*
+      Convolution layers have a single source layer, and must be
+      given their shape before their kernel weights are set.
+      getWeight() also works for convolution layers, by mapping the
+      pair of neurons onto the kernel. getConvolutionTaps() returns
+      the source neurons that feed a neuron, with their weights.
+    */
+    void setConvolutionParameters( const ConvolutionParameters &parameters );
+    const ConvolutionParameters &getConvolutionParameters() const;
+    void setKernelWeight( unsigned outputChannel,
+                          unsigned inputChannel,
+                          unsigned row,
+                          unsigned column,
+                          double weight );
+    double getKernelWeight( unsigned outputChannel,
+                            unsigned inputChannel,
+                            unsigned row,
+                            unsigned column ) const;
+    List<Pair<unsigned, double>> getConvolutionTaps( unsigned neuron ) const;
+
+    /*
+      Check whether the dense weights of a weighted sum layer with a
+      single source layer encode a convolution over square images. If
+      so, turn the layer into a convolution layer and discard the
+      dense weights. Returns true iff the layer was converted.
+    */
+    bool detectConvolution();
+
     void addActivationSource( unsigned sourceLayer,
                               unsigned sourceNeuron,
                               unsigned targetNeuron );
@@ -86,19 +157,44 @@ public:
     double getAssignment( unsigned neuron ) const;
     void computeAssignment();
 
+    /*
+      Back-propagate the gradient of some function of the network's
+      neurons through this layer. gradients maps every layer index to
+      an array with an entry per neuron. The gradient of this layer's
+      neurons is added to the gradients of their source neurons,
+      using the current assignment. Eliminated neurons are constant,
+      and do not propagate anything.
+
+      If useBounds is set, activation functions are replaced by their
+      linear relaxation under the current bounds rather than by their
+      derivative at the current assignment; e.g., an unfixed ReLU with
+      source bounds [l, u] has slope u / (u - l).
+    */
+    void backPropagate( Map<unsigned, double *> &gradients, bool useBounds = false ) const;
+
     /*
       Bound related functionality: grab the current bounds from the
-      Tableau, or compute bounds from source layers
+      Tableau (or, before the Tableau exists, from an input query),
+      or compute bounds from source layers. When grabbing the bounds
+      from the Tableau, returns true iff they differ from the ones
+      currently stored in the layer.
     */
     void setLb( unsigned neuron, double bound );
     void setUb( unsigned neuron, double bound );
     double getLb( unsigned neuron ) const;
     double getUb( unsigned neuron ) const;
 
-    void obtainCurrentBounds();
+    bool obtainCurrentBounds();
+    void obtainCurrentBounds( const InputQuery &inputQuery );
     void computeSymbolicBounds();
     void computeIntervalArithmeticBounds();
 
+    /*
+      Store/restore the bounds and the symbolic bounds of the layer
+    */
+    void storeState( LayerState &state ) const;
+    void restoreState( const LayerState &state );
+
     /*
       Preprocessing functionality: variable elimination and reindexing
     */
@@ -128,6 +224,26 @@ private:
     Map<unsigned, double *> _layerToNegativeWeights;
     double *_bias;
 
+    /*
+      _weightsSharedWithCopies is set for a layer that owns weights
+      which its copies share; _weightsShared is set for a copy that
+      does not own its weights.
+    */
+    bool _weightsSharedWithCopies;
+    bool _weightsShared;
+
+    /*
+      The shape and kernel of a convolution layer. For every neuron
+      i, the entries _tapStart[i] to _tapStart[i+1] - 1 of
+      _tapSourceNeuron and _tapKernelIndex list the source neurons
+      that feed it, and the corresponding entries of the kernel.
+    */
+    ConvolutionParameters _convolution;
+    double *_kernel;
+    unsigned *_tapStart;
+    unsigned *_tapSourceNeuron;
+    unsigned *_tapKernelIndex;
+
     double *_assignment;
 
     double *_lb;
@@ -152,20 +268,78 @@ private:
     void allocateMemory();
     void freeMemoryIfNeeded();
 
+    /*
+      Make a private copy of weights shared with another layer
+    */
+    void unshareWeights();
+
+    void computeConvolutionTaps();
+    void freeConvolutionMemoryIfNeeded();
+    unsigned kernelIndex( unsigned outputChannel,
+                          unsigned inputChannel,
+                          unsigned row,
+                          unsigned column ) const;
+
+    /*
+      Check whether the dense weights from the source layer match a
+      convolution with the given shape and, if so, store its kernel
+    */
+    bool matchConvolution( const ConvolutionParameters &parameters,
+                           const double *weights,
+                           const Vector<unsigned> &nonZeroWeights,
+                           double *kernel ) const;
+
+    void getCurrentBoundsFromTableau( unsigned neuron, double &lb, double &ub ) const;
+
     /*
       Helper functions for symbolic bound tightening
     */
     void comptueSymbolicBoundsForInput();
     void computeSymbolicBoundsForRelu();
     void computeSymbolicBoundsForAbsoluteValue();
+    void computeSymbolicBoundsForSign();
+    void computeSymbolicBoundsForMax();
     void computeSymbolicBoundsForWeightedSum();
+    void computeSymbolicBoundsForConvolution();
+
+    /*
+      Compute concrete bounds for the neurons of a linear layer from
+      its symbolic bounds, and report any tighter bounds
+    */
+    void concretizeSymbolicBounds();
+
+    /*
+      Add the symbolic bounds contributed by one source layer of a
+      weighted sum layer, computing the matrix products in single
+      precision. The rounding errors are bounded and added to the
+      symbolic biases. Returns false, without changing anything, if
+      the single precision computation overflowed.
+    */
+    bool addSourceSymbolicBoundsInSinglePrecision( const Layer *sourceLayer,
+                                                   unsigned sourceLayerIndex,
+                                                   unsigned sourceLayerSize );
 
     /*
       Helper functions for interval bound tightening
     */
     void computeIntervalArithmeticBoundsForWeightedSum();
+    void computeIntervalArithmeticBoundsForConvolution();
     void computeIntervalArithmeticBoundsForRelu();
     void computeIntervalArithmeticBoundsForAbs();
+    void computeIntervalArithmeticBoundsForSign();
+    void computeIntervalArithmeticBoundsForMax();
+
+    /*
+      Gather the bounds of each neuron's activation source, for layers
+      whose neurons have a single source
+    */
+    void getActivationSourceBounds( double *sourceLb, double *sourceUb ) const;
+
+    /*
+      Store any of the given bounds that are tighter than the current
+      ones, and report them to the layer owner
+    */
+    void storeTighterBounds( const double *newLb, const double *newUb );
 
     const double *getSymbolicLb() const;
     const double *getSymbolicUb() const;
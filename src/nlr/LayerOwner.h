@@ -30,6 +30,7 @@ public:
     virtual const ITableau *getTableau() const = 0;
     virtual unsigned getNumberOfLayers() const = 0;
     virtual void receiveTighterBound( Tightening tightening ) = 0;
+    virtual bool singlePrecisionSymbolicBoundsInUse() const = 0;
 };
 
 } // namespace NLR
@@ -0,0 +1,122 @@
+/*********************                                                        */
+/*! \file LayerState.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#ifndef __LayerState_h__
+#define __LayerState_h__
+
+#include <cstddef>
+
+namespace NLR {
+
+/*
+  A copy of the bounds of a layer, and of the symbolic bounds that
+  were computed for it by the most recent symbolic bound propagation.
+*/
+struct LayerState
+{
+    LayerState()
+        : _size( 0 )
+        , _inputLayerSize( 0 )
+        , _lb( NULL )
+        , _ub( NULL )
+        , _symbolicLb( NULL )
+        , _symbolicUb( NULL )
+        , _symbolicLowerBias( NULL )
+        , _symbolicUpperBias( NULL )
+        , _symbolicLbOfLb( NULL )
+        , _symbolicUbOfLb( NULL )
+        , _symbolicLbOfUb( NULL )
+        , _symbolicUbOfUb( NULL )
+    {
+    }
+
+    ~LayerState()
+    {
+        freeMemoryIfNeeded();
+    }
+
+    void allocate( unsigned size, unsigned inputLayerSize )
+    {
+        freeMemoryIfNeeded();
+
+        _size = size;
+        _inputLayerSize = inputLayerSize;
+
+        _lb = new double[size];
+        _ub = new double[size];
+
+        _symbolicLb = new double[size * inputLayerSize];
+        _symbolicUb = new double[size * inputLayerSize];
+        _symbolicLowerBias = new double[size];
+        _symbolicUpperBias = new double[size];
+
+        _symbolicLbOfLb = new double[size];
+        _symbolicUbOfLb = new double[size];
+        _symbolicLbOfUb = new double[size];
+        _symbolicUbOfUb = new double[size];
+    }
+
+    void freeMemoryIfNeeded()
+    {
+        double **buffers[] = {
+            &_lb, &_ub,
+            &_symbolicLb, &_symbolicUb,
+            &_symbolicLowerBias, &_symbolicUpperBias,
+            &_symbolicLbOfLb, &_symbolicUbOfLb,
+            &_symbolicLbOfUb, &_symbolicUbOfUb,
+        };
+
+        for ( double **buffer : buffers )
+        {
+            if ( *buffer )
+            {
+                delete[] *buffer;
+                *buffer = NULL;
+            }
+        }
+    }
+
+    unsigned _size;
+    unsigned _inputLayerSize;
+
+    double *_lb;
+    double *_ub;
+
+    double *_symbolicLb;
+    double *_symbolicUb;
+    double *_symbolicLowerBias;
+    double *_symbolicUpperBias;
+    double *_symbolicLbOfLb;
+    double *_symbolicUbOfLb;
+    double *_symbolicLbOfUb;
+    double *_symbolicUbOfUb;
+
+private:
+    // Disallow copying
+    LayerState( const LayerState & );
+    LayerState &operator=( const LayerState & );
+};
+
+} // namespace NLR
+
+#endif // __LayerState_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
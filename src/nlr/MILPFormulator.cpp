@@ -256,6 +256,7 @@ void MILPFormulator::addLayerToModel( GurobiWrapper &gurobi, const Layer *layer
     {
         case Layer::INPUT:
         case Layer::WEIGHTED_SUM:
+        case Layer::CONVOLUTION:
             break;
 
         case Layer::RELU:
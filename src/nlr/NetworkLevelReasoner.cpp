@@ -16,12 +16,14 @@
 #include "AbsoluteValueConstraint.h"
 #include "Debug.h"
 #include "FloatUtils.h"
+#include "InputQuery.h"
 #include "LPFormulator.h"
 #include "MILPFormulator.h"
 #include "MStringf.h"
 #include "MarabouError.h"
 #include "NLRError.h"
 #include "NetworkLevelReasoner.h"
+#include "Options.h"
 #include "ReluConstraint.h"
 #include <cstring>
 
@@ -29,6 +31,8 @@ namespace NLR {
 
 NetworkLevelReasoner::NetworkLevelReasoner()
     : _tableau( NULL )
+    , _allLayersDirty( true )
+    , _singlePrecisionSymbolicBounds( false )
 {
 }
 
@@ -45,6 +49,12 @@ bool NetworkLevelReasoner::functionTypeSupported( PiecewiseLinearFunctionType ty
     if ( type == PiecewiseLinearFunctionType::ABSOLUTE_VALUE )
         return true;
 
+    if ( type == PiecewiseLinearFunctionType::SIGN )
+        return true;
+
+    if ( type == PiecewiseLinearFunctionType::MAX )
+        return true;
+
     return false;
 }
 
@@ -52,11 +62,13 @@ void NetworkLevelReasoner::addLayer( unsigned layerIndex, Layer::Type type, unsi
 {
     Layer *layer = new Layer( layerIndex, type, layerSize, this );
     _layerIndexToLayer[layerIndex] = layer;
+    _allLayersDirty = true;
 }
 
 void NetworkLevelReasoner::addLayerDependency( unsigned sourceLayer, unsigned targetLayer )
 {
     _layerIndexToLayer[targetLayer]->addSourceLayer( sourceLayer, _layerIndexToLayer[sourceLayer]->getSize() );
+    _allLayersDirty = true;
 }
 
 void NetworkLevelReasoner::setWeight( unsigned sourceLayer,
@@ -67,11 +79,46 @@ void NetworkLevelReasoner::setWeight( unsigned sourceLayer,
 {
     _layerIndexToLayer[targetLayer]->setWeight
         ( sourceLayer, sourceNeuron, targetNeuron, weight );
+    _allLayersDirty = true;
 }
 
 void NetworkLevelReasoner::setBias( unsigned layer, unsigned neuron, double bias )
 {
     _layerIndexToLayer[layer]->setBias( neuron, bias );
+    _allLayersDirty = true;
+}
+
+void NetworkLevelReasoner::setConvolutionParameters( unsigned layer,
+                                                     const Layer::ConvolutionParameters &parameters )
+{
+    _layerIndexToLayer[layer]->setConvolutionParameters( parameters );
+    _allLayersDirty = true;
+}
+
+void NetworkLevelReasoner::setKernelWeight( unsigned layer,
+                                            unsigned outputChannel,
+                                            unsigned inputChannel,
+                                            unsigned row,
+                                            unsigned column,
+                                            double weight )
+{
+    _layerIndexToLayer[layer]->setKernelWeight( outputChannel, inputChannel, row, column, weight );
+    _allLayersDirty = true;
+}
+
+unsigned NetworkLevelReasoner::detectConvolutionalLayers()
+{
+    unsigned count = 0;
+    for ( const auto &layer : _layerIndexToLayer )
+    {
+        if ( layer.second->detectConvolution() )
+            ++count;
+    }
+
+    if ( count > 0 )
+        _allLayersDirty = true;
+
+    return count;
 }
 
 void NetworkLevelReasoner::addActivationSource( unsigned sourceLayer,
@@ -80,6 +127,7 @@ void NetworkLevelReasoner::addActivationSource( unsigned sourceLayer,
                                                 unsigned targetNeuron )
 {
     _layerIndexToLayer[targetLeyer]->addActivationSource( sourceLayer, sourceNeuron, targetNeuron );
+    _allLayersDirty = true;
 }
 
 const Layer *NetworkLevelReasoner::getLayer( unsigned index ) const
@@ -99,9 +147,111 @@ void NetworkLevelReasoner::evaluate( double *input, double *output )
             sizeof(double) * outputLayer->getSize() );
 }
 
+void NetworkLevelReasoner::backPropagate( Map<unsigned, double *> &gradients, bool useBounds ) const
+{
+    for ( unsigned i = _layerIndexToLayer.size() - 1; i > 0; --i )
+        _layerIndexToLayer[i]->backPropagate( gradients, useBounds );
+}
+
+void NetworkLevelReasoner::computeOutputSensitivity( Map<unsigned, double *> &sensitivity ) const
+{
+    Map<unsigned, double *> gradients;
+    for ( const auto &layer : _layerIndexToLayer )
+    {
+        unsigned size = layer.second->getSize();
+        gradients[layer.first] = new double[size];
+        std::fill_n( sensitivity[layer.first], size, 0 );
+    }
+
+    // One backward pass per output neuron, so that their coefficients
+    // do not cancel out
+    unsigned outputLayerIndex = _layerIndexToLayer.size() - 1;
+    unsigned outputLayerSize = _layerIndexToLayer[outputLayerIndex]->getSize();
+    for ( unsigned output = 0; output < outputLayerSize; ++output )
+    {
+        for ( const auto &layer : _layerIndexToLayer )
+            std::fill_n( gradients[layer.first], layer.second->getSize(), 0 );
+
+        gradients[outputLayerIndex][output] = 1;
+        backPropagate( gradients, true );
+
+        for ( const auto &layer : _layerIndexToLayer )
+        {
+            double *layerSensitivity = sensitivity[layer.first];
+            const double *layerGradient = gradients[layer.first];
+            for ( unsigned i = 0; i < layer.second->getSize(); ++i )
+                layerSensitivity[i] += FloatUtils::abs( layerGradient[i] );
+        }
+    }
+
+    for ( const auto &gradient : gradients )
+        delete[] gradient.second;
+}
+
+void NetworkLevelReasoner::getReluSplitScores( Map<unsigned, double> &scores ) const
+{
+    Map<unsigned, double *> sensitivity;
+    for ( const auto &layer : _layerIndexToLayer )
+        sensitivity[layer.first] = new double[layer.second->getSize()];
+
+    computeOutputSensitivity( sensitivity );
+
+    for ( const auto &layerEntry : _layerIndexToLayer )
+    {
+        const Layer *layer = layerEntry.second;
+        if ( layer->getLayerType() != Layer::RELU )
+            continue;
+
+        // Only score the earliest layer with unfixed ReLUs
+        if ( !scores.empty() )
+            break;
+
+        for ( unsigned i = 0; i < layer->getSize(); ++i )
+        {
+            if ( layer->neuronEliminated( i ) )
+                continue;
+
+            NeuronIndex sourceIndex = *layer->getActivationSources( i ).begin();
+            const Layer *sourceLayer = _layerIndexToLayer[sourceIndex._layer];
+            double lb = sourceLayer->getLb( sourceIndex._neuron );
+            double ub = sourceLayer->getUb( sourceIndex._neuron );
+
+            // Splitting on a fixed ReLU tightens nothing
+            if ( lb >= 0 || ub <= 0 )
+                continue;
+
+            double intercept = -lb * ub / ( ub - lb );
+            scores[layer->neuronToVariable( i )] = sensitivity[layerEntry.first][i] * intercept;
+        }
+    }
+
+    for ( const auto &layerSensitivity : sensitivity )
+        delete[] layerSensitivity.second;
+}
+
+void NetworkLevelReasoner::getInputSensitivity( Map<unsigned, double> &sensitivity ) const
+{
+    Map<unsigned, double *> layerSensitivity;
+    for ( const auto &layer : _layerIndexToLayer )
+        layerSensitivity[layer.first] = new double[layer.second->getSize()];
+
+    computeOutputSensitivity( layerSensitivity );
+
+    const Layer *inputLayer = _layerIndexToLayer[0];
+    for ( unsigned i = 0; i < inputLayer->getSize(); ++i )
+    {
+        if ( !inputLayer->neuronEliminated( i ) )
+            sensitivity[inputLayer->neuronToVariable( i )] = layerSensitivity[0][i];
+    }
+
+    for ( const auto &entry : layerSensitivity )
+        delete[] entry.second;
+}
+
 void NetworkLevelReasoner::setNeuronVariable( NeuronIndex index, unsigned variable )
 {
     _layerIndexToLayer[index._layer]->setNeuronVariable( index._neuron, variable );
+    _allLayersDirty = true;
 }
 
 void NetworkLevelReasoner::receiveTighterBound( Tightening tightening )
@@ -109,6 +259,20 @@ void NetworkLevelReasoner::receiveTighterBound( Tightening tightening )
     _boundTightenings.append( tightening );
 }
 
+void NetworkLevelReasoner::useSinglePrecisionSymbolicBounds( bool singlePrecision )
+{
+    if ( _singlePrecisionSymbolicBounds == singlePrecision )
+        return;
+
+    _singlePrecisionSymbolicBounds = singlePrecision;
+    _allLayersDirty = true;
+}
+
+bool NetworkLevelReasoner::singlePrecisionSymbolicBoundsInUse() const
+{
+    return _singlePrecisionSymbolicBounds;
+}
+
 void NetworkLevelReasoner::getConstraintTightenings( List<Tightening> &tightenings )
 {
     tightenings = _boundTightenings;
@@ -117,8 +281,38 @@ void NetworkLevelReasoner::getConstraintTightenings( List<Tightening> &tightenin
 
 void NetworkLevelReasoner::symbolicBoundPropagation()
 {
+    /*
+      A layer's symbolic bounds need to be recomputed only if its own
+      bounds have changed, or if any of its source layers have been
+      recomputed. Because layers are indexed in topological order,
+      this covers the entire downstream cone of the dirty layers.
+    */
+    Set<unsigned> recomputedLayers;
     for ( unsigned i = 0; i < _layerIndexToLayer.size(); ++i )
-        _layerIndexToLayer[i]->computeSymbolicBounds();
+    {
+        Layer *layer = _layerIndexToLayer[i];
+
+        bool recompute =
+            _allLayersDirty ||
+            !GlobalConfiguration::USE_INCREMENTAL_SYMBOLIC_BOUND_TIGHTENING ||
+            _dirtyLayers.exists( i );
+
+        for ( const auto &sourceLayer : layer->getSourceLayers() )
+        {
+            if ( recompute )
+                break;
+            recompute = recomputedLayers.exists( sourceLayer.first );
+        }
+
+        if ( recompute )
+        {
+            layer->computeSymbolicBounds();
+            recomputedLayers.insert( i );
+        }
+    }
+
+    _dirtyLayers.clear();
+    _allLayersDirty = false;
 }
 
 void NetworkLevelReasoner::lpRelaxationPropagation()
@@ -126,12 +320,33 @@ void NetworkLevelReasoner::lpRelaxationPropagation()
     LPFormulator lpFormulator( this );
     lpFormulator.setCutoff( 0 );
 
-    if ( GlobalConfiguration::MILP_SOLVER_BOUND_TIGHTENING_TYPE ==
-         GlobalConfiguration::LP_RELAXATION )
-        lpFormulator.optimizeBoundsWithLpRelaxation( _layerIndexToLayer );
-    else if ( GlobalConfiguration::MILP_SOLVER_BOUND_TIGHTENING_TYPE ==
-              GlobalConfiguration::LP_RELAXATION_INCREMENTAL )
+    /*
+      The MILP encodings require Gurobi. If we get here in one of those
+      modes, the built-in LP solver is in use, and the corresponding LP
+      relaxation is solved instead.
+    */
+    switch ( GlobalConfiguration::MILP_SOLVER_BOUND_TIGHTENING_TYPE )
+    {
+    case GlobalConfiguration::LP_RELAXATION:
+    case GlobalConfiguration::MILP_ENCODING:
+    {
+        int numberOfThreads = Options::get()->getInt( Options::NUM_LP_TIGHTENING_THREADS );
+        if ( numberOfThreads > 1 )
+            lpFormulator.optimizeBoundsWithParallelLpRelaxation( _layerIndexToLayer,
+                                                                 numberOfThreads );
+        else
+            lpFormulator.optimizeBoundsWithLpRelaxation( _layerIndexToLayer );
+        break;
+    }
+
+    case GlobalConfiguration::LP_RELAXATION_INCREMENTAL:
+    case GlobalConfiguration::MILP_ENCODING_INCREMENTAL:
         lpFormulator.optimizeBoundsWithIncrementalLpRelaxation( _layerIndexToLayer );
+        break;
+
+    case GlobalConfiguration::NONE:
+        break;
+    }
 }
 
 void NetworkLevelReasoner::MILPPropagation()
@@ -173,6 +388,55 @@ void NetworkLevelReasoner::storeIntoOther( NetworkLevelReasoner &other ) const
     }
 
     other._constraintsInTopologicalOrder = _constraintsInTopologicalOrder;
+    other._dirtyLayers.clear();
+    other._allLayersDirty = true;
+    other._singlePrecisionSymbolicBounds = _singlePrecisionSymbolicBounds;
+}
+
+void NetworkLevelReasoner::shareWeightsWithCopies()
+{
+    for ( const auto &layer : _layerIndexToLayer )
+        layer.second->shareWeightsWithCopies();
+}
+
+void NetworkLevelReasoner::storeState( NetworkLevelReasonerState &state ) const
+{
+    state.freeMemoryIfNeeded();
+
+    if ( !GlobalConfiguration::USE_SYMBOLIC_BOUND_TIGHTENING ||
+         !GlobalConfiguration::USE_INCREMENTAL_SYMBOLIC_BOUND_TIGHTENING )
+        return;
+
+    state._stateIsStored = true;
+    state._allLayersDirty = _allLayersDirty;
+
+    // If everything is dirty, there is nothing worth keeping
+    if ( _allLayersDirty )
+        return;
+
+    state._dirtyLayers = _dirtyLayers;
+    for ( const auto &layer : _layerIndexToLayer )
+    {
+        LayerState *layerState = new LayerState;
+        layer.second->storeState( *layerState );
+        state._layerStates[layer.first] = layerState;
+    }
+}
+
+void NetworkLevelReasoner::restoreState( const NetworkLevelReasonerState &state )
+{
+    if ( !state._stateIsStored || state._allLayersDirty )
+    {
+        _dirtyLayers.clear();
+        _allLayersDirty = true;
+        return;
+    }
+
+    for ( auto &layer : _layerIndexToLayer )
+        layer.second->restoreState( *state._layerStates[layer.first] );
+
+    _dirtyLayers = state._dirtyLayers;
+    _allLayersDirty = false;
 }
 
 void NetworkLevelReasoner::updateVariableIndices( const Map<unsigned, unsigned> &oldIndexToNewIndex,
@@ -180,13 +444,26 @@ void NetworkLevelReasoner::updateVariableIndices( const Map<unsigned, unsigned>
 {
     for ( auto &layer : _layerIndexToLayer )
         layer.second->updateVariableIndices( oldIndexToNewIndex, mergedVariables );
+
+    _allLayersDirty = true;
 }
 
 void NetworkLevelReasoner::obtainCurrentBounds()
 {
     ASSERT( _tableau );
     for ( const auto &layer : _layerIndexToLayer )
-        layer.second->obtainCurrentBounds();
+    {
+        if ( layer.second->obtainCurrentBounds() )
+            _dirtyLayers.insert( layer.first );
+    }
+}
+
+void NetworkLevelReasoner::obtainCurrentBounds( const InputQuery &inputQuery )
+{
+    for ( const auto &layer : _layerIndexToLayer )
+        layer.second->obtainCurrentBounds( inputQuery );
+
+    _allLayersDirty = true;
 }
 
 void NetworkLevelReasoner::setTableau( const ITableau *tableau )
@@ -203,6 +480,8 @@ void NetworkLevelReasoner::eliminateVariable( unsigned variable, double value )
 {
     for ( auto &layer : _layerIndexToLayer )
         layer.second->eliminateVariable( variable, value );
+
+    _allLayersDirty = true;
 }
 
 
@@ -231,4 +510,14 @@ void NetworkLevelReasoner::addConstraintInTopologicalOrder( PiecewiseLinearConst
     _constraintsInTopologicalOrder.append( constraint );
 }
 
+void NetworkLevelReasoner::updateConstraintsInTopologicalOrder( const Map<PiecewiseLinearConstraint *,
+                                                                PiecewiseLinearConstraint *> &constraintToNewConstraint )
+{
+    for ( auto &constraint : _constraintsInTopologicalOrder )
+    {
+        if ( constraintToNewConstraint.exists( constraint ) )
+            constraint = constraintToNewConstraint.at( constraint );
+    }
+}
+
 } // namespace NLR
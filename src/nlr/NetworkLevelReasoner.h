@@ -20,10 +20,13 @@
 #include "Layer.h"
 #include "LayerOwner.h"
 #include "Map.h"
+#include "NetworkLevelReasonerState.h"
 #include "NeuronIndex.h"
 #include "PiecewiseLinearFunctionType.h"
 #include "Tightening.h"
 
+class InputQuery;
+
 namespace NLR {
 
 /*
@@ -50,6 +53,13 @@ public:
                     unsigned targetNeuron,
                     double weight );
     void setBias( unsigned layer, unsigned neuron, double bias );
+    void setConvolutionParameters( unsigned layer, const Layer::ConvolutionParameters &parameters );
+    void setKernelWeight( unsigned layer,
+                          unsigned outputChannel,
+                          unsigned inputChannel,
+                          unsigned row,
+                          unsigned column,
+                          double weight );
     void addActivationSource( unsigned sourceLayer,
                               unsigned sourceNeuron,
                               unsigned targetLeyer,
@@ -58,6 +68,13 @@ public:
     unsigned getNumberOfLayers() const;
     const Layer *getLayer( unsigned index ) const;
 
+    /*
+      Replace weighted sum layers whose dense weights encode a
+      convolution with convolution layers, which share their kernel
+      weights. Returns the number of layers replaced.
+    */
+    unsigned detectConvolutionalLayers();
+
     /*
       Bind neurons in the NLR to the Tableau variables that represent them.
     */
@@ -68,11 +85,49 @@ public:
     */
     void evaluate( double *input , double *output );
 
+    /*
+      Compute the gradient of a function of the network's neurons,
+      at the point of the most recent evaluation. On entry,
+      gradients[i] holds the partial derivatives of the function with
+      respect to the neurons of layer i; on exit, it holds the total
+      derivatives, so that gradients[0] is the gradient with respect
+      to the input.
+    */
+    void backPropagate( Map<unsigned, double *> &gradients, bool useBounds = false ) const;
+
+    /*
+      Estimate how strongly the output layer depends on each neuron,
+      under the linear relaxation given by the current bounds: the
+      sum, over all output neurons, of the absolute coefficient of the
+      neuron in the output's relaxed backward pass. sensitivity maps
+      every layer index to an array with an entry per neuron.
+    */
+    void computeOutputSensitivity( Map<unsigned, double *> &sensitivity ) const;
+
+    /*
+      BaBSR-style scores for splitting on unfixed ReLUs: the output
+      sensitivity of the ReLU, times the intercept -lu / (u - l) of its
+      triangle relaxation, i.e. an estimate of how much splitting it
+      would tighten the output bounds. Only the earliest layer with
+      unfixed ReLUs is scored, as splitting there also tightens the
+      bounds of all later layers. Scores are keyed by the ReLU's
+      output variable. Requires up-to-date layer bounds.
+    */
+    void getReluSplitScores( Map<unsigned, double> &scores ) const;
+
+    /*
+      The output sensitivity of every input variable, as above
+    */
+    void getInputSensitivity( Map<unsigned, double> &sensitivity ) const;
+
     /*
       Bound propagation methods:
 
         - obtainCurrentBounds: make the NLR obtain the current bounds
-          on all variables from the tableau.
+          on all variables from the tableau. Layers whose bounds have
+          changed are marked as dirty. The preprocessor, which runs
+          before the tableau exists, obtains the bounds from the input
+          query instead; this marks all layers as dirty.
 
         - Interval arithmetic: compute the bounds of a layer's neurons
           based on the concrete bounds of the previous layer.
@@ -84,11 +139,14 @@ public:
           expressions and obtain tighter bounds (e.g., if the upper
           bound on the upper bound of a ReLU node is negative, that
           ReLU is inactive and its output can be set to 0.
+          Propagation is incremental: only dirty layers and the
+          layers downstream from them are recomputed.
 
         - LP Relaxation: invoking an LP solver on a series of LP
           relaxations of the problem we're trying to solve, and
           optimizing the lower and upper bounds of each of the
-          varibales.
+          varibales. The LP solver is Gurobi if it is available, or
+          the built-in simplex otherwise.
 
         - receiveTighterBound: this is a callback from the layer
           objects, through which they report tighter bounds.
@@ -102,6 +160,7 @@ public:
     const ITableau *getTableau() const;
 
     void obtainCurrentBounds();
+    void obtainCurrentBounds( const InputQuery &inputQuery );
     void intervalArithmeticBoundPropagation();
     void symbolicBoundPropagation();
     void lpRelaxationPropagation();
@@ -110,6 +169,15 @@ public:
     void receiveTighterBound( Tightening tightening );
     void getConstraintTightenings( List<Tightening> &tightenings );
 
+    /*
+      Perform the matrix products of symbolic bound tightening in
+      single precision. This roughly doubles their throughput; the
+      rounding errors are bounded and added to the symbolic biases, so
+      that the results remain sound.
+    */
+    void useSinglePrecisionSymbolicBounds( bool singlePrecision );
+    bool singlePrecisionSymbolicBoundsInUse() const;
+
     /*
       For debugging purposes: dump the network topology
     */
@@ -120,6 +188,21 @@ public:
     */
     void storeIntoOther( NetworkLevelReasoner &other ) const;
 
+    /*
+      Let duplicates of this reasoner share its layers' weights rather
+      than copy them. The weights must not change afterwards, and this
+      reasoner must outlive its duplicates.
+    */
+    void shareWeightsWithCopies();
+
+    /*
+      Store/restore the results of symbolic bound propagation, so
+      that they can be reused after backtracking. These are invoked
+      by the engine whenever it stores/restores its own state.
+    */
+    void storeState( NetworkLevelReasonerState &state ) const;
+    void restoreState( const NetworkLevelReasonerState &state );
+
     /*
       Methods that are typically invoked by the preprocessor, to
       inform us of changes in variable indices or if a variable has
@@ -136,6 +219,13 @@ public:
     List<PiecewiseLinearConstraint *> getConstraintsInTopologicalOrder();
     void addConstraintInTopologicalOrder( PiecewiseLinearConstraint *constraint );
 
+    /*
+      Replace the constraints with their counterparts, e.g. after the
+      reasoner was duplicated along with the constraints
+    */
+    void updateConstraintsInTopologicalOrder( const Map<PiecewiseLinearConstraint *,
+                                              PiecewiseLinearConstraint *> &constraintToNewConstraint );
+
 private:
     Map<unsigned, Layer *> _layerIndexToLayer;
     const ITableau *_tableau;
@@ -143,6 +233,16 @@ private:
     // Tightenings discovered by the various layers
     List<Tightening> _boundTightenings;
 
+    /*
+      Layers whose bounds have changed since the last symbolic bound
+      propagation. Any change to the network itself invalidates the
+      results for all layers.
+    */
+    Set<unsigned> _dirtyLayers;
+    bool _allLayersDirty;
+
+    bool _singlePrecisionSymbolicBounds;
+
     void freeMemoryIfNeeded();
 
     List<PiecewiseLinearConstraint *> _constraintsInTopologicalOrder;
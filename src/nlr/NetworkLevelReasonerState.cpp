@@ -0,0 +1,50 @@
+/*********************                                                        */
+/*! \file NetworkLevelReasonerState.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#include "NetworkLevelReasonerState.h"
+
+namespace NLR {
+
+NetworkLevelReasonerState::NetworkLevelReasonerState()
+    : _stateIsStored( false )
+    , _allLayersDirty( true )
+{
+}
+
+NetworkLevelReasonerState::~NetworkLevelReasonerState()
+{
+    freeMemoryIfNeeded();
+}
+
+void NetworkLevelReasonerState::freeMemoryIfNeeded()
+{
+    for ( auto &layerState : _layerStates )
+        delete layerState.second;
+    _layerStates.clear();
+
+    _dirtyLayers.clear();
+    _allLayersDirty = true;
+    _stateIsStored = false;
+}
+
+} // namespace NLR
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,66 @@
+/*********************                                                        */
+/*! \file NetworkLevelReasonerState.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#ifndef __NetworkLevelReasonerState_h__
+#define __NetworkLevelReasonerState_h__
+
+#include "LayerState.h"
+#include "Map.h"
+#include "Set.h"
+
+namespace NLR {
+
+/*
+  The results of the most recent symbolic bound propagation, together
+  with the set of layers whose bounds have changed since. The engine
+  stores this alongside its own state whenever the SMT core pushes a
+  new split, so that after backtracking the propagation can resume
+  incrementally instead of starting over.
+*/
+class NetworkLevelReasonerState
+{
+public:
+    NetworkLevelReasonerState();
+    ~NetworkLevelReasonerState();
+
+    void freeMemoryIfNeeded();
+
+    /*
+      False if nothing was stored, in which case restoring this state
+      forces a full propagation.
+    */
+    bool _stateIsStored;
+
+    bool _allLayersDirty;
+    Set<unsigned> _dirtyLayers;
+    Map<unsigned, LayerState *> _layerStates;
+
+private:
+    // Disallow copying
+    NetworkLevelReasonerState( const NetworkLevelReasonerState & );
+    NetworkLevelReasonerState &operator=( const NetworkLevelReasonerState & );
+};
+
+} // namespace NLR
+
+#endif // __NetworkLevelReasonerState_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,30 @@
+'''
+Save the query of an ONNX network, with every input bounded in
+[-bound, bound], so that it can be loaded by the benchmark:
+
+    python export_onnx_query.py ../../../resources/onnx/fc1.onnx fc1.query
+    ./nlr_benchmark fc1.query
+'''
+
+import sys
+
+from maraboupy import Marabou
+
+
+def main():
+    if len(sys.argv) < 3:
+        print("Usage: %s <network.onnx> <query file> [bound]" % sys.argv[0])
+        sys.exit(1)
+
+    bound = float(sys.argv[3]) if len(sys.argv) > 3 else 1.0
+
+    network = Marabou.read_onnx(sys.argv[1])
+    for var in network.inputVars[0].flatten():
+        network.setLowerBound(var, -bound)
+        network.setUpperBound(var, bound)
+
+    network.saveQuery(sys.argv[2])
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,111 @@
+/*********************                                                        */
+/*! \file main.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** A microbenchmark for the interval arithmetic bound propagation of
+ ** the network level reasoner. The network is either an ACAS Xu style
+ ** .nnet file, or a query file saved by maraboupy (see
+ ** export_onnx_query.py for the ONNX networks in resources/onnx).
+
+ **/
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "AcasParser.h"
+#include "InputQuery.h"
+#include "MString.h"
+#include "MarabouError.h"
+#include "NetworkLevelReasoner.h"
+#include "QueryLoader.h"
+#include "Tableau.h"
+#include "TimeUtils.h"
+
+int main( int argc, char **argv )
+{
+    if ( argc < 2 )
+    {
+        printf( "Usage: %s <network.nnet | query file> [iterations]\n", argv[0] );
+        return 1;
+    }
+
+    String path = argv[1];
+    unsigned iterations = argc > 2 ? atoi( argv[2] ) : 10000;
+
+    try
+    {
+        InputQuery inputQuery;
+        if ( path.contains( ".nnet" ) )
+        {
+            AcasParser acasParser( path );
+            acasParser.generateQuery( inputQuery );
+        }
+        else
+        {
+            inputQuery = QueryLoader::loadQuery( path );
+        }
+
+        if ( !inputQuery.constructNetworkLevelReasoner() )
+        {
+            printf( "Could not construct a network level reasoner for %s\n", path.ascii() );
+            return 1;
+        }
+
+        // The layers read their initial bounds from the tableau
+        unsigned n = inputQuery.getNumberOfVariables();
+        Tableau tableau;
+        tableau.setDimensions( 1, n );
+        for ( unsigned i = 0; i < n; ++i )
+        {
+            tableau.setLowerBound( i, inputQuery.getLowerBound( i ) );
+            tableau.setUpperBound( i, inputQuery.getUpperBound( i ) );
+        }
+
+        NLR::NetworkLevelReasoner *nlr = inputQuery.getNetworkLevelReasoner();
+        nlr->setTableau( &tableau );
+
+        unsigned neurons = 0;
+        for ( unsigned i = 0; i < nlr->getNumberOfLayers(); ++i )
+            neurons += nlr->getLayer( i )->getSize();
+
+        unsigned long long total = 0;
+        List<Tightening> tightenings;
+        for ( unsigned i = 0; i < iterations; ++i )
+        {
+            nlr->obtainCurrentBounds();
+
+            struct timespec start = TimeUtils::sampleMicro();
+            nlr->intervalArithmeticBoundPropagation();
+            total += TimeUtils::timePassed( start, TimeUtils::sampleMicro() );
+
+            nlr->getConstraintTightenings( tightenings );
+        }
+
+        printf( "%s: %u layers, %u neurons, %u tightenings per pass\n",
+                path.ascii(), nlr->getNumberOfLayers(), neurons, tightenings.size() );
+        printf( "Interval arithmetic: %u passes, %.3f micro per pass\n",
+                iterations, iterations > 0 ? (double)total / iterations : 0 );
+    }
+    catch ( const MarabouError &e )
+    {
+        printf( "Caught a MarabouError. Code: %u. Message: %s\n", e.getCode(), e.getUserMessage() );
+        return 1;
+    }
+
+    return 0;
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -17,6 +17,7 @@
 
 #include "FloatUtils.h"
 #include "../../engine/tests/MockTableau.h" // TODO: fix this
+#include "LPFormulator.h"
 #include "NetworkLevelReasoner.h"
 #include "Tightening.h"
 #include "Layer.h"
@@ -150,6 +151,83 @@ public:
         TS_ASSERT( FloatUtils::areEqual( output[1], 0 ) );
     }
 
+    void test_back_propagate_relus()
+    {
+        NLR::NetworkLevelReasoner nlr;
+
+        populateNetwork( nlr );
+
+        double input[2] = { 1, -1 };
+        double output[2];
+        nlr.evaluate( input, output );
+
+        // Gradient of g: both ReLUs in the last hidden layer are active,
+        // and so are a and b
+        Map<unsigned, double *> gradients;
+        for ( unsigned i = 0; i < nlr.getNumberOfLayers(); ++i )
+        {
+            unsigned size = nlr.getLayer( i )->getSize();
+            gradients[i] = new double[size];
+            std::fill_n( gradients[i], size, 0 );
+        }
+        gradients[5][1] = 1;
+
+        nlr.backPropagate( gradients );
+
+        TS_ASSERT( FloatUtils::areEqual( gradients[4][0], 1 ) );
+        TS_ASSERT( FloatUtils::areEqual( gradients[4][1], 3 ) );
+        TS_ASSERT( FloatUtils::areEqual( gradients[2][0], -2 ) );
+        TS_ASSERT( FloatUtils::areEqual( gradients[2][1], 4 ) );
+        TS_ASSERT( FloatUtils::areEqual( gradients[2][2], -4 ) );
+        TS_ASSERT( FloatUtils::areEqual( gradients[1][2], 0 ) );
+        TS_ASSERT( FloatUtils::areEqual( gradients[0][0], 6 ) );
+        TS_ASSERT( FloatUtils::areEqual( gradients[0][1], -12 ) );
+
+        for ( const auto &gradient : gradients )
+            delete[] gradient.second;
+    }
+
+    void test_relu_split_scores()
+    {
+        NLR::NetworkLevelReasoner nlr;
+        MockTableau tableau;
+        nlr.setTableau( &tableau );
+        populateNetworkSBT( nlr, tableau );
+
+        tableau.setLowerBound( 0, -1 ); tableau.setUpperBound( 0, 1 );
+        tableau.setLowerBound( 1, -1 ); tableau.setUpperBound( 1, 1 );
+
+        // x2 is unstable, x3 is active
+        tableau.setLowerBound( 2, -2 ); tableau.setUpperBound( 2, 6 );
+        tableau.setLowerBound( 3, 1 ); tableau.setUpperBound( 3, 3 );
+        tableau.setLowerBound( 4, 0 ); tableau.setUpperBound( 4, 6 );
+        tableau.setLowerBound( 5, 1 ); tableau.setUpperBound( 5, 3 );
+
+        TS_ASSERT_THROWS_NOTHING( nlr.obtainCurrentBounds() );
+
+        /*
+          Relaxed backward pass from x6 = x4 - x5:
+
+            x4: 1, x5: -1
+            x2: 1 * 6 / ( 6 + 2 ) = 0.75, x3: -1
+            x0: 2 * 0.75 - 1 = 0.5, x1: 3 * 0.75 - 1 = 1.25
+        */
+        Map<unsigned, double> inputSensitivity;
+        nlr.getInputSensitivity( inputSensitivity );
+
+        TS_ASSERT_EQUALS( inputSensitivity.size(), 2U );
+        TS_ASSERT( FloatUtils::areEqual( inputSensitivity[0], 0.5 ) );
+        TS_ASSERT( FloatUtils::areEqual( inputSensitivity[1], 1.25 ) );
+
+        // Only the unstable ReLU is scored: 1 * ( 2 * 6 ) / ( 6 + 2 )
+        Map<unsigned, double> scores;
+        nlr.getReluSplitScores( scores );
+
+        TS_ASSERT_EQUALS( scores.size(), 1U );
+        TS_ASSERT( scores.exists( 4 ) );
+        TS_ASSERT( FloatUtils::areEqual( scores[4], 1.5 ) );
+    }
+
     void test_evaluate_non_consecutive_layers()
     {
         NLR::NetworkLevelReasoner nlr;
@@ -321,6 +399,57 @@ public:
         TS_ASSERT( FloatUtils::areEqual( output1[0], output2[0] ) );
         TS_ASSERT( FloatUtils::areEqual( output1[1], output2[1] ) );
     }
+    void test_store_into_other_with_shared_weights()
+    {
+        NLR::NetworkLevelReasoner nlr;
+
+        populateNetwork( nlr );
+        nlr.shareWeightsWithCopies();
+
+        NLR::NetworkLevelReasoner nlr2;
+
+        TS_ASSERT_THROWS_NOTHING( nlr.storeIntoOther( nlr2 ) );
+
+        TS_ASSERT( !nlr.getLayer( 1 )->weightsShared() );
+        TS_ASSERT( nlr2.getLayer( 1 )->weightsShared() );
+        TS_ASSERT( nlr2.getLayer( 3 )->weightsShared() );
+
+        double input[2];
+        double output1[2];
+        double output2[2];
+
+        input[0] = 1;
+        input[1] = 1;
+
+        TS_ASSERT_THROWS_NOTHING( nlr.evaluate( input, output1 ) );
+        TS_ASSERT_THROWS_NOTHING( nlr2.evaluate( input, output2 ) );
+
+        TS_ASSERT( FloatUtils::areEqual( output1[0], output2[0] ) );
+        TS_ASSERT( FloatUtils::areEqual( output1[1], output2[1] ) );
+
+        // Copies of a copy share the weights as well
+        NLR::NetworkLevelReasoner nlr3;
+        TS_ASSERT_THROWS_NOTHING( nlr2.storeIntoOther( nlr3 ) );
+        TS_ASSERT( nlr3.getLayer( 1 )->weightsShared() );
+
+        // Changing the weights of a copy does not affect the original
+        nlr2.setWeight( 4, 0, 5, 0, 10 );
+        nlr2.setBias( 5, 0, 1 );
+        TS_ASSERT( !nlr2.getLayer( 5 )->weightsShared() );
+        TS_ASSERT( nlr3.getLayer( 5 )->weightsShared() );
+
+        TS_ASSERT_EQUALS( nlr.getLayer( 5 )->getWeight( 4, 0, 0 ), 1 );
+        TS_ASSERT_EQUALS( nlr.getLayer( 5 )->getBias( 0 ), 0 );
+        TS_ASSERT_EQUALS( nlr2.getLayer( 5 )->getWeight( 4, 0, 0 ), 10 );
+        TS_ASSERT_EQUALS( nlr2.getLayer( 5 )->getBias( 0 ), 1 );
+
+        TS_ASSERT_THROWS_NOTHING( nlr.evaluate( input, output1 ) );
+        TS_ASSERT_THROWS_NOTHING( nlr3.evaluate( input, output2 ) );
+
+        TS_ASSERT( FloatUtils::areEqual( output1[0], output2[0] ) );
+        TS_ASSERT( FloatUtils::areEqual( output1[1], output2[1] ) );
+    }
+
 
     void test_interval_arithmetic_bound_propagation_relu_constraints()
     {
@@ -1488,4 +1617,833 @@ public:
         for ( const auto &bound : bounds )
             TS_ASSERT( expectedBounds.exists( bound ) );
     }
+
+    void applyTightenings( MockTableau &tableau, const List<Tightening> &tightenings )
+    {
+        for ( const auto &tightening : tightenings )
+        {
+            if ( tightening._type == Tightening::LB )
+                tableau.setLowerBound( tightening._variable, tightening._value );
+            else
+                tableau.setUpperBound( tightening._variable, tightening._value );
+        }
+    }
+
+    void populateNetworkWithMaxAndSign( NLR::NetworkLevelReasoner &nlr )
+    {
+        /*
+              x2 = x0 + x1
+              x3 = x0 - x1
+              x4 = -x0
+
+              x5 = max( x2, x3 )
+              x6 = max( x3, x4 )
+
+              x7 = x5 - x6
+              x8 = x6 + 1
+
+              x9 = sign( x7 )
+              x10 = sign( x8 )
+        */
+
+        // Create the layers
+        nlr.addLayer( 0, NLR::Layer::INPUT, 2 );
+        nlr.addLayer( 1, NLR::Layer::WEIGHTED_SUM, 3 );
+        nlr.addLayer( 2, NLR::Layer::MAX, 2 );
+        nlr.addLayer( 3, NLR::Layer::WEIGHTED_SUM, 2 );
+        nlr.addLayer( 4, NLR::Layer::SIGN, 2 );
+
+        // Mark layer dependencies
+        for ( unsigned i = 1; i <= 4; ++i )
+            nlr.addLayerDependency( i - 1, i );
+
+        // Set the weights and biases for the weighted sum layers
+        nlr.setWeight( 0, 0, 1, 0, 1 );
+        nlr.setWeight( 0, 1, 1, 0, 1 );
+        nlr.setWeight( 0, 0, 1, 1, 1 );
+        nlr.setWeight( 0, 1, 1, 1, -1 );
+        nlr.setWeight( 0, 0, 1, 2, -1 );
+
+        nlr.setWeight( 2, 0, 3, 0, 1 );
+        nlr.setWeight( 2, 1, 3, 0, -1 );
+        nlr.setWeight( 2, 1, 3, 1, 1 );
+
+        nlr.setBias( 3, 1, 1 );
+
+        // Mark the Max/Sign sources
+        nlr.addActivationSource( 1, 0, 2, 0 );
+        nlr.addActivationSource( 1, 1, 2, 0 );
+        nlr.addActivationSource( 1, 1, 2, 1 );
+        nlr.addActivationSource( 1, 2, 2, 1 );
+
+        nlr.addActivationSource( 3, 0, 4, 0 );
+        nlr.addActivationSource( 3, 1, 4, 1 );
+
+        // Variable indexing
+        nlr.setNeuronVariable( NLR::NeuronIndex( 0, 0 ), 0 );
+        nlr.setNeuronVariable( NLR::NeuronIndex( 0, 1 ), 1 );
+
+        nlr.setNeuronVariable( NLR::NeuronIndex( 1, 0 ), 2 );
+        nlr.setNeuronVariable( NLR::NeuronIndex( 1, 1 ), 3 );
+        nlr.setNeuronVariable( NLR::NeuronIndex( 1, 2 ), 4 );
+
+        nlr.setNeuronVariable( NLR::NeuronIndex( 2, 0 ), 5 );
+        nlr.setNeuronVariable( NLR::NeuronIndex( 2, 1 ), 6 );
+
+        nlr.setNeuronVariable( NLR::NeuronIndex( 3, 0 ), 7 );
+        nlr.setNeuronVariable( NLR::NeuronIndex( 3, 1 ), 8 );
+
+        nlr.setNeuronVariable( NLR::NeuronIndex( 4, 0 ), 9 );
+        nlr.setNeuronVariable( NLR::NeuronIndex( 4, 1 ), 10 );
+    }
+
+    void setBoundsForMaxAndSign( MockTableau &tableau )
+    {
+        // x0 in [1, 2], x1 in [-1, 1]
+        tableau.setLowerBound( 0, 1 );
+        tableau.setUpperBound( 0, 2 );
+        tableau.setLowerBound( 1, -1 );
+        tableau.setUpperBound( 1, 1 );
+
+        double large = 1000;
+        for ( unsigned i = 2; i <= 10; ++i )
+        {
+            tableau.setLowerBound( i, -large );
+            tableau.setUpperBound( i, large );
+        }
+    }
+
+    void test_evaluate_max_and_sign()
+    {
+        NLR::NetworkLevelReasoner nlr;
+        populateNetworkWithMaxAndSign( nlr );
+
+        double input[2];
+        double output[2];
+
+        // x2..x4 = 3, -1, -1; x5, x6 = 3, -1; x7, x8 = 4, 0
+        input[0] = 1;
+        input[1] = 2;
+
+        TS_ASSERT_THROWS_NOTHING( nlr.evaluate( input, output ) );
+
+        TS_ASSERT( FloatUtils::areEqual( output[0], 1 ) );
+        TS_ASSERT( FloatUtils::areEqual( output[1], 1 ) );
+
+        // x2..x4 = -2, -2, 2; x5, x6 = -2, 2; x7, x8 = -4, 3
+        input[0] = -2;
+        input[1] = 0;
+
+        TS_ASSERT_THROWS_NOTHING( nlr.evaluate( input, output ) );
+
+        TS_ASSERT( FloatUtils::areEqual( output[0], -1 ) );
+        TS_ASSERT( FloatUtils::areEqual( output[1], 1 ) );
+    }
+
+    void test_interval_arithmetic_bound_propagation_max_and_sign()
+    {
+        NLR::NetworkLevelReasoner nlr;
+        MockTableau tableau;
+        nlr.setTableau( &tableau );
+        populateNetworkWithMaxAndSign( nlr );
+        setBoundsForMaxAndSign( tableau );
+
+        TS_ASSERT_THROWS_NOTHING( nlr.obtainCurrentBounds() );
+        TS_ASSERT_THROWS_NOTHING( nlr.intervalArithmeticBoundPropagation() );
+
+        /*
+          x2: [0, 3], x3: [0, 3], x4: [-2, -1]
+          x5: [0, 3], x6: [0, 3]
+          x7: [-3, 3], x8: [1, 4]
+          x9: [-1, 1], x10: [1, 1]
+        */
+        List<Tightening> expectedBounds({
+                Tightening( 2, 0, Tightening::LB ),
+                Tightening( 2, 3, Tightening::UB ),
+                Tightening( 3, 0, Tightening::LB ),
+                Tightening( 3, 3, Tightening::UB ),
+                Tightening( 4, -2, Tightening::LB ),
+                Tightening( 4, -1, Tightening::UB ),
+
+                Tightening( 5, 0, Tightening::LB ),
+                Tightening( 5, 3, Tightening::UB ),
+                Tightening( 6, 0, Tightening::LB ),
+                Tightening( 6, 3, Tightening::UB ),
+
+                Tightening( 7, -3, Tightening::LB ),
+                Tightening( 7, 3, Tightening::UB ),
+                Tightening( 8, 1, Tightening::LB ),
+                Tightening( 8, 4, Tightening::UB ),
+
+                Tightening( 9, -1, Tightening::LB ),
+                Tightening( 9, 1, Tightening::UB ),
+                Tightening( 10, 1, Tightening::LB ),
+                Tightening( 10, 1, Tightening::UB ),
+                    });
+
+        List<Tightening> bounds;
+        TS_ASSERT_THROWS_NOTHING( nlr.getConstraintTightenings( bounds ) );
+
+        TS_ASSERT_EQUALS( expectedBounds.size(), bounds.size() );
+        for ( const auto &bound : bounds )
+            TS_ASSERT( expectedBounds.exists( bound ) );
+    }
+
+    void test_sbt_max_and_sign()
+    {
+        if ( !GlobalConfiguration::USE_SYMBOLIC_BOUND_TIGHTENING )
+            return;
+
+        NLR::NetworkLevelReasoner nlr;
+        MockTableau tableau;
+        nlr.setTableau( &tableau );
+        populateNetworkWithMaxAndSign( nlr );
+        setBoundsForMaxAndSign( tableau );
+
+        TS_ASSERT_THROWS_NOTHING( nlr.obtainCurrentBounds() );
+        TS_ASSERT_THROWS_NOTHING( nlr.symbolicBoundPropagation() );
+
+        /*
+          Layer 1:
+
+          x2 = x0 + x1   : [0, 3]
+          x3 = x0 - x1   : [0, 3]
+          x4 = -x0       : [-2, -1]
+
+          Max layer:
+
+          x5: x2 has the largest lower bound, but x3 may exceed it.
+          x5.lb = x0 + x1   : [0, 3]
+          x5.ub = 3         : [3, 3]
+
+          x6: x3 dominates x4, so x6 = x3.
+          x6.lb = x0 - x1   : [0, 3]
+          x6.ub = x0 - x1   : [0, 3]
+
+          Layer 3:
+
+          x7.lb = x5.lb - x6.ub = 2x1          : [-2, 2]
+          x7.ub = x5.ub - x6.lb = 3 - x0 + x1  : [0, 3]
+
+          x8.lb = x0 - x1 + 1  : [1, 4]
+          x8.ub = x0 - x1 + 1  : [1, 4]
+
+          Sign layer:
+
+          x9: x7 in [-2, 3], not fixed.
+          x9.lb = -1 + 2/3 * 2x1             : [-7/3, 1/3], clipped to [-1, 1/3]
+          x9.ub =  1 + ( 3 - x0 + x1 )       : [1, 4], clipped to [1, 1]
+
+          x10: x8 is positive, so x10 = 1.
+        */
+        List<Tightening> expectedBounds({
+                Tightening( 2, 0, Tightening::LB ),
+                Tightening( 2, 3, Tightening::UB ),
+                Tightening( 3, 0, Tightening::LB ),
+                Tightening( 3, 3, Tightening::UB ),
+                Tightening( 4, -2, Tightening::LB ),
+                Tightening( 4, -1, Tightening::UB ),
+
+                Tightening( 5, 0, Tightening::LB ),
+                Tightening( 5, 3, Tightening::UB ),
+                Tightening( 6, 0, Tightening::LB ),
+                Tightening( 6, 3, Tightening::UB ),
+
+                Tightening( 7, -2, Tightening::LB ),
+                Tightening( 7, 3, Tightening::UB ),
+                Tightening( 8, 1, Tightening::LB ),
+                Tightening( 8, 4, Tightening::UB ),
+
+                Tightening( 9, -1, Tightening::LB ),
+                Tightening( 9, 1, Tightening::UB ),
+                Tightening( 10, 1, Tightening::LB ),
+                Tightening( 10, 1, Tightening::UB ),
+                    });
+
+        List<Tightening> bounds;
+        TS_ASSERT_THROWS_NOTHING( nlr.getConstraintTightenings( bounds ) );
+
+        TS_ASSERT_EQUALS( expectedBounds.size(), bounds.size() );
+        for ( const auto &bound : bounds )
+            TS_ASSERT( expectedBounds.exists( bound ) );
+    }
+
+    void populateNetworkForPrecisionTest( NLR::NetworkLevelReasoner &nlr, MockTableau &tableau )
+    {
+        // Create the layers
+        nlr.addLayer( 0, NLR::Layer::INPUT, 3 );
+        nlr.addLayer( 1, NLR::Layer::WEIGHTED_SUM, 4 );
+        nlr.addLayer( 2, NLR::Layer::RELU, 4 );
+        nlr.addLayer( 3, NLR::Layer::WEIGHTED_SUM, 2 );
+
+        // Mark layer dependencies
+        for ( unsigned i = 1; i <= 3; ++i )
+            nlr.addLayerDependency( i - 1, i );
+
+        // Weights and biases that are not representable in floating point
+        for ( unsigned i = 0; i < 3; ++i )
+            for ( unsigned j = 0; j < 4; ++j )
+                nlr.setWeight( 0, i, 1, j, 0.1 * ( i + 1 ) - 0.37 * j + 1.0 / 3 );
+
+        for ( unsigned i = 0; i < 4; ++i )
+        {
+            nlr.setBias( 1, i, 0.2 - 0.15 * i );
+            nlr.addActivationSource( 1, i, 2, i );
+
+            for ( unsigned j = 0; j < 2; ++j )
+                nlr.setWeight( 2, i, 3, j, ( i % 2 == j ? 1.7 : -0.9 ) / ( i + 1 ) );
+        }
+
+        nlr.setBias( 3, 0, 1.0 / 7 );
+        nlr.setBias( 3, 1, -0.3 );
+
+        // Variable indexing
+        unsigned variable = 0;
+        for ( unsigned layer = 0; layer < 4; ++layer )
+            for ( unsigned neuron = 0; neuron < nlr.getLayer( layer )->getSize(); ++neuron )
+                nlr.setNeuronVariable( NLR::NeuronIndex( layer, neuron ), variable++ );
+
+        tableau.setLowerBound( 0, -1 );
+        tableau.setUpperBound( 0, 1 );
+        tableau.setLowerBound( 1, 0.1 );
+        tableau.setUpperBound( 1, 0.7 );
+        tableau.setLowerBound( 2, -0.3 );
+        tableau.setUpperBound( 2, 0.9 );
+
+        double large = 1000;
+        for ( unsigned i = 3; i < variable; ++i )
+        {
+            tableau.setLowerBound( i, -large );
+            tableau.setUpperBound( i, large );
+        }
+
+        nlr.setTableau( &tableau );
+    }
+
+    void test_sbt_single_precision()
+    {
+        if ( !GlobalConfiguration::USE_SYMBOLIC_BOUND_TIGHTENING )
+            return;
+
+        NLR::NetworkLevelReasoner doubleNlr;
+        MockTableau doubleTableau;
+        populateNetworkForPrecisionTest( doubleNlr, doubleTableau );
+
+        NLR::NetworkLevelReasoner singleNlr;
+        MockTableau singleTableau;
+        populateNetworkForPrecisionTest( singleNlr, singleTableau );
+        singleNlr.useSinglePrecisionSymbolicBounds( true );
+        TS_ASSERT( singleNlr.singlePrecisionSymbolicBoundsInUse() );
+
+        TS_ASSERT_THROWS_NOTHING( doubleNlr.obtainCurrentBounds() );
+        TS_ASSERT_THROWS_NOTHING( doubleNlr.symbolicBoundPropagation() );
+        TS_ASSERT_THROWS_NOTHING( singleNlr.obtainCurrentBounds() );
+        TS_ASSERT_THROWS_NOTHING( singleNlr.symbolicBoundPropagation() );
+
+        /*
+          The single precision bounds may only be looser than the
+          double precision ones, and only slightly
+        */
+        for ( unsigned layer = 1; layer < 4; ++layer )
+        {
+            for ( unsigned neuron = 0; neuron < doubleNlr.getLayer( layer )->getSize(); ++neuron )
+            {
+                double doubleLb = doubleNlr.getLayer( layer )->getLb( neuron );
+                double doubleUb = doubleNlr.getLayer( layer )->getUb( neuron );
+                double singleLb = singleNlr.getLayer( layer )->getLb( neuron );
+                double singleUb = singleNlr.getLayer( layer )->getUb( neuron );
+
+                TS_ASSERT_LESS_THAN_EQUALS( singleLb, doubleLb );
+                TS_ASSERT_LESS_THAN_EQUALS( doubleUb, singleUb );
+                TS_ASSERT_LESS_THAN( doubleLb - singleLb, 0.0001 );
+                TS_ASSERT_LESS_THAN( singleUb - doubleUb, 0.0001 );
+            }
+        }
+
+        // The bounds contain the outputs for a grid of inputs
+        const NLR::Layer *outputLayer = singleNlr.getLayer( 3 );
+        double input[3];
+        double output[2];
+        for ( unsigned i = 0; i <= 4; ++i )
+        {
+            for ( unsigned j = 0; j <= 4; ++j )
+            {
+                for ( unsigned k = 0; k <= 4; ++k )
+                {
+                    input[0] = -1 + 0.5 * i;
+                    input[1] = 0.1 + 0.15 * j;
+                    input[2] = -0.3 + 0.3 * k;
+
+                    TS_ASSERT_THROWS_NOTHING( singleNlr.evaluate( input, output ) );
+
+                    for ( unsigned neuron = 0; neuron < 2; ++neuron )
+                    {
+                        TS_ASSERT_LESS_THAN_EQUALS( outputLayer->getLb( neuron ), output[neuron] );
+                        TS_ASSERT_LESS_THAN_EQUALS( output[neuron], outputLayer->getUb( neuron ) );
+                    }
+                }
+            }
+        }
+    }
+
+    void test_sbt_incremental()
+    {
+        if ( !GlobalConfiguration::USE_SYMBOLIC_BOUND_TIGHTENING )
+            return;
+
+        NLR::NetworkLevelReasoner nlr;
+        MockTableau tableau;
+        nlr.setTableau( &tableau );
+        populateNetworkSBT( nlr, tableau );
+
+        tableau.setLowerBound( 0, 4 );
+        tableau.setUpperBound( 0, 6 );
+        tableau.setLowerBound( 1, 1 );
+        tableau.setUpperBound( 1, 5 );
+
+        // First invocation: everything is computed
+        TS_ASSERT_THROWS_NOTHING( nlr.obtainCurrentBounds() );
+        TS_ASSERT_THROWS_NOTHING( nlr.symbolicBoundPropagation() );
+
+        List<Tightening> bounds;
+        TS_ASSERT_THROWS_NOTHING( nlr.getConstraintTightenings( bounds ) );
+        TS_ASSERT_EQUALS( bounds.size(), 10U );
+        applyTightenings( tableau, bounds );
+
+        // Nothing has changed, so nothing is recomputed and nothing new is learned
+        TS_ASSERT_THROWS_NOTHING( nlr.obtainCurrentBounds() );
+        TS_ASSERT_THROWS_NOTHING( nlr.symbolicBoundPropagation() );
+        TS_ASSERT_THROWS_NOTHING( nlr.getConstraintTightenings( bounds ) );
+        TS_ASSERT( bounds.empty() );
+
+        NLR::NetworkLevelReasonerState state;
+        TS_ASSERT_THROWS_NOTHING( nlr.storeState( state ) );
+
+        /*
+          Tighten x0 to [4, 5]. The input layer is dirty, and so is
+          everything downstream of it:
+
+          x2: [11, 25]
+          x3: [5, 10]
+          x4: [11, 25]
+          x5: [5, 10]
+          x6: [6, 15]
+        */
+        tableau.setUpperBound( 0, 5 );
+
+        TS_ASSERT_THROWS_NOTHING( nlr.obtainCurrentBounds() );
+        TS_ASSERT_THROWS_NOTHING( nlr.symbolicBoundPropagation() );
+
+        List<Tightening> expectedBounds({
+                Tightening( 2, 25, Tightening::UB ),
+                Tightening( 3, 10, Tightening::UB ),
+                Tightening( 4, 25, Tightening::UB ),
+                Tightening( 5, 10, Tightening::UB ),
+                Tightening( 6, 15, Tightening::UB ),
+                    });
+
+        TS_ASSERT_THROWS_NOTHING( nlr.getConstraintTightenings( bounds ) );
+        TS_ASSERT_EQUALS( expectedBounds.size(), bounds.size() );
+        for ( const auto &bound : expectedBounds )
+            TS_ASSERT( bounds.exists( bound ) );
+        applyTightenings( tableau, bounds );
+
+        /*
+          Tighten x4, a ReLU output, to [12, 25]. Only layers 2 and 3
+          are recomputed; x6 inherits its bounds symbolically from
+          the inputs, so nothing new is discovered.
+        */
+        tableau.setLowerBound( 4, 12 );
+
+        TS_ASSERT_THROWS_NOTHING( nlr.obtainCurrentBounds() );
+        TS_ASSERT_THROWS_NOTHING( nlr.symbolicBoundPropagation() );
+        TS_ASSERT_THROWS_NOTHING( nlr.getConstraintTightenings( bounds ) );
+        TS_ASSERT( bounds.empty() );
+        TS_ASSERT( FloatUtils::areEqual( nlr.getLayer( 2 )->getLb( 0 ), 12 ) );
+
+        // Backtrack: restore the stored results and the matching tableau bounds
+        tableau.setUpperBound( 0, 6 );
+        tableau.setUpperBound( 2, 27 );
+        tableau.setUpperBound( 3, 11 );
+        tableau.setLowerBound( 4, 11 );
+        tableau.setUpperBound( 4, 27 );
+        tableau.setUpperBound( 5, 11 );
+        tableau.setUpperBound( 6, 16 );
+
+        TS_ASSERT_THROWS_NOTHING( nlr.restoreState( state ) );
+        TS_ASSERT( FloatUtils::areEqual( nlr.getLayer( 3 )->getUb( 0 ), 16 ) );
+
+        TS_ASSERT_THROWS_NOTHING( nlr.obtainCurrentBounds() );
+        TS_ASSERT_THROWS_NOTHING( nlr.symbolicBoundPropagation() );
+        TS_ASSERT_THROWS_NOTHING( nlr.getConstraintTightenings( bounds ) );
+        TS_ASSERT( bounds.empty() );
+
+        // Loosening a bound without restoring forces a recomputation
+        tableau.setUpperBound( 6, 20 );
+
+        TS_ASSERT_THROWS_NOTHING( nlr.obtainCurrentBounds() );
+        TS_ASSERT_THROWS_NOTHING( nlr.symbolicBoundPropagation() );
+        TS_ASSERT_THROWS_NOTHING( nlr.getConstraintTightenings( bounds ) );
+        TS_ASSERT_EQUALS( bounds.size(), 1U );
+        TS_ASSERT( bounds.exists( Tightening( 6, 16, Tightening::UB ) ) );
+    }
+
+    void populateNetworkForLpRelaxation( NLR::NetworkLevelReasoner &nlr,
+                                         MockTableau &tableau,
+                                         double *lbBefore,
+                                         double *ubBefore )
+    {
+        nlr.setTableau( &tableau );
+        populateNetworkSBT( nlr, tableau );
+
+        tableau.setLowerBound( 0, 4 );
+        tableau.setUpperBound( 0, 6 );
+        tableau.setLowerBound( 1, 1 );
+        tableau.setUpperBound( 1, 5 );
+
+        nlr.setBias( 1, 0, -15 );
+
+        TS_ASSERT_THROWS_NOTHING( nlr.obtainCurrentBounds() );
+        TS_ASSERT_THROWS_NOTHING( nlr.symbolicBoundPropagation() );
+
+        List<Tightening> bounds;
+        TS_ASSERT_THROWS_NOTHING( nlr.getConstraintTightenings( bounds ) );
+
+        // Variable v is neuron v % 2 of layer v / 2
+        for ( unsigned v = 0; v < 7; ++v )
+        {
+            lbBefore[v] = nlr.getLayer( v / 2 )->getLb( v % 2 );
+            ubBefore[v] = nlr.getLayer( v / 2 )->getUb( v % 2 );
+        }
+    }
+
+    void checkLpRelaxationTightenings( NLR::NetworkLevelReasoner &nlr,
+                                       const double *lbBefore,
+                                       const double *ubBefore )
+    {
+        /*
+          SBT gives x6 in [-8, 1] (see test_sbt_relus_active_and_not_fixed).
+
+          The LP relaxation finds the tighter lower bound: with
+          x4 >= max( 0, 2x0 + 3x1 - 15 ) and x5 = x0 + x1, the minimum of
+          x6 = x4 - x5 is -7, attained at x0 = 6, x1 = 1. All other
+          bounds are already optimal.
+        */
+        List<Tightening> bounds;
+        TS_ASSERT_THROWS_NOTHING( nlr.getConstraintTightenings( bounds ) );
+
+        bool found = false;
+        for ( const auto &bound : bounds )
+        {
+            if ( bound._variable == 6 && bound._type == Tightening::LB )
+            {
+                TS_ASSERT( FloatUtils::areEqual( bound._value, -7 ) );
+                found = true;
+            }
+            else
+            {
+                // Only numerical noise on the other bounds
+                double previous = bound._type == Tightening::LB ?
+                    lbBefore[bound._variable] : ubBefore[bound._variable];
+                TS_ASSERT( FloatUtils::areEqual( bound._value, previous ) );
+            }
+        }
+
+        TS_ASSERT( found );
+        TS_ASSERT( FloatUtils::areEqual( nlr.getLayer( 3 )->getLb( 0 ), -7 ) );
+        TS_ASSERT( FloatUtils::areEqual( nlr.getLayer( 3 )->getUb( 0 ), 1 ) );
+    }
+
+    void test_lp_relaxation_propagation()
+    {
+        if ( !GlobalConfiguration::USE_SYMBOLIC_BOUND_TIGHTENING ||
+             GlobalConfiguration::MILP_SOLVER_BOUND_TIGHTENING_TYPE == GlobalConfiguration::NONE )
+            return;
+
+        NLR::NetworkLevelReasoner nlr;
+        MockTableau tableau;
+        double lbBefore[7];
+        double ubBefore[7];
+        populateNetworkForLpRelaxation( nlr, tableau, lbBefore, ubBefore );
+
+        TS_ASSERT_THROWS_NOTHING( nlr.lpRelaxationPropagation() );
+
+        checkLpRelaxationTightenings( nlr, lbBefore, ubBefore );
+    }
+
+    void test_parallel_lp_relaxation_propagation()
+    {
+        if ( !GlobalConfiguration::USE_SYMBOLIC_BOUND_TIGHTENING )
+            return;
+
+        // More workers than neurons per layer, and fewer
+        for ( unsigned numberOfWorkers : { 2, 3 } )
+        {
+            NLR::NetworkLevelReasoner nlr;
+            MockTableau tableau;
+            double lbBefore[7];
+            double ubBefore[7];
+            populateNetworkForLpRelaxation( nlr, tableau, lbBefore, ubBefore );
+
+            Map<unsigned, NLR::Layer *> layers;
+            for ( unsigned i = 0; i < nlr.getNumberOfLayers(); ++i )
+                layers[i] = const_cast<NLR::Layer *>( nlr.getLayer( i ) );
+
+            NLR::LPFormulator lpFormulator( &nlr );
+            lpFormulator.setCutoff( 0 );
+            TS_ASSERT_THROWS_NOTHING(
+                lpFormulator.optimizeBoundsWithParallelLpRelaxation( layers, numberOfWorkers ) );
+
+            checkLpRelaxationTightenings( nlr, lbBefore, ubBefore );
+        }
+    }
+
+    double kernelWeightForConvolutionTest( unsigned outputChannel, unsigned row, unsigned column )
+    {
+        return ( outputChannel == 0 ? 1.0 : -1.0 ) * ( row + 1 ) + 0.5 * column - 0.25;
+    }
+
+    void populateNetworkWithConvolution( NLR::NetworkLevelReasoner &nlr, MockTableau &tableau, bool dense )
+    {
+        /*
+          A single 3x3 input channel, convolved with a 3x3 kernel with
+          stride 2 and padding 1 into two 2x2 output channels. This is
+          followed by a ReLU layer and a weighted sum layer with two
+          outputs. If dense is set, the convolution is encoded as an
+          equivalent weighted sum layer.
+        */
+        NLR::Layer::ConvolutionParameters parameters;
+        parameters._inputChannels = 1;
+        parameters._inputHeight = 3;
+        parameters._inputWidth = 3;
+        parameters._outputChannels = 2;
+        parameters._kernelHeight = 3;
+        parameters._kernelWidth = 3;
+        parameters._stride = 2;
+        parameters._padding = 1;
+
+        // Create the layers
+        nlr.addLayer( 0, NLR::Layer::INPUT, 9 );
+        nlr.addLayer( 1, dense ? NLR::Layer::WEIGHTED_SUM : NLR::Layer::CONVOLUTION, 8 );
+        nlr.addLayer( 2, NLR::Layer::RELU, 8 );
+        nlr.addLayer( 3, NLR::Layer::WEIGHTED_SUM, 2 );
+
+        // Mark layer dependencies
+        for ( unsigned i = 1; i <= 3; ++i )
+            nlr.addLayerDependency( i - 1, i );
+
+        if ( !dense )
+            nlr.setConvolutionParameters( 1, parameters );
+
+        for ( unsigned o = 0; o < 2; ++o )
+        {
+            for ( unsigned y = 0; y < 2; ++y )
+            {
+                for ( unsigned x = 0; x < 2; ++x )
+                {
+                    unsigned neuron = ( o * 2 + y ) * 2 + x;
+                    nlr.setBias( 1, neuron, o == 0 ? 0.5 : -1 );
+
+                    for ( unsigned row = 0; row < 3; ++row )
+                    {
+                        for ( unsigned column = 0; column < 3; ++column )
+                        {
+                            double weight = kernelWeightForConvolutionTest( o, row, column );
+
+                            if ( !dense )
+                            {
+                                if ( y == 0 && x == 0 )
+                                    nlr.setKernelWeight( 1, o, 0, row, column, weight );
+                                continue;
+                            }
+
+                            // Input pixel ( 2y + row - 1, 2x + column - 1 ), if not padding
+                            int inputRow = 2 * y + row - 1;
+                            int inputColumn = 2 * x + column - 1;
+                            if ( inputRow < 0 || inputRow > 2 || inputColumn < 0 || inputColumn > 2 )
+                                continue;
+
+                            nlr.setWeight( 0, inputRow * 3 + inputColumn, 1, neuron, weight );
+                        }
+                    }
+                }
+            }
+        }
+
+        for ( unsigned i = 0; i < 8; ++i )
+        {
+            nlr.addActivationSource( 1, i, 2, i );
+
+            nlr.setWeight( 2, i, 3, 0, 0.5 + 0.1 * i );
+            nlr.setWeight( 2, i, 3, 1, i % 2 == 0 ? -1 : 0.3 );
+        }
+
+        // Variable indexing
+        unsigned variable = 0;
+        for ( unsigned layer = 0; layer < 4; ++layer )
+            for ( unsigned neuron = 0; neuron < nlr.getLayer( layer )->getSize(); ++neuron )
+                nlr.setNeuronVariable( NLR::NeuronIndex( layer, neuron ), variable++ );
+
+        for ( unsigned i = 0; i < 9; ++i )
+        {
+            tableau.setLowerBound( i, -1 + 0.1 * i );
+            tableau.setUpperBound( i, 1 - 0.05 * i );
+        }
+
+        double large = 1000;
+        for ( unsigned i = 9; i < variable; ++i )
+        {
+            tableau.setLowerBound( i, -large );
+            tableau.setUpperBound( i, large );
+        }
+
+        nlr.setTableau( &tableau );
+    }
+
+    void compareNetworkOutputs( NLR::NetworkLevelReasoner &first, NLR::NetworkLevelReasoner &second )
+    {
+        double input[9];
+        double firstOutput[2];
+        double secondOutput[2];
+
+        for ( unsigned sample = 0; sample < 5; ++sample )
+        {
+            for ( unsigned i = 0; i < 9; ++i )
+                input[i] = ( ( sample * 7 + i * 3 ) % 11 ) / 5.0 - 1;
+
+            TS_ASSERT_THROWS_NOTHING( first.evaluate( input, firstOutput ) );
+            TS_ASSERT_THROWS_NOTHING( second.evaluate( input, secondOutput ) );
+
+            for ( unsigned i = 0; i < 2; ++i )
+                TS_ASSERT( FloatUtils::areEqual( firstOutput[i], secondOutput[i] ) );
+        }
+    }
+
+    void compareLayerBounds( NLR::NetworkLevelReasoner &first, NLR::NetworkLevelReasoner &second )
+    {
+        for ( unsigned layer = 1; layer < 4; ++layer )
+        {
+            for ( unsigned neuron = 0; neuron < first.getLayer( layer )->getSize(); ++neuron )
+            {
+                TS_ASSERT( FloatUtils::areEqual( first.getLayer( layer )->getLb( neuron ),
+                                                 second.getLayer( layer )->getLb( neuron ) ) );
+                TS_ASSERT( FloatUtils::areEqual( first.getLayer( layer )->getUb( neuron ),
+                                                 second.getLayer( layer )->getUb( neuron ) ) );
+            }
+        }
+    }
+
+    void test_evaluate_convolution()
+    {
+        NLR::NetworkLevelReasoner convolution;
+        MockTableau convolutionTableau;
+        populateNetworkWithConvolution( convolution, convolutionTableau, false );
+
+        NLR::NetworkLevelReasoner dense;
+        MockTableau denseTableau;
+        populateNetworkWithConvolution( dense, denseTableau, true );
+
+        const NLR::Layer *layer = convolution.getLayer( 1 );
+        TS_ASSERT_EQUALS( layer->getLayerType(), NLR::Layer::CONVOLUTION );
+        TS_ASSERT_EQUALS( layer->getConvolutionParameters().getOutputHeight(), 2U );
+        TS_ASSERT_EQUALS( layer->getConvolutionParameters().getOutputWidth(), 2U );
+
+        // The implicit weights match the dense ones
+        for ( unsigned i = 0; i < 9; ++i )
+            for ( unsigned j = 0; j < 8; ++j )
+                TS_ASSERT_EQUALS( layer->getWeight( 0, i, j ), dense.getLayer( 1 )->getWeight( 0, i, j ) );
+
+        // Neuron 3 is the bottom right pixel of channel 0, fed by input pixels 4, 5, 7 and 8
+        TS_ASSERT_EQUALS( layer->getConvolutionTaps( 3 ).size(), 4U );
+        TS_ASSERT_EQUALS( layer->getConvolutionTaps( 0 ).size(), 4U );
+
+        // With all inputs set to 1, neuron 0 is 0.5 + 2.25 + 2.75 + 3.25 + 3.75
+        double input[9];
+        double output[2];
+        std::fill_n( input, 9, 1 );
+        TS_ASSERT_THROWS_NOTHING( convolution.evaluate( input, output ) );
+        TS_ASSERT( FloatUtils::areEqual( layer->getAssignment( 0 ), 12.5 ) );
+
+        compareNetworkOutputs( convolution, dense );
+    }
+
+    void test_convolution_bound_propagation()
+    {
+        NLR::NetworkLevelReasoner convolution;
+        MockTableau convolutionTableau;
+        populateNetworkWithConvolution( convolution, convolutionTableau, false );
+
+        NLR::NetworkLevelReasoner dense;
+        MockTableau denseTableau;
+        populateNetworkWithConvolution( dense, denseTableau, true );
+
+        TS_ASSERT_THROWS_NOTHING( convolution.obtainCurrentBounds() );
+        TS_ASSERT_THROWS_NOTHING( dense.obtainCurrentBounds() );
+
+        TS_ASSERT_THROWS_NOTHING( convolution.intervalArithmeticBoundPropagation() );
+        TS_ASSERT_THROWS_NOTHING( dense.intervalArithmeticBoundPropagation() );
+        compareLayerBounds( convolution, dense );
+
+        if ( !GlobalConfiguration::USE_SYMBOLIC_BOUND_TIGHTENING )
+            return;
+
+        TS_ASSERT_THROWS_NOTHING( convolution.symbolicBoundPropagation() );
+        TS_ASSERT_THROWS_NOTHING( dense.symbolicBoundPropagation() );
+        compareLayerBounds( convolution, dense );
+
+        if ( GlobalConfiguration::MILP_SOLVER_BOUND_TIGHTENING_TYPE == GlobalConfiguration::NONE )
+            return;
+
+        TS_ASSERT_THROWS_NOTHING( convolution.lpRelaxationPropagation() );
+        TS_ASSERT_THROWS_NOTHING( dense.lpRelaxationPropagation() );
+        compareLayerBounds( convolution, dense );
+    }
+
+    void test_detect_convolution()
+    {
+        NLR::NetworkLevelReasoner detected;
+        MockTableau detectedTableau;
+        populateNetworkWithConvolution( detected, detectedTableau, true );
+
+        NLR::NetworkLevelReasoner dense;
+        MockTableau denseTableau;
+        populateNetworkWithConvolution( dense, denseTableau, true );
+
+        // Only the first weighted sum layer is a convolution
+        TS_ASSERT_EQUALS( detected.detectConvolutionalLayers(), 1U );
+        TS_ASSERT_EQUALS( detected.getLayer( 1 )->getLayerType(), NLR::Layer::CONVOLUTION );
+        TS_ASSERT_EQUALS( detected.getLayer( 3 )->getLayerType(), NLR::Layer::WEIGHTED_SUM );
+
+        const NLR::Layer::ConvolutionParameters &parameters =
+            detected.getLayer( 1 )->getConvolutionParameters();
+        TS_ASSERT_EQUALS( parameters._inputChannels, 1U );
+        TS_ASSERT_EQUALS( parameters._inputHeight, 3U );
+        TS_ASSERT_EQUALS( parameters._outputChannels, 2U );
+        TS_ASSERT_EQUALS( parameters._kernelHeight, 3U );
+        TS_ASSERT_EQUALS( parameters._stride, 2U );
+        TS_ASSERT_EQUALS( parameters._padding, 1U );
+
+        for ( unsigned o = 0; o < 2; ++o )
+            for ( unsigned row = 0; row < 3; ++row )
+                for ( unsigned column = 0; column < 3; ++column )
+                    TS_ASSERT_EQUALS( detected.getLayer( 1 )->getKernelWeight( o, 0, row, column ),
+                                      kernelWeightForConvolutionTest( o, row, column ) );
+
+        compareNetworkOutputs( detected, dense );
+
+        // Detection is idempotent, and the convolution survives duplication
+        TS_ASSERT_EQUALS( detected.detectConvolutionalLayers(), 0U );
+
+        NLR::NetworkLevelReasoner copy;
+        TS_ASSERT_THROWS_NOTHING( detected.storeIntoOther( copy ) );
+        TS_ASSERT_EQUALS( copy.getLayer( 1 )->getLayerType(), NLR::Layer::CONVOLUTION );
+        compareNetworkOutputs( copy, dense );
+
+        // A dense layer is left alone
+        NLR::NetworkLevelReasoner other;
+        MockTableau otherTableau;
+        populateNetworkWithConvolution( other, otherTableau, true );
+        other.setWeight( 0, 8, 1, 0, 1 );
+        TS_ASSERT_EQUALS( other.detectConvolutionalLayers(), 0U );
+    }
 };